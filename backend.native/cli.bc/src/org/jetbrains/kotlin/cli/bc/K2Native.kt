@@ -259,6 +259,7 @@ class K2Native : CLICompiler<K2NativeCompilerArguments>() {
                         DestroyRuntimeMode.ON_SHUTDOWN
                     }
                 })
+                put(LAZY_GLOBAL_INITIALIZATION, arguments.lazyGlobalInitialization)
             }
         }
     }
@@ -878,6 +878,8 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         output("void (*DisposeStablePointer)(${prefix}_KNativePtr ptr);", 1)
         output("void (*DisposeString)(const char* string);", 1)
         output("${prefix}_KBoolean (*IsInstance)(${prefix}_KNativePtr ref, const ${prefix}_KType* type);", 1)
+        output("void (*AttachRuntime)(void);", 1)
+        output("void (*DetachRuntime)(void);", 1)
         predefinedTypes.forEach {
             val nullableIt = it.makeNullable()
             val argument = if (!it.isUnit()) translateType(it) else "void"
@@ -928,6 +930,8 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         |void EnterFrame(KObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
         |void LeaveFrame(KObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
         |void Kotlin_initRuntimeIfNeeded();
+        |void Kotlin_attachRuntime();
+        |void Kotlin_detachRuntime();
         |void TerminateWithUnhandledException(KObjHeader*) RUNTIME_NORETURN;
         |
         |KObjHeader* CreateStringFromCString(const char*, KObjHeader**);
@@ -1007,6 +1011,8 @@ internal class CAdapterGenerator(val context: Context) : DeclarationDescriptorVi
         output(".DisposeStablePointer = DisposeStablePointerImpl,", 1)
         output(".DisposeString = DisposeStringImpl,", 1)
         output(".IsInstance = IsInstanceImpl,", 1)
+        output(".AttachRuntime = Kotlin_attachRuntime,", 1)
+        output(".DetachRuntime = Kotlin_detachRuntime,", 1)
         predefinedTypes.forEach {
             output(".${it.createNullableNameForPredefinedType} = ${it.createNullableNameForPredefinedType}Impl,", 1)
         }
@@ -148,6 +148,8 @@ class KonanConfigKeys {
                 = CompilerConfigurationKey.create("override konan.properties values")
         val DESTROY_RUNTIME_MODE: CompilerConfigurationKey<DestroyRuntimeMode>
                 = CompilerConfigurationKey.create("when to destroy runtime")
+        val LAZY_GLOBAL_INITIALIZATION: CompilerConfigurationKey<Boolean>
+                = CompilerConfigurationKey.create("initialize global properties on the first access")
     }
 }
 
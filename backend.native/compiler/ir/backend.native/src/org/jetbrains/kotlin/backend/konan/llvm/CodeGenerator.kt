@@ -946,9 +946,7 @@ internal class FunctionGenerationContext(val function: LLVMValueRef,
                 addPhiIncoming(resultPhi, currentBlock to fastValue)
             }
             appendingTo(slowPathBB) {
-                val actualInterfaceTableSize = sub(kImmInt32Zero, interfaceTableSize) // -interfaceTableSize
-                val slowValue = call(context.llvm.lookupInterfaceTableRecord,
-                        listOf(interfaceTable, actualInterfaceTableSize, Int32(interfaceId).llvm))
+                val slowValue = call(context.llvm.lookupInterfaceTableRecord, listOf(typeInfo, Int32(interfaceId).llvm))
                 br(takeResBB)
                 addPhiIncoming(resultPhi, currentBlock to slowValue)
             }
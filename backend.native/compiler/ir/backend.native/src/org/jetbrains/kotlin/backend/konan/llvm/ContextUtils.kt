@@ -522,6 +522,7 @@ internal class Llvm(val context: Context, val llvmModule: LLVMModuleRef) {
     val checkLifetimesConstraint = importRtFunction("CheckLifetimesConstraint")
     val freezeSubgraph = importRtFunction("FreezeSubgraph")
     val checkGlobalsAccessible = importRtFunction("CheckGlobalsAccessible")
+    val callInitGlobalPossiblyLock = importRtFunction("CallInitGlobalPossiblyLock")
 
     val kRefSharedHolderInitLocal = importRtFunction("KRefSharedHolder_initLocal")
     val kRefSharedHolderInit = importRtFunction("KRefSharedHolder_init")
@@ -16,6 +16,7 @@ import org.jetbrains.kotlin.backend.konan.descriptors.*
 import org.jetbrains.kotlin.backend.konan.ir.*
 import org.jetbrains.kotlin.backend.konan.llvm.coverage.LLVMCoverageInstrumentation
 import org.jetbrains.kotlin.builtins.UnsignedType
+import org.jetbrains.kotlin.descriptors.ClassKind
 import org.jetbrains.kotlin.descriptors.Modality
 import org.jetbrains.kotlin.ir.IrElement
 import org.jetbrains.kotlin.ir.IrStatement
@@ -334,8 +335,11 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
             return
         }
 
+        val lazyFields = context.llvm.fileInitializers.filter { it.isLazilyInitialized() }
+        val lazyInitializer = if (lazyFields.isEmpty()) null else createLazyInitializer(lazyFields)
+
         // Create global initialization records.
-        val initNode = createInitNode(createInitBody())
+        val initNode = createInitNode(createInitBody(lazyInitializer))
         context.llvm.irStaticInitializers.add(IrStaticInitializer(konanLibrary, createInitCtor(initNode)))
     }
 
@@ -388,7 +392,11 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
     val INIT_THREAD_LOCAL_GLOBALS = 2
     val DEINIT_GLOBALS = 3
 
-    private fun createInitBody(): LLVMValueRef {
+    // Init states of lazily initialized files, must be synchronized with Runtime.cpp
+    val FILE_NOT_INITIALIZED = 0
+    val FILE_INITIALIZED = 1
+
+    private fun createInitBody(lazyInitializer: LazyFileInitializer?): LLVMValueRef {
         val initFunction = LLVMAddFunction(context.llvmModule, "", kInitFuncType)!!
         LLVMSetLinkage(initFunction, LLVMLinkage.LLVMPrivateLinkage)
         generateFunction(codegen, initFunction) {
@@ -411,32 +419,8 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
                 // Globals initalizers may contain accesses to objects, so visit them first.
                 appendingTo(bbInit) {
                     context.llvm.fileInitializers
-                            .forEach { irField ->
-                                if (irField.storageKind != FieldStorageKind.THREAD_LOCAL) {
-                                    val address = context.llvmDeclarations.forStaticField(irField).storageAddressAccess.getAddress(
-                                            functionGenerationContext
-                                    )
-                                    val initialValue = if (irField.initializer?.expression !is IrConst<*>?) {
-                                        val initialization = evaluateExpression(irField.initializer!!.expression)
-                                        if (irField.storageKind == FieldStorageKind.SHARED_FROZEN)
-                                            freeze(initialization, currentCodeContext.exceptionHandler)
-                                        initialization
-                                    } else {
-                                        null
-                                    }
-                                    val needRegistration =
-                                            context.memoryModel == MemoryModel.EXPERIMENTAL && // only for the new MM
-                                                    irField.type.binaryTypeIsReference() && // only for references
-                                                    (initialValue != null || // which are initialized from heap object
-                                                            !irField.isFinal) // or are not final
-                                    if (needRegistration) {
-                                        call(context.llvm.initAndRegisterGlobalFunction, listOf(address, initialValue
-                                                ?: kNullObjHeaderPtr))
-                                    } else if (initialValue != null) {
-                                        storeAny(initialValue, address, false)
-                                    }
-                                }
-                            }
+                            .filter { it.storageKind != FieldStorageKind.THREAD_LOCAL && !it.isLazilyInitialized() }
+                            .forEach { initializeGlobal(it) }
                     ret(null)
                 }
 
@@ -477,6 +461,8 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
                     context.llvm.globalSharedObjects.forEach { address ->
                         storeHeapRef(codegen.kNullObjHeaderPtr, address)
                     }
+                    if (lazyInitializer != null)
+                        store(Int32(FILE_NOT_INITIALIZED).llvm, lazyInitializer.state)
                     ret(null)
                 }
             }
@@ -484,6 +470,97 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
         return initFunction
     }
 
+    private fun initializeGlobal(irField: IrField) {
+        val address = context.llvmDeclarations.forStaticField(irField).storageAddressAccess.getAddress(
+                functionGenerationContext
+        )
+        val initialValue = if (irField.initializer?.expression !is IrConst<*>?) {
+            val initialization = evaluateExpression(irField.initializer!!.expression)
+            if (irField.storageKind == FieldStorageKind.SHARED_FROZEN)
+                functionGenerationContext.freeze(initialization, currentCodeContext.exceptionHandler)
+            initialization
+        } else {
+            null
+        }
+        val needRegistration =
+                context.memoryModel == MemoryModel.EXPERIMENTAL && // only for the new MM
+                        irField.type.binaryTypeIsReference() && // only for references
+                        (initialValue != null || // which are initialized from heap object
+                                !irField.isFinal) // or are not final
+        if (needRegistration) {
+            functionGenerationContext.call(context.llvm.initAndRegisterGlobalFunction, listOf(address, initialValue
+                    ?: codegen.kNullObjHeaderPtr))
+        } else if (initialValue != null) {
+            functionGenerationContext.storeAny(initialValue, address, false)
+        }
+    }
+
+    //-------------------------------------------------------------------------//
+    // Lazy global initialization (-Xlazy-global-initialization).
+    //
+    // Global properties with non-trivial initializers are initialized per file on the first access to any of them
+    // instead of at startup. Each such file gets an init state word and an initializer function, every access to
+    // its lazy properties checks the state first and calls the runtime to run the initializer if needed.
+
+    private class LazyFileInitializer(val state: LLVMValueRef, val function: LLVMValueRef)
+
+    private val lazyFileInitializers = mutableMapOf<IrFile, LazyFileInitializer>()
+    private val lazilyInitializedFields = mutableMapOf<IrField, Boolean>()
+    private var currentLazyInitializerFile: IrFile? = null
+
+    private fun IrField.isLazilyInitialized(): Boolean = lazilyInitializedFields.getOrPut(this) {
+        // Fields without properties (e.g. test suite registrations) exist for the side effects of their initializers.
+        context.config.lazyGlobalInitialization && context.needGlobalInit(this) && correspondingPropertySymbol != null &&
+                context.llvmModuleSpecification.containsDeclaration(this) &&
+                initializer.let { it != null && it.expression !is IrConst<*> } &&
+                when (storageKind) {
+                    FieldStorageKind.THREAD_LOCAL -> false
+                    // With the strict memory model the initializer may only run on the main thread, and only
+                    // the accesses to non-primitive globals are guaranteed to happen there.
+                    FieldStorageKind.SHARED_FROZEN -> context.memoryModel != MemoryModel.STRICT
+                    FieldStorageKind.GLOBAL -> context.memoryModel != MemoryModel.STRICT || isGlobalNonPrimitive
+                } &&
+                staticInitializer(this) == null
+    }
+
+    private fun lazyFileInitializer(file: IrFile): LazyFileInitializer = lazyFileInitializers.getOrPut(file) {
+        val state = context.llvm.staticData.placeGlobal("init_state", Int32(FILE_NOT_INITIALIZED)).llvmGlobal
+        val function = LLVMAddFunction(context.llvmModule, "", functionType(voidType, false))!!
+        LazyFileInitializer(state, function)
+    }
+
+    private fun createLazyInitializer(fields: List<IrField>): LazyFileInitializer {
+        val file = fields.first().file
+        val initializer = lazyFileInitializer(file)
+        currentLazyInitializerFile = file
+        generateFunction(codegen, initializer.function) {
+            using(FunctionScope(initializer.function, "lazy_init_body", it)) {
+                fields.forEach { initializeGlobal(it) }
+                ret(null)
+            }
+        }
+        currentLazyInitializerFile = null
+        LLVMSetLinkage(initializer.function, LLVMLinkage.LLVMPrivateLinkage)
+        return initializer
+    }
+
+    private fun initializeLazyGlobalIfNeeded(field: IrField) {
+        if (!field.isLazilyInitialized()) return
+        val file = field.file
+        // Recursive accesses from the initializer itself are known to see the initialized file.
+        if (file == currentLazyInitializerFile) return
+        val initializer = lazyFileInitializer(file)
+        with(functionGenerationContext) {
+            val state = load(initializer.state)
+            LLVMSetOrdering(state, LLVMAtomicOrdering.LLVMAtomicOrderingAcquire)
+            LLVMSetAlignment(state, 4)
+            ifThen(icmpNe(state, Int32(FILE_INITIALIZED).llvm)) {
+                call(context.llvm.callInitGlobalPossiblyLock, listOf(initializer.state, initializer.function),
+                        Lifetime.IRRELEVANT, currentCodeContext.exceptionHandler)
+            }
+        }
+    }
+
     //-------------------------------------------------------------------------//
     // Creates static struct InitNode $nodeName = {$initName, NULL};
 
@@ -847,14 +924,95 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
             val globalPropertyAccess = context.llvmDeclarations.forStaticField(declaration).storageAddressAccess
             val initializer = declaration.initializer?.expression as? IrConst<*>
             val globalProperty = (globalPropertyAccess as? GlobalAddressAccess)?.getAddress(null)
+            val staticValue = if (globalProperty != null && initializer == null) staticInitializer(declaration) else null
             if (globalProperty != null) {
-                LLVMSetInitializer(globalProperty, if (initializer != null)
-                    evaluateExpression(initializer) else LLVMConstNull(type))
+                LLVMSetInitializer(globalProperty, when {
+                    initializer != null -> evaluateExpression(initializer)
+                    staticValue != null -> staticValue.llvm
+                    else -> LLVMConstNull(type)
+                })
                 // (Cannot do this before the global is initialized).
                 LLVMSetLinkage(globalProperty, LLVMLinkage.LLVMInternalLinkage)
             }
-            context.llvm.fileInitializers.add(declaration)
+            // Permanent objects are neither registered nor released, so the file initializer has nothing to do.
+            if (staticValue == null)
+                context.llvm.fileInitializers.add(declaration)
+        }
+    }
+
+    /**
+     * Evaluates the initializer of a global property at compile time if it only constructs objects from constants,
+     * e.g. `@SharedImmutable val origin = Point(0, 0)`. The objects are emitted as permanent ones into the data
+     * section, so nothing is executed at startup for such properties. Permanent objects are frozen, so only
+     * the properties frozen anyway after their initialization are built this way, and in any optimization mode.
+     */
+    private val staticInitializers = mutableMapOf<IrField, ConstValue?>()
+
+    private fun staticInitializer(field: IrField): ConstValue? =
+            staticInitializers.getOrPut(field) { evaluateStaticInitializer(field) }
+
+    private fun evaluateStaticInitializer(field: IrField): ConstValue? {
+        if (!field.isFinal || field.storageKind != FieldStorageKind.SHARED_FROZEN)
+            return null
+        // Objective-C wrappers are attached to objects through meta-objects, which permanent objects can't have.
+        if (context.config.target.family.isAppleFamily) return null
+        val constructorCall = field.initializer?.expression as? IrConstructorCall ?: return null
+        return evaluateStaticConstructorCall(constructorCall)
+    }
+
+    private fun evaluateStaticValue(value: IrExpression): ConstValue? = when (value) {
+        is IrConst<*> -> constValue(evaluateConst(value))
+        is IrConstructorCall -> evaluateStaticConstructorCall(value)
+        else -> null
+    }
+
+    private fun evaluateStaticConstructorCall(call: IrConstructorCall): ConstValue? {
+        val constructor = call.symbol.owner
+        val irClass = constructor.constructedClass
+        // Permanent objects are frozen, so only the classes with immutable state can be used.
+        if (irClass.kind != ClassKind.CLASS || irClass.modality != Modality.FINAL || irClass.isInner ||
+                irClass.isInlined() || irClass.isObjCClass())
+            return null
+        val fields = context.getLayoutBuilder(irClass).fields
+        if (fields.any { !it.isFinal }) return null
+        val storedValues = constructor.storedFieldValues() ?: return null
+        val values = fields.map { field ->
+            val stored = storedValues[field] ?: return null
+            val value = if (stored is IrGetValue)
+                call.getValueArgument((stored.symbol.owner as IrValueParameter).index) ?: return null
+            else
+                stored
+            evaluateStaticValue(value) ?: return null
+        }
+        return context.llvm.staticData.createConstKotlinObject(irClass, *values.toTypedArray())
+    }
+
+    /**
+     * Returns the values the constructor stores to the fields: constants or its own parameters, or null if it does
+     * anything else. Matches the lowered primary constructors of the classes with no initializer blocks.
+     */
+    private fun IrConstructor.storedFieldValues(): Map<IrField, IrExpression>? {
+        val statements = (body as? IrBlockBody)?.statements ?: return null
+        val irClass = constructedClass
+        val values = mutableMapOf<IrField, IrExpression>()
+        fun collect(statement: IrStatement): Boolean = when {
+            statement is IrDelegatingConstructorCall ->
+                statement.symbol.owner.constructedClass.isAny()
+            statement is IrBlock && statement.origin == IrStatementOrigin.INITIALIZE_FIELD ->
+                statement.statements.all { collect(it) }
+            statement is IrSetField -> {
+                val field = statement.symbol.owner
+                val value = statement.value
+                val storesConstant = value is IrConst<*> ||
+                        (value is IrGetValue && value.symbol.owner in valueParameters)
+                (statement.receiver as? IrGetValue)?.symbol == irClass.thisReceiver?.symbol &&
+                        field.parent == irClass && storesConstant && values.put(field, value) == null
+            }
+            statement is IrReturn ->
+                statement === statements.last() && (statement.value as? IrGetObjectValue)?.symbol == context.irBuiltIns.unitClass
+            else -> false
         }
+        return values.takeIf { statements.all { collect(it) } }
     }
 
     private fun recordCoverage(irElement: IrElement) {
@@ -1580,6 +1738,7 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
                 if (context.config.threadsAreAllowed && value.symbol.owner.isGlobalNonPrimitive) {
                     functionGenerationContext.checkGlobalsAccessible(currentCodeContext.exceptionHandler)
                 }
+                initializeLazyGlobalIfNeeded(value.symbol.owner)
                 val ptr = context.llvmDeclarations.forStaticField(value.symbol.owner).storageAddressAccess.getAddress(
                         functionGenerationContext
                 )
@@ -1648,6 +1807,7 @@ internal class CodeGeneratorVisitor(val context: Context, val lifetimes: Map<IrE
             )
             if (context.config.threadsAreAllowed && value.symbol.owner.storageKind == FieldStorageKind.GLOBAL)
                 functionGenerationContext.checkGlobalsAccessible(currentCodeContext.exceptionHandler)
+            initializeLazyGlobalIfNeeded(value.symbol.owner)
             if (value.symbol.owner.storageKind == FieldStorageKind.SHARED_FROZEN)
                 functionGenerationContext.freeze(valueToAssign, currentCodeContext.exceptionHandler)
             functionGenerationContext.storeAny(valueToAssign, globalAddress, false)
@@ -53,6 +53,10 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
         else -> false
     }
 
+    // The annotation is inherited, so that subclasses of control flow exceptions don't capture stack traces either.
+    private fun hasNoStackTrace(irClass: IrClass): Boolean =
+            generateSequence(irClass) { it.getSuperClassNotAny() }.any { it.hasAnnotation(KonanFqNames.noStackTrace) }
+
     private fun flagsFromClass(irClass: IrClass): Int {
         var result = 0
         if (irClass.isFrozen)
@@ -77,13 +81,17 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
             result = result or TF_HAS_FINALIZER
         }
 
+        if (hasNoStackTrace(irClass)) {
+            result = result or TF_NO_STACK_TRACE
+        }
+
         return result
     }
 
     inner class MethodTableRecord(val nameSignature: LocalHash, methodEntryPoint: ConstPointer?) :
             Struct(runtime.methodTableRecordType, nameSignature, methodEntryPoint)
 
-    inner class InterfaceTableRecord(id: Int32, vtableSize: Int32, vtable: ConstPointer?) :
+    inner class InterfaceTableRecord(val id: Int32, vtableSize: Int32, vtable: ConstPointer?) :
             Struct(runtime.interfaceTableRecordType, id, vtableSize, vtable)
 
     private inner class TypeInfo(
@@ -97,8 +105,10 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
             interfacesCount: Int,
             methods: ConstValue,
             methodsCount: Int,
+            methodsIndex: ConstPointer,
             interfaceTableSize: Int,
             interfaceTable: ConstValue,
+            interfaceTableIndex: ConstPointer,
             packageName: String?,
             relativeName: String?,
             flags: Int,
@@ -143,7 +153,10 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
 
                     *listOfNotNull(writableTypeInfo).toTypedArray(),
 
-                    associatedObjects
+                    associatedObjects,
+
+                    methodsIndex,
+                    interfaceTableIndex
             )
 
     private fun kotlinStringLiteral(string: String?): ConstPointer = if (string == null) {
@@ -152,6 +165,40 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
         staticData.kotlinStringLiteral(string)
     }
 
+    // Keep in sync with TypeInfo.cpp.
+    private val TABLE_INDEX_LINEAR_SEARCH_THRESHOLD = 8
+
+    // Keep in sync with MixKey in TypeInfo.cpp.
+    private fun tableIndexSlot(key: Long): Int = ((key * -0x61C8864680B583EBL) ushr 32).toInt()
+
+    /**
+     * Places the open addressing hash index of a table sorted by [keys], used by the runtime to look up
+     * the records in constant time. Small tables are scanned by the runtime, so they get null instead.
+     */
+    private fun placeTableIndex(name: String, keys: List<Long>): ConstPointer {
+        if (keys.size <= TABLE_INDEX_LINEAR_SEARCH_THRESHOLD) return NullPointer(int32Type)
+        var size = 1
+        while (size < 2 * keys.size) size *= 2
+        val mask = size - 1
+        val slots = IntArray(size) { -1 }
+        keys.forEachIndexed { record, key ->
+            var slot = tableIndexSlot(key) and mask
+            while (slots[slot] != -1) slot = (slot + 1) and mask
+            slots[slot] = record
+        }
+        return staticData.placeGlobalConstArray(name, int32Type, listOf(Int32(mask)) + slots.map { Int32(it) })
+    }
+
+    private fun placeMethodsIndex(name: String, methods: List<MethodTableRecord>) =
+            placeTableIndex(name, methods.map { it.nameSignature.value })
+
+    // Only the conservative interface tables, sorted by the interface id, are looked up by the runtime.
+    private fun placeInterfaceTableIndex(name: String, interfaceTable: List<InterfaceTableRecord>, interfaceTableSize: Int) =
+            if (interfaceTableSize >= 0)
+                NullPointer(int32Type)
+            else
+                placeTableIndex(name, interfaceTable.map { it.id.value.toLong() })
+
     private val EXPORT_TYPE_INFO_FQ_NAME = FqName.fromSegments(listOf("kotlin", "native", "internal", "ExportTypeInfo"))
 
     private fun exportTypeInfoIfRequired(irClass: IrClass, typeInfoGlobal: LLVMValueRef?) {
@@ -280,7 +327,9 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
                 objOffsetsPtr, objOffsetsCount,
                 interfacesPtr, interfaces.size,
                 methodsPtr, methods.size,
+                placeMethodsIndex("kmethodsindex:$className", methods),
                 interfaceTableSize, interfaceTablePtr,
+                placeInterfaceTableIndex("kifacetableindex:$className", interfaceTable, interfaceTableSize),
                 reflectionInfo.packageName,
                 reflectionInfo.relativeName,
                 flagsFromClass(irClass),
@@ -595,7 +644,9 @@ internal class RTTIGenerator(override val context: Context) : ContextUtils {
                 objOffsets = objOffsetsPtr, objOffsetsCount = objOffsetsCount,
                 interfaces = interfacesPtr, interfacesCount = interfaces.size,
                 methods = methodsPtr, methodsCount = methods.size,
+                methodsIndex = placeMethodsIndex("", methods),
                 interfaceTableSize = interfaceTableSize, interfaceTable = interfaceTablePtr,
+                interfaceTableIndex = placeInterfaceTableIndex("", interfaceTable, interfaceTableSize),
                 packageName = reflectionInfo.packageName,
                 relativeName = reflectionInfo.relativeName,
                 flags = flagsFromClass(irClass) or (if (immutable) TF_IMMUTABLE else 0),
@@ -640,4 +691,5 @@ private const val TF_OBJC_DYNAMIC = 8
 private const val TF_LEAK_DETECTOR_CANDIDATE = 16
 private const val TF_SUSPEND_FUNCTION = 32
 private const val TF_HAS_FINALIZER = 64
+private const val TF_NO_STACK_TRACE = 128
 
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package codegen.initializers.lazyGlobals
+
+import kotlin.native.internal.Debugging
+import kotlin.test.*
+
+var created = 0
+
+class Holder(val value: Int) {
+    init {
+        created++
+    }
+}
+
+// Compiled with -Xlazy-global-initialization, so the file is initialized on the first access to these.
+val first = Holder(1)
+val second = Holder(first.value + 1)
+
+@Test fun runTest() {
+    val filesBefore = Debugging.initializedFilesCount
+    val createdBefore = created
+    val value = second.value
+    val filesAfter = Debugging.initializedFilesCount
+
+    assertEquals(0, createdBefore)
+    assertEquals(2, value)
+    assertEquals(2, created)
+    assertEquals(filesBefore + 1, filesAfter)
+    assertEquals(1, first.value)
+    assertEquals(2, created)
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package codegen.initializers.staticObjects
+
+import kotlin.native.concurrent.SharedImmutable
+import kotlin.native.concurrent.isFrozen
+import kotlin.test.*
+
+data class Point(val x: Int, val y: Int)
+
+class Segment(val name: String, val from: Point, val to: Point, val length: Double)
+
+class Logged(val value: Int) {
+    init {
+        println("Logged($value)")
+    }
+}
+
+// Built at compile time into permanent objects, as they are frozen anyway.
+@SharedImmutable
+val origin = Point(0, 0)
+@SharedImmutable
+val segment = Segment("diagonal", Point(1, 2), Point(4, 6), 5.0)
+@SharedImmutable
+val nothing: Point? = null
+// Not frozen, so initialized at startup.
+val plain = Point(2, 3)
+// Have side effects and are initialized at startup.
+@SharedImmutable
+val logged = Logged(42)
+val computed = Point(origin.x + 1, segment.to.y)
+
+@Test fun runTest() {
+    assertEquals(Point(0, 0), origin)
+    assertSame(origin, origin)
+    assertEquals("diagonal", segment.name)
+    assertEquals(Point(1, 2), segment.from)
+    assertEquals(Point(4, 6), segment.to)
+    assertEquals(5.0, segment.length)
+    assertEquals(Point(0, 0).hashCode(), origin.hashCode())
+    assertEquals("Point(x=4, y=6)", segment.to.toString())
+    assertNull(nothing)
+    assertEquals(Point(1, 6), computed)
+    assertEquals(Point(2, 3), plain)
+    println(logged.value)
+}
+
+// Whether built at compile time or at startup, as on Apple targets, the globals are frozen as before.
+@Test fun frozenness() {
+    assertTrue(origin.isFrozen)
+    assertTrue(segment.isFrozen)
+    assertTrue(segment.from.isFrozen)
+    assertTrue(logged.isFrozen)
+    assertFalse(plain.isFrozen)
+    assertFalse(computed.isFrozen)
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+import kotlin.native.concurrent.ThreadLocal
+import kotlin.native.internal.Debugging
+
+@ThreadLocal
+private var callsOnThread = 0
+
+fun ensureInitialized() {}
+
+fun callback(): Int = ++callsOnThread
+
+fun printAttachStatistics() {
+    println("attaches: ${Debugging.runtimeAttachCount}")
+    println("reused: ${Debugging.reusedRuntimeAttachCount}")
+}
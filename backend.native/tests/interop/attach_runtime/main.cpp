@@ -0,0 +1,29 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "testlib_api.h"
+
+#include <thread>
+
+int main() {
+    auto* lib = testlib_symbols();
+    lib->kotlin.root.ensureInitialized();
+    bool ok = true;
+    for (int i = 0; i < 4; ++i) {
+        std::thread t([lib, &ok]() {
+            lib->AttachRuntime();
+            // Nested attaches are only counted.
+            lib->AttachRuntime();
+            // Thread-local globals are initialized anew on every attach.
+            ok = ok && lib->kotlin.root.callback() == 1;
+            lib->DetachRuntime();
+            ok = ok && lib->kotlin.root.callback() == 2;
+            lib->DetachRuntime();
+        });
+        t.join();
+    }
+    lib->kotlin.root.printAttachStatistics();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,14 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+import kotlin.native.internal.Debugging
+
+fun ensureInitialized() {}
+
+// Allocates in the object heap of the calling thread, which is released when the runtime is detached from it.
+fun allocate(count: Int): Int {
+    val objects = List(count) { Any() }
+    return if (Debugging.objectHeapSize > 0) objects.size else -1
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "testlib_api.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+int main() {
+    auto* lib = testlib_symbols();
+    lib->kotlin.root.ensureInitialized();
+    std::atomic<bool> ok(true);
+    for (int i = 0; i < 4; ++i) {
+        // Detached explicitly, while the allocator still serves the thread.
+        std::thread([lib, &ok]() {
+            lib->AttachRuntime();
+            if (lib->kotlin.root.allocate(1000) != 1000) ok = false;
+            lib->DetachRuntime();
+        }).join();
+        // Attached by the call, and detached when the thread exits, possibly after the allocator is done with it.
+        std::thread([lib, &ok]() {
+            if (lib->kotlin.root.allocate(1000) != 1000) ok = false;
+        }).join();
+    }
+    printf("%s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
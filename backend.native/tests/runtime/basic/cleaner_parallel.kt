@@ -0,0 +1,44 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+@file:OptIn(ExperimentalStdlibApi::class)
+
+package runtime.basic.cleaner_parallel
+
+import kotlin.test.*
+
+import kotlin.native.internal.*
+import kotlin.native.concurrent.*
+import kotlin.system.getTimeMillis
+
+const val CLEANERS_COUNT = 10000
+
+fun createCleaners(counter: AtomicInt) {
+    for (i in 0 until CLEANERS_COUNT) {
+        createCleaner(counter) { it.increment() }
+    }
+}
+
+@Test
+fun testParallelCleaners() {
+    assertEquals(1, cleanerWorkersCount)
+    cleanerWorkersCount = 4
+    assertEquals(4, cleanerWorkersCount)
+
+    val counter = AtomicInt(0).freeze()
+    createCleaners(counter)
+    assertFailsWith<IllegalStateException> {
+        cleanerWorkersCount = 2
+    }
+
+    GC.collect()
+    val deadline = getTimeMillis() + 60_000
+    while (Debugging.pendingCleanersCount > 0L) {
+        assertTrue(getTimeMillis() < deadline, "Cleaners are still pending: ${Debugging.pendingCleanersCount}")
+    }
+
+    assertEquals(CLEANERS_COUNT, counter.value)
+    assertEquals(CLEANERS_COUNT.toLong(), Debugging.executedCleanersCount)
+    assertTrue(Debugging.maxCleanerLagNanos >= 0L)
+}
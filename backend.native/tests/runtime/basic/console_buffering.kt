@@ -0,0 +1,107 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+@file:OptIn(ExperimentalStdlibApi::class)
+
+import kotlinx.cinterop.*
+import platform.posix.*
+import kotlin.system.exitProcess
+import kotlin.test.*
+
+// Everything that can be read from `fd` right now.
+fun readAvailable(fd: Int): String {
+    val buffer = ByteArray(1024)
+    val result = StringBuilder()
+    while (true) {
+        val count = buffer.usePinned { read(fd, it.addressOf(0), buffer.size.convert()) }.toInt()
+        if (count <= 0) return result.toString()
+        result.append(buffer.decodeToString(0, count))
+    }
+}
+
+fun readFile(path: String): String {
+    val fd = open(path, O_RDONLY)
+    assertTrue(fd >= 0)
+    try {
+        return readAvailable(fd)
+    } finally {
+        close(fd)
+    }
+}
+
+fun redirectStdout(fd: Int) {
+    assertEquals(STDOUT_FILENO, dup2(fd, STDOUT_FILENO))
+    // AUTO is resolved again for the new standard output.
+    Platform.consoleBuffering = ConsoleBuffering.AUTO
+}
+
+fun regularFileStdout() {
+    val path = "${getenv("TMPDIR")?.toKString() ?: "/tmp"}/console_buffering_${getpid()}.txt"
+    val file = assertNotNull(fopen(path, "w"))
+    redirectStdout(fileno(file))
+    fclose(file)
+    try {
+        // Fully buffered: the lines are only written out on request, in the order they were printed.
+        println("file 1")
+        print("file ")
+        println(2)
+        print("file 3")
+        assertEquals("", readFile(path))
+        Platform.flushConsole()
+        assertEquals("file 1\nfile 2\nfile 3", readFile(path))
+
+        Platform.consoleBuffering = ConsoleBuffering.LINE
+        println()
+        assertEquals("file 1\nfile 2\nfile 3\n", readFile(path))
+    } finally {
+        unlink(path)
+    }
+}
+
+fun pipeStdout() {
+    val (readEnd, writeEnd) = memScoped {
+        val fds = allocArray<IntVar>(2)
+        assertEquals(0, pipe(fds))
+        fds[0] to fds[1]
+    }
+    fcntl(readEnd, F_SETFL, O_NONBLOCK)
+    redirectStdout(writeEnd)
+    close(writeEnd)
+
+    // Line buffered, as something on the other side may be waiting for the lines.
+    print("pipe 1")
+    assertEquals("", readAvailable(readEnd))
+    println()
+    assertEquals("pipe 1\n", readAvailable(readEnd))
+    println("pipe 2")
+    assertEquals("pipe 2\n", readAvailable(readEnd))
+
+    Platform.consoleBuffering = ConsoleBuffering.NONE
+    print("pipe 3")
+    assertEquals("pipe 3", readAvailable(readEnd))
+
+    Platform.consoleBuffering = ConsoleBuffering.FULL
+    assertEquals(ConsoleBuffering.FULL, Platform.consoleBuffering)
+    println("pipe 4")
+    assertEquals("", readAvailable(readEnd))
+    // Changing the policy writes out what's buffered.
+    Platform.consoleBuffering = ConsoleBuffering.LINE
+    assertEquals("pipe 4\n", readAvailable(readEnd))
+    close(readEnd)
+}
+
+fun main() {
+    val stdout = dup(STDOUT_FILENO)
+    regularFileStdout()
+    pipeStdout()
+    redirectStdout(stdout)
+    close(stdout)
+
+    // Written out by exitProcess.
+    Platform.consoleBuffering = ConsoleBuffering.FULL
+    println("exit 1")
+    print("exit 2")
+    exitProcess(0)
+}
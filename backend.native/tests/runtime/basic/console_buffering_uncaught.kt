@@ -0,0 +1,13 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+@file:OptIn(ExperimentalStdlibApi::class)
+
+fun main() {
+    Platform.consoleBuffering = ConsoleBuffering.FULL
+    println("buffered")
+    // The report of the exception is buffered as well, and both are written out when the program terminates.
+    throw IllegalStateException("failure")
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.exceptions.no_stack_trace
+
+import kotlin.native.internal.NoStackTrace
+import kotlin.test.*
+
+@NoStackTrace
+open class Signal : Throwable()
+
+class DerivedSignal : Signal()
+
+// Same as Signal, but without the annotation.
+open class PlainSignal : Throwable()
+
+class Failure : Exception()
+
+fun <T : Throwable> throwAt(depth: Int, create: () -> T): T =
+        if (depth == 0) throw create() else throwAt(depth - 1, create)
+
+fun <T : Throwable> catchAt(depth: Int, create: () -> T): Throwable {
+    try {
+        throwAt(depth, create)
+    } catch (e: Throwable) {
+        return e
+    }
+    fail("Nothing thrown")
+}
+
+@Test fun runTest() {
+    // Captured for the same throwable without the annotation, so the empty traces below are suppressed ones.
+    assertTrue(catchAt(3) { PlainSignal() }.getStackTrace().isNotEmpty())
+    assertEquals(0, catchAt(3) { Signal() }.getStackTrace().size)
+    assertEquals(0, catchAt(3) { DerivedSignal() }.getStackTrace().size)
+    assertEquals(0, catchAt(300) { Signal() }.getStackTrace().size)
+    assertEquals(0, Signal().getStackTrace().size)
+
+    val shallow = catchAt(3) { Failure() }.getStackTrace().size
+    assertTrue(shallow > 0)
+    // Deeper than the per-thread scratch buffer used for capturing.
+    val deep = catchAt(300) { Failure() }.getStackTrace().size
+    assertTrue(deep >= shallow)
+    println("OK")
+}
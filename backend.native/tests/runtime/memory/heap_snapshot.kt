@@ -0,0 +1,53 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.heap_snapshot
+
+import kotlin.native.internal.GC
+import kotlin.test.*
+import kotlinx.cinterop.*
+import platform.posix.*
+
+class Retained(val payload: ByteArray)
+
+var sink: Retained? = null
+
+// Both a global and a local, for the snapshots of the memory managers start from different roots.
+var global: List<Retained>? = null
+
+// Runs tools/scripts/heap_snapshot.py on the snapshot, and returns the counts of the objects per type.
+fun analyze(script: String, snapshot: String): Map<String, Int> {
+    val pipe = popen("python3 $script --bytes --types 100000 --objects 0 $snapshot", "r")
+            ?: error("Cannot run $script")
+    val counts = mutableMapOf<String, Int>()
+    memScoped {
+        val buffer = allocArray<ByteVar>(1024)
+        while (fgets(buffer, 1024, pipe) != null) {
+            // Count, shallow and retained sizes, and the type.
+            val columns = buffer.toKString().trim().split(Regex("\\s+"))
+            val count = columns.first().toIntOrNull()
+            if (columns.size == 4 && count != null) counts[columns[3]] = count
+        }
+    }
+    assertEquals(0, pclose(pipe), "$script failed")
+    return counts
+}
+
+fun main(args: Array<String>) {
+    val retained = List(100) { Retained(ByteArray(1000)) }
+    global = retained
+    // Released right before the snapshot, so that their containers may be still waiting to be freed.
+    repeat(10) { sink = Retained(ByteArray(10)) }
+    sink = null
+    val snapshot = "${getenv("TMPDIR")?.toKString() ?: "/tmp"}/heap_snapshot_${getpid()}.bin"
+    assertTrue(GC.dumpHeapSnapshot(snapshot))
+    try {
+        val counts = analyze(args[0], snapshot)
+        assertEquals(retained.size, counts["runtime.memory.heap_snapshot.Retained"])
+    } finally {
+        remove(snapshot)
+    }
+    println("OK")
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.refs_range
+
+import kotlin.native.concurrent.*
+import kotlin.native.ref.*
+import kotlin.test.*
+
+// Array.copyInto and Array.fill update the reference counters of a whole range at once, in chunks of 64 elements.
+// Each case is checked against the element-wise model, and the leak checker verifies at exit that the counters
+// are balanced.
+
+class Node(val id: Int) {
+    var next: Any? = null
+}
+
+val shared = Node(-1)
+
+fun newElements(size: Int): Array<Any?> = Array(size) {
+    when {
+        it % 7 == 0 -> null
+        it % 3 == 0 -> shared
+        else -> Node(it)
+    }
+}
+
+fun snapshot(array: Array<Any?>): List<Any?> = List(array.size) { array[it] }
+
+fun assertSameElements(expected: List<Any?>, actual: Array<Any?>) {
+    assertEquals(expected.size, actual.size)
+    for (index in expected.indices) {
+        assertSame(expected[index], actual[index], "at $index")
+    }
+}
+
+fun checkCopy(source: Array<Any?>, destination: Array<Any?>, destinationOffset: Int, startIndex: Int, endIndex: Int) {
+    val from = snapshot(source)
+    val expected = snapshot(destination).toMutableList()
+    for (index in startIndex until endIndex) {
+        expected[destinationOffset + index - startIndex] = from[index]
+    }
+    source.copyInto(destination, destinationOffset, startIndex, endIndex)
+    assertSameElements(expected, destination)
+}
+
+fun checkFill(array: Array<Any?>, element: Any?, fromIndex: Int, toIndex: Int) {
+    val expected = snapshot(array).toMutableList()
+    for (index in fromIndex until toIndex) {
+        expected[index] = element
+    }
+    array.fill(element, fromIndex, toIndex)
+    assertSameElements(expected, array)
+}
+
+fun overlappingCopies() {
+    // Shifts below, at and above the chunk size, both ways.
+    for (shift in listOf(1, 2, 63, 64, 65, 128, 200)) {
+        val array = newElements(300)
+        checkCopy(array, array, shift, 0, array.size - shift)
+        checkCopy(array, array, 0, shift, array.size)
+        checkCopy(array, array, 0, 0, array.size)
+    }
+}
+
+fun disjointCopies() {
+    val source = newElements(1000)
+    val destination = newElements(1000)
+    checkCopy(source, destination, 0, 0, 1000)
+    checkCopy(source, destination, 10, 500, 1000)
+    checkCopy(destination, source, 999, 0, 1)
+    checkCopy(source, destination, 0, 0, 0)
+}
+
+fun fills() {
+    val array = newElements(300)
+    val node = Node(0)
+    checkFill(array, node, 0, 300)
+    // Most of the slots already hold the element.
+    checkFill(array, node, 10, 290)
+    checkFill(array, shared, 0, 150)
+    checkFill(array, null, 100, 200)
+    checkFill(array, "permanent", 0, 300)
+    checkFill(array, null, 0, 300)
+}
+
+fun selfReferences() {
+    val array = newElements(200)
+    // The array references itself, and is released by the same updates that store it.
+    checkFill(array, array, 50, 150)
+    checkCopy(array, array, 1, 0, 199)
+    checkCopy(array, array, 0, 70, 200)
+    val node = Node(1)
+    node.next = array
+    checkFill(array, node, 0, 100)
+    checkCopy(array, array, 100, 0, 100)
+    // Break the cycles, so that everything is freed without the cycle collector.
+    node.next = null
+    checkFill(array, null, 0, 200)
+}
+
+fun frozenElements() {
+    val frozen = newElements(300).also {
+        it[1] = Node(1).apply { next = shared }
+    }.freeze()
+    assertTrue(shared.isFrozen)
+    val array = newElements(300)
+    checkCopy(frozen, array, 0, 0, 300)
+    checkCopy(array, array, 5, 0, 295)
+    checkFill(array, frozen, 0, 200)
+    checkFill(array, frozen[1], 100, 300)
+    checkCopy(frozen, array, 40, 200, 260)
+    assertFailsWith<InvalidMutabilityException> {
+        frozen.fill(null)
+    }
+    assertFailsWith<InvalidMutabilityException> {
+        array.copyInto(frozen)
+    }
+}
+
+fun fillWithNodes(array: Array<Any?>): List<WeakReference<Any>> = List(array.size) { index ->
+    val node = Node(index)
+    array[index] = node
+    WeakReference<Any>(node)
+}
+
+// The elements dropped by the range updates must be freed right away, not only at exit.
+fun droppedElementsAreFreed() {
+    if (Platform.memoryModel != MemoryModel.STRICT) return
+    val array = arrayOfNulls<Any?>(200)
+    val weaks = fillWithNodes(array)
+    array.copyInto(array, 1, 0, 199)
+    array.copyInto(array, 0, 100, 200)
+    array.fill(null)
+    for (weak in weaks) {
+        assertNull(weak.get())
+    }
+}
+
+fun main() {
+    Platform.isMemoryLeakCheckerActive = true
+    overlappingCopies()
+    disjointCopies()
+    fills()
+    selfReferences()
+    frozenElements()
+    droppedElementsAreFreed()
+    println("OK")
+}
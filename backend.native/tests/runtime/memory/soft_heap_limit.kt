@@ -0,0 +1,39 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.memory.soft_heap_limit
+
+import kotlin.test.*
+import kotlin.native.internal.GC
+
+class Node(val payload: ByteArray) {
+    var next: Node? = null
+}
+
+fun makeGarbageCycle() {
+    val first = Node(ByteArray(16 * 1024))
+    val second = Node(ByteArray(16 * 1024))
+    first.next = second
+    second.next = first
+}
+
+@Test fun runTest() {
+    assertEquals(0L, GC.softHeapLimit)
+    assertFailsWith<IllegalArgumentException> { GC.softHeapLimit = -1 }
+
+    val limit = 16L * 1024 * 1024
+    GC.softHeapLimit = limit
+    assertEquals(limit, GC.softHeapLimit)
+    try {
+        // Cycles are only collected by the cycle collector, which the limit forces to run. Collections are
+        // spaced by the heap growth, so the usage may overshoot the limit somewhat, but not by the whole 320 MB
+        // of garbage.
+        repeat(10_000) { makeGarbageCycle() }
+        assertTrue(GC.heapUsage < 4 * limit, "heapUsage = ${GC.heapUsage}")
+    } finally {
+        GC.softHeapLimit = 0
+    }
+    println("OK")
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+@file:OptIn(ExperimentalStdlibApi::class)
+
+package runtime.memory.weak_keyed_map
+
+import kotlin.test.*
+import kotlin.native.ref.*
+
+data class Key(val id: Int)
+
+fun fillTemporaryKeys(map: WeakKeyedMap<Key, String>, count: Int) {
+    for (i in 0 until count) {
+        map[Key(i)] = "temporary $i"
+    }
+}
+
+@Test fun runTest() {
+    val map = WeakKeyedMap<Key, String>()
+    val keys = Array(100) { Key(it) }
+    keys.forEach { map[it] = "value ${it.id}" }
+    assertEquals(100, map.size)
+    assertEquals("value 42", map[keys[42]])
+    // Keys are compared by identity.
+    assertNull(map[Key(42)])
+    assertFalse(map.containsKey(Key(42)))
+
+    assertEquals("value 7", map.put(keys[7], "seven"))
+    assertEquals("seven", map[keys[7]])
+    assertEquals("seven", map.remove(keys[7]))
+    assertNull(map.remove(keys[7]))
+    assertEquals(99, map.size)
+    assertEquals("again", map.getOrPut(keys[7]) { "again" })
+    assertEquals("again", map.getOrPut(keys[7]) { "other" })
+
+    fillTemporaryKeys(map, 1000)
+    kotlin.native.internal.GC.collect()
+    // Entries of the collected keys are gone.
+    assertEquals(100, map.size)
+    keys.forEach { assertNotNull(map[it]) }
+
+    map.clear()
+    assertEquals(0, map.size)
+    println("OK")
+}
@@ -115,3 +115,30 @@ val counters = Array(COUNT) { AtomicInt(0) }
         try { it.result } catch (e: IllegalStateException) {}
     }
 }
+
+@SharedImmutable
+val cancellableCounter = AtomicInt(0)
+
+@Test fun runTest3() {
+    val worker = Worker.start()
+    val cancelled = worker.executeAfterCancellable(1000*1000*1000, {
+        println("CANCELLED EXECUTED")
+        assert(false)
+    }.freeze())
+    val handles = Array(100) { index ->
+        worker.executeAfterCancellable(1000L * (1000 + index), {
+            cancellableCounter.increment()
+        }.freeze())
+    }
+    assertTrue(worker.cancelDelayed(cancelled))
+    assertFalse(worker.cancelDelayed(cancelled))
+    // Every other job is cancelled, the rest run.
+    for (index in handles.indices step 2) {
+        assertTrue(worker.cancelDelayed(handles[index]))
+    }
+    worker.requestTermination().result
+    assertEquals(50, cancellableCounter.value)
+    handles.forEach {
+        assertFalse(worker.cancelDelayed(it))
+    }
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.worker12
+
+import kotlin.test.*
+
+import kotlin.native.concurrent.*
+
+// Future slots are reused, so the id of a consumed future must neither stay valid nor refer to the next future.
+fun checkConsumedFuture(consumed: Future<Int>, worker: Worker) {
+    assertEquals(FutureState.INVALID, consumed.state)
+    val next = worker.execute(TransferMode.SAFE, { 2 }) { it * 2 }
+    assertNotEquals(consumed.id, next.id)
+    assertEquals(FutureState.INVALID, consumed.state)
+    assertFailsWith<IllegalStateException> { consumed.result }
+    assertEquals(4, next.result)
+    assertEquals(FutureState.INVALID, next.state)
+}
+
+@Test fun runTest() {
+    val worker = Worker.start(errorReporting = false)
+
+    val succeeded = worker.execute(TransferMode.SAFE, { 1 }) { it + 1 }
+    assertEquals(2, succeeded.result)
+    checkConsumedFuture(succeeded, worker)
+
+    val failed = worker.execute(TransferMode.SAFE, { 1 }) { if (it > 0) throw Error("failed") else it }
+    assertFailsWith<IllegalStateException> { failed.result }
+    // The slot of the failed future is released as well.
+    checkConsumedFuture(failed, worker)
+
+    worker.requestTermination().result
+    println("OK")
+}
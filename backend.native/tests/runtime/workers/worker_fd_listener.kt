@@ -0,0 +1,67 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package runtime.workers.worker_fd_listener
+
+import kotlin.test.*
+
+import kotlin.native.concurrent.*
+import kotlin.system.getTimeMillis
+import kotlinx.cinterop.*
+import platform.posix.*
+
+@SharedImmutable
+val received = AtomicInt(0)
+
+@SharedImmutable
+val spinning = AtomicInt(1)
+
+// Keeps the queue of the worker busy, so that the descriptors are only seen if polled between the jobs.
+fun spin() {
+    if (spinning.value != 0) Worker.current.executeAfter(0, ::spin.freeze())
+}
+
+@Test fun runTest() {
+    if (Platform.osFamily != OsFamily.LINUX && Platform.osFamily != OsFamily.ANDROID) {
+        assertFailsWith<UnsupportedOperationException> {
+            Worker.current.addFdListener(0, Worker.FD_READABLE) {}
+        }
+        println("OK")
+        return
+    }
+    val worker = Worker.start()
+    val (readFd, writeFd) = memScoped {
+        val fds = allocArray<IntVar>(2)
+        assertEquals(0, pipe(fds))
+        fds[0] to fds[1]
+    }
+    worker.addFdListener(readFd, Worker.FD_READABLE, { events: Int ->
+        assertNotEquals(0, events and Worker.FD_READABLE)
+        val buffer = ByteArray(16)
+        val count = buffer.usePinned { read(readFd, it.addressOf(0), buffer.size.convert()) }
+        received.addAndGet(count.toInt())
+    }.freeze())
+    assertFailsWith<IllegalStateException> {
+        worker.addFdListener(readFd, Worker.FD_READABLE, { _: Int -> }.freeze())
+    }
+    worker.executeAfter(0, ::spin.freeze())
+    // The listener is watched again after every call.
+    val deadline = getTimeMillis() + 60_000
+    for (i in 1..3) {
+        byteArrayOf(i.toByte()).usePinned { assertEquals(1L, write(writeFd, it.addressOf(0), 1.convert()).toLong()) }
+        while (received.value < i) {
+            assertTrue(getTimeMillis() < deadline, "Listener was not called for write $i")
+            usleep(1000.convert())
+        }
+    }
+    spinning.value = 0
+    assertTrue(worker.removeFdListener(readFd))
+    assertFalse(worker.removeFdListener(readFd))
+    worker.requestTermination().result
+    close(readFd)
+    close(writeFd)
+    assertEquals(3, received.value)
+    println("OK")
+}
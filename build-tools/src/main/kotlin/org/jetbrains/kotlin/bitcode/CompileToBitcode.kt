@@ -33,6 +33,7 @@ open class CompileToBitcode @Inject constructor(
     var excludeFiles: List<String> = listOf(
             "**/*Test.cpp",
             "**/*Test.mm",
+            "**/*Benchmark.cpp",
     )
     var includeFiles: List<String> = listOf(
             "**/*.cpp",
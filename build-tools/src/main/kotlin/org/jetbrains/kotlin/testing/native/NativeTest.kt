@@ -156,13 +156,15 @@ open class LinkNativeTest @Inject constructor(
     }
 }
 
-fun createTestTask(
+// Links `testedTaskNames` together with the `*<kind>.cpp` sources from their source roots
+// and with the `main` provided by the `${target}<kind>Support` bitcode.
+private fun createLinkNativeTestTask(
         project: Project,
-        testName: String,
-        testTaskName: String,
+        kind: String,
+        executableName: String,
         testedTaskNames: List<String>,
-        configureCompileToBitcode: CompileToBitcode.() -> Unit = {},
-): Task {
+        configureCompileToBitcode: CompileToBitcode.() -> Unit
+): LinkNativeTest {
     val platformManager = project.rootProject.findProperty("platformManager") as PlatformManager
     val googleTestExtension = project.extensions.getByName(RuntimeTestingPlugin.GOOGLE_TEST_EXTENSION_NAME) as GoogleTestExtension
     val testedTasks = testedTaskNames.map {
@@ -173,16 +175,16 @@ fun createTestTask(
     }.distinct().single()
     val konanTarget = platformManager.targetByName(target)
     val compileToBitcodeTasks = testedTasks.mapNotNull {
-        val name = "${it.name}TestBitcode"
+        val name = "${it.name}${kind}Bitcode"
         val task = project.tasks.findByName(name) as? CompileToBitcode ?:
             project.tasks.create(name,
                     CompileToBitcode::class.java,
                     it.srcRoot,
-                    "${it.folderName}Tests",
+                    "${it.folderName}${kind}s",
                     target, "test"
                     ).apply {
                 excludeFiles = emptyList()
-                includeFiles = listOf("**/*Test.cpp", "**/*Test.mm")
+                includeFiles = listOf("**/*$kind.cpp", "**/*$kind.mm")
                 dependsOn(it)
                 dependsOn("downloadGoogleTest")
                 compilerArgs.addAll(it.compilerArgs)
@@ -199,23 +201,23 @@ fun createTestTask(
         project.tasks.getByName("${target}Googlemock") as CompileToBitcode
     )
 
-    val testSupportTask = project.tasks.getByName("${target}TestSupport") as CompileToBitcode
+    val supportTask = project.tasks.getByName("${target}${kind}Support") as CompileToBitcode
 
     // TODO: It may make sense to merge llvm-link, compile and link to a single task.
     val llvmLinkTask = project.tasks.create(
-            "${testTaskName}LlvmLink",
+            "${executableName}LlvmLink",
             LlvmLinkNativeTest::class.java,
-            testTaskName, target, testSupportTask.outFile
+            executableName, target, supportTask.outFile
     ).apply {
         val tasksToLink = (compileToBitcodeTasks + testedTasks + testFrameworkTasks)
         inputFiles = project.files(tasksToLink.map { it.outFile })
-        dependsOn(testSupportTask)
+        dependsOn(supportTask)
         dependsOn(tasksToLink)
     }
 
     val clangFlags = platformManager.platform(konanTarget).configurables as ClangFlags
     val compileTask = project.tasks.create(
-            "${testTaskName}Compile",
+            "${executableName}Compile",
             CompileNativeTest::class.java,
             llvmLinkTask.outputFile,
             target
@@ -226,17 +228,27 @@ fun createTestTask(
     }
 
     val mimallocEnabled = testedTaskNames.any { it.contains("mimalloc", ignoreCase = true) }
-    val linkTask = LinkNativeTest.create(
+    return LinkNativeTest.create(
             project,
             platformManager,
-            "${testTaskName}Link",
+            "${executableName}Link",
             listOf(compileTask.outputFile),
             target,
-            testTaskName,
+            executableName,
             mimallocEnabled
     ).apply {
         dependsOn(compileTask)
     }
+}
+
+fun createTestTask(
+        project: Project,
+        testName: String,
+        testTaskName: String,
+        testedTaskNames: List<String>,
+        configureCompileToBitcode: CompileToBitcode.() -> Unit = {},
+): Task {
+    val linkTask = createLinkNativeTestTask(project, "Test", testTaskName, testedTaskNames, configureCompileToBitcode)
 
     return project.tasks.create(testTaskName, Exec::class.java).apply {
         dependsOn(linkTask)
@@ -260,3 +272,34 @@ fun createTestTask(
         }
     }
 }
+
+// Benchmarks are the `*Benchmark.cpp` files of the tested modules. The report is written to
+// `benchmarkReports/$benchmarkTaskName/report.json` in the format of the `performance` benchmarks
+// with the names prefixed by `benchmarkName`.
+fun createBenchmarkTask(
+        project: Project,
+        benchmarkName: String,
+        benchmarkTaskName: String,
+        testedTaskNames: List<String>,
+        configureCompileToBitcode: CompileToBitcode.() -> Unit = {},
+): Task {
+    val linkTask = createLinkNativeTestTask(project, "Benchmark", benchmarkTaskName, testedTaskNames,
+            configureCompileToBitcode)
+
+    return project.tasks.create(benchmarkTaskName, Exec::class.java).apply {
+        dependsOn(linkTask)
+
+        workingDir = project.buildDir.resolve("benchmarkReports/$benchmarkTaskName")
+        val jsonReport = workingDir.resolve("report.json")
+        executable(linkTask.outputFile)
+        args("--prefix", "${benchmarkName}.", "--output", jsonReport.absolutePath)
+        // E.g. -PruntimeBenchmarksArgs="--filterRegex Memory.* --repeat 5"
+        (project.findProperty("runtimeBenchmarksArgs") as? String)?.let { extraArgs ->
+            args(extraArgs.split(' ').filter { it.isNotEmpty() })
+        }
+
+        doFirst {
+            workingDir.mkdirs()
+        }
+    }
+}
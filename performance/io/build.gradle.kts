@@ -0,0 +1,42 @@
+import org.jetbrains.kotlin.gradle.plugin.mpp.NativeBuildType
+import org.jetbrains.kotlin.RunKotlinNativeTask
+import org.jetbrains.kotlin.BenchmarkRepeatingType
+
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+plugins {
+    id("benchmarking")
+}
+
+val defaultBuildType = NativeBuildType.RELEASE
+
+benchmark {
+    applicationName = "IO"
+    commonSrcDirs = listOf("../../tools/benchmarks/shared/src/main/kotlin/report", "src/main/kotlin", "../shared/src/main/kotlin")
+    jvmSrcDirs = listOf("src/main/kotlin-jvm", "../shared/src/main/kotlin-jvm")
+    nativeSrcDirs = listOf("src/main/kotlin-native", "../shared/src/main/kotlin-native/common")
+    mingwSrcDirs = listOf("src/main/kotlin-native", "../shared/src/main/kotlin-native/mingw")
+    posixSrcDirs = listOf("src/main/kotlin-native", "../shared/src/main/kotlin-native/posix")
+    buildType = (findProperty("nativeBuildType") as String?)?.let { NativeBuildType.valueOf(it) } ?: defaultBuildType
+    repeatingType = BenchmarkRepeatingType.EXTERNAL
+}
+
+// ReadLine.file generates a multi-gigabyte input on its first run and reuses it in the following ones,
+// so the input is removed once all the runs are over.
+val deleteReadLineInput by tasks.registering {
+    doLast {
+        val directories = listOf(
+                System.getenv("TMPDIR") ?: System.getenv("TEMP") ?: "/tmp",
+                System.getProperty("java.io.tmpdir")
+        )
+        for (directory in directories.distinct()) {
+            File(directory).listFiles { file -> file.name.startsWith("kotlin-read-line-benchmark-") }?.forEach { it.delete() }
+        }
+    }
+}
+
+tasks.named("konanRun") { finalizedBy(deleteReadLineInput) }
+tasks.named("jvmRun") { finalizedBy(deleteReadLineInput) }
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.io
+
+import java.io.File
+import java.io.FileInputStream
+
+actual fun getEnvironmentVariable(name: String): String? = System.getenv(name)
+
+actual fun temporaryDirectory(): String = System.getProperty("java.io.tmpdir")
+
+actual fun fileExists(path: String): Boolean = File(path).exists()
+
+actual fun writeRepeatedly(path: String, block: ByteArray, count: Int) {
+    // Written under another name first, so an interrupted run doesn't leave a truncated input behind.
+    val temporaryFile = File("$path.part")
+    temporaryFile.outputStream().use { out ->
+        repeat(count) { out.write(block) }
+    }
+    if (!temporaryFile.renameTo(File(path))) error("Cannot rename '$temporaryFile' to '$path'")
+}
+
+actual fun redirectStdin(path: String) {
+    System.setIn(FileInputStream(path))
+}
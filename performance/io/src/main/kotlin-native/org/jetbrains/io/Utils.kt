@@ -0,0 +1,40 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.io
+
+import kotlinx.cinterop.*
+import platform.posix.*
+
+actual fun getEnvironmentVariable(name: String): String? = getenv(name)?.toKString()
+
+actual fun temporaryDirectory(): String =
+        getEnvironmentVariable("TMPDIR") ?: getEnvironmentVariable("TEMP") ?: "/tmp"
+
+actual fun fileExists(path: String): Boolean = access(path, F_OK) == 0
+
+actual fun writeRepeatedly(path: String, block: ByteArray, count: Int) {
+    // Written under another name first, so an interrupted run doesn't leave a truncated input behind.
+    val temporaryPath = "$path.part"
+    val file = fopen(temporaryPath, "wb") ?: error("Cannot write file '$temporaryPath'")
+    try {
+        block.usePinned { pinned ->
+            repeat(count) {
+                val written = fwrite(pinned.addressOf(0), 1.convert(), block.size.convert(), file)
+                if (written.toLong() != block.size.toLong()) throw Error("File write error")
+            }
+        }
+    } finally {
+        fclose(file)
+    }
+    if (rename(temporaryPath, path) != 0) error("Cannot rename '$temporaryPath' to '$path'")
+}
+
+actual fun redirectStdin(path: String) {
+    val fd = open(path, O_RDONLY)
+    if (fd < 0) error("Cannot read file '$path'")
+    if (dup2(fd, STDIN_FILENO) < 0) error("Cannot redirect the standard input")
+    close(fd)
+}
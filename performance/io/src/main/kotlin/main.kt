@@ -0,0 +1,26 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+import org.jetbrains.io.*
+import org.jetbrains.benchmarksLauncher.*
+import kotlinx.cli.*
+
+class IOLauncher : Launcher() {
+    override val benchmarks = BenchmarksCollection(
+      mutableMapOf(
+          "ReadLine.file" to BenchmarkEntryManual(::readLinesFromFile),
+      )
+    )
+}
+
+fun main(args: Array<String>) {
+    val launcher = IOLauncher()
+    BenchmarksRunner.runBenchmarks(args, { arguments: BenchmarkArguments ->
+        if (arguments is BaseBenchmarkArguments) {
+            launcher.launch(arguments.warmup, arguments.repeat, arguments.prefix,
+                    arguments.filter, arguments.filterRegex, arguments.verbose)
+        } else emptyList()
+    }, benchmarksListAction = launcher::benchmarksListAction)
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.io
+
+expect fun getEnvironmentVariable(name: String): String?
+expect fun temporaryDirectory(): String
+expect fun fileExists(path: String): Boolean
+// Writes `block` `count` times into a new file at `path`.
+expect fun writeRepeatedly(path: String, block: ByteArray, count: Int)
+expect fun redirectStdin(path: String)
+
+// Size of the input in megabytes, can be overridden with the environment variable.
+private const val DEFAULT_INPUT_SIZE = 2048
+private const val INPUT_SIZE_VARIABLE = "READ_LINE_BENCHMARK_SIZE_MB"
+private const val BLOCK_SIZE = 1024 * 1024
+
+// About a megabyte of lines from empty to a few hundred characters long, some with non-ASCII characters
+// and Windows line terminators.
+private fun generateBlock(): ByteArray {
+    val builder = StringBuilder()
+    var random = 1
+    while (true) {
+        random = random * 1103515245 + 12345
+        val length = (random ushr 16) % 300
+        val line = buildString {
+            for (i in 0 until length) {
+                append(if (i % 61 == 60) 'Ж' else 'a' + (i + length) % 26)
+            }
+        }
+        val terminator = if (length % 7 == 0) "\r\n" else "\n"
+        if (builder.length + line.length * 2 + terminator.length > BLOCK_SIZE) break
+        builder.append(line).append(terminator)
+    }
+    return builder.toString().encodeToByteArray()
+}
+
+// The input is generated by the first run and reused by the following ones, so the first run must be a warm up.
+// The build deletes it after the runs, the file name must match the pattern in build.gradle.kts.
+private fun prepareInput(): String {
+    val size = getEnvironmentVariable(INPUT_SIZE_VARIABLE)?.toInt() ?: DEFAULT_INPUT_SIZE
+    val path = "${temporaryDirectory()}/kotlin-read-line-benchmark-${size}m.txt"
+    if (!fileExists(path)) {
+        val block = generateBlock()
+        writeRepeatedly(path, block, (size.toLong() * 1024 * 1024 / block.size).toInt())
+    }
+    return path
+}
+
+private var readLinesFromFileRun = false
+// Benchmark
+fun readLinesFromFile(): Long {
+    if (readLinesFromFileRun) {
+        error("Function readLinesFromFile can be called only once.")
+    }
+    readLinesFromFileRun = true
+
+    redirectStdin(prepareInput())
+    var total = 0L
+    while (true) {
+        val line = readLine() ?: break
+        total += line.length + 1
+    }
+    return total
+}
@@ -19,6 +19,7 @@ package org.jetbrains.ring
 import kotlin.native.concurrent.FreezableAtomicReference as KAtomicRef
 import kotlin.native.concurrent.isFrozen
 import kotlin.native.concurrent.freeze
+import kotlin.native.internal.NoStackTrace
 
 public actual class AtomicRef<T> constructor(@PublishedApi internal val a: KAtomicRef<T>) {
     public actual inline var value: T
@@ -50,4 +51,7 @@ public actual class AtomicRef<T> constructor(@PublishedApi internal val a: KAtom
     override fun toString(): String = value.toString()
 }
 
-public actual fun <T> atomic(initial: T): AtomicRef<T> = AtomicRef<T>(KAtomicRef(initial))
\ No newline at end of file
+public actual fun <T> atomic(initial: T): AtomicRef<T> = AtomicRef<T>(KAtomicRef(initial))
+
+@NoStackTrace
+public actual open class ControlFlowSignal actual constructor() : Throwable()
@@ -26,6 +26,8 @@ class RingLauncher : Launcher() {
             mutableMapOf(
                     "AbstractMethod.sortStrings" to BenchmarkEntryWithInit.create(::AbstractMethodBenchmark, { sortStrings() }),
                     "AbstractMethod.sortStringsWithComparator" to BenchmarkEntryWithInit.create(::AbstractMethodBenchmark, { sortStringsWithComparator() }),
+                    "AbstractMethod.sortStringsWithCustomComparator" to BenchmarkEntryWithInit.create(::AbstractMethodBenchmark, { sortStringsWithCustomComparator() }),
+                    "AbstractMethod.iterateViaInterfaces" to BenchmarkEntryWithInit.create(::AbstractMethodBenchmark, { iterateViaInterfaces() }),
                     "AllocationBenchmark.allocateObjects" to BenchmarkEntryWithInit.create(::AllocationBenchmark, { allocateObjects() }),
                     "ClassArray.copy" to BenchmarkEntryWithInit.create(::ClassArrayBenchmark, { copy() }),
                     "ClassArray.copyManual" to BenchmarkEntryWithInit.create(::ClassArrayBenchmark, { copyManual() }),
@@ -191,6 +193,10 @@ class RingLauncher : Launcher() {
                     "Switch.testEnumsSwitch" to BenchmarkEntryWithInit.create(::SwitchBenchmark, { testEnumsSwitch() }),
                     "Switch.testDenseEnumsSwitch" to BenchmarkEntryWithInit.create(::SwitchBenchmark, { testDenseEnumsSwitch() }),
                     "Switch.testSealedWhenSwitch" to BenchmarkEntryWithInit.create(::SwitchBenchmark, { testSealedWhenSwitch() }),
+                    "ThrowCatch.throwCatchShallow" to BenchmarkEntryWithInit.create(::ThrowCatchBenchmark, { throwCatchShallow() }),
+                    "ThrowCatch.throwCatchDeep" to BenchmarkEntryWithInit.create(::ThrowCatchBenchmark, { throwCatchDeep() }),
+                    "ThrowCatch.throwCatchControlFlow" to BenchmarkEntryWithInit.create(::ThrowCatchBenchmark, { throwCatchControlFlow() }),
+                    "ThrowCatch.throwCatchPrintable" to BenchmarkEntryWithInit.create(::ThrowCatchBenchmark, { throwCatchPrintable() }),
                     "WithIndicies.withIndicies" to BenchmarkEntryWithInit.create(::WithIndiciesBenchmark, { withIndicies() }),
                     "WithIndicies.withIndiciesManual" to BenchmarkEntryWithInit.create(::WithIndiciesBenchmark, { withIndiciesManual() }),
                     "OctoTest" to BenchmarkEntry(::octoTest),
@@ -210,7 +216,8 @@ class RingLauncher : Launcher() {
                     "Casts.interfaceCast" to BenchmarkEntryWithInit.create(::CastsBenchmark, { interfaceCast() }),
                     "LocalObjects.localArray" to BenchmarkEntryWithInit.create(::LocalObjectsBenchmark, { localArray() }),
                     "LinkedListWithAtomicsBenchmark" to BenchmarkEntryWithInit.create(::LinkedListWithAtomicsBenchmark, { ensureNext() }),
-                    "Inheritance.baseCalls" to BenchmarkEntryWithInit.create(::InheritanceBenchmark, { baseCalls() })
+                    "Inheritance.baseCalls" to BenchmarkEntryWithInit.create(::InheritanceBenchmark, { baseCalls() }),
+                    "Inheritance.interfaceCalls" to BenchmarkEntryWithInit.create(::InheritanceBenchmark, { interfaceCalls() })
             )
     )
 }
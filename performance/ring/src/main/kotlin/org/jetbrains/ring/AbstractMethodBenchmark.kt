@@ -48,5 +48,33 @@ open class AbstractMethodBenchmark {
         res.addAll(arr.subList(0, if (BENCHMARK_SIZE < arr.size) BENCHMARK_SIZE else arr.size))
         return res
     }
+
+    //Benchmark
+    fun sortStringsWithCustomComparator(): List<String> {
+        val comparator = Comparator<String> { a, b ->
+            val length = minOf(a.length, b.length)
+            for (i in 0 until length) {
+                val x = sequenceMap[a[i]] ?: a[i].toInt()
+                val y = sequenceMap[b[i]] ?: b[i].toInt()
+                if (x != y) return@Comparator x - y
+            }
+            a.length - b.length
+        }
+        return arr.subList(0, if (BENCHMARK_SIZE < arr.size) BENCHMARK_SIZE else arr.size).sortedWith(comparator)
+    }
+
+    //Benchmark
+    fun iterateViaInterfaces(): Int {
+        val iterable: Iterable<String> = arr
+        var previous: Comparable<String> = ""
+        var result = 0
+        for (s in iterable) {
+            val chars: CharSequence = s
+            result += chars.length
+            if (previous < s) result++
+            previous = s
+        }
+        return result
+    }
 }
 
@@ -483,6 +483,39 @@ open class InheritanceBenchmark {
         open fun g15(): Int = 15
     }
 
+    interface I1 { fun i1(): Int }
+    interface I2 { fun i2(): Int }
+    interface I3 { fun i3(): Int }
+    interface I4 { fun i4(): Int }
+    interface I5 { fun i5(): Int }
+    interface I6 { fun i6(): Int }
+    interface I7 { fun i7(): Int }
+    interface I8 { fun i8(): Int }
+    interface I9 { fun i9(): Int }
+    interface I10 { fun i10(): Int }
+    interface I11 { fun i11(): Int }
+    interface I12 { fun i12(): Int }
+
+    open class H() : G(), I1, I2, I3, I4, I5, I6, I7, I8, I9, I10, I11, I12 {
+        override fun i1(): Int = 1
+        override fun i2(): Int = 2
+        override fun i3(): Int = 3
+        override fun i4(): Int = 4
+        override fun i5(): Int = 5
+        override fun i6(): Int = 6
+        override fun i7(): Int = 7
+        override fun i8(): Int = 8
+        override fun i9(): Int = 9
+        override fun i10(): Int = 10
+        override fun i11(): Int = 11
+        override fun i12(): Int = 12
+    }
+
+    class K() : H() {
+        override fun i1(): Int = 100
+        override fun i12(): Int = 1200
+    }
+
     val a = A()
     val b = B()
     val c = C()
@@ -490,6 +523,7 @@ open class InheritanceBenchmark {
     val e = E()
     val f = F()
     val g = G()
+    val objects: Array<Any> = arrayOf(H(), K())
 
     fun baseCalls(): Int {
         var x = 0
@@ -505,4 +539,17 @@ open class InheritanceBenchmark {
         }
         return x
     }
-}
\ No newline at end of file
+
+    fun interfaceCalls(): Int {
+        var x = 0
+        for (i in 0 until RUNS) {
+            val o = objects[i and 1]
+            x += (o as I1).i1()
+            x += (o as I3).i3()
+            x += (o as I6).i6()
+            x += (o as I9).i9()
+            x += (o as I12).i12()
+        }
+        return x
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.ring
+
+import org.jetbrains.benchmarksLauncher.Blackhole
+
+/**
+ * An exception thrown to leave a computation early. Doesn't capture the stack trace where supported.
+ */
+expect open class ControlFlowSignal() : Throwable
+
+private const val THROW_DEPTH = 20
+
+open class ThrowCatchBenchmark {
+    private fun throwAt(depth: Int, create: () -> Throwable): Int {
+        if (depth == 0) throw create()
+        return throwAt(depth - 1, create) + 1
+    }
+
+    private fun catchAt(depth: Int, create: () -> Throwable): Int {
+        try {
+            return throwAt(depth, create)
+        } catch (e: Throwable) {
+            return depth
+        }
+    }
+
+    //Benchmark
+    fun throwCatchShallow() {
+        for (i in 0 until BENCHMARK_SIZE) {
+            Blackhole.consume(catchAt(0) { IllegalStateException() })
+        }
+    }
+
+    //Benchmark
+    fun throwCatchDeep() {
+        for (i in 0 until BENCHMARK_SIZE) {
+            Blackhole.consume(catchAt(THROW_DEPTH) { IllegalStateException() })
+        }
+    }
+
+    //Benchmark
+    fun throwCatchControlFlow() {
+        for (i in 0 until BENCHMARK_SIZE) {
+            Blackhole.consume(catchAt(THROW_DEPTH) { ControlFlowSignal() })
+        }
+    }
+
+    //Benchmark
+    fun throwCatchPrintable() {
+        for (i in 0 until BENCHMARK_SIZE / 10) {
+            try {
+                throwAt(THROW_DEPTH) { IllegalStateException() }
+            } catch (e: IllegalStateException) {
+                Blackhole.consume(e.stackTraceToString())
+            }
+        }
+    }
+}
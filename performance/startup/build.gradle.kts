@@ -15,11 +15,14 @@ val defaultBuildType = NativeBuildType.RELEASE
 
 benchmark {
     applicationName = "Startup"
-    commonSrcDirs = listOf("../../tools/benchmarks/shared/src/main/kotlin/report", "src/main/kotlin", "../shared/src/main/kotlin")
-    jvmSrcDirs = listOf("../shared/src/main/kotlin-jvm")
-    nativeSrcDirs = listOf("../shared/src/main/kotlin-native/common")
+    commonSrcDirs = listOf("../../tools/benchmarks/shared/src/main/kotlin/report", "src/main/kotlin", "$buildDir/generated/globals",
+            "../shared/src/main/kotlin")
+    jvmSrcDirs = listOf("src/main/kotlin-jvm", "../shared/src/main/kotlin-jvm")
+    nativeSrcDirs = listOf("src/main/kotlin-native", "../shared/src/main/kotlin-native/common")
     mingwSrcDirs = listOf("../shared/src/main/kotlin-native/mingw")
     posixSrcDirs = listOf("../shared/src/main/kotlin-native/posix")
     buildType = (findProperty("nativeBuildType") as String?)?.let { NativeBuildType.valueOf(it) } ?: defaultBuildType
     repeatingType = BenchmarkRepeatingType.EXTERNAL
 }
+
+apply(from = "globals.gradle.kts")
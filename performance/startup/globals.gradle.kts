@@ -0,0 +1,36 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+// Generates the files with globals used by the Globals.initializeFew benchmark into build/generated/globals.
+// Each file has a few globals too heavy to be built at compile time, so they have to be initialized at startup
+// unless global initialization is lazy.
+
+val globalsFileCount = 32
+val generatedGlobalsDir = buildDir.resolve("generated/globals")
+
+val generateGlobals by tasks.registering {
+    inputs.property("globalsFileCount", globalsFileCount)
+    outputs.dir(generatedGlobalsDir)
+    doLast {
+        val packageDir = generatedGlobalsDir.resolve("org/jetbrains/startup/globals")
+        delete(packageDir)
+        packageDir.mkdirs()
+        for (i in 0 until globalsFileCount) {
+            packageDir.resolve("Globals$i.kt").writeText("""
+                |// Generated by globals.gradle.kts, don't edit.
+                |
+                |package org.jetbrains.startup.globals
+                |
+                |val squares$i = IntArray(4096) { it * it + $i }
+                |val labels$i = Array(256) { "label${i}_${'$'}it" }
+                |val indices$i = labels$i.withIndex().associate { it.value to it.index }
+                |""".trimMargin())
+        }
+    }
+}
+
+tasks.matching { it.name.startsWith("compile") && it.name.contains("Kotlin") }.configureEach {
+    dependsOn(generateGlobals)
+}
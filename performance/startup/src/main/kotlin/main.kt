@@ -12,6 +12,7 @@ class StartupLauncher : Launcher() {
       mutableMapOf(
           "Singleton.initialize" to BenchmarkEntryManual(::singletonInitialize),
           "Singleton.initializeNested" to BenchmarkEntryManual(::singletonInitializeNested),
+          "Globals.initializeFew" to BenchmarkEntryManual(::globalsInitializeFew),
       )
     )
 }
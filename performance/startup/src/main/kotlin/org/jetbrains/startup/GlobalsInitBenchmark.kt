@@ -0,0 +1,29 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package org.jetbrains.startup
+
+import org.jetbrains.benchmarksLauncher.printStderr
+import org.jetbrains.startup.globals.*
+
+// Number of files whose globals were initialized on the first access, -1 if the platform doesn't track it.
+expect fun initializedFilesCount(): Int
+
+private var globalsInitializeFewRun = false
+// Benchmark
+// Only 2 of the 32 files with globals are used. With lazy global initialization the others are never initialized.
+fun globalsInitializeFew(): Int {
+    if (globalsInitializeFewRun) {
+        error("Function globalsInitializeFew can be called only once.")
+    }
+    globalsInitializeFewRun = true
+
+    var total = 0
+    total += squares0[100] + indices0.getValue("label0_200")
+    total += squares17[100] + indices17.getValue("label17_200")
+
+    printStderr("Initialized files: ${initializedFilesCount()}\n")
+    return total
+}
@@ -0,0 +1,30 @@
+import org.jetbrains.kotlin.gradle.plugin.mpp.NativeBuildType
+import org.jetbrains.kotlin.RunKotlinNativeTask
+import org.jetbrains.kotlin.BenchmarkRepeatingType
+
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+plugins {
+    id("benchmarking")
+}
+
+val defaultBuildType = NativeBuildType.RELEASE
+
+// The startup benchmarks built with lazy initialization of globals, to be compared with the eager ones.
+benchmark {
+    applicationName = "StartupLazy"
+    commonSrcDirs = listOf("../../tools/benchmarks/shared/src/main/kotlin/report", "../startup/src/main/kotlin", "$buildDir/generated/globals",
+            "../shared/src/main/kotlin")
+    jvmSrcDirs = listOf("../startup/src/main/kotlin-jvm", "../shared/src/main/kotlin-jvm")
+    nativeSrcDirs = listOf("../startup/src/main/kotlin-native", "../shared/src/main/kotlin-native/common")
+    mingwSrcDirs = listOf("../shared/src/main/kotlin-native/mingw")
+    posixSrcDirs = listOf("../shared/src/main/kotlin-native/posix")
+    buildType = (findProperty("nativeBuildType") as String?)?.let { NativeBuildType.valueOf(it) } ?: defaultBuildType
+    repeatingType = BenchmarkRepeatingType.EXTERNAL
+    compilerOpts = listOf("-Xlazy-global-initialization")
+}
+
+apply(from = "../startup/globals.gradle.kts")
@@ -20,6 +20,11 @@ fun CompileToBitcode.includeRuntime() {
     headersDirs += files("../common/src/hash/headers", "src/main/cpp")
 }
 
+fun CompileToBitcode.includeBenchmarkSupport() {
+    includeRuntime()
+    headersDirs += files("src/benchmark_support/cpp")
+}
+
 val hostName: String by project
 val targetList: List<String> by project
 
@@ -67,7 +72,12 @@ bitcode {
     }
 
     create("std_alloc")
-    create("opt_alloc")
+    create("opt_alloc") {
+        includeRuntime()
+        headersDirs += files("src/mimalloc/c/include")
+        // For the Kotlin/Native additions to the mimalloc API.
+        compilerArgs.add("-DKONAN_MI_MALLOC=1")
+    }
 
     create("exceptionsSupport", file("src/exceptions_support")) {
         includeRuntime()
@@ -97,6 +107,15 @@ bitcode {
         headersDirs += googletest.headersDirs
     }
 
+    create("benchmark_support", outputGroup = "test") {
+        includeRuntime()
+        dependsOn("downloadGoogleTest")
+        headersDirs += googletest.headersDirs
+        // Reuses the compiler-generated stubs of the tests.
+        srcDirs = files("src/benchmark_support/cpp", "src/test_support/cpp")
+        excludeFiles += listOf("**/TestLauncher.cpp")
+    }
+
     create("legacy_memory_manager", file("src/legacymm")) {
         includeRuntime()
     }
@@ -158,6 +177,58 @@ targetList.forEach { targetName ->
         dependsOn("${targetName}MimallocRuntimeTests")
         dependsOn("${targetName}ExperimentalMMRuntimeTests")
     }
+
+    createBenchmarkTask(
+            project,
+            "StdAlloc",
+            "${targetName}StdAllocRuntimeBenchmarks",
+            listOf(
+                "${targetName}Runtime",
+                "${targetName}LegacyMemoryManager",
+                "${targetName}Strict",
+                "${targetName}Release",
+                "${targetName}StdAlloc"
+            )
+    ) {
+        includeBenchmarkSupport()
+    }
+
+    createBenchmarkTask(
+            project,
+            "Mimalloc",
+            "${targetName}MimallocRuntimeBenchmarks",
+            listOf(
+                "${targetName}Runtime",
+                "${targetName}LegacyMemoryManager",
+                "${targetName}Strict",
+                "${targetName}Release",
+                "${targetName}Mimalloc",
+                "${targetName}OptAlloc"
+            )
+    ) {
+        includeBenchmarkSupport()
+    }
+
+    createBenchmarkTask(
+            project,
+            "ExperimentalMM",
+            "${targetName}ExperimentalMMRuntimeBenchmarks",
+            listOf(
+                "${targetName}Runtime",
+                "${targetName}ExperimentalMemoryManager",
+                "${targetName}Release",
+                "${targetName}Mimalloc",
+                "${targetName}OptAlloc"
+            )
+    ) {
+        includeBenchmarkSupport()
+    }
+
+    tasks.register("${targetName}RuntimeBenchmarks") {
+        dependsOn("${targetName}StdAllocRuntimeBenchmarks")
+        dependsOn("${targetName}MimallocRuntimeBenchmarks")
+        dependsOn("${targetName}ExperimentalMMRuntimeBenchmarks")
+    }
 }
 
 val hostRuntime by tasks.registering {
@@ -180,6 +251,10 @@ val hostExperimentalMMRuntimeTests by tasks.registering {
     dependsOn("${hostName}ExperimentalMMRuntimeTests")
 }
 
+val hostRuntimeBenchmarks by tasks.registering {
+    dependsOn("${hostName}RuntimeBenchmarks")
+}
+
 val assemble by tasks.registering {
     dependsOn(tasks.withType(CompileToBitcode::class).matching {
         it.outputGroup == "main"
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_BENCHMARK_H
+#define RUNTIME_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Utils.hpp"
+
+namespace kotlin {
+namespace benchmark {
+
+class StartBarrier;
+
+// Passed to a benchmark function on every thread running it. The function does its setup, runs the measured
+// operation while `KeepRunning()` returns true, then does its teardown:
+//
+//   void Operation(benchmark::State& state) {
+//       Setup();
+//       while (state.KeepRunning()) {
+//           DoOperation();
+//       }
+//       Teardown();
+//   }
+//
+// Only the time between the first and the last call to `KeepRunning()` is measured.
+class State : private Pinned {
+public:
+    State(StartBarrier& barrier, int64_t iterations, int64_t argument, int threadIndex, int threadCount) noexcept :
+        barrier_(barrier), iterations_(iterations), argument_(argument), threadIndex_(threadIndex), threadCount_(threadCount) {}
+
+    // Returns true `iterations()` times. The first call waits until all the threads of the run are ready.
+    bool KeepRunning() noexcept {
+        if (remaining_ > 0) {
+            --remaining_;
+            return true;
+        }
+        return StartOrFinish();
+    }
+
+    // Excludes the time until `ResumeTiming` from the measurement, e.g. to prepare the input of the next iteration.
+    void PauseTiming() noexcept;
+    void ResumeTiming() noexcept;
+
+    int64_t iterations() const noexcept { return iterations_; }
+    // One of the arguments the benchmark is registered with, 0 if there are none.
+    int64_t argument() const noexcept { return argument_; }
+    int threadIndex() const noexcept { return threadIndex_; }
+    int threadCount() const noexcept { return threadCount_; }
+
+    bool finished() const noexcept { return finished_; }
+    std::chrono::nanoseconds elapsed() const noexcept { return elapsed_; }
+
+private:
+    bool StartOrFinish() noexcept;
+
+    StartBarrier& barrier_;
+    const int64_t iterations_;
+    const int64_t argument_;
+    const int threadIndex_;
+    const int threadCount_;
+    int64_t remaining_ = 0;
+    bool started_ = false;
+    bool finished_ = false;
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::nanoseconds elapsed_{0};
+};
+
+using Function = void (*)(State&);
+using Hook = void (*)();
+
+// Registers the benchmark `name` with every combination of `arguments` and `threadCounts`. Declared as
+// a namespace-scope variable of the benchmark file:
+//
+//   benchmark::Registration operation("Suite.Operation", Operation, {16, 256}, {1, 4});
+//
+// The reported name has the argument and the thread count appended when there is more than one of them,
+// e.g. "Suite.Operation/256/threads:4". `setUp` and `tearDown` are called on the launcher thread before
+// and after every run, e.g. to create the data structure shared by the threads of the run.
+class Registration : private Pinned {
+public:
+    Registration(
+            const char* name,
+            Function function,
+            std::vector<int64_t> arguments = {},
+            std::vector<int> threadCounts = {1},
+            Hook setUp = nullptr,
+            Hook tearDown = nullptr) noexcept;
+};
+
+} // namespace benchmark
+} // namespace kotlin
+
+#endif // RUNTIME_BENCHMARK_H
@@ -0,0 +1,329 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kotlin;
+
+class kotlin::benchmark::StartBarrier : private Pinned {
+public:
+    explicit StartBarrier(int count) noexcept : count_(count) {}
+
+    void Wait() noexcept {
+        std::unique_lock<std::mutex> guard(mutex_);
+        if (--count_ == 0) {
+            condition_.notify_all();
+            return;
+        }
+        condition_.wait(guard, [this] { return count_ == 0; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    int count_;
+};
+
+bool benchmark::State::StartOrFinish() noexcept {
+    if (!started_) {
+        started_ = true;
+        barrier_.Wait();
+        if (iterations_ == 0) return false;
+        remaining_ = iterations_ - 1;
+        start_ = std::chrono::steady_clock::now();
+        return true;
+    }
+    if (!finished_) {
+        elapsed_ += std::chrono::steady_clock::now() - start_;
+        finished_ = true;
+    }
+    return false;
+}
+
+void benchmark::State::PauseTiming() noexcept {
+    elapsed_ += std::chrono::steady_clock::now() - start_;
+}
+
+void benchmark::State::ResumeTiming() noexcept {
+    start_ = std::chrono::steady_clock::now();
+}
+
+namespace {
+
+// Same as the defaults of the `performance` benchmarks launcher, scaled down to the duration of the runtime operations.
+constexpr int kDefaultWarmup = 5;
+constexpr int kDefaultRepeat = 20;
+// Each measured run is scaled to take about this long.
+constexpr auto kRunDuration = std::chrono::milliseconds(10);
+constexpr int64_t kMaxIterations = int64_t(1) << 40;
+
+struct Benchmark {
+    std::string name;
+    benchmark::Function function;
+    int64_t argument;
+    int threadCount;
+    benchmark::Hook setUp;
+    benchmark::Hook tearDown;
+};
+
+std::vector<Benchmark>& registry() noexcept {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Options {
+    int warmup = kDefaultWarmup;
+    int repeat = kDefaultRepeat;
+    std::string prefix;
+    std::string output;
+    std::vector<std::string> filters;
+    std::vector<std::regex> filterRegexes;
+    bool verbose = false;
+    bool list = false;
+};
+
+struct Result {
+    std::string name;
+    bool passed;
+    double scoreMicros;
+    int repeat;
+    int warmup;
+};
+
+void logVerbose(const Options& options, const char* format, const char* argument) {
+    if (options.verbose) fprintf(stderr, format, argument);
+}
+
+// Returns the mean time of an iteration on a thread.
+std::chrono::nanoseconds::rep runOnce(const Benchmark& benchmark, int64_t iterations) {
+    if (benchmark.setUp != nullptr) benchmark.setUp();
+    benchmark::StartBarrier barrier(benchmark.threadCount);
+    std::vector<std::chrono::nanoseconds> elapsed(benchmark.threadCount);
+    std::vector<std::exception_ptr> errors(benchmark.threadCount);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < benchmark.threadCount; ++i) {
+        threads.emplace_back([&, i] {
+            benchmark::State state(barrier, iterations, benchmark.argument, i, benchmark.threadCount);
+            try {
+                benchmark.function(state);
+                if (!state.finished()) throw std::logic_error("The benchmark must call KeepRunning until it returns false");
+            } catch (...) {
+                errors[i] = std::current_exception();
+                // Don't leave the other threads waiting at the start.
+                state.KeepRunning();
+            }
+            elapsed[i] = state.elapsed();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (benchmark.tearDown != nullptr) benchmark.tearDown();
+    std::chrono::nanoseconds total(0);
+    for (int i = 0; i < benchmark.threadCount; ++i) {
+        if (errors[i]) std::rethrow_exception(errors[i]);
+        total += elapsed[i];
+    }
+    return total.count() / benchmark.threadCount;
+}
+
+int64_t calibrate(const Benchmark& benchmark) {
+    const auto target = std::chrono::nanoseconds(kRunDuration).count();
+    int64_t iterations = 1;
+    while (true) {
+        auto elapsed = runOnce(benchmark, iterations);
+        if (elapsed >= target / 10 || iterations >= kMaxIterations) {
+            // Multiple of 4, like the `performance` benchmarks: loops with such trip counts execute optimally.
+            int64_t scaled = iterations * target / std::max<decltype(elapsed)>(elapsed, 1);
+            return std::min((scaled / 4 + 1) * 4, kMaxIterations);
+        }
+        iterations *= 10;
+    }
+}
+
+void run(const Options& options, const Benchmark& benchmark, std::vector<Result>& results) {
+    std::string name = options.prefix + benchmark.name;
+    try {
+        logVerbose(options, "Calibrating %s\n", name.c_str());
+        int64_t iterations = calibrate(benchmark);
+        logVerbose(options, "Warm up iterations for benchmark %s\n", name.c_str());
+        for (int i = 0; i < options.warmup; ++i) {
+            runOnce(benchmark, iterations);
+        }
+        logVerbose(options, "Running benchmark %s\n", name.c_str());
+        for (int i = 0; i < options.repeat; ++i) {
+            double nanos = static_cast<double>(runOnce(benchmark, iterations));
+            results.push_back({name, true, nanos / iterations / 1000, i + 1, options.warmup});
+        }
+    } catch (std::exception& e) {
+        fprintf(stderr, "Failure while running benchmark %s: %s\n", name.c_str(), e.what());
+        results.push_back({name, false, 0.0, options.repeat, options.warmup});
+    }
+}
+
+std::string escape(const std::string& string) {
+    std::string result;
+    for (char c : string) {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+// The same JSON as `BenchmarkResult.toJson()` of the `performance` benchmarks, so that the reports can be compared
+// and uploaded by the same tools.
+std::string toJson(const std::vector<Result>& results) {
+    std::string json = "[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        char score[32];
+        snprintf(score, sizeof(score), "%.9g", result.scoreMicros);
+        if (i > 0) json += ", ";
+        json += "{\n";
+        json += "    \"name\": \"" + escape(result.name) + "\",\n";
+        json += std::string("    \"status\": \"") + (result.passed ? "PASSED" : "FAILED") + "\",\n";
+        json += std::string("    \"score\": ") + score + ",\n";
+        json += "    \"metric\": \"EXECUTION_TIME\",\n";
+        json += std::string("    \"runtimeInUs\": ") + score + ",\n";
+        json += "    \"repeat\": " + std::to_string(result.repeat) + ",\n";
+        json += "    \"warmup\": " + std::to_string(result.warmup) + "\n";
+        json += "}";
+    }
+    json += "]";
+    return json;
+}
+
+bool matches(const Options& options, const std::string& name) {
+    if (options.filters.empty() && options.filterRegexes.empty()) return true;
+    for (auto& filter : options.filters) {
+        if (filter == name) return true;
+    }
+    for (auto& regex : options.filterRegexes) {
+        if (std::regex_match(name, regex)) return true;
+    }
+    return false;
+}
+
+void usage() {
+    fprintf(stderr,
+            "Usage: benchmark [list] [options]\n"
+            "  list                      Show list of benchmarks\n"
+            "  -w, --warmup N            Number of warm up iterations (default: %d)\n"
+            "  -r, --repeat N            Number of each benchmark run (default: %d)\n"
+            "  -p, --prefix PREFIX       Prefix added to benchmark name\n"
+            "  -o, --output FILE         Output file\n"
+            "  -f, --filter NAME         Benchmark to run\n"
+            "  -fr, --filterRegex REGEX  Benchmark to run, described by a regular expression\n"
+            "  -v, --verbose             Verbose mode of running\n",
+            kDefaultWarmup, kDefaultRepeat);
+}
+
+bool parse(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        auto is = [&option](const char* shortName, const char* longName) { return option == shortName || option == longName; };
+        if (option == "list") {
+            options.list = true;
+            continue;
+        }
+        if (is("-v", "--verbose")) {
+            options.verbose = true;
+            continue;
+        }
+        if (i + 1 == argc) return false;
+        const char* value = argv[++i];
+        if (is("-w", "--warmup")) {
+            options.warmup = atoi(value);
+        } else if (is("-r", "--repeat")) {
+            options.repeat = atoi(value);
+        } else if (is("-p", "--prefix")) {
+            options.prefix = value;
+        } else if (is("-o", "--output")) {
+            options.output = value;
+        } else if (is("-f", "--filter")) {
+            options.filters.push_back(value);
+        } else if (is("-fr", "--filterRegex")) {
+            try {
+                options.filterRegexes.emplace_back(value);
+            } catch (std::regex_error& e) {
+                fprintf(stderr, "Invalid regular expression %s: %s\n", value, e.what());
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return options.warmup >= 0 && options.repeat > 0;
+}
+
+} // namespace
+
+benchmark::Registration::Registration(
+        const char* name,
+        Function function,
+        std::vector<int64_t> arguments,
+        std::vector<int> threadCounts,
+        Hook setUp,
+        Hook tearDown) noexcept {
+    bool nameArguments = arguments.size() > 1;
+    bool nameThreads = threadCounts.size() > 1;
+    if (arguments.empty()) arguments.push_back(0);
+    for (int64_t argument : arguments) {
+        for (int threadCount : threadCounts) {
+            std::string fullName = name;
+            if (nameArguments) fullName += "/" + std::to_string(argument);
+            if (nameThreads) fullName += "/threads:" + std::to_string(threadCount);
+            registry().push_back({fullName, function, argument, threadCount, setUp, tearDown});
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse(argc, argv, options)) {
+        usage();
+        return 1;
+    }
+    if (options.list) {
+        for (auto& benchmark : registry()) {
+            printf("%s\n", benchmark.name.c_str());
+        }
+        return 0;
+    }
+
+    std::vector<Result> results;
+    for (auto& benchmark : registry()) {
+        if (matches(options, benchmark.name)) run(options, benchmark, results);
+    }
+    if (results.empty()) {
+        fprintf(stderr, "No matching benchmarks found\n");
+        return 1;
+    }
+
+    std::string json = toJson(results);
+    if (options.output.empty()) {
+        printf("%s", json.c_str());
+        return 0;
+    }
+    FILE* file = fopen(options.output.c_str(), "w");
+    if (file == nullptr || fwrite(json.data(), 1, json.size(), file) != json.size() || fclose(file) != 0) {
+        fprintf(stderr, "Cannot write %s\n", options.output.c_str());
+        return 1;
+    }
+    return 0;
+}
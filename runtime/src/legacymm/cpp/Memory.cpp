@@ -31,6 +31,7 @@
 #endif
 
 #include "Alloc.h"
+#include "AllocationProfiler.hpp"
 #include "KAssert.h"
 #include "Atomic.h"
 #include "Cleaner.h"
@@ -38,6 +39,7 @@
 #include "CyclicCollector.h"
 #endif  // USE_CYCLIC_GC
 #include "Exceptions.h"
+#include "HeapSnapshot.hpp"
 #include "KString.h"
 #include "Memory.h"
 #include "MemoryPrivate.hpp"
@@ -119,6 +121,11 @@ constexpr size_t kMaxGcAllocThreshold = 8 * 1024 * 1024;
 constexpr double kGcCollectCyclesLoadRatio = 0.3;
 // Minimum time of cycles collection to change thresholds.
 constexpr size_t kGcCollectCyclesMinimumDuration = 200;
+// Above this percentage of the soft heap limit allocations force full collections.
+constexpr int64_t kSoftHeapLimitPressurePercent = 90;
+// Initial growth of the heap, in percents of the soft heap limit, after which the next such collection is done.
+// Doubled after each collection freeing less than that, up to the limit itself.
+constexpr int64_t kSoftHeapLimitGcStepPercent = 5;
 
 #endif  // USE_GC
 
@@ -149,6 +156,11 @@ volatile int aliveMemoryStatesCount = 0;
 KBoolean g_hasCyclicCollector = true;
 #endif  // USE_CYCLIC_GC
 
+#if USE_GC
+// Soft limit for the memory taken by objects of all threads, 0 if not set.
+int64_t softHeapLimit = 0;
+#endif  // USE_GC
+
 // TODO: Consider using ObjHolder.
 class ScopedRefHolder : private kotlin::MoveOnly {
  public:
@@ -603,6 +615,10 @@ public:
             RuntimeAssert(it->second.size == size, "Attempt to add TLS record with the same key and different size");
             return;
         }
+        // Records are added in the same order on all threads, so all of them store the same offset here.
+        void* offset = reinterpret_cast<void*>(static_cast<intptr_t>(size_));
+        void* previous = __atomic_exchange_n(key, offset, __ATOMIC_RELAXED);
+        RuntimeAssert(previous == nullptr || previous == offset, "TLS records must be added in the same order on all threads");
         map_->emplace(key, Entry{size_, size});
         size_ += size;
     }
@@ -621,19 +637,16 @@ public:
         map_->clear();
     }
 
+    KRef* begin() noexcept { return storage_; }
+    KRef* end() noexcept { return storage_ + size_; }
+
     KRef* Lookup(Key key, int index) noexcept {
         RuntimeAssert(storage_ != nullptr, "Storage must be committed");
-        // In many cases there is only one module, so this is one element cache.
-        if (lastKey_ == key) {
-            return storage_ + lastOffset_ + index;
-        }
-        auto it = map_->find(key);
-        RuntimeAssert(it != map_->end(), "Must be there");
-        auto entry = it->second;
-        RuntimeAssert(index < entry.size, "Out of bounds in TLS access");
-        lastKey_ = key;
-        lastOffset_ = entry.offset;
-        return storage_ + entry.offset + index;
+        // The offset of the record is stored in the key, so there is nothing to search for. The bounds of the record
+        // itself are not checked, as that would take the search again.
+        intptr_t offset = reinterpret_cast<intptr_t>(__atomic_load_n(key, __ATOMIC_RELAXED));
+        RuntimeAssert(index >= 0 && offset + index < size_, "Out of bounds in TLS access");
+        return storage_ + offset + index;
     }
 
 private:
@@ -647,8 +660,6 @@ private:
     Map* map_ = nullptr;
     KRef* storage_ = nullptr;
     int size_ = 0;
-    int lastOffset_ = 0;
-    Key lastKey_ = nullptr;
 };
 
 } // namespace
@@ -696,6 +707,10 @@ struct MemoryState {
 
   uint64_t allocSinceLastGc;
   uint64_t allocSinceLastGcThreshold;
+  // Heap usage above which the next collection caused by the soft heap limit is done, and the growth of the heap
+  // that is allowed after such a collection. 0 until the first such collection.
+  int64_t nextHeapPressureGcBytes;
+  int64_t heapPressureGcStep;
 #endif // USE_GC
 
   // A stack of initializing singletons.
@@ -837,8 +852,9 @@ class ObjectContainer : public Container {
 
 class ArrayContainer : public Container {
  public:
-  ArrayContainer(MemoryState* state, const TypeInfo* type_info, uint32_t elements) {
-    Init(state, type_info, elements);
+  // With `initialize` set to false, the elements are left uninitialized and must be filled by the caller.
+  ArrayContainer(MemoryState* state, const TypeInfo* type_info, uint32_t elements, bool initialize = true) {
+    Init(state, type_info, elements, initialize);
   }
 
   // Array container shalln't have any dtor, as it's being freed by ::Release().
@@ -848,7 +864,7 @@ class ArrayContainer : public Container {
   }
 
  private:
-  void Init(MemoryState* state, const TypeInfo* type_info, uint32_t elements);
+  void Init(MemoryState* state, const TypeInfo* type_info, uint32_t elements, bool initialize);
 };
 
 // Class representing arena-style placement container.
@@ -1043,7 +1059,9 @@ inline bool isFreezableAtomic(ContainerHeader* container) {
   return isFreezableAtomic(obj);
 }
 
-ContainerHeader* allocContainer(MemoryState* state, size_t size) {
+// Only the first `zeroedSize` bytes of the container are zeroed.
+ContainerHeader* allocContainer(MemoryState* state, size_t size, size_t zeroedSize) {
+ RuntimeAssert(zeroedSize <= size, "Cannot zero more than allocated");
  ContainerHeader* result = nullptr;
 #if USE_GC
   // We recycle elements of finalizer queue for new allocations, to avoid trashing memory manager.
@@ -1060,7 +1078,7 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
       else
         previous->setNextLink(container->nextLink());
       state->finalizerQueueSize--;
-      memset(container, 0, size);
+      memset(container, 0, zeroedSize);
       break;
     }
     previous = container;
@@ -1072,7 +1090,13 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
     if (state != nullptr)
         state->allocSinceLastGc += size;
 #endif
-    result = konanConstructSizedInstance<ContainerHeader>(alignUp(size, kObjectAlignment));
+    if (zeroedSize == size) {
+      result = new (konanAllocObjectMemory(alignUp(size, kObjectAlignment))) ContainerHeader();
+    } else {
+      void* memory = konanAllocUninitializedObjectMemory(alignUp(size, kObjectAlignment));
+      if (memory != nullptr) memset(memory, 0, zeroedSize);
+      result = new (memory) ContainerHeader();
+    }
     atomicAdd(&allocCount, 1);
   }
   if (state != nullptr) {
@@ -1084,6 +1108,10 @@ ContainerHeader* allocContainer(MemoryState* state, size_t size) {
   return result;
 }
 
+ContainerHeader* allocContainer(MemoryState* state, size_t size) {
+  return allocContainer(state, size, size);
+}
+
 ContainerHeader* allocAggregatingFrozenContainer(KStdVector<ContainerHeader*>& containers) {
   auto componentSize = containers.size();
   auto* superContainer = allocContainer(memoryState, sizeof(ContainerHeader) + sizeof(void*) * componentSize);
@@ -1113,7 +1141,7 @@ void processFinalizerQueue(MemoryState* state) {
     state->containers->erase(container);
 #endif
     CONTAINER_DESTROY_EVENT(state, container)
-    konanFreeMemory(container);
+    konanFreeObjectMemory(container);
     atomicAdd(&allocCount, -1);
   }
   RuntimeAssert(state->finalizerQueueSize == 0, "Queue must be empty here");
@@ -1154,7 +1182,7 @@ void scheduleDestroyContainer(MemoryState* state, ContainerHeader* container) {
     processFinalizerQueue(state);
   }
 #else
-  konanFreeMemory(container);
+  konanFreeObjectMemory(container);
   atomicAdd(&allocCount, -1);
   CONTAINER_DESTROY_EVENT(state, container);
 #endif
@@ -1727,6 +1755,42 @@ inline void addHeapRef(const ObjHeader* header) {
     addHeapRef(const_cast<ContainerHeader*>(container));
 }
 
+inline void addHeapRefs(ContainerHeader* container, uint32_t count) {
+  MEMORY_LOG("AddHeapRefs %p: rc=%d, count=%d\n", container, container->refCount(), count)
+#if COLLECT_STATISTIC
+  for (uint32_t i = 0; i < count; ++i)
+    UPDATE_ADDREF_STAT(memoryState, container, needAtomicAccess(container), 0)
+#endif
+  switch (container->tag()) {
+    case CONTAINER_TAG_STACK:
+      break;
+    case CONTAINER_TAG_LOCAL:
+      RuntimeAssert(container->refCount() > 0, "add ref for reclaimed object");
+      container->incRefCount</* Atomic = */ false>(count);
+      break;
+    /* case CONTAINER_TAG_FROZEN: case CONTAINER_TAG_SHARED: */
+    default:
+      RuntimeAssert(container->refCount() > 0, "add ref for reclaimed object");
+      container->incRefCount</* Atomic = */ true>(count);
+      break;
+  }
+}
+
+// Adds references to all the objects in the range, with a single counter update per run of equal references.
+inline void addHeapRefs(ObjHeader* const* begin, ObjHeader* const* end) {
+  while (begin != end) {
+    ObjHeader* object = *begin;
+    ObjHeader* const* run = begin + 1;
+    while (run != end && *run == object) ++run;
+    if (object != nullptr) {
+      auto* container = containerFor(object);
+      if (container != nullptr)
+        addHeapRefs(container, run - begin);
+    }
+    begin = run;
+  }
+}
+
 inline bool tryAddHeapRef(ContainerHeader* container) {
   switch (container->tag()) {
     case CONTAINER_TAG_STACK:
@@ -2147,6 +2211,7 @@ void deinitMemory(MemoryState* memoryState, bool destroyRuntime) {
 
   konanFreeMemory(memoryState);
   ::memoryState = nullptr;
+  konan::release_object_heap();
 }
 
 void makeShareable(ContainerHeader* container) {
@@ -2254,7 +2319,125 @@ void updateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) {
   }
 }
 
+// Number of references the range operations save on the stack to release them after the update.
+constexpr uint32_t kRefsRangeChunk = 64;
+
+template <bool Strict>
+inline void releaseHeapRefs(ObjHeader* const* begin, ObjHeader* const* end) {
+  for (; begin != end; ++begin) {
+    if (reinterpret_cast<uintptr_t>(*begin) > 1)
+      releaseHeapRef<Strict>(*begin);
+  }
+}
+
+// Same as updateHeapRef() for each location, in the order of memmove(). New references are added before
+// the locations are updated, and the old ones are released afterwards, so the objects stay reachable through
+// either. When the ranges overlap by all but a few slots, only the references shifted into and out of the
+// destination change their counters.
+template <bool Strict>
+void updateHeapRefsRange(ObjHeader** destination, ObjHeader* const* source, uint32_t count) {
+  if (count == 0 || destination == source) return;
+  for (uint32_t index = 0; index < count; ++index) {
+    UPDATE_REF_EVENT(memoryState, destination[index], source[index], destination + index, 0);
+  }
+
+  ObjHeader* released[kRefsRangeChunk];
+  if (destination > source && destination < source + count &&
+      static_cast<uint32_t>(destination - source) <= kRefsRangeChunk) {
+    // Shift towards the end: source[0, shift) comes in, destination[count - shift, count) goes out.
+    uint32_t shift = destination - source;
+    addHeapRefs(source, source + shift);
+    memcpy(released, destination + count - shift, shift * sizeof(ObjHeader*));
+    memmove(destination, source, count * sizeof(ObjHeader*));
+    releaseHeapRefs<Strict>(released, released + shift);
+    return;
+  }
+  if (source > destination && source < destination + count &&
+      static_cast<uint32_t>(source - destination) <= kRefsRangeChunk) {
+    // Shift towards the beginning: source[count - shift, count) comes in, destination[0, shift) goes out.
+    uint32_t shift = source - destination;
+    addHeapRefs(source + count - shift, source + count);
+    memcpy(released, destination, shift * sizeof(ObjHeader*));
+    memmove(destination, source, count * sizeof(ObjHeader*));
+    releaseHeapRefs<Strict>(released, released + shift);
+    return;
+  }
+
+  // The rest of the overlapping ranges are farther apart than a chunk, so the chunks themselves never overlap.
+  bool forward = destination < source;
+  for (uint32_t done = 0; done < count; done += kRefsRangeChunk) {
+    uint32_t size = count - done < kRefsRangeChunk ? count - done : kRefsRangeChunk;
+    uint32_t offset = forward ? done : count - done - size;
+    ObjHeader** to = destination + offset;
+    ObjHeader* const* from = source + offset;
+    addHeapRefs(from, from + size);
+    memcpy(released, to, size * sizeof(ObjHeader*));
+    memcpy(to, from, size * sizeof(ObjHeader*));
+    releaseHeapRefs<Strict>(released, released + size);
+  }
+}
+
+// Same as updateHeapRef(location, object) for each location in the range, with a single counter update for `object`.
+template <bool Strict>
+void fillHeapRefsRange(ObjHeader** destination, const ObjHeader* object, uint32_t count) {
+  uint32_t changed = 0;
+  for (uint32_t index = 0; index < count; ++index) {
+    if (destination[index] != object) {
+      UPDATE_REF_EVENT(memoryState, destination[index], object, destination + index, 0);
+      ++changed;
+    }
+  }
+  if (changed == 0) return;
+  if (object != nullptr) {
+    auto* container = containerFor(object);
+    if (container != nullptr)
+      addHeapRefs(const_cast<ContainerHeader*>(container), changed);
+  }
+
+  ObjHeader* released[kRefsRangeChunk];
+  for (uint32_t done = 0; done < count; done += kRefsRangeChunk) {
+    uint32_t size = count - done < kRefsRangeChunk ? count - done : kRefsRangeChunk;
+    ObjHeader** to = destination + done;
+    uint32_t releasedCount = 0;
+    for (uint32_t index = 0; index < size; ++index) {
+      if (to[index] != object) {
+        released[releasedCount++] = to[index];
+        *const_cast<const ObjHeader**>(to + index) = object;
+      }
+    }
+    releaseHeapRefs<Strict>(released, released + releasedCount);
+  }
+}
+
+inline bool isUnderHeapPressure(MemoryState* state, int64_t limit) {
+  if (limit <= 0) return false;
+  int64_t bytes = konan::object_bytes();
+  return bytes > limit / 100 * kSoftHeapLimitPressurePercent && bytes > state->nextHeapPressureGcBytes;
+}
+
+// Collects everything that can be collected, including cycles, and returns the freed memory to the OS.
+// To avoid thrashing when the live objects take most of the limit, the next such collection is only done
+// once the heap grows again, by more and more if the collections keep freeing little.
+void relieveHeapPressure(MemoryState* state, int64_t limit) {
+  int64_t before = konan::object_bytes();
+  GC_LOG("Calling GC from relieveHeapPressure: %lld bytes\n", before)
+  garbageCollect(state, true);
+  konan::trim_heap();
+  int64_t after = konan::object_bytes();
+  int64_t minStep = std::max(limit / 100 * kSoftHeapLimitGcStepPercent, static_cast<int64_t>(1));
+  if (state->heapPressureGcStep == 0 || before - after >= state->heapPressureGcStep) {
+    state->heapPressureGcStep = minStep;
+  } else {
+    state->heapPressureGcStep = std::min(state->heapPressureGcStep * 2, std::max(limit, minStep));
+  }
+  state->nextHeapPressureGcBytes = after + state->heapPressureGcStep;
+}
+
 inline void checkIfGcNeeded(MemoryState* state) {
+  if (state != nullptr && state->gcSuspendCount == 0) {
+    int64_t limit = atomicGet(&softHeapLimit);
+    if (isUnderHeapPressure(state, limit)) relieveHeapPressure(state, limit);
+  }
   if (state != nullptr && state->allocSinceLastGc > state->allocSinceLastGcThreshold && state->gcSuspendCount == 0) {
     // To avoid GC trashing check that at least 10ms passed since last GC.
     if (konan::getTimeMicros() - state->lastGcTimestamp > 10 * 1000) {
@@ -2283,6 +2466,7 @@ OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
   checkIfGcNeeded(state);
 #endif  // USE_GC
   auto container = ObjectContainer(state, type_info);
+  kotlin::profiler::OnAllocation(type_info, type_info->instanceSize_);
   ObjHeader* obj = container.GetPlace();
 #if USE_GC
   if (Strict) {
@@ -2306,14 +2490,15 @@ OBJ_GETTER(allocInstance, const TypeInfo* type_info) {
 }
 
 template <bool Strict>
-OBJ_GETTER(allocArrayInstance, const TypeInfo* type_info, int32_t elements) {
+OBJ_GETTER(allocArrayInstance, const TypeInfo* type_info, int32_t elements, bool initialize) {
   RuntimeAssert(type_info->instanceSize_ < 0, "must be an array");
   if (elements < 0) ThrowIllegalArgumentException();
   auto* state = memoryState;
 #if USE_GC
   checkIfGcNeeded(state);
 #endif  // USE_GC
-  auto container = ArrayContainer(state, type_info, elements);
+  auto container = ArrayContainer(state, type_info, elements, initialize);
+  kotlin::profiler::OnAllocation(type_info, arrayObjectSize(type_info, elements));
 #if USE_GC
   if (Strict) {
     rememberNewContainer(container.header());
@@ -2499,6 +2684,26 @@ OBJ_GETTER(readHeapRefLocked, ObjHeader** location, int32_t* spinlock, int32_t*
   return value;
 }
 
+OBJ_GETTER(readHeapRefLockFree, ObjHeader** location, int32_t* readers, int32_t* cookie) {
+  MEMORY_LOG("ReadHeapRefLockFree: %p\n", location)
+  // Announce the read, so that the location is not cleared and the value freed until we retain it.
+  atomicAdd(readers, 1);
+  ObjHeader* value = atomicGet(location);
+  auto realCookie = computeCookie();
+  // Racy, but each thread only ever matches the cookie it has written itself.
+  bool shallRemember = atomicGet(cookie) != realCookie;
+  if (shallRemember) atomicSet(cookie, realCookie);
+  UpdateReturnRef(OBJ_RESULT, value);
+#if USE_GC
+  if (IsStrictMemoryModel && shallRemember && value != nullptr) {
+    auto* container = containerFor(value);
+    rememberNewContainer(container);
+  }
+#endif  // USE_GC
+  atomicAdd(readers, -1);
+  return value;
+}
+
 OBJ_GETTER(readHeapRefNoLock, ObjHeader* object, KInt index) {
   MEMORY_LOG("ReadHeapRefNoLock: %p index %d\n", object, index)
   ObjHeader** location = reinterpret_cast<ObjHeader**>(
@@ -2638,6 +2843,61 @@ KBoolean getTuneGCThreshold() {
   return memoryState->gcErgonomics;
 }
 
+void setSoftHeapLimit(KLong value) {
+  GC_LOG("setSoftHeapLimit %lld\n", value)
+  if (value < 0) {
+    ThrowIllegalArgumentException();
+  }
+  atomicSet(&softHeapLimit, static_cast<int64_t>(value));
+}
+
+KLong getSoftHeapLimit() {
+  return atomicGet(&softHeapLimit);
+}
+
+void writeContainerObjects(void* block, void* argument) {
+  auto* writer = reinterpret_cast<kotlin::HeapSnapshotWriter*>(argument);
+  auto* container = reinterpret_cast<ContainerHeader*>(block);
+  // Subcontainers of a frozen component are separate blocks.
+  if (isAggregatingFrozenContainer(container)) return;
+  // Only local containers count exactly the references from the heap, globals and stable pointers.
+  int64_t refCount = container->local() ? container->refCount() : kotlin::HeapSnapshotWriter::kUnknownRefCount;
+  traverseContainerObjects(container, [writer, refCount](ObjHeader* obj) {
+    writer->WriteObject(obj, refCount);
+  });
+}
+
+// Globals aren't registered anywhere, the offline analysis finds the objects they refer to by the reference counts
+// exceeding the references from the snapshot.
+bool dumpHeapSnapshot(MemoryState* state, const char* path) {
+  kotlin::HeapSnapshotWriter writer(path);
+  if (!writer.ok()) return false;
+  KStdVector<ObjHeader*> roots;
+  for (FrameOverlay* frame = currentFrame; frame != nullptr; frame = frame->previous) {
+    ObjHeader** current = reinterpret_cast<ObjHeader**>(frame + 1) + frame->parameters;
+    ObjHeader** end = current + frame->count - kFrameOverlaySlots - frame->parameters;
+    for (; current < end; ++current) {
+      if (*current == nullptr) continue;
+      writer.WriteRoot(kotlin::HeapSnapshotWriter::kRootStack, *current);
+      roots.push_back(*current);
+    }
+  }
+  for (KRef object : state->tls) {
+    if (object == nullptr) continue;
+    writer.WriteRoot(kotlin::HeapSnapshotWriter::kRootThreadLocal, object);
+    roots.push_back(object);
+  }
+#if USE_GC
+  // The containers in the finalizer queue are still allocated, but their first object links the queue.
+  processFinalizerQueue(state);
+#endif  // USE_GC
+  // The writer only allocates in the runtime heap, so the object heap doesn't change while it is visited.
+  if (!konan::visit_object_heap(writeContainerObjects, &writer)) {
+    writer.WriteReachableObjects(roots);
+  }
+  return writer.Finish();
+}
+
 KNativePtr createStablePointer(KRef any) {
   if (any == nullptr) return nullptr;
   MEMORY_LOG("CreateStablePointer for %p rc=%d\n", any, containerFor(any) ? containerFor(any)->refCount() : 0)
@@ -3151,11 +3411,12 @@ void ObjectContainer::Init(MemoryState* state, const TypeInfo* typeInfo) {
   OBJECT_ALLOC_EVENT(memoryState, typeInfo->instanceSize_, GetPlace())
 }
 
-void ArrayContainer::Init(MemoryState* state, const TypeInfo* typeInfo, uint32_t elements) {
+void ArrayContainer::Init(MemoryState* state, const TypeInfo* typeInfo, uint32_t elements, bool initialize) {
   RuntimeAssert(typeInfo->instanceSize_ < 0, "Must be an array");
+  RuntimeAssert(initialize || typeInfo != theArrayTypeInfo, "Elements of an object array must be initialized");
   uint32_t allocSize =
       sizeof(ContainerHeader) + arrayObjectSize(typeInfo, elements);
-  header_ = allocContainer(state, allocSize);
+  header_ = allocContainer(state, allocSize, initialize ? allocSize : sizeof(ContainerHeader) + sizeof(ArrayHeader));
   RuntimeCheck(header_ != nullptr, "Cannot alloc memory");
   // One object in this container, no need to set.
   header_->setContainerSize(allocSize);
@@ -3193,7 +3454,8 @@ bool ArenaContainer::allocContainer(container_size_t minSize) {
   auto size = minSize + sizeof(ContainerHeader) + sizeof(ContainerChunk);
   size = alignUp(size, kContainerAlignment);
   // TODO: keep simple cache of container chunks.
-  ContainerChunk* result = konanConstructSizedInstance<ContainerChunk>(size);
+  // Chunks stay out of the object heap, so that heap snapshots may treat all its blocks as heap containers.
+  ContainerChunk* result = new (konanAllocMemory(size)) ContainerChunk();
   RuntimeCheck(result != nullptr, "Cannot alloc memory");
   if (result == nullptr) return false;
   result->next = currentChunk_;
@@ -3318,6 +3580,13 @@ void RestoreMemory(MemoryState* memoryState) {
     ::memoryState = memoryState;
 }
 
+bool DetachMemory(MemoryState* memoryState) {
+    RuntimeAssert(::memoryState == memoryState, "Must detach the memory state of the current thread");
+    RuntimeAssert(::currentFrame == nullptr, "Cannot detach memory state with active frames");
+    ::memoryState = nullptr;
+    return true;
+}
+
 OBJ_GETTER(AllocInstanceStrict, const TypeInfo* type_info) {
   RETURN_RESULT_OF(allocInstance<true>, type_info);
 }
@@ -3326,10 +3595,17 @@ OBJ_GETTER(AllocInstanceRelaxed, const TypeInfo* type_info) {
 }
 
 OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* typeInfo, int32_t elements) {
-  RETURN_RESULT_OF(allocArrayInstance<true>, typeInfo, elements);
+  RETURN_RESULT_OF(allocArrayInstance<true>, typeInfo, elements, true);
 }
 OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* typeInfo, int32_t elements) {
-  RETURN_RESULT_OF(allocArrayInstance<false>, typeInfo, elements);
+  RETURN_RESULT_OF(allocArrayInstance<false>, typeInfo, elements, true);
+}
+
+OBJ_GETTER(AllocUninitializedArrayInstanceStrict, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstance<true>, typeInfo, elements, false);
+}
+OBJ_GETTER(AllocUninitializedArrayInstanceRelaxed, const TypeInfo* typeInfo, int32_t elements) {
+  RETURN_RESULT_OF(allocArrayInstance<false>, typeInfo, elements, false);
 }
 
 OBJ_GETTER(InitThreadLocalSingletonStrict, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
@@ -3396,6 +3672,20 @@ RUNTIME_NOTHROW void UpdateReturnRefRelaxed(ObjHeader** returnSlot, const ObjHea
   updateReturnRef<false>(returnSlot, value);
 }
 
+RUNTIME_NOTHROW void UpdateHeapRefsRangeStrict(ObjHeader** destination, ObjHeader* const* source, uint32_t count) {
+  updateHeapRefsRange<true>(destination, source, count);
+}
+RUNTIME_NOTHROW void UpdateHeapRefsRangeRelaxed(ObjHeader** destination, ObjHeader* const* source, uint32_t count) {
+  updateHeapRefsRange<false>(destination, source, count);
+}
+
+RUNTIME_NOTHROW void FillHeapRefsRangeStrict(ObjHeader** destination, const ObjHeader* object, uint32_t count) {
+  fillHeapRefsRange<true>(destination, object, count);
+}
+RUNTIME_NOTHROW void FillHeapRefsRangeRelaxed(ObjHeader** destination, const ObjHeader* object, uint32_t count) {
+  fillHeapRefsRange<false>(destination, object, count);
+}
+
 RUNTIME_NOTHROW void ZeroArrayRefs(ArrayHeader* array) {
   for (uint32_t index = 0; index < array->count_; ++index) {
     ObjHeader** location = ArrayAddressOfElementAt(array, index);
@@ -3420,6 +3710,10 @@ OBJ_GETTER(ReadHeapRefLocked, ObjHeader** location, int32_t* spinlock, int32_t*
   RETURN_RESULT_OF(readHeapRefLocked, location, spinlock, cookie);
 }
 
+OBJ_GETTER(ReadHeapRefLockFree, ObjHeader** location, int32_t* readers, int32_t* cookie) {
+  RETURN_RESULT_OF(readHeapRefLockFree, location, readers, cookie);
+}
+
 OBJ_GETTER(ReadHeapRefNoLock, ObjHeader* object, KInt index) {
   RETURN_RESULT_OF(readHeapRefNoLock, object, index);
 }
@@ -3533,6 +3827,31 @@ KBoolean Kotlin_native_internal_GC_getTuneThreshold(KRef) {
 #endif
 }
 
+void Kotlin_native_internal_GC_setSoftHeapLimit(KRef, KLong value) {
+#if USE_GC
+  setSoftHeapLimit(value);
+#endif
+}
+
+KLong Kotlin_native_internal_GC_getSoftHeapLimit(KRef) {
+#if USE_GC
+  return getSoftHeapLimit();
+#else
+  return -1;
+#endif
+}
+
+KLong Kotlin_native_internal_GC_getHeapUsage(KRef) {
+  return konan::object_bytes();
+}
+
+KBoolean Kotlin_native_internal_GC_dumpHeapSnapshot(KRef, KRef path) {
+  char* cPath = CreateCStringFromString(path);
+  bool result = dumpHeapSnapshot(memoryState, cPath);
+  konan::free(cPath);
+  return result;
+}
+
 OBJ_GETTER(Kotlin_native_internal_GC_detectCycles, KRef) {
 #if USE_CYCLE_DETECTOR
   if (!KonanNeedDebugInfo && !Kotlin_memoryLeakCheckerEnabled()) RETURN_OBJ(nullptr);
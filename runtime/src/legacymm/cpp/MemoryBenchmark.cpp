@@ -0,0 +1,142 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Memory.h"
+#include "TypeInfo.h"
+#include "Utils.hpp"
+
+using namespace kotlin;
+
+namespace {
+
+const std::vector<int> kThreadCounts = {1, 4};
+
+// The memory of the benchmark thread. Must outlive the `ObjHolder`s of the benchmark.
+class ScopedMemoryState : private Pinned {
+public:
+    ScopedMemoryState() noexcept : state_(InitMemory(false)) {}
+    ~ScopedMemoryState() { DeinitMemory(state_, false); }
+
+private:
+    MemoryState* state_;
+};
+
+// A class with `referenceCount` reference fields, or a primitive array with `-instanceSize` bytes elements.
+class Type : private Pinned {
+public:
+    Type(int32_t instanceSize, int32_t referenceCount) noexcept : offsets_(referenceCount) {
+        for (int32_t i = 0; i < referenceCount; ++i) {
+            offsets_[i] = sizeof(ObjHeader) + i * sizeof(ObjHeader*);
+        }
+        typeInfo_.typeInfo_ = &typeInfo_;
+        typeInfo_.instanceSize_ = instanceSize;
+        typeInfo_.objOffsets_ = offsets_.data();
+        typeInfo_.objOffsetsCount_ = referenceCount;
+    }
+
+    const TypeInfo* get() const noexcept { return &typeInfo_; }
+
+    static ObjHeader** field(ObjHeader* object, int32_t index) noexcept {
+        return reinterpret_cast<ObjHeader**>(reinterpret_cast<uintptr_t>(object) + sizeof(ObjHeader)) + index;
+    }
+
+private:
+    TypeInfo typeInfo_ = {};
+    std::vector<int32_t> offsets_;
+};
+
+const Type byteArrayType(-1, 0);
+const Type nodeType(sizeof(ObjHeader) + 2 * sizeof(ObjHeader*), 2);
+
+// `argument()` is the instance size in bytes.
+void AllocInstanceBenchmark(benchmark::State& state) {
+    ScopedMemoryState memory;
+    Type type(static_cast<int32_t>(state.argument()), 0);
+    ObjHolder holder;
+    while (state.KeepRunning()) {
+        AllocInstance(type.get(), holder.slot());
+    }
+}
+
+// `argument()` is the number of bytes.
+void AllocArrayInstanceBenchmark(benchmark::State& state) {
+    ScopedMemoryState memory;
+    ObjHolder holder;
+    while (state.KeepRunning()) {
+        AllocArrayInstance(byteArrayType.get(), static_cast<int32_t>(state.argument()), holder.slot());
+    }
+}
+
+void UpdateHeapRefBenchmark(benchmark::State& state) {
+    ScopedMemoryState memory;
+    ObjHolder object;
+    ObjHolder first;
+    ObjHolder second;
+    AllocInstance(nodeType.get(), object.slot());
+    AllocInstance(nodeType.get(), first.slot());
+    AllocInstance(nodeType.get(), second.slot());
+    ObjHeader** location = Type::field(object.obj(), 0);
+    ObjHeader* values[] = {first.obj(), second.obj()};
+    int64_t index = 0;
+    while (state.KeepRunning()) {
+        UpdateHeapRef(location, values[index++ & 1]);
+    }
+    ZeroHeapRef(location);
+}
+
+// `argument()` is the number of the local variables of the frame.
+void EnterLeaveFrameBenchmark(benchmark::State& state) {
+    ScopedMemoryState memory;
+    constexpr int kOverlaySize = sizeof(FrameOverlay) / sizeof(ObjHeader*);
+    int count = kOverlaySize + static_cast<int>(state.argument());
+    std::vector<ObjHeader*> frame(count, nullptr);
+    while (state.KeepRunning()) {
+        EnterFrame(frame.data(), 0, count);
+        LeaveFrame(frame.data(), 0, count);
+    }
+}
+
+// `argument()` is the number of the objects of the subgraph, a complete binary tree.
+void FreezeSubgraphBenchmark(benchmark::State& state) {
+    ScopedMemoryState memory;
+    ObjHolder root;
+    ObjHolder child;
+    std::vector<ObjHeader*> nodes(state.argument());
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        AllocInstance(nodeType.get(), root.slot());
+        nodes[0] = root.obj();
+        for (size_t i = 1; i < nodes.size(); ++i) {
+            AllocInstance(nodeType.get(), child.slot());
+            UpdateHeapRef(Type::field(nodes[(i - 1) / 2], (i - 1) % 2), child.obj());
+            nodes[i] = child.obj();
+        }
+        child.clear();
+        state.ResumeTiming();
+
+        FreezeSubgraph(root.obj());
+    }
+}
+
+void CreateStablePointerBenchmark(benchmark::State& state) {
+    ScopedMemoryState memory;
+    ObjHolder holder;
+    AllocInstance(nodeType.get(), holder.slot());
+    while (state.KeepRunning()) {
+        DisposeStablePointer(CreateStablePointer(holder.obj()));
+    }
+}
+
+benchmark::Registration allocInstance("Memory.AllocInstance", AllocInstanceBenchmark, {16, 64, 256}, kThreadCounts);
+benchmark::Registration allocArrayInstance("Memory.AllocArrayInstance", AllocArrayInstanceBenchmark, {16, 256, 4096}, kThreadCounts);
+benchmark::Registration updateHeapRef("Memory.UpdateHeapRef", UpdateHeapRefBenchmark);
+benchmark::Registration enterLeaveFrame("Memory.EnterLeaveFrame", EnterLeaveFrameBenchmark, {1, 16});
+benchmark::Registration freezeSubgraph("Memory.FreezeSubgraph", FreezeSubgraphBenchmark, {16, 256}, kThreadCounts);
+benchmark::Registration createStablePointer("Memory.CreateStablePointer", CreateStablePointerBenchmark, {}, kThreadCounts);
+
+} // namespace
@@ -124,6 +124,18 @@ struct ContainerHeader {
 #endif
   }
 
+  template <bool Atomic>
+  inline void incRefCount(uint32_t count) {
+#ifdef KONAN_NO_THREADS
+    refCount_ += count * CONTAINER_TAG_INCREMENT;
+#else
+    if (Atomic)
+      __sync_add_and_fetch(&refCount_, count * CONTAINER_TAG_INCREMENT);
+    else
+      refCount_ += count * CONTAINER_TAG_INCREMENT;
+#endif
+  }
+
   template <bool Atomic>
   inline bool tryIncRefCount() {
     if (Atomic) {
@@ -309,6 +321,9 @@ OBJ_GETTER(AllocInstanceRelaxed, const TypeInfo* type_info) RUNTIME_NOTHROW;
 OBJ_GETTER(AllocArrayInstanceStrict, const TypeInfo* type_info, int32_t elements);
 OBJ_GETTER(AllocArrayInstanceRelaxed, const TypeInfo* type_info, int32_t elements);
 
+OBJ_GETTER(AllocUninitializedArrayInstanceStrict, const TypeInfo* type_info, int32_t elements);
+OBJ_GETTER(AllocUninitializedArrayInstanceRelaxed, const TypeInfo* type_info, int32_t elements);
+
 OBJ_GETTER(InitThreadLocalSingletonStrict, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 OBJ_GETTER(InitThreadLocalSingletonRelaxed, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 
@@ -321,6 +336,8 @@ MODEL_VARIANTS(void, ZeroStackRef, ObjHeader** location);
 MODEL_VARIANTS(void, UpdateStackRef, ObjHeader** location, const ObjHeader* object);
 MODEL_VARIANTS(void, UpdateHeapRef, ObjHeader** location, const ObjHeader* object);
 MODEL_VARIANTS(void, UpdateHeapRefIfNull, ObjHeader** location, const ObjHeader* object);
+MODEL_VARIANTS(void, UpdateHeapRefsRange, ObjHeader** destination, ObjHeader* const* source, uint32_t count);
+MODEL_VARIANTS(void, FillHeapRefsRange, ObjHeader** destination, const ObjHeader* object, uint32_t count);
 MODEL_VARIANTS(void, UpdateReturnRef, ObjHeader** returnSlot, const ObjHeader* object);
 MODEL_VARIANTS(void, EnterFrame, ObjHeader** start, int parameters, int count);
 MODEL_VARIANTS(void, LeaveFrame, ObjHeader** start, int parameters, int count);
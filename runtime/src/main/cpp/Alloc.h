@@ -33,6 +33,19 @@ inline void konanFreeMemory(void* memory) {
   konan::free(memory);
 }
 
+// Memory for Kotlin objects, see konan::calloc_object.
+inline void* konanAllocObjectMemory(size_t size) {
+  return konan::calloc_object(size);
+}
+
+inline void* konanAllocUninitializedObjectMemory(size_t size) {
+  return konan::malloc_object(size);
+}
+
+inline void konanFreeObjectMemory(void* memory) {
+  konan::free_object(memory);
+}
+
 template<typename T>
 inline T* konanAllocArray(size_t length) {
   return reinterpret_cast<T*>(konanAllocMemory(length * sizeof(T)));
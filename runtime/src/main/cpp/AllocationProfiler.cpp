@@ -0,0 +1,394 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "AllocationProfiler.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include "Alloc.h"
+#include "Atomic.h"
+#include "Exceptions.h"
+#include "ExecFormat.h"
+#include "KString.h"
+#include "Mutex.hpp"
+#include "Natives.h"
+#include "Porting.h"
+#include "TypeInfo.h"
+
+using namespace kotlin;
+
+int64_t profiler::internal::samplingInterval = 0;
+THREAD_LOCAL_VARIABLE int64_t profiler::internal::bytesUntilSample = 0;
+
+namespace {
+
+constexpr int kMaxSampledFrames = 64;
+// OnSamplingPoint and the allocation function of the memory manager.
+constexpr int kSkipFrames = 2;
+
+struct SampleKey {
+    const TypeInfo* typeInfo;
+    // The innermost frame first.
+    KStdVector<void*> frames;
+
+    bool operator==(const SampleKey& other) const noexcept { return typeInfo == other.typeInfo && frames == other.frames; }
+};
+
+struct SampleKeyHash {
+    size_t operator()(const SampleKey& key) const noexcept {
+        size_t result = reinterpret_cast<uintptr_t>(key.typeInfo);
+        for (void* frame : key.frames) {
+            result = result * 31 + reinterpret_cast<uintptr_t>(frame);
+        }
+        return result;
+    }
+};
+
+struct StringHash {
+    size_t operator()(const KStdString& string) const noexcept {
+        // FNV-1a.
+        size_t result = 2166136261u;
+        for (char c : string) {
+            result = (result ^ static_cast<unsigned char>(c)) * 16777619u;
+        }
+        return result;
+    }
+};
+
+using StringIndex = std::unordered_map<
+        KStdString,
+        uint64_t,
+        StringHash,
+        std::equal_to<KStdString>,
+        KonanAllocator<std::pair<const KStdString, uint64_t>>>;
+
+// Estimated allocations for a sample key, each sample being scaled by the inverse of its probability.
+struct SampleValue {
+    double objects = 0;
+    double bytes = 0;
+};
+
+using Samples = std::unordered_map<
+        SampleKey,
+        SampleValue,
+        SampleKeyHash,
+        std::equal_to<SampleKey>,
+        KonanAllocator<std::pair<const SampleKey, SampleValue>>>;
+
+SimpleMutex samplesMutex;
+// The interval the last sampling was started with, kept for the profiles after the profiler is stopped.
+int64_t lastSamplingInterval = 0;
+uint64_t samplesStartNanos = 0;
+// The same moment as wall clock time, for the pprof timestamp.
+uint64_t samplesStartEpochNanos = 0;
+
+uint64_t epochNanos() noexcept {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// Marks the start of the samples on both clocks: the monotonic one measures the duration of the profile.
+void startSamplesClock() noexcept {
+    samplesStartNanos = konan::getTimeNanos();
+    samplesStartEpochNanos = epochNanos();
+}
+
+// Incremented on every start, so that each thread draws a fresh sampling point after that.
+int32_t samplingGeneration = 0;
+THREAD_LOCAL_VARIABLE int32_t threadSamplingGeneration = 0;
+THREAD_LOCAL_VARIABLE uint64_t randomState = 0;
+
+Samples& samples() noexcept {
+    static Samples* result = konanConstructInstance<Samples>();
+    return *result;
+}
+
+// Uniformly distributed in (0, 1].
+double nextRandom() noexcept {
+    uint64_t x = randomState;
+    if (x == 0) {
+        x = (konan::getTimeNanos() ^ reinterpret_cast<uintptr_t>(&randomState)) | 1;
+    }
+    // xorshift64.
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    randomState = x;
+    return static_cast<double>((x >> 11) + 1) / static_cast<double>(1ULL << 53);
+}
+
+int64_t nextSamplingDistance(int64_t interval) noexcept {
+    return static_cast<int64_t>(-std::log(nextRandom()) * interval) + 1;
+}
+
+KStdString frameName(void* address) noexcept {
+    char buffer[512];
+    if (!AddressToSymbol(address, buffer, sizeof(buffer)) || buffer[0] == '\0') {
+        konan::snprintf(buffer, sizeof(buffer), "%p", address);
+    }
+    return KStdString(buffer);
+}
+
+KStdVector<std::pair<SampleKey, SampleValue>> snapshotSamples() noexcept {
+    LockGuard<SimpleMutex> guard(samplesMutex);
+    return KStdVector<std::pair<SampleKey, SampleValue>>(samples().begin(), samples().end());
+}
+
+// Just enough of the protobuf encoding for profile.proto.
+class ProtoWriter {
+public:
+    void Varint(uint64_t value) noexcept {
+        while (value >= 0x80) {
+            data_ += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        data_ += static_cast<char>(value);
+    }
+
+    void VarintField(int field, uint64_t value) noexcept {
+        Varint(static_cast<uint64_t>(field) << 3);
+        Varint(value);
+    }
+
+    void BytesField(int field, const KStdString& bytes) noexcept {
+        Varint((static_cast<uint64_t>(field) << 3) | 2);
+        Varint(bytes.size());
+        data_ += bytes;
+    }
+
+    void MessageField(int field, const ProtoWriter& message) noexcept { BytesField(field, message.data_); }
+
+    const KStdString& data() const noexcept { return data_; }
+
+private:
+    KStdString data_;
+};
+
+class StringTable {
+public:
+    StringTable() noexcept { Intern(""); }
+
+    uint64_t Intern(const KStdString& string) noexcept {
+        auto it = indices_.find(string);
+        if (it != indices_.end()) return it->second;
+        uint64_t index = strings_.size();
+        strings_.push_back(string);
+        indices_.emplace(string, index);
+        return index;
+    }
+
+    const KStdVector<KStdString>& strings() const noexcept { return strings_; }
+
+private:
+    KStdVector<KStdString> strings_;
+    StringIndex indices_;
+};
+
+ProtoWriter valueType(StringTable& strings, const char* type, const char* unit) noexcept {
+    ProtoWriter result;
+    result.VarintField(1, strings.Intern(type));
+    result.VarintField(2, strings.Intern(unit));
+    return result;
+}
+
+} // namespace
+
+void profiler::internal::OnSamplingPoint(const TypeInfo* typeInfo, int64_t size) noexcept {
+    int64_t interval = atomicGet(&samplingInterval);
+    if (interval == 0) return;
+    int32_t generation = atomicGet(&samplingGeneration);
+    if (threadSamplingGeneration != generation) {
+        // The first allocation on this thread since the start: the sampling point hasn't been chosen yet.
+        threadSamplingGeneration = generation;
+        bytesUntilSample = nextSamplingDistance(interval) - size;
+        if (bytesUntilSample > 0) return;
+    }
+    bytesUntilSample = nextSamplingDistance(interval);
+    double probability = 1 - std::exp(-static_cast<double>(size) / interval);
+    if (probability <= 0) return;
+
+    void* frames[kMaxSampledFrames];
+    int count = CaptureStackTraceAddresses(frames, kMaxSampledFrames, kSkipFrames);
+    SampleKey key{typeInfo, KStdVector<void*>(frames, frames + count)};
+    LockGuard<SimpleMutex> guard(samplesMutex);
+    SampleValue& value = samples()[std::move(key)];
+    value.objects += 1 / probability;
+    value.bytes += size / probability;
+}
+
+void profiler::StartAllocationSampling(int64_t samplingInterval) noexcept {
+    RuntimeAssert(samplingInterval > 0, "Sampling interval must be positive");
+    {
+        LockGuard<SimpleMutex> guard(samplesMutex);
+        if (samples().empty()) startSamplesClock();
+        lastSamplingInterval = samplingInterval;
+    }
+    atomicAdd(&samplingGeneration, 1);
+    atomicSet(&internal::samplingInterval, samplingInterval);
+}
+
+void profiler::StopAllocationSampling() noexcept {
+    atomicSet(&internal::samplingInterval, static_cast<int64_t>(0));
+}
+
+bool profiler::IsAllocationSamplingActive() noexcept {
+    return atomicGet(&internal::samplingInterval) != 0;
+}
+
+void profiler::ResetAllocationSamples() noexcept {
+    LockGuard<SimpleMutex> guard(samplesMutex);
+    samples().clear();
+    startSamplesClock();
+}
+
+KStdString profiler::DumpAllocationSamplesCollapsed() noexcept {
+    KStdUnorderedMap<void*, KStdString> frameNames;
+    KStdString result;
+    for (auto& sample : snapshotSamples()) {
+        const auto& frames = sample.first.frames;
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            auto name = frameNames.find(*it);
+            if (name == frameNames.end()) {
+                KStdString frame = frameName(*it);
+                // `;` separates the frames.
+                for (char& c : frame) {
+                    if (c == ';') c = ',';
+                }
+                name = frameNames.emplace(*it, std::move(frame)).first;
+            }
+            result += name->second;
+            result += ';';
+        }
+        result += TypeName(sample.first.typeInfo);
+        char bytes[32];
+        konan::snprintf(bytes, sizeof(bytes), " %lld\n", static_cast<long long>(std::llround(sample.second.bytes)));
+        result += bytes;
+    }
+    return result;
+}
+
+KStdString profiler::DumpAllocationSamplesPprof() noexcept {
+    auto snapshot = snapshotSamples();
+    int64_t interval;
+    uint64_t startNanos;
+    uint64_t startEpochNanos;
+    {
+        LockGuard<SimpleMutex> guard(samplesMutex);
+        interval = lastSamplingInterval;
+        startNanos = samplesStartNanos;
+        startEpochNanos = samplesStartEpochNanos;
+    }
+
+    StringTable strings;
+    ProtoWriter profile;
+    profile.MessageField(1, valueType(strings, "alloc_objects", "count"));
+    profile.MessageField(1, valueType(strings, "alloc_space", "bytes"));
+
+    KStdUnorderedMap<void*, uint64_t> locationIds;
+    StringIndex functionIds;
+    ProtoWriter locations;
+    ProtoWriter functions;
+    uint64_t objectTypeKey = strings.Intern("object type");
+    for (auto& sample : snapshot) {
+        ProtoWriter locationIdsOfSample;
+        for (void* address : sample.first.frames) {
+            auto location = locationIds.find(address);
+            if (location == locationIds.end()) {
+                KStdString name = frameName(address);
+                auto function = functionIds.find(name);
+                if (function == functionIds.end()) {
+                    uint64_t functionId = functionIds.size() + 1;
+                    uint64_t nameIndex = strings.Intern(name);
+                    ProtoWriter message;
+                    message.VarintField(1, functionId);
+                    message.VarintField(2, nameIndex);
+                    message.VarintField(3, nameIndex);
+                    functions.MessageField(5, message);
+                    function = functionIds.emplace(std::move(name), functionId).first;
+                }
+                uint64_t locationId = locationIds.size() + 1;
+                ProtoWriter line;
+                line.VarintField(1, function->second);
+                ProtoWriter message;
+                message.VarintField(1, locationId);
+                message.VarintField(3, reinterpret_cast<uintptr_t>(address));
+                message.MessageField(4, line);
+                locations.MessageField(4, message);
+                location = locationIds.emplace(address, locationId).first;
+            }
+            locationIdsOfSample.Varint(location->second);
+        }
+        ProtoWriter values;
+        values.Varint(static_cast<uint64_t>(std::llround(sample.second.objects)));
+        values.Varint(static_cast<uint64_t>(std::llround(sample.second.bytes)));
+        ProtoWriter label;
+        label.VarintField(1, objectTypeKey);
+        label.VarintField(2, strings.Intern(TypeName(sample.first.typeInfo)));
+
+        ProtoWriter message;
+        message.BytesField(1, locationIdsOfSample.data());
+        message.BytesField(2, values.data());
+        message.MessageField(3, label);
+        profile.MessageField(2, message);
+    }
+
+    ProtoWriter periodType = valueType(strings, "space", "bytes");
+
+    KStdString result = profile.data();
+    result += locations.data();
+    result += functions.data();
+    ProtoWriter tail;
+    // All the strings are interned by now.
+    for (auto& string : strings.strings()) {
+        tail.BytesField(6, string);
+    }
+    // time_nanos is a wall clock time, duration_nanos is measured on the monotonic clock.
+    tail.VarintField(9, startEpochNanos);
+    tail.VarintField(10, konan::getTimeNanos() - startNanos);
+    tail.MessageField(11, periodType);
+    tail.VarintField(12, interval);
+    result += tail.data();
+    return result;
+}
+
+extern "C" {
+
+void Kotlin_AllocationProfiler_start(KLong samplingInterval) {
+    if (samplingInterval <= 0) {
+        ThrowIllegalArgumentException();
+    }
+    profiler::StartAllocationSampling(samplingInterval);
+}
+
+void Kotlin_AllocationProfiler_stop() {
+    profiler::StopAllocationSampling();
+}
+
+KBoolean Kotlin_AllocationProfiler_isActive() {
+    return profiler::IsAllocationSamplingActive();
+}
+
+void Kotlin_AllocationProfiler_reset() {
+    profiler::ResetAllocationSamples();
+}
+
+OBJ_GETTER0(Kotlin_AllocationProfiler_dumpPprof) {
+    KStdString profile = profiler::DumpAllocationSamplesPprof();
+    ArrayHeader* result = AllocUninitializedArrayInstance(theByteArrayTypeInfo, profile.size(), OBJ_RESULT)->array();
+    memcpy(ByteArrayAddressOfElementAt(result, 0), profile.data(), profile.size());
+    RETURN_OBJ(result->obj());
+}
+
+OBJ_GETTER0(Kotlin_AllocationProfiler_dumpCollapsed) {
+    KStdString stacks = profiler::DumpAllocationSamplesCollapsed();
+    RETURN_RESULT_OF(CreateStringFromUtf8, stacks.data(), stacks.size());
+}
+
+} // extern "C"
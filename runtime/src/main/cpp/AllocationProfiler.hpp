@@ -0,0 +1,65 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_ALLOCATION_PROFILER_H
+#define RUNTIME_ALLOCATION_PROFILER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Common.h"
+#include "Memory.h"
+#include "Types.h"
+
+namespace kotlin {
+namespace profiler {
+
+// Sampling profiler of the heap allocations.
+//
+// Allocations are sampled as a Poisson process over the allocated bytes: the distance between two sampling
+// points is exponentially distributed with the mean of the sampling interval, and an allocation is sampled
+// when it covers such a point. So an allocation of `size` bytes is sampled with the probability
+// `1 - exp(-size / interval)`, and every sample is scaled by the inverse of that probability in the profiles.
+// For each sample the stack and the type of the object are recorded.
+//
+// When the profiler is stopped, the allocations only pay for a single load of a global variable.
+
+namespace internal {
+
+// Mean distance between sampling points in bytes, 0 when the profiler is stopped.
+extern int64_t samplingInterval;
+// Bytes left until the next sampling point on this thread.
+extern THREAD_LOCAL_VARIABLE int64_t bytesUntilSample;
+
+void OnSamplingPoint(const TypeInfo* typeInfo, int64_t size) noexcept;
+
+} // namespace internal
+
+ALWAYS_INLINE inline void OnAllocation(const TypeInfo* typeInfo, int64_t size) noexcept {
+    if (__builtin_expect(__atomic_load_n(&internal::samplingInterval, __ATOMIC_RELAXED) == 0, true)) return;
+    internal::bytesUntilSample -= size;
+    if (internal::bytesUntilSample <= 0) internal::OnSamplingPoint(typeInfo, size);
+}
+
+// Starts sampling with the given mean interval in bytes, keeping the samples collected so far.
+void StartAllocationSampling(int64_t samplingInterval) noexcept;
+void StopAllocationSampling() noexcept;
+bool IsAllocationSamplingActive() noexcept;
+// Discards the samples collected so far.
+void ResetAllocationSamples() noexcept;
+
+// The samples as collapsed stacks: one line per distinct stack, the frames from the outermost one separated by
+// `;`, with the type of the object as the innermost frame, followed by the estimated number of allocated bytes.
+// The format is understood by flamegraph.pl and most of the flame graph viewers.
+KStdString DumpAllocationSamplesCollapsed() noexcept;
+
+// The samples as a serialized pprof profile (profile.proto of github.com/google/pprof) with the estimated
+// number of allocated objects and bytes for each sample. The type of the object is the `object type` label.
+KStdString DumpAllocationSamplesPprof() noexcept;
+
+} // namespace profiler
+} // namespace kotlin
+
+#endif // RUNTIME_ALLOCATION_PROFILER_H
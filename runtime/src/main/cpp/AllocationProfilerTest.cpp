@@ -0,0 +1,140 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "AllocationProfiler.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "TypeInfo.h"
+
+using namespace kotlin;
+
+namespace {
+
+template <size_t Length>
+struct StaticString {
+    explicit StaticString(const char (&ascii)[Length]) {
+        header.typeInfoOrMeta_ = nullptr;
+        header.count_ = Length - 1;
+        for (size_t i = 0; i < Length - 1; ++i) {
+            chars[i] = ascii[i];
+        }
+    }
+
+    ObjHeader* obj() { return reinterpret_cast<ObjHeader*>(&header); }
+
+    ArrayHeader header;
+    KChar chars[Length];
+};
+
+class AllocationProfilerTest : public testing::Test {
+public:
+    AllocationProfilerTest() : packageName_("test.pkg"), relativeName_("Foo") {
+        typeInfo_.packageName_ = packageName_.obj();
+        typeInfo_.relativeName_ = relativeName_.obj();
+        profiler::ResetAllocationSamples();
+    }
+
+    ~AllocationProfilerTest() {
+        profiler::StopAllocationSampling();
+        profiler::ResetAllocationSamples();
+    }
+
+    NO_INLINE void allocate(int64_t size) { profiler::OnAllocation(&typeInfo_, size); }
+
+    static uint64_t epochNanos() {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    }
+
+    // Whether the profile has a varint field 9 (time_nanos) within the given bounds.
+    static bool hasTimeNanosWithin(const KStdString& pprof, uint64_t from, uint64_t to) {
+        for (size_t i = 0; i < pprof.size(); ++i) {
+            if (pprof[i] != 0x48) continue;
+            uint64_t value = 0;
+            int shift = 0;
+            for (size_t j = i + 1; j < pprof.size() && shift < 64; ++j, shift += 7) {
+                value |= static_cast<uint64_t>(pprof[j] & 0x7f) << shift;
+                if ((pprof[j] & 0x80) == 0) break;
+            }
+            if (value >= from && value <= to) return true;
+        }
+        return false;
+    }
+
+    // Estimated bytes of the only collapsed stack.
+    static long long collapsedBytes(const KStdString& collapsed) {
+        auto space = collapsed.rfind(' ');
+        if (space == KStdString::npos) return -1;
+        return std::atoll(collapsed.c_str() + space + 1);
+    }
+
+private:
+    StaticString<9> packageName_;
+    StaticString<4> relativeName_;
+    TypeInfo typeInfo_ = {};
+};
+
+} // namespace
+
+TEST_F(AllocationProfilerTest, Stopped) {
+    EXPECT_FALSE(profiler::IsAllocationSamplingActive());
+    for (int i = 0; i < 1000; ++i) {
+        allocate(1024);
+    }
+    EXPECT_EQ("", profiler::DumpAllocationSamplesCollapsed());
+}
+
+TEST_F(AllocationProfilerTest, SampleEverything) {
+    profiler::StartAllocationSampling(1);
+    EXPECT_TRUE(profiler::IsAllocationSamplingActive());
+    for (int i = 0; i < 10; ++i) {
+        allocate(64);
+    }
+    profiler::StopAllocationSampling();
+    allocate(64);
+
+    KStdString collapsed = profiler::DumpAllocationSamplesCollapsed();
+    EXPECT_NE(KStdString::npos, collapsed.find(";test.pkg.Foo 640\n")) << collapsed;
+    EXPECT_EQ(collapsed.find('\n'), collapsed.size() - 1) << collapsed;
+
+    KStdString pprof = profiler::DumpAllocationSamplesPprof();
+    ASSERT_FALSE(pprof.empty());
+    // Field 1 (sample_type), length-delimited.
+    EXPECT_EQ(0x0a, pprof[0]);
+    EXPECT_NE(KStdString::npos, pprof.find("alloc_space"));
+    EXPECT_NE(KStdString::npos, pprof.find("object type"));
+    EXPECT_NE(KStdString::npos, pprof.find("test.pkg.Foo"));
+
+    profiler::ResetAllocationSamples();
+    EXPECT_EQ("", profiler::DumpAllocationSamplesCollapsed());
+}
+
+TEST_F(AllocationProfilerTest, Estimate) {
+    profiler::StartAllocationSampling(4096);
+    constexpr long long kCount = 100000;
+    constexpr long long kSize = 100;
+    for (int i = 0; i < kCount; ++i) {
+        allocate(kSize);
+    }
+    profiler::StopAllocationSampling();
+    // About 2500 samples, so the estimate is within a few percent.
+    long long bytes = collapsedBytes(profiler::DumpAllocationSamplesCollapsed());
+    EXPECT_GT(bytes, kCount * kSize * 9 / 10);
+    EXPECT_LT(bytes, kCount * kSize * 11 / 10);
+}
+
+TEST_F(AllocationProfilerTest, PprofTimeIsWallClock) {
+    uint64_t before = epochNanos();
+    profiler::StartAllocationSampling(1);
+    allocate(64);
+    profiler::StopAllocationSampling();
+    uint64_t after = epochNanos();
+    EXPECT_TRUE(hasTimeNanosWithin(profiler::DumpAllocationSamplesPprof(), before, after));
+}
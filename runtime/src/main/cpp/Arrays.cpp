@@ -118,9 +118,7 @@ void Kotlin_Array_fillImpl(KRef thiz, KInt fromIndex, KInt toIndex, KRef value)
   ArrayHeader* array = thiz->array();
   checkRangeIndexes(fromIndex, toIndex, array->count_);
   mutabilityCheck(thiz);
-  for (KInt index = fromIndex; index < toIndex; ++index) {
-    UpdateHeapRef(ArrayAddressOfElementAt(array, index), value);
-  }
+  FillHeapRefsRange(ArrayAddressOfElementAt(array, fromIndex), value, toIndex - fromIndex);
 }
 
 void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
@@ -133,17 +131,8 @@ void Kotlin_Array_copyImpl(KConstRef thiz, KInt fromIndex,
     ThrowArrayIndexOutOfBoundsException();
   }
   mutabilityCheck(destination);
-  if (fromIndex >= toIndex) {
-    for (int index = 0; index < count; index++) {
-      UpdateHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
-                      *ArrayAddressOfElementAt(array, fromIndex + index));
-    }
-  } else {
-    for (int index = count - 1; index >= 0; index--) {
-      UpdateHeapRef(ArrayAddressOfElementAt(destinationArray, toIndex + index),
-                      *ArrayAddressOfElementAt(array, fromIndex + index));
-    }
-  }
+  UpdateHeapRefsRange(ArrayAddressOfElementAt(destinationArray, toIndex),
+                      ArrayAddressOfElementAt(array, fromIndex), count);
 }
 
 // Arrays.kt
@@ -451,12 +440,13 @@ OBJ_GETTER(Kotlin_CharArray_copyOf, KConstRef thiz, KInt newSize) {
   if (newSize < 0) {
     ThrowIllegalArgumentException();
   }
-  ArrayHeader* result = AllocArrayInstance(array->type_info(), newSize, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(array->type_info(), newSize, OBJ_RESULT)->array();
   KInt toCopy = array->count_ < static_cast<uint32_t>(newSize) ?  array->count_ : newSize;
   memcpy(
       PrimitiveArrayAddressOfElementAt<KChar>(result, 0),
       PrimitiveArrayAddressOfElementAt<KChar>(array, 0),
       toCopy * sizeof(KChar));
+  memset(PrimitiveArrayAddressOfElementAt<KChar>(result, toCopy), 0, (newSize - toCopy) * sizeof(KChar));
   RETURN_OBJ(result->obj());
 }
 
@@ -634,7 +624,7 @@ OBJ_GETTER(Kotlin_ImmutableBlob_toByteArray, KConstRef thiz, KInt startIndex, KI
     ThrowArrayIndexOutOfBoundsException();
   }
   KInt count = endIndex - startIndex;
-  ArrayHeader* result = AllocArrayInstance(theByteArrayTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theByteArrayTypeInfo, count, OBJ_RESULT)->array();
   memcpy(PrimitiveArrayAddressOfElementAt<KByte>(result, 0),
          PrimitiveArrayAddressOfElementAt<KByte>(array, startIndex),
          count);
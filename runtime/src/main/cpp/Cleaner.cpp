@@ -6,13 +6,21 @@
 #include "Cleaner.h"
 
 #include "Memory.h"
+#include "Porting.h"
 #include "Runtime.h"
 #include "Worker.h"
 
+#if KONAN_OBJC_INTEROP
+#include "ObjCMMAPI.h"
+#endif
+
 // Defined in Cleaner.kt
 extern "C" void Kotlin_CleanerImpl_shutdownCleanerWorker(KInt, bool);
 extern "C" KInt Kotlin_CleanerImpl_createCleanerWorker();
 
+// Defined in Worker.kt
+extern "C" OBJ_GETTER(WorkerLaunchpad, KRef);
+
 namespace {
 
 struct CleanerImpl {
@@ -24,8 +32,122 @@ constexpr KInt kCleanerWorkerUninitialized = 0;
 constexpr KInt kCleanerWorkerInitializing = -1;
 constexpr KInt kCleanerWorkerShutdown = -2;
 
+// The first cleaner worker, also used for the GC requests and waiting for the scheduled cleaners.
 KInt globalCleanerWorker = kCleanerWorkerUninitialized;
 
+constexpr int kMaxCleanerWorkers = 16;
+
+// Only changed before the workers are created.
+int cleanerWorkersCount = 1;
+
+struct PendingCleaner {
+    PendingCleaner* next;
+    KNativePtr cleanerStablePtr;
+    uint64_t disposeTimeNanos;
+};
+
+// Cleaners disposed by any thread, run in batches by a single cleaner worker. Disposing pushes onto a lock-free
+// stack, and only the push onto an empty stack schedules the worker: it takes the whole stack at once.
+struct CleanerQueue {
+    PendingCleaner* head = nullptr;
+    KInt worker = 0;
+};
+
+CleanerQueue cleanerQueues[kMaxCleanerWorkers];
+int32_t nextCleanerQueue = 0;
+
+KLong pendingCleanersCount = 0;
+KLong executedCleanersCount = 0;
+KLong maxCleanerLagNanos = 0;
+
+void updateMaxCleanerLag(KLong lag) {
+    KLong max = atomicGet(&maxCleanerLagNanos);
+    while (lag > max) {
+        KLong old = compareAndSwap(&maxCleanerLagNanos, max, lag);
+        if (old == max) break;
+        max = old;
+    }
+}
+
+PendingCleaner* takePendingCleaners(CleanerQueue* queue) {
+    PendingCleaner* head = __atomic_exchange_n(&queue->head, nullptr, __ATOMIC_ACQ_REL);
+    // The stack has the most recently disposed first, run them in the disposal order.
+    PendingCleaner* reversed = nullptr;
+    while (head != nullptr) {
+        PendingCleaner* next = head->next;
+        head->next = reversed;
+        reversed = head;
+        head = next;
+    }
+    return reversed;
+}
+
+void runCleaner(KNativePtr cleanerStablePtr) {
+    ObjHolder operationHolder, dummyHolder;
+    KRef operation = DerefStablePointer(cleanerStablePtr, operationHolder.slot());
+#if KONAN_NO_EXCEPTIONS
+    WorkerLaunchpad(operation, dummyHolder.slot());
+#else
+    try {
+#if KONAN_OBJC_INTEROP
+        konan::AutoreleasePool autoreleasePool;
+#endif
+        WorkerLaunchpad(operation, dummyHolder.slot());
+    } catch (ExceptionObjHolder& e) {
+        // Cleaner workers don't report errors, see `createCleanerWorker` in Cleaner.kt.
+    }
+#endif
+    DisposeStablePointer(cleanerStablePtr);
+}
+
+// Executed on the cleaner worker of the queue.
+void drainCleanerQueue(void* argument) {
+    auto* queue = reinterpret_cast<CleanerQueue*>(argument);
+    PendingCleaner* pending = takePendingCleaners(queue);
+    while (pending != nullptr) {
+        updateMaxCleanerLag(konan::getTimeNanos() - pending->disposeTimeNanos);
+        runCleaner(pending->cleanerStablePtr);
+        PendingCleaner* next = pending->next;
+        konanFreeMemory(pending);
+        // Counted as executed first, so that once no cleaners are pending, all of them are seen as executed.
+        atomicAdd(&executedCleanersCount, static_cast<KLong>(1));
+        atomicAdd(&pendingCleanersCount, static_cast<KLong>(-1));
+        pending = next;
+    }
+}
+
+void scheduleCleaner(KNativePtr cleanerStablePtr) {
+    int count = atomicGet(&cleanerWorkersCount);
+    auto& queue = cleanerQueues[static_cast<uint32_t>(atomicAdd(&nextCleanerQueue, 1)) % count];
+    auto* pending = konanConstructInstance<PendingCleaner>();
+    pending->cleanerStablePtr = cleanerStablePtr;
+    pending->disposeTimeNanos = konan::getTimeNanos();
+    atomicAdd(&pendingCleanersCount, static_cast<KLong>(1));
+    PendingCleaner* head = atomicGet(&queue.head);
+    do {
+        pending->next = head;
+    } while (!__atomic_compare_exchange_n(&queue.head, &head, pending, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    if (head == nullptr) {
+        // The queue was empty, so the worker hasn't been asked to drain it yet.
+        bool result = WorkerScheduleNative(queue.worker, drainCleanerQueue, &queue);
+        RuntimeAssert(result, "Couldn't find Cleaner worker");
+    }
+}
+
+// Disposes the cleaners left in the queues without running them.
+void discardPendingCleaners() {
+    for (int i = 0; i < cleanerWorkersCount; ++i) {
+        PendingCleaner* pending = takePendingCleaners(&cleanerQueues[i]);
+        while (pending != nullptr) {
+            DisposeStablePointer(pending->cleanerStablePtr);
+            PendingCleaner* next = pending->next;
+            konanFreeMemory(pending);
+            atomicAdd(&pendingCleanersCount, static_cast<KLong>(-1));
+            pending = next;
+        }
+    }
+}
+
 void disposeCleaner(CleanerImpl* thiz) {
     auto worker = atomicGet(&globalCleanerWorker);
     RuntimeAssert(
@@ -44,8 +166,7 @@ void disposeCleaner(CleanerImpl* thiz) {
 
     RuntimeAssert(worker > 0, "Cleaner worker must be fully initialized here");
 
-    bool result = WorkerSchedule(worker, thiz->cleanerStablePtr);
-    RuntimeAssert(result, "Couldn't find Cleaner worker");
+    scheduleCleaner(thiz->cleanerStablePtr);
 }
 
 } // namespace
@@ -90,8 +211,14 @@ void ShutdownCleaners(bool executeScheduledCleaners) {
     RuntimeAssert(worker > 0, "Cleaner worker must be fully initialized here");
 
     atomicSet(&globalCleanerWorker, kCleanerWorkerShutdown);
-    Kotlin_CleanerImpl_shutdownCleanerWorker(worker, executeScheduledCleaners);
-    WaitNativeWorkerTermination(worker);
+    for (int i = 0; i < cleanerWorkersCount; ++i) {
+        Kotlin_CleanerImpl_shutdownCleanerWorker(cleanerQueues[i].worker, executeScheduledCleaners);
+    }
+    for (int i = 0; i < cleanerWorkersCount; ++i) {
+        WaitNativeWorkerTermination(cleanerQueues[i].worker);
+    }
+    // Only left if the workers were told not to run them.
+    discardPendingCleaners();
 }
 
 extern "C" KInt Kotlin_CleanerImpl_getCleanerWorker() {
@@ -105,6 +232,10 @@ extern "C" KInt Kotlin_CleanerImpl_getCleanerWorker() {
                 continue;
             }
             worker = Kotlin_CleanerImpl_createCleanerWorker();
+            cleanerQueues[0].worker = worker;
+            for (int i = 1; i < cleanerWorkersCount; ++i) {
+                cleanerQueues[i].worker = Kotlin_CleanerImpl_createCleanerWorker();
+            }
             if (!compareAndSet(&globalCleanerWorker, kCleanerWorkerInitializing, worker)) {
                 RuntimeCheck(false, "Someone interrupted worker initializing");
             }
@@ -125,6 +256,34 @@ extern "C" KInt Kotlin_CleanerImpl_getCleanerWorker() {
     return worker;
 }
 
+extern "C" KInt Kotlin_CleanerImpl_getCleanerWorkersCount() {
+    return atomicGet(&cleanerWorkersCount);
+}
+
+extern "C" KBoolean Kotlin_CleanerImpl_setCleanerWorkersCount(KInt count) {
+    RuntimeAssert(count > 0 && count <= kMaxCleanerWorkers, "Unexpected number of cleaner workers");
+    // The workers must not be created concurrently.
+    if (!compareAndSet(&globalCleanerWorker, kCleanerWorkerUninitialized, kCleanerWorkerInitializing)) {
+        return false;
+    }
+    atomicSet(&cleanerWorkersCount, static_cast<int>(count));
+    atomicSet(&globalCleanerWorker, kCleanerWorkerUninitialized);
+    return true;
+}
+
+extern "C" KLong Kotlin_Debugging_getPendingCleanersCount() {
+    return atomicGet(&pendingCleanersCount);
+}
+
+extern "C" KLong Kotlin_Debugging_getExecutedCleanersCount() {
+    return atomicGet(&executedCleanersCount);
+}
+
+extern "C" KLong Kotlin_Debugging_getMaxCleanerLagNanos() {
+    return atomicGet(&maxCleanerLagNanos);
+}
+
 void ResetCleanerWorkerForTests() {
     atomicSet(&globalCleanerWorker, kCleanerWorkerUninitialized);
+    atomicSet(&cleanerWorkersCount, 1);
 }
@@ -15,6 +15,9 @@ void ShutdownCleaners(bool executeScheduledCleaners);
 
 extern "C" KInt Kotlin_CleanerImpl_getCleanerWorker();
 
+// Sets the number of workers running the cleaners. Returns false if the workers have already been created.
+extern "C" KBoolean Kotlin_CleanerImpl_setCleanerWorkersCount(KInt count);
+
 void ResetCleanerWorkerForTests();
 
 #endif // RUNTIME_CLEANER_H
@@ -79,3 +79,27 @@ TEST(CleanerTest, ShutdownWithCreation) {
     EXPECT_CALL(*shutdownCleanerWorkerMock, Call(workerId, executeScheduledCleaners));
     ShutdownCleaners(executeScheduledCleaners);
 }
+
+TEST(CleanerTest, ShutdownWithSeveralWorkers) {
+    ResetCleanerWorkerForTests();
+
+    constexpr bool executeScheduledCleaners = false;
+
+    auto createCleanerWorkerMock = ScopedCreateCleanerWorkerMock();
+    auto shutdownCleanerWorkerMock = ScopedShutdownCleanerWorkerMock();
+
+    EXPECT_TRUE(Kotlin_CleanerImpl_setCleanerWorkersCount(3));
+    EXPECT_CALL(*createCleanerWorkerMock, Call())
+            .WillOnce(testing::Return(42))
+            .WillOnce(testing::Return(43))
+            .WillOnce(testing::Return(44));
+    EXPECT_THAT(Kotlin_CleanerImpl_getCleanerWorker(), 42);
+    EXPECT_THAT(Kotlin_CleanerImpl_getCleanerWorker(), 42);
+    // Too late to change.
+    EXPECT_FALSE(Kotlin_CleanerImpl_setCleanerWorkersCount(1));
+
+    EXPECT_CALL(*shutdownCleanerWorkerMock, Call(42, executeScheduledCleaners));
+    EXPECT_CALL(*shutdownCleanerWorkerMock, Call(43, executeScheduledCleaners));
+    EXPECT_CALL(*shutdownCleanerWorkerMock, Call(44, executeScheduledCleaners));
+    ShutdownCleaners(executeScheduledCleaners);
+}
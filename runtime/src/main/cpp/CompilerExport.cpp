@@ -4,6 +4,7 @@
  */
 
 #include "Memory.h"
+#include "Runtime.h"
 
 namespace {
 
@@ -28,6 +29,7 @@ void EnsureDeclarationsEmitted() {
     ensureUsed(InitThreadLocalSingleton);
     ensureUsed(InitSingleton);
     ensureUsed(InitAndRegisterGlobal);
+    ensureUsed(CallInitGlobalPossiblyLock);
     ensureUsed(UpdateHeapRef);
     ensureUsed(UpdateStackRef);
     ensureUsed(UpdateReturnRef);
@@ -21,29 +21,28 @@
 #include "Types.h"
 #include "Exceptions.h"
 
-#include "utf8.h"
-
 extern "C" {
 
 // io/Console.kt
-void Kotlin_io_Console_print(KString message) {
+static void writeToConsole(KString message, bool newline) {
   if (message->type_info() != theStringTypeInfo) {
     ThrowClassCastException(message->obj(), theStringTypeInfo);
   }
   // TODO: system stdout must be aware about UTF-8.
   const KChar* utf16 = CharArrayAddressOfElementAt(message, 0);
-  KStdString utf8;
-  utf8.reserve(message->count_);
-  // Replace incorrect sequences with a default codepoint (see utf8::with_replacement::default_replacement)
-  utf8::with_replacement::utf16to8(utf16, utf16 + message->count_, back_inserter(utf8));
-  konan::consoleWriteUtf8(utf8.c_str(), utf8.size());
+  konan::consoleWriteUtf16(utf16, message->count_, newline);
+}
+
+void Kotlin_io_Console_print(KString message) {
+  writeToConsole(message, false);
 }
 
 void Kotlin_io_Console_println(KString message) {
-  Kotlin_io_Console_print(message);
 #ifndef KONAN_ANDROID
+  writeToConsole(message, true);
+#else
   // On Android single print produces logcat entry, so no need in linefeed.
-  Kotlin_io_Console_println0();
+  writeToConsole(message, false);
 #endif
 }
 
@@ -51,12 +50,16 @@ void Kotlin_io_Console_println0() {
   konan::consoleWriteUtf8("\n", 1);
 }
 
+static void createStringFromLine(const char* utf8, uint32_t sizeBytes, void* context) {
+  CreateStringFromUtf8(utf8, sizeBytes, reinterpret_cast<ObjHeader**>(context));
+}
+
 OBJ_GETTER0(Kotlin_io_Console_readLine) {
-  char data[4096];
-  if (konan::consoleReadUtf8(data, sizeof(data)) < 0) {
+  // The line is decoded straight from the input buffer.
+  if (!konan::consoleReadLineUtf8(createStringFromLine, OBJ_RESULT)) {
     RETURN_OBJ(nullptr);
   }
-  RETURN_RESULT_OF(CreateStringFromCString, data);
+  return *OBJ_RESULT;
 }
 
 } // extern "C"
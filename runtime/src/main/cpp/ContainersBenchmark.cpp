@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "MultiSourceQueue.hpp"
+#include "SingleLockList.hpp"
+
+using namespace kotlin;
+
+namespace {
+
+const std::vector<int> kThreadCounts = {1, 4};
+
+using IntQueue = MultiSourceQueue<int>;
+using IntList = SingleLockList<int>;
+
+// Created anew for every run, so that the published elements don't pile up.
+IntQueue* queue = nullptr;
+
+void CreateQueue() {
+    queue = new IntQueue();
+}
+
+void DestroyQueue() {
+    delete queue;
+    queue = nullptr;
+}
+
+// Inserts `argument()` elements and publishes them, like a thread handing over the objects it allocated.
+void MultiSourceQueuePublish(benchmark::State& state) {
+    IntQueue::Producer producer(*queue);
+    while (state.KeepRunning()) {
+        for (int64_t i = 0; i < state.argument(); ++i) {
+            producer.Insert(static_cast<int>(i));
+        }
+        producer.Publish();
+    }
+}
+
+IntList list;
+
+void SingleLockListEmplace(benchmark::State& state) {
+    std::vector<IntList::Node*> nodes;
+    nodes.reserve(state.iterations());
+    while (state.KeepRunning()) {
+        nodes.push_back(list.Emplace(state.threadIndex()));
+    }
+    for (auto* node : nodes) {
+        list.Erase(node);
+    }
+}
+
+void SingleLockListEmplaceErase(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        list.Erase(list.Emplace(state.threadIndex()));
+    }
+}
+
+benchmark::Registration multiSourceQueuePublish(
+        "MultiSourceQueue.Publish", MultiSourceQueuePublish, {1, 16, 256}, kThreadCounts, CreateQueue, DestroyQueue);
+benchmark::Registration singleLockListEmplace("SingleLockList.Emplace", SingleLockListEmplace, {}, kThreadCounts);
+benchmark::Registration singleLockListEmplaceErase("SingleLockList.EmplaceErase", SingleLockListEmplaceErase, {}, kThreadCounts);
+
+} // namespace
@@ -0,0 +1,486 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "CpuProfiler.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if !KONAN_WINDOWS && !KONAN_NO_THREADS && !KONAN_NO_EXCEPTIONS
+#define CPU_PROFILER_SUPPORTED 1
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#if KONAN_LINUX || KONAN_ANDROID
+// Each thread is sampled by a timer measuring its own CPU time, so the signals are only sent to the Kotlin threads.
+// Elsewhere a single timer measures the CPU time of the process.
+#define CPU_PROFILER_THREAD_TIMERS 1
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+#endif
+
+#include "Alloc.h"
+#include "Atomic.h"
+#include "Exceptions.h"
+#include "ExecFormat.h"
+#include "KString.h"
+#include "Mutex.hpp"
+#include "Natives.h"
+#include "Porting.h"
+#include "SourceInfo.h"
+
+using namespace kotlin;
+
+namespace {
+
+SimpleMutex samplesMutex;
+// Number of samples of each collapsed stack.
+KStdOrderedMap<KStdString, int64_t>* samples = nullptr;
+int64_t droppedSamples = 0;
+
+KStdOrderedMap<KStdString, int64_t>& samplesUnlocked() noexcept {
+    if (samples == nullptr) samples = konanConstructInstance<KStdOrderedMap<KStdString, int64_t>>();
+    return *samples;
+}
+
+#if CPU_PROFILER_SUPPORTED
+
+constexpr int64_t kDefaultIntervalMicros = 10000;
+constexpr int kMaxFrames = 64;
+constexpr int kMaxThreads = 64;
+// A power of two, so that the indices may wrap around.
+constexpr uint32_t kRingCapacity = 32;
+constexpr int64_t kDrainIntervalNanos = 10 * 1000 * 1000;
+// recordSample, handleProfilingSignal and the signal trampoline.
+constexpr int kSkipFrames = 3;
+
+struct RawSample {
+    int32_t count;
+    // The innermost frame first.
+    void* frames[kMaxFrames];
+};
+
+enum ThreadState : int32_t {
+    kThreadFree = 0,
+    kThreadAttached,
+};
+
+// A thread with a runtime attached. Its samples go to the ring buffer with the same index.
+struct ProfiledThread {
+    volatile int32_t state;
+    pthread_t thread;
+#if CPU_PROFILER_THREAD_TIMERS
+    pid_t tid;
+    bool timerArmed;
+    timer_t timer;
+#endif
+};
+
+// Single producer, the signal handler on the thread owning the ring, and single consumer, the drain thread.
+// Samples [tail, head) are ready to be consumed. The ring outlives its owner, so that its samples are still drained.
+struct ThreadRing {
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    RawSample samples[kRingCapacity];
+};
+
+// Threads beyond kMaxThreads are not sampled.
+ProfiledThread threads[kMaxThreads];
+// Guards the attachment of the threads and their timers.
+SimpleMutex threadsMutex;
+int64_t samplingIntervalMicros = 0;
+// Allocated on the first start and never freed, as the signal handlers may access it at any moment.
+ThreadRing* rings = nullptr;
+volatile bool samplingActive = false;
+// The SIGPROF handler replaced by the profiler. The signals not sent by the profiler are passed to it.
+// Published before the profiler's handler is installed and never freed, as the signal handlers may access it.
+struct sigaction* volatile previousAction = nullptr;
+
+SimpleMutex startStopMutex;
+pthread_t drainThread;
+volatile bool drainThreadShouldStop = false;
+// Cache of frameName, only accessed under samplesMutex.
+KStdUnorderedMap<void*, KStdString>* frameNames = nullptr;
+
+// Not accessed from the signal handler, which may not touch the TLS: it is allocated lazily in some cases.
+THREAD_LOCAL_VARIABLE ProfiledThread* currentThread = nullptr;
+
+void handleProfilingSignal(int signal, siginfo_t* info, void* context);
+
+bool isCurrentThread(const ProfiledThread& thread) noexcept {
+    return __atomic_load_n(&thread.state, __ATOMIC_ACQUIRE) == kThreadAttached && pthread_equal(thread.thread, pthread_self());
+}
+
+// Returns the thread the signal was sent to by the profiler, or nullptr if the signal is foreign.
+ProfiledThread* findSampledThread(siginfo_t* info) noexcept {
+#if CPU_PROFILER_THREAD_TIMERS
+    // The timers pass the thread along with the signal.
+    if (info->si_code != SI_TIMER) return nullptr;
+    uintptr_t address = reinterpret_cast<uintptr_t>(info->si_value.sival_ptr);
+    uintptr_t begin = reinterpret_cast<uintptr_t>(threads);
+    if (address < begin || address >= begin + sizeof(threads) || (address - begin) % sizeof(ProfiledThread) != 0) {
+        return nullptr;
+    }
+    ProfiledThread* thread = static_cast<ProfiledThread*>(info->si_value.sival_ptr);
+    return isCurrentThread(*thread) ? thread : nullptr;
+#else
+    for (int i = 0; i < kMaxThreads; ++i) {
+        if (isCurrentThread(threads[i])) return &threads[i];
+    }
+    return nullptr;
+#endif
+}
+
+void chainSignal(int signal, siginfo_t* info, void* context) noexcept {
+    const struct sigaction* action = __atomic_load_n(&previousAction, __ATOMIC_ACQUIRE);
+    if (action == nullptr) return;
+    if ((action->sa_flags & SA_SIGINFO) != 0) {
+        if (action->sa_sigaction != nullptr && action->sa_sigaction != handleProfilingSignal) {
+            action->sa_sigaction(signal, info, context);
+        }
+    } else if (action->sa_handler != SIG_DFL && action->sa_handler != SIG_IGN) {
+        // The default action of SIGPROF terminates the process, so a stray signal is rather ignored.
+        action->sa_handler(signal);
+    }
+}
+
+// Async-signal-safe: no locks and no allocations. The unwinder itself isn't formally async-signal-safe, but
+// it is what the other in-process profilers rely on as well.
+NO_INLINE void recordSample(ThreadRing& ring) noexcept {
+    uint32_t head = ring.head;
+    if (head - __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE) == kRingCapacity) {
+        atomicAdd(&droppedSamples, static_cast<int64_t>(1));
+        return;
+    }
+    RawSample& sample = ring.samples[head % kRingCapacity];
+    sample.count = CaptureStackTraceAddresses(sample.frames, kMaxFrames, kSkipFrames);
+    __atomic_store_n(&ring.head, head + 1, __ATOMIC_RELEASE);
+}
+
+void handleProfilingSignal(int signal, siginfo_t* info, void* context) {
+    int savedErrno = errno;
+    ProfiledThread* thread = findSampledThread(info);
+    if (thread == nullptr) {
+        chainSignal(signal, info, context);
+    } else if (__atomic_load_n(&samplingActive, __ATOMIC_ACQUIRE)) {
+        recordSample(rings[thread - threads]);
+    }
+    errno = savedErrno;
+}
+
+void installSignalHandler() noexcept {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = handleProfilingSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    struct sigaction current;
+    RuntimeCheck(sigaction(SIGPROF, nullptr, &current) == 0, "Cannot read the profiling signal handler");
+    if ((current.sa_flags & SA_SIGINFO) != 0 && current.sa_sigaction == handleProfilingSignal) return;
+    // The host has installed its own handler since the last start, or it's the first start.
+    auto* previous = konanAllocArray<struct sigaction>(1);
+    *previous = current;
+    __atomic_store_n(&previousAction, previous, __ATOMIC_RELEASE);
+    RuntimeCheck(sigaction(SIGPROF, &action, nullptr) == 0, "Cannot install the profiling signal handler");
+}
+
+#if CPU_PROFILER_THREAD_TIMERS
+
+// Must be called under threadsMutex. If the timer can't be created, the thread is just not sampled.
+void armThreadTimer(ProfiledThread& thread) noexcept {
+    if (thread.timerArmed) return;
+    clockid_t clock;
+    if (pthread_getcpuclockid(thread.thread, &clock) != 0) return;
+    struct sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_value.sival_ptr = &thread;
+    event.sigev_notify_thread_id = thread.tid;
+    if (timer_create(clock, &event, &thread.timer) != 0) return;
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = samplingIntervalMicros / 1000000;
+    spec.it_interval.tv_nsec = (samplingIntervalMicros % 1000000) * 1000;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(thread.timer, 0, &spec, nullptr) != 0) {
+        timer_delete(thread.timer);
+        return;
+    }
+    thread.timerArmed = true;
+}
+
+// Must be called under threadsMutex.
+void disarmThreadTimer(ProfiledThread& thread) noexcept {
+    if (!thread.timerArmed) return;
+    timer_delete(thread.timer);
+    thread.timerArmed = false;
+}
+
+#else
+
+void setProcessTimer(int64_t intervalMicros) noexcept {
+    struct itimerval timer;
+    timer.it_interval.tv_sec = intervalMicros / 1000000;
+    timer.it_interval.tv_usec = intervalMicros % 1000000;
+    timer.it_value = timer.it_interval;
+    RuntimeCheck(setitimer(ITIMER_PROF, &timer, nullptr) == 0, "Cannot set the profiling timer");
+}
+
+#endif // CPU_PROFILER_THREAD_TIMERS
+
+void detachThread(void* argument) {
+    auto* thread = static_cast<ProfiledThread*>(argument);
+    LockGuard<SimpleMutex> guard(threadsMutex);
+#if CPU_PROFILER_THREAD_TIMERS
+    disarmThreadTimer(*thread);
+#endif
+    currentThread = nullptr;
+    // The signal handler runs on this thread, so it only has to see the writes above in the program order.
+    // Another thread may take the slot and the ring then: there is only one producer at a time anyway.
+    atomicSet(&thread->state, static_cast<int32_t>(kThreadFree));
+}
+
+KStdString frameName(void* address) noexcept {
+    char symbol[512];
+    if (!AddressToSymbol(address, symbol, sizeof(symbol)) || symbol[0] == '\0') {
+        konan::snprintf(symbol, sizeof(symbol), "%p", address);
+    }
+    KStdString result(symbol);
+    SourceInfo sourceInfo = Kotlin_getSourceInfo(address);
+    if (sourceInfo.fileName != nullptr) {
+        const char* fileName = strrchr(sourceInfo.fileName, '/');
+        fileName = fileName != nullptr ? fileName + 1 : sourceInfo.fileName;
+        char location[256];
+        if (sourceInfo.lineNumber != -1) {
+            konan::snprintf(location, sizeof(location), " (%s:%d)", fileName, sourceInfo.lineNumber);
+        } else {
+            konan::snprintf(location, sizeof(location), " (%s)", fileName);
+        }
+        result += location;
+    }
+    // `;` separates the frames.
+    for (char& c : result) {
+        if (c == ';') c = ',';
+    }
+    return result;
+}
+
+void countSampleUnlocked(const RawSample& sample) noexcept {
+    if (frameNames == nullptr) frameNames = konanConstructInstance<KStdUnorderedMap<void*, KStdString>>();
+    KStdString stack;
+    for (int i = sample.count - 1; i >= 0; --i) {
+        // The end of the stack on some platforms.
+        if (sample.frames[i] == nullptr) continue;
+        // The outer frames are return addresses, which may already belong to the next line or even function.
+        void* address = i == 0 ? sample.frames[i] : static_cast<char*>(sample.frames[i]) - 1;
+        auto name = frameNames->find(address);
+        if (name == frameNames->end()) {
+            name = frameNames->emplace(address, frameName(address)).first;
+        }
+        if (!stack.empty()) stack += ';';
+        stack += name->second;
+    }
+    if (stack.empty()) stack = "<unknown>";
+    samplesUnlocked()[stack]++;
+}
+
+void drainRings() noexcept {
+    LockGuard<SimpleMutex> guard(samplesMutex);
+    for (int i = 0; i < kMaxThreads; ++i) {
+        ThreadRing& ring = rings[i];
+        uint32_t head = __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE);
+        for (uint32_t tail = ring.tail; tail != head; ++tail) {
+            countSampleUnlocked(ring.samples[tail % kRingCapacity]);
+            __atomic_store_n(&ring.tail, tail + 1, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+void* drainRoutine(void*) {
+    while (!atomicGet(&drainThreadShouldStop)) {
+        struct timespec interval = {0, kDrainIntervalNanos};
+        nanosleep(&interval, nullptr);
+        drainRings();
+    }
+    return nullptr;
+}
+
+KStdString profilePath;
+
+void writeProfileAtExit() {
+    profiler::StopCpuSampling();
+    KStdString stacks = profiler::DumpCpuSamplesCollapsed();
+    FILE* file = fopen(profilePath.c_str(), "w");
+    if (file == nullptr) {
+        konan::consoleErrorf("Cannot write the CPU profile to %s\n", profilePath.c_str());
+        return;
+    }
+    fwrite(stacks.data(), 1, stacks.size(), file);
+    fclose(file);
+}
+
+#endif // CPU_PROFILER_SUPPORTED
+
+} // namespace
+
+bool profiler::StartCpuSampling(int64_t intervalMicros) noexcept {
+    RuntimeAssert(intervalMicros > 0, "Sampling interval must be positive");
+#if CPU_PROFILER_SUPPORTED
+    LockGuard<SimpleMutex> guard(startStopMutex);
+    if (atomicGet(&samplingActive)) return false;
+    if (rings == nullptr) {
+        rings = konanAllocArray<ThreadRing>(kMaxThreads);
+        // The unwinder initializes itself lazily on the first use, which must not happen in the signal handler.
+        void* frames[1];
+        CaptureStackTraceAddresses(frames, 1, 0);
+    }
+    installSignalHandler();
+    atomicSet(&drainThreadShouldStop, false);
+    RuntimeCheck(pthread_create(&drainThread, nullptr, drainRoutine, nullptr) == 0, "Cannot start the profiler thread");
+    {
+        LockGuard<SimpleMutex> threadsGuard(threadsMutex);
+        samplingIntervalMicros = intervalMicros;
+        atomicSet(&samplingActive, true);
+#if CPU_PROFILER_THREAD_TIMERS
+        for (auto& thread : threads) {
+            if (atomicGet(&thread.state) == kThreadAttached) armThreadTimer(thread);
+        }
+#endif
+    }
+#if !CPU_PROFILER_THREAD_TIMERS
+    setProcessTimer(intervalMicros);
+#endif
+    return true;
+#else
+    return false;
+#endif
+}
+
+void profiler::StopCpuSampling() noexcept {
+#if CPU_PROFILER_SUPPORTED
+    LockGuard<SimpleMutex> guard(startStopMutex);
+    if (!atomicGet(&samplingActive)) return;
+#if CPU_PROFILER_THREAD_TIMERS
+    {
+        LockGuard<SimpleMutex> threadsGuard(threadsMutex);
+        for (auto& thread : threads) {
+            disarmThreadTimer(thread);
+        }
+        atomicSet(&samplingActive, false);
+    }
+#else
+    setProcessTimer(0);
+    atomicSet(&samplingActive, false);
+#endif
+    atomicSet(&drainThreadShouldStop, true);
+    pthread_join(drainThread, nullptr);
+    drainRings();
+#endif
+}
+
+bool profiler::IsCpuSamplingActive() noexcept {
+#if CPU_PROFILER_SUPPORTED
+    return atomicGet(&samplingActive);
+#else
+    return false;
+#endif
+}
+
+void profiler::ResetCpuSamples() noexcept {
+    LockGuard<SimpleMutex> guard(samplesMutex);
+    samplesUnlocked().clear();
+    atomicSet(&droppedSamples, static_cast<int64_t>(0));
+}
+
+int64_t profiler::DroppedCpuSamples() noexcept {
+    return atomicGet(&droppedSamples);
+}
+
+KStdString profiler::DumpCpuSamplesCollapsed() noexcept {
+    KStdString result;
+    LockGuard<SimpleMutex> guard(samplesMutex);
+    for (auto& sample : samplesUnlocked()) {
+        char count[32];
+        konan::snprintf(count, sizeof(count), " %lld\n", static_cast<long long>(sample.second));
+        result += sample.first;
+        result += count;
+    }
+    return result;
+}
+
+void profiler::OnRuntimeThreadAttached() noexcept {
+#if CPU_PROFILER_SUPPORTED
+    if (currentThread != nullptr) return;
+    LockGuard<SimpleMutex> guard(threadsMutex);
+    for (auto& thread : threads) {
+        if (atomicGet(&thread.state) != kThreadFree) continue;
+        thread.thread = pthread_self();
+#if CPU_PROFILER_THREAD_TIMERS
+        thread.tid = static_cast<pid_t>(syscall(SYS_gettid));
+#endif
+        __atomic_store_n(&thread.state, static_cast<int32_t>(kThreadAttached), __ATOMIC_RELEASE);
+        currentThread = &thread;
+#if CPU_PROFILER_THREAD_TIMERS
+        if (atomicGet(&samplingActive)) armThreadTimer(thread);
+#endif
+        konan::onThreadExit(detachThread, &thread);
+        return;
+    }
+#endif
+}
+
+void profiler::StartCpuSamplingFromEnvironment() noexcept {
+#if CPU_PROFILER_SUPPORTED
+    const char* path = getenv("KONAN_CPU_PROFILE");
+    if (path == nullptr || path[0] == '\0') return;
+    int64_t intervalMicros = kDefaultIntervalMicros;
+    if (const char* interval = getenv("KONAN_CPU_PROFILE_INTERVAL_US")) {
+        long long value = atoll(interval);
+        if (value > 0) intervalMicros = value;
+    }
+    if (!StartCpuSampling(intervalMicros)) return;
+    profilePath = path;
+    atexit(writeProfileAtExit);
+#endif
+}
+
+extern "C" {
+
+KBoolean Kotlin_CpuProfiler_start(KLong intervalMicros) {
+    if (intervalMicros <= 0) {
+        ThrowIllegalArgumentException();
+    }
+    return profiler::StartCpuSampling(intervalMicros);
+}
+
+void Kotlin_CpuProfiler_stop() {
+    profiler::StopCpuSampling();
+}
+
+KBoolean Kotlin_CpuProfiler_isActive() {
+    return profiler::IsCpuSamplingActive();
+}
+
+void Kotlin_CpuProfiler_reset() {
+    profiler::ResetCpuSamples();
+}
+
+KLong Kotlin_CpuProfiler_droppedSamples() {
+    return profiler::DroppedCpuSamples();
+}
+
+OBJ_GETTER0(Kotlin_CpuProfiler_dumpCollapsed) {
+    KStdString stacks = profiler::DumpCpuSamplesCollapsed();
+    RETURN_RESULT_OF(CreateStringFromUtf8, stacks.data(), stacks.size());
+}
+
+} // extern "C"
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_CPU_PROFILER_H
+#define RUNTIME_CPU_PROFILER_H
+
+#include <cstdint>
+
+#include "Types.h"
+
+namespace kotlin {
+namespace profiler {
+
+// Sampling CPU profiler.
+//
+// On Linux and Android every thread with a runtime attached has a SIGPROF timer measuring its own CPU time, so the
+// other threads of the host are never interrupted. Elsewhere a single timer measures the CPU time of the process and
+// interrupts the thread which is running when it fires. The signal handler unwinds the stack of a Kotlin thread into
+// a ring buffer owned by the thread, without locks or allocations, and passes the other SIGPROF signals to the handler
+// it has replaced. A background thread drains the ring buffers, symbolizes the frames and counts the samples of each
+// stack.
+//
+// Not supported on Windows and on the targets without threads or exceptions: there the profiler can't be started.
+
+// Starts sampling every `intervalMicros` microseconds of CPU time, keeping the samples collected so far.
+// Returns false if the profiler is not supported or is already active.
+bool StartCpuSampling(int64_t intervalMicros) noexcept;
+// Stops sampling. The samples taken before it returns are all counted.
+void StopCpuSampling() noexcept;
+bool IsCpuSamplingActive() noexcept;
+// Discards the samples collected so far.
+void ResetCpuSamples() noexcept;
+// Number of the samples lost because a ring buffer was full.
+int64_t DroppedCpuSamples() noexcept;
+
+// The samples as collapsed stacks: one line per distinct stack, the frames from the outermost one separated by
+// `;` and followed by the number of samples. A frame is the symbol of the function with the source file and the
+// line when they are known.
+KStdString DumpCpuSamplesCollapsed() noexcept;
+
+// Makes the current thread sampled by the profiler. Called when a runtime is attached to the thread.
+// At most 64 threads are sampled at a time.
+void OnRuntimeThreadAttached() noexcept;
+
+// Starts the profiler if the `KONAN_CPU_PROFILE` environment variable is set. Its value is the path of the file
+// the collapsed stacks are written to when the process exits. `KONAN_CPU_PROFILE_INTERVAL_US` overrides the
+// sampling interval.
+void StartCpuSamplingFromEnvironment() noexcept;
+
+} // namespace profiler
+} // namespace kotlin
+
+#endif // RUNTIME_CPU_PROFILER_H
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "CpuProfiler.hpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "Common.h"
+
+using namespace kotlin;
+
+// Not in an anonymous namespace, so that it is in the dynamic symbol table.
+extern "C" NO_INLINE uint64_t CpuProfilerTest_spin(double seconds) {
+    volatile uint64_t result = 0;
+    std::clock_t start = std::clock();
+    while (static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC < seconds) {
+        for (int i = 0; i < 10000; ++i) {
+            result = result * 31 + i;
+        }
+    }
+    return result;
+}
+
+namespace {
+
+volatile std::sig_atomic_t foreignSignals = 0;
+
+void countForeignSignal(int) {
+    foreignSignals = foreignSignals + 1;
+}
+
+// Total number of samples of the collapsed stacks containing `frame`.
+long long countSamples(const KStdString& collapsed, const char* frame) {
+    long long result = 0;
+    size_t lineStart = 0;
+    while (lineStart < collapsed.size()) {
+        size_t lineEnd = collapsed.find('\n', lineStart);
+        KStdString line = collapsed.substr(lineStart, lineEnd - lineStart);
+        size_t space = line.rfind(' ');
+        if (line.find(frame) != KStdString::npos && space != KStdString::npos) {
+            result += std::atoll(line.c_str() + space + 1);
+        }
+        lineStart = lineEnd + 1;
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(CpuProfilerTest, SampleSpin) {
+    profiler::OnRuntimeThreadAttached();
+    profiler::ResetCpuSamples();
+    ASSERT_TRUE(profiler::StartCpuSampling(1000));
+    EXPECT_TRUE(profiler::IsCpuSamplingActive());
+    EXPECT_FALSE(profiler::StartCpuSampling(1000));
+    CpuProfilerTest_spin(0.3);
+    profiler::StopCpuSampling();
+    EXPECT_FALSE(profiler::IsCpuSamplingActive());
+
+    KStdString collapsed = profiler::DumpCpuSamplesCollapsed();
+    // About 300 samples unless the machine is heavily loaded.
+    EXPECT_GT(countSamples(collapsed, "CpuProfilerTest_spin"), 30) << collapsed;
+    EXPECT_EQ(collapsed.back(), '\n');
+
+    // Nothing is sampled after the stop.
+    CpuProfilerTest_spin(0.05);
+    EXPECT_EQ(collapsed, profiler::DumpCpuSamplesCollapsed());
+
+    profiler::ResetCpuSamples();
+    EXPECT_EQ("", profiler::DumpCpuSamplesCollapsed());
+}
+
+TEST(CpuProfilerTest, ChainsForeignSignals) {
+    profiler::OnRuntimeThreadAttached();
+    struct sigaction action = {};
+    action.sa_handler = countForeignSignal;
+    sigemptyset(&action.sa_mask);
+    struct sigaction original;
+    ASSERT_EQ(0, sigaction(SIGPROF, &action, &original));
+    foreignSignals = 0;
+
+    ASSERT_TRUE(profiler::StartCpuSampling(1000));
+    // The thread has no runtime attached, so the signal goes to the handler the profiler has replaced.
+    std::thread([] { raise(SIGPROF); }).join();
+    EXPECT_EQ(1, foreignSignals);
+#if KONAN_LINUX
+    // The threads without a runtime aren't interrupted at all.
+    std::thread([] { CpuProfilerTest_spin(0.1); }).join();
+    EXPECT_EQ(1, foreignSignals);
+#endif
+    profiler::StopCpuSampling();
+
+    ASSERT_EQ(0, sigaction(SIGPROF, &original, nullptr));
+}
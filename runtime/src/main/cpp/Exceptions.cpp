@@ -79,6 +79,76 @@ struct Backtrace {
   ObjHolder arrayHolder;
 };
 
+_Unwind_Ptr getUnwindAddress(struct _Unwind_Context* context) {
+#if (__MINGW32__ || __MINGW64__)
+  return _Unwind_GetRegionStart(context);
+#else
+  return _Unwind_GetIP(context);
+#endif
+}
+
+// Most stack traces fit into this many frames, so they are captured with a single unwinding pass.
+constexpr int kScratchBacktraceSize = 128;
+
+THREAD_LOCAL_VARIABLE KNativePtr scratchBacktraceFrames[kScratchBacktraceSize];
+// Allocating the resulting array may run arbitrary code which captures another stack trace.
+THREAD_LOCAL_VARIABLE bool scratchBacktraceInUse = false;
+
+// Holds the scratch frames for its lifetime, so that they are released when the allocation of the array throws.
+struct ScratchBacktrace {
+  explicit ScratchBacktrace(int skip) : count(0), skipCount(skip), overflow(false) {
+    scratchBacktraceInUse = true;
+  }
+
+  ~ScratchBacktrace() {
+    scratchBacktraceInUse = false;
+  }
+
+  ScratchBacktrace(const ScratchBacktrace&) = delete;
+  ScratchBacktrace& operator=(const ScratchBacktrace&) = delete;
+
+  int count;
+  int skipCount;
+  bool overflow;
+};
+
+_Unwind_Reason_Code scratchUnwindCallback(
+    struct _Unwind_Context* context, void* arg) {
+  ScratchBacktrace* backtrace = reinterpret_cast<ScratchBacktrace*>(arg);
+  if (backtrace->skipCount > 0) {
+    backtrace->skipCount--;
+    return _URC_NO_REASON;
+  }
+  if (backtrace->count == kScratchBacktraceSize) {
+    backtrace->overflow = true;
+    // Stops unwinding.
+    return _URC_END_OF_STACK;
+  }
+  scratchBacktraceFrames[backtrace->count++] = (KNativePtr) getUnwindAddress(context);
+  return _URC_NO_REASON;
+}
+
+struct AddressBuffer {
+  void** addresses;
+  int capacity;
+  int count;
+  int skipCount;
+};
+
+_Unwind_Reason_Code addressBufferCallback(
+    struct _Unwind_Context* context, void* arg) {
+  AddressBuffer* buffer = reinterpret_cast<AddressBuffer*>(arg);
+  if (buffer->skipCount > 0) {
+    buffer->skipCount--;
+    return _URC_NO_REASON;
+  }
+  if (buffer->count == buffer->capacity) {
+    return _URC_END_OF_STACK;
+  }
+  buffer->addresses[buffer->count++] = reinterpret_cast<void*>(getUnwindAddress(context));
+  return _URC_NO_REASON;
+}
+
 _Unwind_Reason_Code depthCountCallback(
     struct _Unwind_Context * context, void* arg) {
   int* result = reinterpret_cast<int*>(arg);
@@ -94,12 +164,7 @@ _Unwind_Reason_Code unwindCallback(
     return _URC_NO_REASON;
   }
 
-#if (__MINGW32__ || __MINGW64__)
-  _Unwind_Ptr address = _Unwind_GetRegionStart(context);
-#else
-  _Unwind_Ptr address = _Unwind_GetIP(context);
-#endif
-  backtrace->setNextElement(address);
+  backtrace->setNextElement(getUnwindAddress(context));
 
   return _URC_NO_REASON;
 }
@@ -117,13 +182,32 @@ SourceInfo getSourceInfo(KConstRef stackTrace, int index) {
 
 // TODO: this implementation is just a hack, e.g. the result is inexact;
 // however it is better to have an inexact stacktrace than not to have any.
-NO_INLINE OBJ_GETTER0(Kotlin_getCurrentStackTrace) {
+NO_INLINE OBJ_GETTER(Kotlin_getCurrentStackTrace, KConstRef throwable) {
 #if OMIT_BACKTRACE
   return AllocArrayInstance(theNativePtrArrayTypeInfo, 0, OBJ_RESULT);
 #else
+  if ((throwable->type_info()->flags_ & TF_NO_STACK_TRACE) != 0) {
+    return AllocArrayInstance(theNativePtrArrayTypeInfo, 0, OBJ_RESULT);
+  }
   // Skips first 2 elements as irrelevant: this function and primary Throwable constructor.
   constexpr int kSkipFrames = 2;
 #if USE_GCC_UNWIND
+  if (!scratchBacktraceInUse) {
+    ScratchBacktrace scratch(kSkipFrames);
+    _Unwind_Backtrace(scratchUnwindCallback, &scratch);
+    if (!scratch.overflow) {
+      ObjHolder resultHolder;
+      ObjHeader* result = AllocArrayInstance(theNativePtrArrayTypeInfo, scratch.count, resultHolder.slot());
+      // TODO: throw cached OOME?
+      RuntimeCheck(result != nullptr, "Cannot create backtrace array");
+      if (scratch.count > 0) {
+        memcpy(PrimitiveArrayAddressOfElementAt<KNativePtr>(result->array(), 0), scratchBacktraceFrames,
+               scratch.count * sizeof(KNativePtr));
+      }
+      RETURN_OBJ(result);
+    }
+  }
+  // The stack is too deep for the scratch buffer: count the frames first.
   int depth = 0;
   _Unwind_Backtrace(depthCountCallback, &depth);
   Backtrace result(depth, kSkipFrames);
@@ -149,6 +233,26 @@ NO_INLINE OBJ_GETTER0(Kotlin_getCurrentStackTrace) {
 #endif  // !OMIT_BACKTRACE
 }
 
+NO_INLINE int CaptureStackTraceAddresses(void** buffer, int capacity, int skip) noexcept {
+#if OMIT_BACKTRACE
+  return 0;
+#elif USE_GCC_UNWIND
+  // Skips this function as well.
+  AddressBuffer addresses = { buffer, capacity, 0, skip + 1 };
+  _Unwind_Backtrace(addressBufferCallback, &addresses);
+  return addresses.count;
+#else
+  const int maxSize = 128;
+  void* frames[maxSize];
+  int size = backtrace(frames, maxSize);
+  int count = 0;
+  for (int index = skip + 1; index < size && count < capacity; ++index) {
+    buffer[count++] = frames[index];
+  }
+  return count;
+#endif  // OMIT_BACKTRACE
+}
+
 OBJ_GETTER(GetStackTraceStrings, KConstRef stackTrace) {
 #if OMIT_BACKTRACE
   ObjHeader* result = AllocArrayInstance(theArrayTypeInfo, 1, OBJ_RESULT);
@@ -23,8 +23,9 @@
 extern "C" {
 #endif
 
-// Returns current stacktrace as Array<String>.
-OBJ_GETTER0(Kotlin_getCurrentStackTrace);
+// Returns current stacktrace as NativePtrArray of return addresses, to be captured by the given throwable.
+// The result is empty if the throwable's type is marked with @NoStackTrace.
+OBJ_GETTER(Kotlin_getCurrentStackTrace, KConstRef throwable);
 
 OBJ_GETTER(GetStackTraceStrings, KConstRef stackTrace);
 
@@ -74,4 +75,8 @@ void PrintThrowable(KRef);
 // It's not always safe to extract SourceInfo during unhandled exception termination.
 void DisallowSourceInfo();
 
+// Writes up to `capacity` return addresses of the current stack into `buffer`, skipping `skip` innermost frames
+// besides this function itself. Doesn't allocate Kotlin objects. Returns the number of addresses written.
+int CaptureStackTraceAddresses(void** buffer, int capacity, int skip) noexcept;
+
 #endif // RUNTIME_NAMES_H
@@ -23,15 +23,18 @@
 #include <dlfcn.h>
 #include <elf.h>
 #include <fcntl.h>
+#include <link.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
-#include <vector>
+#include <algorithm>
 
 #include "KAssert.h"
+#include "Mutex.hpp"
 
 namespace {
 
@@ -51,93 +54,175 @@ namespace {
 #error "Impossible ELFSIZE"
 #endif
 
-struct SymRecord {
-  Elf_Sym* symtabBegin;
-  Elf_Sym* symtabEnd;
-  char* strtab;
-};
-
-typedef KStdVector<SymRecord> SymRecordList;
-
-SymRecordList* symbols = nullptr;
-
 // Unfortunately, symbol tables are stored in ELF sections not mapped
 // during regular execution, so we have to map binary ourselves.
 Elf_Ehdr* findElfHeader() {
   int fd = open("/proc/self/exe", O_RDONLY);
   if (fd < 0) return nullptr;
   struct stat fd_stat;
-  if (fstat(fd, &fd_stat) < 0) return nullptr;
+  if (fstat(fd, &fd_stat) < 0) {
+    close(fd);
+    return nullptr;
+  }
   void* result = mmap(nullptr, fd_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
   if (result == MAP_FAILED) return nullptr;
   return (Elf_Ehdr*)result;
 }
 
-void initSymbols() {
-  RuntimeAssert(symbols == nullptr, "Init twice");
-  symbols = konanConstructInstance<SymRecordList>();
-  Elf_Ehdr* ehdr = findElfHeader();
-  if (ehdr == nullptr) return;
-  RuntimeAssert(strncmp((const char*)ehdr->e_ident, ELFMAG, SELFMAG) == 0, "Must be an ELF");
-  char* mapAddress = (char*)ehdr;
-  Elf_Shdr* shdr = (Elf_Shdr*)(mapAddress + ehdr->e_shoff);
-  for (int i = 0; i < ehdr->e_shnum; i++) {
-    if (shdr[i].sh_type == SHT_SYMTAB) {   // Static symbol table.
-      SymRecord record;
-      record.symtabBegin = (Elf_Sym*)(mapAddress + shdr[i].sh_offset);
-      record.symtabEnd = (Elf_Sym*)((char*)record.symtabBegin + shdr[i].sh_size);
-      record.strtab = (char *)(mapAddress + shdr[shdr[i].sh_link].sh_offset);
-      symbols->push_back(record);
+int mainProgramCallback(struct dl_phdr_info* info, size_t size, void* data) {
+  *reinterpret_cast<uintptr_t*>(data) = info->dlpi_addr;
+  // The main program always comes first.
+  return 1;
+}
+
+// Difference between the run-time and the link-time addresses of the executable, non-zero for PIE.
+uintptr_t findLoadBias() {
+  uintptr_t bias = 0;
+  dl_iterate_phdr(mainProgramCallback, &bias);
+  return bias;
+}
+
+struct SymbolRange {
+  uintptr_t start;
+  uintptr_t end;
+  const char* name;
+};
+
+// Address ranges of all sized symbols from the static and dynamic symbol tables of the executable,
+// sorted by the start address for binary search.
+class SymbolIndex {
+ public:
+  SymbolIndex() {
+    Elf_Ehdr* ehdr = findElfHeader();
+    if (ehdr == nullptr) return;
+    RuntimeAssert(strncmp((const char*)ehdr->e_ident, ELFMAG, SELFMAG) == 0, "Must be an ELF");
+    char* mapAddress = (char*)ehdr;
+    uintptr_t bias = findLoadBias();
+    Elf_Shdr* shdr = (Elf_Shdr*)(mapAddress + ehdr->e_shoff);
+    for (int i = 0; i < ehdr->e_shnum; i++) {
+      // Static and dynamic symbol tables.
+      if (shdr[i].sh_type != SHT_SYMTAB && shdr[i].sh_type != SHT_DYNSYM) continue;
+      Elf_Sym* begin = (Elf_Sym*)(mapAddress + shdr[i].sh_offset);
+      Elf_Sym* end = (Elf_Sym*)((char*)begin + shdr[i].sh_size);
+      char* strtab = (char*)(mapAddress + shdr[shdr[i].sh_link].sh_offset);
+      for (Elf_Sym* symbol = begin; symbol < end; symbol++) {
+        if (symbol->st_size == 0) continue;
+        uintptr_t start = symbol->st_value + bias;
+        ranges.push_back({start, start + symbol->st_size, &strtab[symbol->st_name]});
+      }
     }
-    if (shdr[i].sh_type == SHT_DYNSYM) {   // Dynamic symbol table.
-      SymRecord record;
-      record.symtabBegin = (Elf_Sym*)(mapAddress + shdr[i].sh_offset);
-      record.symtabEnd = (Elf_Sym*)((char*)record.symtabBegin + shdr[i].sh_size);
-      record.strtab = (char*)(mapAddress + shdr[shdr[i].sh_link].sh_offset);
-      symbols->push_back(record);
+    // Symbols starting at the same address are usually aliases, the first one wins.
+    std::stable_sort(ranges.begin(), ranges.end(), [](const SymbolRange& lhs, const SymbolRange& rhs) {
+      return lhs.start < rhs.start;
+    });
+    ranges.erase(std::unique(ranges.begin(), ranges.end(), [](const SymbolRange& lhs, const SymbolRange& rhs) {
+      return lhs.start == rhs.start;
+    }), ranges.end());
+    maxEnds.reserve(ranges.size());
+    uintptr_t maxEnd = 0;
+    for (auto& range : ranges) {
+      maxEnd = std::max(maxEnd, range.end);
+      maxEnds.push_back(maxEnd);
     }
   }
-}
 
-const char* addressToSymbol(const void* address) {
-  if (address == nullptr) return nullptr;
+  // Returns the innermost symbol containing the address.
+  const char* find(uintptr_t address) const {
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), address, [](uintptr_t address, const SymbolRange& range) {
+      return address < range.start;
+    });
+    // Ranges may nest, so walk back while some earlier range may still cover the address.
+    for (size_t index = it - ranges.begin(); index > 0 && maxEnds[index - 1] > address; index--) {
+      if (address < ranges[index - 1].end) return ranges[index - 1].name;
+    }
+    return nullptr;
+  }
+
+ private:
+  KStdVector<SymbolRange> ranges;
+  // maxEnds[i] is the maximum end of ranges[0..i].
+  KStdVector<uintptr_t> maxEnds;
+};
 
+// Recently symbolized addresses, including the ones without a symbol.
+class SymbolCache {
+ public:
+  bool lookup(uintptr_t address, char* resultBuffer, size_t resultBufferSize, bool* found) {
+    LockGuard<SimpleMutex> guard(mutex);
+    auto it = index.find(address);
+    if (it == index.end()) return false;
+    // Move to the front as the most recently used.
+    entries.splice(entries.begin(), entries, it->second);
+    *found = it->second->found;
+    if (*found) copySymbol(it->second->symbol.c_str(), resultBuffer, resultBufferSize);
+    return true;
+  }
+
+  void put(uintptr_t address, const char* symbol) {
+    LockGuard<SimpleMutex> guard(mutex);
+    if (index.find(address) != index.end()) return;
+    // Copy the name, the library it comes from may be unloaded later.
+    entries.push_front({address, symbol != nullptr ? symbol : "", symbol != nullptr});
+    index[address] = entries.begin();
+    if (entries.size() > kCapacity) {
+      index.erase(entries.back().address);
+      entries.pop_back();
+    }
+  }
+
+  static void copySymbol(const char* symbol, char* resultBuffer, size_t resultBufferSize) {
+    strncpy(resultBuffer, symbol, resultBufferSize);
+    resultBuffer[resultBufferSize - 1] = '\0';
+  }
+
+ private:
+  static constexpr size_t kCapacity = 1024;
+
+  struct Entry {
+    uintptr_t address;
+    KStdString symbol;
+    bool found;
+  };
+
+  SimpleMutex mutex;
+  // Most recently used first.
+  KStdList<Entry> entries;
+  KStdUnorderedMap<uintptr_t, KStdList<Entry>::iterator> index;
+};
+
+const char* addressToSymbol(const void* address) {
   // First, look up in dynamically loaded symbols.
   Dl_info info;
   if (dladdr(address, &info) != 0 && info.dli_sname != nullptr) {
     return info.dli_sname;
   }
 
-  // Otherwise, consult symbol table of the file.
-  if (symbols == nullptr) {
-    initSymbols();
-  }
-
-  unsigned long addressValue = (unsigned long)address;
+  // Otherwise, consult symbol table of the file. Built once, on the first use.
+  static SymbolIndex* symbols = konanConstructInstance<SymbolIndex>();
+  return symbols->find((uintptr_t)address);
+}
 
-  for (auto record : *symbols) {
-    auto begin = record.symtabBegin;
-    auto end = record.symtabEnd;
-    while (begin < end) {
-      // st_value is load address adjusted.
-      if (addressValue >= begin->st_value && addressValue < begin->st_value + begin->st_size) {
-        return &record.strtab[begin->st_name];
-      }
-      begin++;
-    }
-  }
-  return nullptr;
+SymbolCache* symbolCache() {
+  static SymbolCache* cache = konanConstructInstance<SymbolCache>();
+  return cache;
 }
 
 }  // namespace
 
 extern "C" bool AddressToSymbol(const void* address, char* resultBuffer, size_t resultBufferSize) {
+  if (address == nullptr) return false;
+  bool found = false;
+  if (symbolCache()->lookup((uintptr_t)address, resultBuffer, resultBufferSize, &found)) {
+    return found;
+  }
   const char* result = addressToSymbol(address);
+  symbolCache()->put((uintptr_t)address, result);
   if (result == nullptr) {
     return false;
   } else {
-    strncpy(resultBuffer, result, resultBufferSize);
-    resultBuffer[resultBufferSize - 1] = '\0';
+    SymbolCache::copySymbol(result, resultBuffer, resultBufferSize);
     return true;
   }
 }
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "ExecFormat.h"
+
+#include <cstring>
+
+#include "Common.h"
+
+#include "gtest/gtest.h"
+
+extern "C" NO_INLINE int Kotlin_ExecFormatTest_function(int x) {
+    return x * 31 + 7;
+}
+
+#if USE_ELF_SYMBOLS
+
+TEST(ExecFormatTest, AddressToSymbol) {
+    auto address = reinterpret_cast<const char*>(&Kotlin_ExecFormatTest_function);
+    char symbol[256];
+    ASSERT_TRUE(AddressToSymbol(address, symbol, sizeof(symbol)));
+    EXPECT_STREQ("Kotlin_ExecFormatTest_function", symbol);
+    // An address inside the function, as a return address would be.
+    ASSERT_TRUE(AddressToSymbol(address + 1, symbol, sizeof(symbol)));
+    EXPECT_STREQ("Kotlin_ExecFormatTest_function", symbol);
+    // Cached result.
+    memset(symbol, 0, sizeof(symbol));
+    ASSERT_TRUE(AddressToSymbol(address, symbol, sizeof(symbol)));
+    EXPECT_STREQ("Kotlin_ExecFormatTest_function", symbol);
+}
+
+TEST(ExecFormatTest, Truncation) {
+    auto address = reinterpret_cast<const char*>(&Kotlin_ExecFormatTest_function);
+    char symbol[7];
+    ASSERT_TRUE(AddressToSymbol(address, symbol, sizeof(symbol)));
+    EXPECT_STREQ("Kotlin", symbol);
+}
+
+#endif // USE_ELF_SYMBOLS
+
+TEST(ExecFormatTest, NoSymbol) {
+    char symbol[256];
+    EXPECT_FALSE(AddressToSymbol(nullptr, symbol, sizeof(symbol)));
+    EXPECT_FALSE(AddressToSymbol(reinterpret_cast<const void*>(16), symbol, sizeof(symbol)));
+}
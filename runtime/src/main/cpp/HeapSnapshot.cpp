@@ -0,0 +1,159 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "HeapSnapshot.hpp"
+
+#include <cstring>
+
+#include "KAssert.h"
+#include "Natives.h"
+#include "Porting.h"
+#include "TypeInfo.h"
+
+using namespace kotlin;
+
+namespace {
+
+constexpr char kMagic[] = "KNHEAP";
+constexpr size_t kBufferSize = 64 * 1024;
+constexpr uint32_t kObjectAlignment = 8;
+
+uint64_t objectSize(const ObjHeader* object) noexcept {
+    const TypeInfo* typeInfo = object->type_info();
+    uint64_t size = typeInfo->instanceSize_ >= 0
+            ? typeInfo->instanceSize_
+            : sizeof(ArrayHeader) - static_cast<int64_t>(typeInfo->instanceSize_) * object->array()->count_;
+    return (size + kObjectAlignment - 1) & ~static_cast<uint64_t>(kObjectAlignment - 1);
+}
+
+template <typename F>
+void traverseReferences(ObjHeader* object, F process) noexcept {
+    const TypeInfo* typeInfo = object->type_info();
+    if (typeInfo == theArrayTypeInfo) {
+        ArrayHeader* array = object->array();
+        for (uint32_t index = 0; index < array->count_; ++index) {
+            process(*ArrayAddressOfElementAt(array, index));
+        }
+        return;
+    }
+    for (int32_t index = 0; index < typeInfo->objOffsetsCount_; ++index) {
+        process(*reinterpret_cast<ObjHeader**>(reinterpret_cast<uintptr_t>(object) + typeInfo->objOffsets_[index]));
+    }
+}
+
+uint32_t referenceCount(const ObjHeader* object) noexcept {
+    const TypeInfo* typeInfo = object->type_info();
+    return typeInfo == theArrayTypeInfo ? object->array()->count_ : typeInfo->objOffsetsCount_;
+}
+
+} // namespace
+
+HeapSnapshotWriter::HeapSnapshotWriter(const char* path) noexcept : file_(fopen(path, "wb")) {
+    if (file_ == nullptr) return;
+    setvbuf(file_, nullptr, _IOFBF, kBufferSize);
+    fwrite(kMagic, 1, sizeof(kMagic) - 1, file_);
+    WriteByte(kVersion);
+}
+
+HeapSnapshotWriter::~HeapSnapshotWriter() {
+    if (file_ != nullptr) fclose(file_);
+}
+
+void HeapSnapshotWriter::WriteRoot(RootKind kind, const ObjHeader* object) noexcept {
+    WriteByte(kTagRoot);
+    WriteByte(kind);
+    WriteVarint(reinterpret_cast<uintptr_t>(object));
+}
+
+void HeapSnapshotWriter::WriteObject(ObjHeader* object, int64_t refCount) noexcept {
+    const TypeInfo* typeInfo = object->type_info();
+    if (writtenTypes_.insert(typeInfo).second) WriteType(typeInfo);
+    WriteByte(kTagObject);
+    WriteVarint(reinterpret_cast<uintptr_t>(object));
+    WriteVarint(reinterpret_cast<uintptr_t>(typeInfo));
+    WriteVarint(objectSize(object));
+    WriteVarint(refCount == kUnknownRefCount ? 0 : refCount + 1);
+    WriteVarint(referenceCount(object));
+    traverseReferences(object, [this](ObjHeader* reference) { WriteVarint(reinterpret_cast<uintptr_t>(reference)); });
+}
+
+void HeapSnapshotWriter::WriteReachableObjects(const KStdVector<ObjHeader*>& roots) noexcept {
+    // Objects are marked as visited when they are queued, so each one is queued at most once, rather than once
+    // per incoming reference.
+    KStdUnorderedSet<ObjHeader*> visited;
+    KStdVector<ObjHeader*> toVisit;
+    auto enqueue = [&visited, &toVisit](ObjHeader* object) {
+        if (object != nullptr && visited.insert(object).second) toVisit.push_back(object);
+    };
+    for (ObjHeader* root : roots) {
+        enqueue(root);
+    }
+    while (!toVisit.empty()) {
+        ObjHeader* object = toVisit.back();
+        toVisit.pop_back();
+        WriteObject(object, kUnknownRefCount);
+        traverseReferences(object, enqueue);
+    }
+}
+
+bool HeapSnapshotWriter::Finish() noexcept {
+    RuntimeAssert(file_ != nullptr, "Snapshot file must be open");
+    WriteByte(kTagEnd);
+    bool result = ferror(file_) == 0;
+    result = fclose(file_) == 0 && result;
+    file_ = nullptr;
+    return result;
+}
+
+void HeapSnapshotWriter::WriteType(const TypeInfo* typeInfo) noexcept {
+    WriteByte(kTagType);
+    WriteVarint(reinterpret_cast<uintptr_t>(typeInfo));
+    KStdString name = TypeName(typeInfo);
+    WriteString(name.data(), name.size());
+    int64_t instanceSize = typeInfo->instanceSize_;
+    WriteVarint((static_cast<uint64_t>(instanceSize) << 1) ^ static_cast<uint64_t>(instanceSize >> 63));
+    if (typeInfo == theArrayTypeInfo) {
+        // The references of arrays are the elements.
+        WriteVarint(0);
+        return;
+    }
+    WriteVarint(typeInfo->objOffsetsCount_);
+    const ExtendedTypeInfo* extendedInfo = typeInfo->extendedInfo_;
+    for (int32_t index = 0; index < typeInfo->objOffsetsCount_; ++index) {
+        int32_t offset = typeInfo->objOffsets_[index];
+        const char* fieldName = nullptr;
+        if (extendedInfo != nullptr) {
+            for (int32_t field = 0; field < extendedInfo->fieldsCount_; ++field) {
+                if (extendedInfo->fieldOffsets_[field] == offset) {
+                    fieldName = extendedInfo->fieldNames_[field];
+                    break;
+                }
+            }
+        }
+        char buffer[32];
+        if (fieldName == nullptr) {
+            konan::snprintf(buffer, sizeof(buffer), "@%d", offset);
+            fieldName = buffer;
+        }
+        WriteString(fieldName, strlen(fieldName));
+    }
+}
+
+void HeapSnapshotWriter::WriteByte(uint8_t value) noexcept {
+    putc(value, file_);
+}
+
+void HeapSnapshotWriter::WriteVarint(uint64_t value) noexcept {
+    while (value >= 0x80) {
+        putc(static_cast<int>((value & 0x7f) | 0x80), file_);
+        value >>= 7;
+    }
+    putc(static_cast<int>(value), file_);
+}
+
+void HeapSnapshotWriter::WriteString(const char* string, size_t length) noexcept {
+    WriteVarint(length);
+    fwrite(string, 1, length, file_);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_HEAP_SNAPSHOT_H
+#define RUNTIME_HEAP_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+
+#include "Memory.h"
+#include "Types.h"
+#include "Utils.hpp"
+
+namespace kotlin {
+
+// Writer of heap snapshots, analyzed offline by tools/scripts/heap_snapshot.py.
+//
+// The snapshot is streamed to the file as the objects are visited. It starts with the magic "KNHEAP" and
+// the format version byte, followed by records. All the integers are unsigned LEB128, the strings are
+// a length followed by UTF-8 bytes. A record starts with its tag:
+//   kTagType:   id, name, instance size (negated element size for arrays, zigzag-encoded),
+//               number of reference fields, their names in the order of the references of the objects.
+//               Written before the first object of the type.
+//   kTagObject: address, type id, size, reference count + 1 (0 if unknown),
+//               number of references, addresses of the referred objects (0 for null).
+//   kTagRoot:   root kind, address of the object.
+//   kTagEnd:    the last record.
+// The references of an object may point to objects outside the snapshot, e.g. to the ones owned by other threads.
+class HeapSnapshotWriter : private Pinned {
+public:
+    enum Tag : uint8_t {
+        kTagEnd = 0,
+        kTagType = 1,
+        kTagObject = 2,
+        kTagRoot = 3,
+    };
+
+    enum RootKind : uint8_t {
+        kRootGlobal = 1,
+        kRootThreadLocal = 2,
+        kRootStack = 3,
+    };
+
+    static constexpr uint8_t kVersion = 1;
+    static constexpr int64_t kUnknownRefCount = -1;
+
+    explicit HeapSnapshotWriter(const char* path) noexcept;
+    ~HeapSnapshotWriter();
+
+    bool ok() const noexcept { return file_ != nullptr; }
+
+    void WriteRoot(RootKind kind, const ObjHeader* object) noexcept;
+    void WriteObject(ObjHeader* object, int64_t refCount) noexcept;
+    // Writes all the objects reachable from `roots`, for the memory managers which can't enumerate their heap.
+    // Objects have no spare header bit to mark them with, so the visited ones are kept in a hash set: this takes
+    // a set entry and at most one work list slot per reachable object, some tens of bytes each.
+    void WriteReachableObjects(const KStdVector<ObjHeader*>& roots) noexcept;
+    // Writes the end record and closes the file. Returns false if any write has failed.
+    bool Finish() noexcept;
+
+private:
+    void WriteType(const TypeInfo* typeInfo) noexcept;
+    void WriteByte(uint8_t value) noexcept;
+    void WriteVarint(uint64_t value) noexcept;
+    void WriteString(const char* string, size_t length) noexcept;
+
+    FILE* file_;
+    KStdUnorderedSet<const TypeInfo*> writtenTypes_;
+};
+
+} // namespace kotlin
+
+#endif // RUNTIME_HEAP_SNAPSHOT_H
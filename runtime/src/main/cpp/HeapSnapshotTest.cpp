@@ -0,0 +1,162 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "HeapSnapshot.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "TypeInfo.h"
+
+using namespace kotlin;
+
+namespace {
+
+struct Node {
+    ObjHeader header;
+    ObjHeader* left;
+    ObjHeader* right;
+
+    ObjHeader* obj() { return &header; }
+};
+
+// Just enough to check the records.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    bool ReadHeader() { return data_.compare(0, 6, "KNHEAP") == 0 && (position_ = 6, Byte() == 1); }
+
+    uint8_t Byte() { return static_cast<uint8_t>(data_.at(position_++)); }
+
+    uint64_t Varint() {
+        uint64_t result = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t value = Byte();
+            result |= static_cast<uint64_t>(value & 0x7f) << shift;
+            if (value < 0x80) return result;
+        }
+    }
+
+    std::string String() {
+        uint64_t length = Varint();
+        std::string result = data_.substr(position_, length);
+        position_ += length;
+        return result;
+    }
+
+private:
+    std::string data_;
+    size_t position_ = 0;
+};
+
+class HeapSnapshotTest : public testing::Test {
+public:
+    HeapSnapshotTest() {
+        typeInfo_.typeInfo_ = &typeInfo_;
+        typeInfo_.instanceSize_ = sizeof(Node);
+        typeInfo_.objOffsets_ = offsets_;
+        typeInfo_.objOffsetsCount_ = 2;
+        typeInfo_.extendedInfo_ = &extendedInfo_;
+        extendedInfo_.fieldsCount_ = 2;
+        extendedInfo_.fieldOffsets_ = offsets_;
+        extendedInfo_.fieldNames_ = fieldNames_;
+        for (auto& node : nodes_) {
+            node.header.typeInfoOrMeta_ = &typeInfo_;
+        }
+    }
+
+    ~HeapSnapshotTest() { std::remove(path_.c_str()); }
+
+    Node& node(int index) { return nodes_[index]; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_ = testing::TempDir() + "HeapSnapshotTest.knheap";
+    int32_t offsets_[2] = {offsetof(Node, left), offsetof(Node, right)};
+    const char* fieldNames_[2] = {"left", "right"};
+    ExtendedTypeInfo extendedInfo_ = {};
+    TypeInfo typeInfo_ = {};
+    Node nodes_[4] = {};
+};
+
+} // namespace
+
+TEST_F(HeapSnapshotTest, ReachableObjects) {
+    node(0).left = node(1).obj();
+    node(0).right = node(2).obj();
+    node(1).right = node(2).obj();
+    node(2).left = node(0).obj();
+    // node(3) is unreachable.
+    node(3).left = node(0).obj();
+
+    HeapSnapshotWriter writer(path().c_str());
+    ASSERT_TRUE(writer.ok());
+    writer.WriteRoot(HeapSnapshotWriter::kRootGlobal, node(0).obj());
+    writer.WriteReachableObjects({node(0).obj()});
+    ASSERT_TRUE(writer.Finish());
+
+    SnapshotReader reader(path());
+    ASSERT_TRUE(reader.ReadHeader());
+    int types = 0;
+    std::vector<uint64_t> roots;
+    std::map<uint64_t, std::vector<uint64_t>> objects;
+    for (bool end = false; !end;) {
+        switch (reader.Byte()) {
+            case HeapSnapshotWriter::kTagEnd:
+                end = true;
+                break;
+            case HeapSnapshotWriter::kTagType: {
+                ++types;
+                reader.Varint();
+                EXPECT_EQ("<anonymous>", reader.String());
+                EXPECT_EQ(sizeof(Node) * 2, reader.Varint());
+                ASSERT_EQ(2u, reader.Varint());
+                EXPECT_EQ("left", reader.String());
+                EXPECT_EQ("right", reader.String());
+                break;
+            }
+            case HeapSnapshotWriter::kTagObject: {
+                uint64_t address = reader.Varint();
+                reader.Varint();
+                EXPECT_EQ(sizeof(Node), reader.Varint());
+                // Unknown reference count.
+                EXPECT_EQ(0u, reader.Varint());
+                auto& references = objects[address];
+                for (uint64_t count = reader.Varint(); count > 0; --count) {
+                    references.push_back(reader.Varint());
+                }
+                break;
+            }
+            case HeapSnapshotWriter::kTagRoot:
+                EXPECT_EQ(HeapSnapshotWriter::kRootGlobal, reader.Byte());
+                roots.push_back(reader.Varint());
+                break;
+            default:
+                FAIL() << "Unknown record";
+        }
+    }
+    auto address = [this](int index) { return reinterpret_cast<uintptr_t>(node(index).obj()); };
+    EXPECT_EQ(1, types);
+    EXPECT_EQ(std::vector<uint64_t>({address(0)}), roots);
+    ASSERT_EQ(3u, objects.size());
+    EXPECT_EQ(std::vector<uint64_t>({address(1), address(2)}), objects[address(0)]);
+    EXPECT_EQ(std::vector<uint64_t>({0, address(2)}), objects[address(1)]);
+    EXPECT_EQ(std::vector<uint64_t>({address(0), 0}), objects[address(2)]);
+}
+
+TEST_F(HeapSnapshotTest, CannotOpen) {
+    HeapSnapshotWriter writer("/nonexistent/directory/snapshot.knheap");
+    EXPECT_FALSE(writer.ok());
+}
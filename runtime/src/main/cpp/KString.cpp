@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <limits>
 #include <string.h>
 
@@ -44,9 +45,12 @@ KStdStringInserter utf16toUtf8OrThrow(const KChar* start, const KChar* end, KStd
 template<utf8to16 conversion>
 OBJ_GETTER(utf8ToUtf16Impl, const char* rawString, const char* end, uint32_t charCount) {
   if (rawString == nullptr) RETURN_OBJ(nullptr);
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, charCount, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, charCount, OBJ_RESULT)->array();
   KChar* rawResult = CharArrayAddressOfElementAt(result, 0);
-  conversion(rawString, end, rawResult);
+  KChar* rawResultEnd = conversion(rawString, end, rawResult);
+  RuntimeAssert(rawResultEnd <= rawResult + charCount, "Conversion overflowed the string");
+  // The string is not zeroed, so make sure nothing is left uninitialized.
+  std::fill(rawResultEnd, rawResult + charCount, 0);
   RETURN_OBJ(result->obj());
 }
 
@@ -57,7 +61,7 @@ OBJ_GETTER(unsafeUtf16ToUtf8Impl, KString thiz, KInt start, KInt size) {
   KStdString utf8;
   utf8.reserve(size);
   conversion(utf16, utf16 + size, back_inserter(utf8));
-  ArrayHeader* result = AllocArrayInstance(theByteArrayTypeInfo, utf8.size(), OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theByteArrayTypeInfo, utf8.size(), OBJ_RESULT)->array();
   ::memcpy(ByteArrayAddressOfElementAt(result, 0), utf8.c_str(), utf8.size());
   RETURN_OBJ(result->obj());
 }
@@ -731,7 +735,7 @@ void DisposeCString(char* cstring) {
 // String.kt
 OBJ_GETTER(Kotlin_String_replace, KString thiz, KChar oldChar, KChar newChar, KBoolean ignoreCase) {
   auto count = thiz->count_;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   KChar* resultRaw = CharArrayAddressOfElementAt(result, 0);
   if (ignoreCase) {
@@ -761,7 +765,7 @@ OBJ_GETTER(Kotlin_String_plusImpl, KString thiz, KString other) {
   if (result_length > static_cast<uint32_t>(std::numeric_limits<int32_t>::max())) {
     ThrowArrayIndexOutOfBoundsException();
   }
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, result_length, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, result_length, OBJ_RESULT)->array();
   memcpy(
       CharArrayAddressOfElementAt(result, 0),
       CharArrayAddressOfElementAt(thiz, 0),
@@ -775,7 +779,7 @@ OBJ_GETTER(Kotlin_String_plusImpl, KString thiz, KString other) {
 
 OBJ_GETTER(Kotlin_String_toUpperCase, KString thiz) {
   auto count = thiz->count_;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   KChar* resultRaw = CharArrayAddressOfElementAt(result, 0);
   for (uint32_t index = 0; index < count; ++index) {
@@ -786,7 +790,7 @@ OBJ_GETTER(Kotlin_String_toUpperCase, KString thiz) {
 
 OBJ_GETTER(Kotlin_String_toLowerCase, KString thiz) {
   auto count = thiz->count_;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, count, OBJ_RESULT)->array();
   const KChar* thizRaw = CharArrayAddressOfElementAt(thiz, 0);
   KChar* resultRaw = CharArrayAddressOfElementAt(result, 0);
   for (uint32_t index = 0; index < count; ++index) {
@@ -803,7 +807,7 @@ OBJ_GETTER(Kotlin_String_unsafeStringFromCharArray, KConstRef thiz, KInt start,
     RETURN_RESULT_OF0(TheEmptyString);
   }
 
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, size, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, size, OBJ_RESULT)->array();
   memcpy(CharArrayAddressOfElementAt(result, 0),
          CharArrayAddressOfElementAt(array, start),
          size * sizeof(KChar));
@@ -811,7 +815,7 @@ OBJ_GETTER(Kotlin_String_unsafeStringFromCharArray, KConstRef thiz, KInt start,
 }
 
 OBJ_GETTER(Kotlin_String_toCharArray, KString string, KInt start, KInt size) {
-  ArrayHeader* result = AllocArrayInstance(theCharArrayTypeInfo, size, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theCharArrayTypeInfo, size, OBJ_RESULT)->array();
   memcpy(CharArrayAddressOfElementAt(result, 0),
          CharArrayAddressOfElementAt(string, start),
          size * sizeof(KChar));
@@ -827,7 +831,7 @@ OBJ_GETTER(Kotlin_String_subSequence, KString thiz, KInt startIndex, KInt endInd
     RETURN_RESULT_OF0(TheEmptyString);
   }
   KInt length = endIndex - startIndex;
-  ArrayHeader* result = AllocArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
+  ArrayHeader* result = AllocUninitializedArrayInstance(theStringTypeInfo, length, OBJ_RESULT)->array();
   memcpy(CharArrayAddressOfElementAt(result, 0),
          CharArrayAddressOfElementAt(thiz, startIndex),
          length * sizeof(KChar));
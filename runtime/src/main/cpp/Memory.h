@@ -125,6 +125,9 @@ struct MemoryState;
 MemoryState* InitMemory(bool firstRuntime);
 void DeinitMemory(MemoryState*, bool destroyRuntime);
 void RestoreMemory(MemoryState*);
+// Unbind the memory state from the current thread, so that another thread can `RestoreMemory` it later.
+// Returns false and does nothing if the memory manager cannot move memory states between threads.
+bool DetachMemory(MemoryState*);
 
 //
 // Object allocation.
@@ -142,6 +145,10 @@ OBJ_GETTER(AllocInstance, const TypeInfo* type_info) RUNTIME_NOTHROW;
 
 OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements);
 
+// Same as AllocArrayInstance, but the elements are not zeroed. Only for arrays of primitives, and the caller
+// must write every element before the array can be observed by anyone else.
+OBJ_GETTER(AllocUninitializedArrayInstance, const TypeInfo* type_info, int32_t elements);
+
 OBJ_GETTER(InitThreadLocalSingleton, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
 
 OBJ_GETTER(InitSingleton, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*));
@@ -192,6 +199,10 @@ void UpdateStackRef(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHR
 void UpdateHeapRef(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
 // Updates location if it is null, atomically.
 void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader* object) RUNTIME_NOTHROW;
+// Updates `count` heap locations starting at `destination` with the values from `source`, as memmove() does.
+void UpdateHeapRefsRange(ObjHeader** destination, ObjHeader* const* source, uint32_t count) RUNTIME_NOTHROW;
+// Updates `count` heap locations starting at `destination` with `object`.
+void FillHeapRefsRange(ObjHeader** destination, const ObjHeader* object, uint32_t count) RUNTIME_NOTHROW;
 // Updates reference in return slot.
 void UpdateReturnRef(ObjHeader** returnSlot, const ObjHeader* object) RUNTIME_NOTHROW;
 // Compares and swaps reference with taken lock.
@@ -203,6 +214,9 @@ void SetHeapRefLocked(ObjHeader** location, ObjHeader* newValue, int32_t* spinlo
     int32_t* cookie) RUNTIME_NOTHROW;
 // Reads reference with taken lock.
 OBJ_GETTER(ReadHeapRefLocked, ObjHeader** location, int32_t* spinlock, int32_t* cookie) RUNTIME_NOTHROW;
+// Reads reference without taking a lock. `readers` counts threads in the middle of the read: whoever clears
+// the location must wait for it to drop to zero before the old value may be freed.
+OBJ_GETTER(ReadHeapRefLockFree, ObjHeader** location, int32_t* readers, int32_t* cookie) RUNTIME_NOTHROW;
 // Called on frame enter, if it has object slots.
 void EnterFrame(ObjHeader** start, int parameters, int count) RUNTIME_NOTHROW;
 // Called on frame leave, if it has object slots.
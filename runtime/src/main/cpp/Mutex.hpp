@@ -32,6 +32,10 @@ class SimpleMutex {
     }
   }
 
+  bool try_lock() {
+    return __sync_bool_compare_and_swap(&atomicInt, 0, 1);
+  }
+
   void unlock() {
     if (!__sync_bool_compare_and_swap(&atomicInt, 1, 0)) {
       RuntimeAssert(false, "Unable to unlock");
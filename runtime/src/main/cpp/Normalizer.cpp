@@ -0,0 +1,933 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Normalizer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "KAssert.h"
+#include "Utils.hpp"
+
+using namespace kotlin;
+
+namespace {
+
+/* Contains canonical classes (see http://www.unicode.org/Public/4.0-Update/UnicodeData-4.0.0.txt). */
+constexpr KInt canonicalClassesKeys[] = {
+  768, 769, 770, 771, 772, 773, 774, 775, 776, 777, 778, 779, 780, 781, 782, 783, 784, 785, 786, 787, 788, 789, 790,
+  791, 792, 793, 794, 795, 796, 797, 798, 799, 800, 801, 802, 803, 804, 805, 806, 807, 808, 809, 810, 811, 812, 813,
+  814, 815, 816, 817, 818, 819, 820, 821, 822, 823, 824, 825, 826, 827, 828, 829, 830, 831, 832, 833, 834, 835, 836,
+  837, 838, 839, 840, 841, 842, 843, 844, 845, 846, 848, 849, 850, 851, 852, 853, 854, 855, 856, 857, 858, 859, 860,
+  861, 862, 863, 864, 865, 866, 867, 868, 869, 870, 871, 872, 873, 874, 875, 876, 877, 878, 879, 1155, 1156, 1157, 1158,
+  1425, 1426, 1427, 1428, 1429, 1430, 1431, 1432, 1433, 1434, 1435, 1436, 1437, 1438, 1439, 1440, 1441, 1442, 1443,
+  1444, 1445, 1446, 1447, 1448, 1449, 1450, 1451, 1452, 1453, 1454, 1455, 1456, 1457, 1458, 1459, 1460, 1461, 1462,
+  1463, 1464, 1465, 1467, 1468, 1469, 1471, 1473, 1474, 1476, 1477, 1479, 1552, 1553, 1554, 1555, 1556, 1557, 1611,
+  1612, 1613, 1614, 1615, 1616, 1617, 1618, 1619, 1620, 1621, 1622, 1623, 1624, 1625, 1626, 1627, 1628, 1629, 1630,
+  1648, 1750, 1751, 1752, 1753, 1754, 1755, 1756, 1759, 1760, 1761, 1762, 1763, 1764, 1767, 1768, 1770, 1771, 1772,
+  1773, 1809, 1840, 1841, 1842, 1843, 1844, 1845, 1846, 1847, 1848, 1849, 1850, 1851, 1852, 1853, 1854, 1855, 1856,
+  1857, 1858, 1859, 1860, 1861, 1862, 1863, 1864, 1865, 1866, 2364, 2381, 2385, 2386, 2387, 2388, 2492, 2509, 2620,
+  2637, 2748, 2765, 2876, 2893, 3021, 3149, 3157, 3158, 3260, 3277, 3405, 3530, 3640, 3641, 3642, 3656, 3657, 3658,
+  3659, 3768, 3769, 3784, 3785, 3786, 3787, 3864, 3865, 3893, 3895, 3897, 3953, 3954, 3956, 3962, 3963, 3964, 3965,
+  3968, 3970, 3971, 3972, 3974, 3975, 4038, 4151, 4153, 4959, 5908, 5940, 6098, 6109, 6313, 6457, 6458, 6459, 6679,
+  6680, 7616, 7617, 7618, 7619, 8400, 8401, 8402, 8403, 8404, 8405, 8406, 8407, 8408, 8409, 8410, 8411, 8412, 8417,
+  8421, 8422, 8423, 8424, 8425, 8426, 8427, 12330, 12331, 12332, 12333, 12334, 12335, 12441, 12442, 43014, 64286, 65056,
+  65057, 65058, 65059, 68109, 68111, 68152, 68153, 68154, 68159, 119141, 119142, 119143, 119144, 119145, 119149, 119150,
+  119151, 119152, 119153, 119154, 119163, 119164, 119165, 119166, 119167, 119168, 119169, 119170, 119173, 119174,
+  119175, 119176, 119177, 119178, 119179, 119210, 119211, 119212, 119213, 119362, 119363, 119364,
+};
+
+constexpr KInt canonicalClassesValues[] = {
+  230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 232, 220,
+  220, 220, 220, 232, 216, 220, 220, 220, 220, 220, 202, 202, 220, 220, 220, 220, 202, 202, 220, 220, 220, 220, 220,
+  220, 220, 220, 220, 220, 220, 1, 1, 1, 1, 1, 220, 220, 220, 220, 230, 230, 230, 230, 230, 230, 230, 230, 240, 230,
+  220, 220, 220, 230, 230, 230, 220, 220, 230, 230, 230, 220, 220, 220, 220, 230, 232, 220, 220, 230, 233, 234, 234,
+  233, 234, 234, 233, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 220, 230,
+  230, 230, 230, 220, 230, 230, 230, 222, 220, 230, 230, 230, 230, 230, 230, 220, 220, 220, 220, 220, 220, 230, 230,
+  220, 230, 230, 222, 228, 230, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 230, 220, 18, 230, 230,
+  230, 230, 230, 230, 27, 28, 29, 30, 31, 32, 33, 34, 230, 230, 220, 220, 230, 230, 230, 230, 230, 220, 230, 230, 35,
+  230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 220, 230, 230, 230, 220, 230, 230, 220, 36, 230, 220, 230, 230,
+  220, 230, 230, 220, 220, 220, 230, 220, 220, 230, 220, 230, 230, 230, 220, 230, 220, 230, 220, 230, 220, 230, 230, 7,
+  9, 230, 220, 230, 230, 7, 9, 7, 9, 7, 9, 7, 9, 9, 9, 84, 91, 7, 9, 9, 9, 103, 103, 9, 107, 107, 107, 107, 118, 118,
+  122, 122, 122, 122, 220, 220, 220, 220, 216, 129, 130, 132, 130, 130, 130, 130, 130, 230, 230, 9, 230, 230, 220, 7, 9,
+  230, 9, 9, 9, 230, 228, 222, 230, 220, 230, 220, 230, 230, 220, 230, 230, 230, 1, 1, 230, 230, 230, 230, 1, 1, 1, 230,
+  230, 230, 1, 1, 230, 220, 230, 1, 1, 218, 228, 232, 222, 224, 224, 8, 8, 9, 26, 230, 230, 230, 230, 220, 230, 230, 1,
+  220, 9, 216, 216, 1, 1, 1, 226, 216, 216, 216, 216, 216, 220, 220, 220, 220, 220, 220, 220, 220, 230, 230, 230, 230,
+  230, 220, 220, 230, 230, 230, 230, 230, 230, 230,
+};
+
+constexpr KInt decompositionKeys[] = {
+  192, 193, 194, 195, 196, 197, 199, 200, 201, 202, 203, 204, 205, 206, 207, 209, 210, 211, 212, 213, 214, 217, 218,
+  219, 220, 221, 224, 225, 226, 227, 228, 229, 231, 232, 233, 234, 235, 236, 237, 238, 239, 241, 242, 243, 244, 245,
+  246, 249, 250, 251, 252, 253, 255, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271,
+  274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 296, 297, 298,
+  299, 300, 301, 302, 303, 304, 308, 309, 310, 311, 313, 314, 315, 316, 317, 318, 323, 324, 325, 326, 327, 328, 332,
+  333, 334, 335, 336, 337, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357,
+  360, 361, 362, 363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382,
+  416, 417, 431, 432, 461, 462, 463, 464, 465, 466, 467, 468, 469, 470, 471, 472, 473, 474, 475, 476, 478, 479, 480,
+  481, 482, 483, 486, 487, 488, 489, 490, 491, 492, 493, 494, 495, 496, 500, 501, 504, 505, 506, 507, 508, 509, 510,
+  511, 512, 513, 514, 515, 516, 517, 518, 519, 520, 521, 522, 523, 524, 525, 526, 527, 528, 529, 530, 531, 532, 533,
+  534, 535, 536, 537, 538, 539, 542, 543, 550, 551, 552, 553, 554, 555, 556, 557, 558, 559, 560, 561, 562, 563, 832,
+  833, 835, 836, 884, 894, 901, 902, 903, 904, 905, 906, 908, 910, 911, 912, 938, 939, 940, 941, 942, 943, 944, 970,
+  971, 972, 973, 974, 979, 980, 1024, 1025, 1027, 1031, 1036, 1037, 1038, 1049, 1081, 1104, 1105, 1107, 1111, 1116,
+  1117, 1118, 1142, 1143, 1217, 1218, 1232, 1233, 1234, 1235, 1238, 1239, 1242, 1243, 1244, 1245, 1246, 1247, 1250,
+  1251, 1252, 1253, 1254, 1255, 1258, 1259, 1260, 1261, 1262, 1263, 1264, 1265, 1266, 1267, 1268, 1269, 1272, 1273,
+  1570, 1571, 1572, 1573, 1574, 1728, 1730, 1747, 2345, 2353, 2356, 2392, 2393, 2394, 2395, 2396, 2397, 2398, 2399,
+  2507, 2508, 2524, 2525, 2527, 2611, 2614, 2649, 2650, 2651, 2654, 2888, 2891, 2892, 2908, 2909, 2964, 3018, 3019,
+  3020, 3144, 3264, 3271, 3272, 3274, 3275, 3402, 3403, 3404, 3546, 3548, 3549, 3550, 3907, 3917, 3922, 3927, 3932,
+  3945, 3955, 3957, 3958, 3960, 3969, 3987, 3997, 4002, 4007, 4012, 4025, 4134, 7680, 7681, 7682, 7683, 7684, 7685,
+  7686, 7687, 7688, 7689, 7690, 7691, 7692, 7693, 7694, 7695, 7696, 7697, 7698, 7699, 7700, 7701, 7702, 7703, 7704,
+  7705, 7706, 7707, 7708, 7709, 7710, 7711, 7712, 7713, 7714, 7715, 7716, 7717, 7718, 7719, 7720, 7721, 7722, 7723,
+  7724, 7725, 7726, 7727, 7728, 7729, 7730, 7731, 7732, 7733, 7734, 7735, 7736, 7737, 7738, 7739, 7740, 7741, 7742,
+  7743, 7744, 7745, 7746, 7747, 7748, 7749, 7750, 7751, 7752, 7753, 7754, 7755, 7756, 7757, 7758, 7759, 7760, 7761,
+  7762, 7763, 7764, 7765, 7766, 7767, 7768, 7769, 7770, 7771, 7772, 7773, 7774, 7775, 7776, 7777, 7778, 7779, 7780,
+  7781, 7782, 7783, 7784, 7785, 7786, 7787, 7788, 7789, 7790, 7791, 7792, 7793, 7794, 7795, 7796, 7797, 7798, 7799,
+  7800, 7801, 7802, 7803, 7804, 7805, 7806, 7807, 7808, 7809, 7810, 7811, 7812, 7813, 7814, 7815, 7816, 7817, 7818,
+  7819, 7820, 7821, 7822, 7823, 7824, 7825, 7826, 7827, 7828, 7829, 7830, 7831, 7832, 7833, 7835, 7840, 7841, 7842,
+  7843, 7844, 7845, 7846, 7847, 7848, 7849, 7850, 7851, 7852, 7853, 7854, 7855, 7856, 7857, 7858, 7859, 7860, 7861,
+  7862, 7863, 7864, 7865, 7866, 7867, 7868, 7869, 7870, 7871, 7872, 7873, 7874, 7875, 7876, 7877, 7878, 7879, 7880,
+  7881, 7882, 7883, 7884, 7885, 7886, 7887, 7888, 7889, 7890, 7891, 7892, 7893, 7894, 7895, 7896, 7897, 7898, 7899,
+  7900, 7901, 7902, 7903, 7904, 7905, 7906, 7907, 7908, 7909, 7910, 7911, 7912, 7913, 7914, 7915, 7916, 7917, 7918,
+  7919, 7920, 7921, 7922, 7923, 7924, 7925, 7926, 7927, 7928, 7929, 7936, 7937, 7938, 7939, 7940, 7941, 7942, 7943,
+  7944, 7945, 7946, 7947, 7948, 7949, 7950, 7951, 7952, 7953, 7954, 7955, 7956, 7957, 7960, 7961, 7962, 7963, 7964,
+  7965, 7968, 7969, 7970, 7971, 7972, 7973, 7974, 7975, 7976, 7977, 7978, 7979, 7980, 7981, 7982, 7983, 7984, 7985,
+  7986, 7987, 7988, 7989, 7990, 7991, 7992, 7993, 7994, 7995, 7996, 7997, 7998, 7999, 8000, 8001, 8002, 8003, 8004,
+  8005, 8008, 8009, 8010, 8011, 8012, 8013, 8016, 8017, 8018, 8019, 8020, 8021, 8022, 8023, 8025, 8027, 8029, 8031,
+  8032, 8033, 8034, 8035, 8036, 8037, 8038, 8039, 8040, 8041, 8042, 8043, 8044, 8045, 8046, 8047, 8048, 8049, 8050,
+  8051, 8052, 8053, 8054, 8055, 8056, 8057, 8058, 8059, 8060, 8061, 8064, 8065, 8066, 8067, 8068, 8069, 8070, 8071,
+  8072, 8073, 8074, 8075, 8076, 8077, 8078, 8079, 8080, 8081, 8082, 8083, 8084, 8085, 8086, 8087, 8088, 8089, 8090,
+  8091, 8092, 8093, 8094, 8095, 8096, 8097, 8098, 8099, 8100, 8101, 8102, 8103, 8104, 8105, 8106, 8107, 8108, 8109,
+  8110, 8111, 8112, 8113, 8114, 8115, 8116, 8118, 8119, 8120, 8121, 8122, 8123, 8124, 8126, 8129, 8130, 8131, 8132,
+  8134, 8135, 8136, 8137, 8138, 8139, 8140, 8141, 8142, 8143, 8144, 8145, 8146, 8147, 8150, 8151, 8152, 8153, 8154,
+  8155, 8157, 8158, 8159, 8160, 8161, 8162, 8163, 8164, 8165, 8166, 8167, 8168, 8169, 8170, 8171, 8172, 8173, 8174,
+  8175, 8178, 8179, 8180, 8182, 8183, 8184, 8185, 8186, 8187, 8188, 8189, 8192, 8193, 8486, 8490, 8491, 8602, 8603,
+  8622, 8653, 8654, 8655, 8708, 8713, 8716, 8740, 8742, 8769, 8772, 8775, 8777, 8800, 8802, 8813, 8814, 8815, 8816,
+  8817, 8820, 8821, 8824, 8825, 8832, 8833, 8836, 8837, 8840, 8841, 8876, 8877, 8878, 8879, 8928, 8929, 8930, 8931,
+  8938, 8939, 8940, 8941, 9001, 9002, 10972, 12364, 12366, 12368, 12370, 12372, 12374, 12376, 12378, 12380, 12382,
+  12384, 12386, 12389, 12391, 12393, 12400, 12401, 12403, 12404, 12406, 12407, 12409, 12410, 12412, 12413, 12436, 12446,
+  12460, 12462, 12464, 12466, 12468, 12470, 12472, 12474, 12476, 12478, 12480, 12482, 12485, 12487, 12489, 12496, 12497,
+  12499, 12500, 12502, 12503, 12505, 12506, 12508, 12509, 12532, 12535, 12536, 12537, 12538, 12542, 63744, 63745, 63746,
+  63747, 63748, 63749, 63750, 63751, 63752, 63753, 63754, 63755, 63756, 63757, 63758, 63759, 63760, 63761, 63762, 63763,
+  63764, 63765, 63766, 63767, 63768, 63769, 63770, 63771, 63772, 63773, 63774, 63775, 63776, 63777, 63778, 63779, 63780,
+  63781, 63782, 63783, 63784, 63785, 63786, 63787, 63788, 63789, 63790, 63791, 63792, 63793, 63794, 63795, 63796, 63797,
+  63798, 63799, 63800, 63801, 63802, 63803, 63804, 63805, 63806, 63807, 63808, 63809, 63810, 63811, 63812, 63813, 63814,
+  63815, 63816, 63817, 63818, 63819, 63820, 63821, 63822, 63823, 63824, 63825, 63826, 63827, 63828, 63829, 63830, 63831,
+  63832, 63833, 63834, 63835, 63836, 63837, 63838, 63839, 63840, 63841, 63842, 63843, 63844, 63845, 63846, 63847, 63848,
+  63849, 63850, 63851, 63852, 63853, 63854, 63855, 63856, 63857, 63858, 63859, 63860, 63861, 63862, 63863, 63864, 63865,
+  63866, 63867, 63868, 63869, 63870, 63871, 63872, 63873, 63874, 63875, 63876, 63877, 63878, 63879, 63880, 63881, 63882,
+  63883, 63884, 63885, 63886, 63887, 63888, 63889, 63890, 63891, 63892, 63893, 63894, 63895, 63896, 63897, 63898, 63899,
+  63900, 63901, 63902, 63903, 63904, 63905, 63906, 63907, 63908, 63909, 63910, 63911, 63912, 63913, 63914, 63915, 63916,
+  63917, 63918, 63919, 63920, 63921, 63922, 63923, 63924, 63925, 63926, 63927, 63928, 63929, 63930, 63931, 63932, 63933,
+  63934, 63935, 63936, 63937, 63938, 63939, 63940, 63941, 63942, 63943, 63944, 63945, 63946, 63947, 63948, 63949, 63950,
+  63951, 63952, 63953, 63954, 63955, 63956, 63957, 63958, 63959, 63960, 63961, 63962, 63963, 63964, 63965, 63966, 63967,
+  63968, 63969, 63970, 63971, 63972, 63973, 63974, 63975, 63976, 63977, 63978, 63979, 63980, 63981, 63982, 63983, 63984,
+  63985, 63986, 63987, 63988, 63989, 63990, 63991, 63992, 63993, 63994, 63995, 63996, 63997, 63998, 63999, 64000, 64001,
+  64002, 64003, 64004, 64005, 64006, 64007, 64008, 64009, 64010, 64011, 64012, 64013, 64016, 64018, 64021, 64022, 64023,
+  64024, 64025, 64026, 64027, 64028, 64029, 64030, 64032, 64034, 64037, 64038, 64042, 64043, 64044, 64045, 64048, 64049,
+  64050, 64051, 64052, 64053, 64054, 64055, 64056, 64057, 64058, 64059, 64060, 64061, 64062, 64063, 64064, 64065, 64066,
+  64067, 64068, 64069, 64070, 64071, 64072, 64073, 64074, 64075, 64076, 64077, 64078, 64079, 64080, 64081, 64082, 64083,
+  64084, 64085, 64086, 64087, 64088, 64089, 64090, 64091, 64092, 64093, 64094, 64095, 64096, 64097, 64098, 64099, 64100,
+  64101, 64102, 64103, 64104, 64105, 64106, 64112, 64113, 64114, 64115, 64116, 64117, 64118, 64119, 64120, 64121, 64122,
+  64123, 64124, 64125, 64126, 64127, 64128, 64129, 64130, 64131, 64132, 64133, 64134, 64135, 64136, 64137, 64138, 64139,
+  64140, 64141, 64142, 64143, 64144, 64145, 64146, 64147, 64148, 64149, 64150, 64151, 64152, 64153, 64154, 64155, 64156,
+  64157, 64158, 64159, 64160, 64161, 64162, 64163, 64164, 64165, 64166, 64167, 64168, 64169, 64170, 64171, 64172, 64173,
+  64174, 64175, 64176, 64177, 64178, 64179, 64180, 64181, 64182, 64183, 64184, 64185, 64186, 64187, 64188, 64189, 64190,
+  64191, 64192, 64193, 64194, 64195, 64196, 64197, 64198, 64199, 64200, 64201, 64202, 64203, 64204, 64205, 64206, 64207,
+  64208, 64209, 64210, 64211, 64212, 64213, 64214, 64215, 64216, 64217, 64285, 64287, 64298, 64299, 64300, 64301, 64302,
+  64303, 64304, 64305, 64306, 64307, 64308, 64309, 64310, 64312, 64313, 64314, 64315, 64316, 64318, 64320, 64321, 64323,
+  64324, 64326, 64327, 64328, 64329, 64330, 64331, 64332, 64333, 64334, 119134, 119135, 119136, 119137, 119138, 119139,
+  119140, 119227, 119228, 119229, 119230, 119231, 119232, 194560, 194561, 194562, 194563, 194564, 194565, 194566,
+  194567, 194568, 194569, 194570, 194571, 194572, 194573, 194574, 194575, 194576, 194577, 194578, 194579, 194580,
+  194581, 194582, 194583, 194584, 194585, 194586, 194587, 194588, 194589, 194590, 194591, 194592, 194593, 194594,
+  194595, 194596, 194597, 194598, 194599, 194600, 194601, 194602, 194603, 194604, 194605, 194606, 194607, 194608,
+  194609, 194610, 194611, 194612, 194613, 194614, 194615, 194616, 194617, 194618, 194619, 194620, 194621, 194622,
+  194623, 194624, 194625, 194626, 194627, 194628, 194629, 194630, 194631, 194632, 194633, 194634, 194635, 194636,
+  194637, 194638, 194639, 194640, 194641, 194642, 194643, 194644, 194645, 194646, 194647, 194648, 194649, 194650,
+  194651, 194652, 194653, 194654, 194655, 194656, 194657, 194658, 194659, 194660, 194661, 194662, 194663, 194664,
+  194665, 194666, 194667, 194668, 194669, 194670, 194671, 194672, 194673, 194674, 194675, 194676, 194677, 194678,
+  194679, 194680, 194681, 194682, 194683, 194684, 194685, 194686, 194687, 194688, 194689, 194690, 194691, 194692,
+  194693, 194694, 194695, 194696, 194697, 194698, 194699, 194700, 194701, 194702, 194703, 194704, 194705, 194706,
+  194707, 194708, 194709, 194710, 194711, 194712, 194713, 194714, 194715, 194716, 194717, 194718, 194719, 194720,
+  194721, 194722, 194723, 194724, 194725, 194726, 194727, 194728, 194729, 194730, 194731, 194732, 194733, 194734,
+  194735, 194736, 194737, 194738, 194739, 194740, 194741, 194742, 194743, 194744, 194745, 194746, 194747, 194748,
+  194749, 194750, 194751, 194752, 194753, 194754, 194755, 194756, 194757, 194758, 194759, 194760, 194761, 194762,
+  194763, 194764, 194765, 194766, 194767, 194768, 194769, 194770, 194771, 194772, 194773, 194774, 194775, 194776,
+  194777, 194778, 194779, 194780, 194781, 194782, 194783, 194784, 194785, 194786, 194787, 194788, 194789, 194790,
+  194791, 194792, 194793, 194794, 194795, 194796, 194797, 194798, 194799, 194800, 194801, 194802, 194803, 194804,
+  194805, 194806, 194807, 194808, 194809, 194810, 194811, 194812, 194813, 194814, 194815, 194816, 194817, 194818,
+  194819, 194820, 194821, 194822, 194823, 194824, 194825, 194826, 194827, 194828, 194829, 194830, 194831, 194832,
+  194833, 194834, 194835, 194836, 194837, 194838, 194839, 194840, 194841, 194842, 194843, 194844, 194845, 194846,
+  194847, 194848, 194849, 194850, 194851, 194852, 194853, 194854, 194855, 194856, 194857, 194858, 194859, 194860,
+  194861, 194862, 194863, 194864, 194865, 194866, 194867, 194868, 194869, 194870, 194871, 194872, 194873, 194874,
+  194875, 194876, 194877, 194878, 194879, 194880, 194881, 194882, 194883, 194884, 194885, 194886, 194887, 194888,
+  194889, 194890, 194891, 194892, 194893, 194894, 194895, 194896, 194897, 194898, 194899, 194900, 194901, 194902,
+  194903, 194904, 194905, 194906, 194907, 194908, 194909, 194910, 194911, 194912, 194913, 194914, 194915, 194916,
+  194917, 194918, 194919, 194920, 194921, 194922, 194923, 194924, 194925, 194926, 194927, 194928, 194929, 194930,
+  194931, 194932, 194933, 194934, 194935, 194936, 194937, 194938, 194939, 194940, 194941, 194942, 194943, 194944,
+  194945, 194946, 194947, 194948, 194949, 194950, 194951, 194952, 194953, 194954, 194955, 194956, 194957, 194958,
+  194959, 194960, 194961, 194962, 194963, 194964, 194965, 194966, 194967, 194968, 194969, 194970, 194971, 194972,
+  194973, 194974, 194975, 194976, 194977, 194978, 194979, 194980, 194981, 194982, 194983, 194984, 194985, 194986,
+  194987, 194988, 194989, 194990, 194991, 194992, 194993, 194994, 194995, 194996, 194997, 194998, 194999, 195000,
+  195001, 195002, 195003, 195004, 195005, 195006, 195007, 195008, 195009, 195010, 195011, 195012, 195013, 195014,
+  195015, 195016, 195017, 195018, 195019, 195020, 195021, 195022, 195023, 195024, 195025, 195026, 195027, 195028,
+  195029, 195030, 195031, 195032, 195033, 195034, 195035, 195036, 195037, 195038, 195039, 195040, 195041, 195042,
+  195043, 195044, 195045, 195046, 195047, 195048, 195049, 195050, 195051, 195052, 195053, 195054, 195055, 195056,
+  195057, 195058, 195059, 195060, 195061, 195062, 195063, 195064, 195065, 195066, 195067, 195068, 195069, 195070,
+  195071, 195072, 195073, 195074, 195075, 195076, 195077, 195078, 195079, 195080, 195081, 195082, 195083, 195084,
+  195085, 195086, 195087, 195088, 195089, 195090, 195091, 195092, 195093, 195094, 195095, 195096, 195097, 195098,
+  195099, 195100, 195101
+};
+
+struct Decomposition {
+  const KInt array[4];
+  const KByte length;
+};
+
+constexpr Decomposition decompositionValues[] = {
+  {{65, 768}, 2}, {{65, 769}, 2}, {{65, 770}, 2}, {{65, 771}, 2}, {{65, 776}, 2}, {{65, 778}, 2}, {{67, 807}, 2},
+  {{69, 768}, 2}, {{69, 769}, 2}, {{69, 770}, 2}, {{69, 776}, 2}, {{73, 768}, 2}, {{73, 769}, 2}, {{73, 770}, 2},
+  {{73, 776}, 2}, {{78, 771}, 2}, {{79, 768}, 2}, {{79, 769}, 2}, {{79, 770}, 2}, {{79, 771}, 2}, {{79, 776}, 2},
+  {{85, 768}, 2}, {{85, 769}, 2}, {{85, 770}, 2}, {{85, 776}, 2}, {{89, 769}, 2}, {{97, 768}, 2}, {{97, 769}, 2},
+  {{97, 770}, 2}, {{97, 771}, 2}, {{97, 776}, 2}, {{97, 778}, 2}, {{99, 807}, 2}, {{101, 768}, 2}, {{101, 769}, 2},
+  {{101, 770}, 2}, {{101, 776}, 2}, {{105, 768}, 2}, {{105, 769}, 2}, {{105, 770}, 2}, {{105, 776}, 2}, {{110, 771}, 2},
+  {{111, 768}, 2}, {{111, 769}, 2}, {{111, 770}, 2}, {{111, 771}, 2}, {{111, 776}, 2}, {{117, 768}, 2}, {{117, 769}, 2},
+  {{117, 770}, 2}, {{117, 776}, 2}, {{121, 769}, 2}, {{121, 776}, 2}, {{65, 772}, 2}, {{97, 772}, 2}, {{65, 774}, 2},
+  {{97, 774}, 2}, {{65, 808}, 2}, {{97, 808}, 2}, {{67, 769}, 2}, {{99, 769}, 2}, {{67, 770}, 2}, {{99, 770}, 2},
+  {{67, 775}, 2}, {{99, 775}, 2}, {{67, 780}, 2}, {{99, 780}, 2}, {{68, 780}, 2}, {{100, 780}, 2}, {{69, 772}, 2},
+  {{101, 772}, 2}, {{69, 774}, 2}, {{101, 774}, 2}, {{69, 775}, 2}, {{101, 775}, 2}, {{69, 808}, 2}, {{101, 808}, 2},
+  {{69, 780}, 2}, {{101, 780}, 2}, {{71, 770}, 2}, {{103, 770}, 2}, {{71, 774}, 2}, {{103, 774}, 2}, {{71, 775}, 2},
+  {{103, 775}, 2}, {{71, 807}, 2}, {{103, 807}, 2}, {{72, 770}, 2}, {{104, 770}, 2}, {{73, 771}, 2}, {{105, 771}, 2},
+  {{73, 772}, 2}, {{105, 772}, 2}, {{73, 774}, 2}, {{105, 774}, 2}, {{73, 808}, 2}, {{105, 808}, 2}, {{73, 775}, 2},
+  {{74, 770}, 2}, {{106, 770}, 2}, {{75, 807}, 2}, {{107, 807}, 2}, {{76, 769}, 2}, {{108, 769}, 2}, {{76, 807}, 2},
+  {{108, 807}, 2}, {{76, 780}, 2}, {{108, 780}, 2}, {{78, 769}, 2}, {{110, 769}, 2}, {{78, 807}, 2}, {{110, 807}, 2},
+  {{78, 780}, 2}, {{110, 780}, 2}, {{79, 772}, 2}, {{111, 772}, 2}, {{79, 774}, 2}, {{111, 774}, 2}, {{79, 779}, 2},
+  {{111, 779}, 2}, {{82, 769}, 2}, {{114, 769}, 2}, {{82, 807}, 2}, {{114, 807}, 2}, {{82, 780}, 2}, {{114, 780}, 2},
+  {{83, 769}, 2}, {{115, 769}, 2}, {{83, 770}, 2}, {{115, 770}, 2}, {{83, 807}, 2}, {{115, 807}, 2}, {{83, 780}, 2},
+  {{115, 780}, 2}, {{84, 807}, 2}, {{116, 807}, 2}, {{84, 780}, 2}, {{116, 780}, 2}, {{85, 771}, 2}, {{117, 771}, 2},
+  {{85, 772}, 2}, {{117, 772}, 2}, {{85, 774}, 2}, {{117, 774}, 2}, {{85, 778}, 2}, {{117, 778}, 2}, {{85, 779}, 2},
+  {{117, 779}, 2}, {{85, 808}, 2}, {{117, 808}, 2}, {{87, 770}, 2}, {{119, 770}, 2}, {{89, 770}, 2}, {{121, 770}, 2},
+  {{89, 776}, 2}, {{90, 769}, 2}, {{122, 769}, 2}, {{90, 775}, 2}, {{122, 775}, 2}, {{90, 780}, 2}, {{122, 780}, 2},
+  {{79, 795}, 2}, {{111, 795}, 2}, {{85, 795}, 2}, {{117, 795}, 2}, {{65, 780}, 2}, {{97, 780}, 2}, {{73, 780}, 2},
+  {{105, 780}, 2}, {{79, 780}, 2}, {{111, 780}, 2}, {{85, 780}, 2}, {{117, 780}, 2}, {{85, 776, 772}, 3},
+  {{117, 776, 772}, 3}, {{85, 776, 769}, 3}, {{117, 776, 769}, 3}, {{85, 776, 780}, 3}, {{117, 776, 780}, 3},
+  {{85, 776, 768}, 3}, {{117, 776, 768}, 3}, {{65, 776, 772}, 3}, {{97, 776, 772}, 3}, {{65, 775, 772}, 3},
+  {{97, 775, 772}, 3}, {{198, 772}, 2}, {{230, 772}, 2}, {{71, 780}, 2}, {{103, 780}, 2}, {{75, 780}, 2},
+  {{107, 780}, 2}, {{79, 808}, 2}, {{111, 808}, 2}, {{79, 808, 772}, 3}, {{111, 808, 772}, 3}, {{439, 780}, 2},
+  {{658, 780}, 2}, {{106, 780}, 2}, {{71, 769}, 2}, {{103, 769}, 2}, {{78, 768}, 2}, {{110, 768}, 2},
+  {{65, 778, 769}, 3}, {{97, 778, 769}, 3}, {{198, 769}, 2}, {{230, 769}, 2}, {{216, 769}, 2}, {{248, 769}, 2},
+  {{65, 783}, 2}, {{97, 783}, 2}, {{65, 785}, 2}, {{97, 785}, 2}, {{69, 783}, 2}, {{101, 783}, 2}, {{69, 785}, 2},
+  {{101, 785}, 2}, {{73, 783}, 2}, {{105, 783}, 2}, {{73, 785}, 2}, {{105, 785}, 2}, {{79, 783}, 2}, {{111, 783}, 2},
+  {{79, 785}, 2}, {{111, 785}, 2}, {{82, 783}, 2}, {{114, 783}, 2}, {{82, 785}, 2}, {{114, 785}, 2}, {{85, 783}, 2},
+  {{117, 783}, 2}, {{85, 785}, 2}, {{117, 785}, 2}, {{83, 806}, 2}, {{115, 806}, 2}, {{84, 806}, 2}, {{116, 806}, 2},
+  {{72, 780}, 2}, {{104, 780}, 2}, {{65, 775}, 2}, {{97, 775}, 2}, {{69, 807}, 2}, {{101, 807}, 2}, {{79, 776, 772}, 3},
+  {{111, 776, 772}, 3}, {{79, 771, 772}, 3}, {{111, 771, 772}, 3}, {{79, 775}, 2}, {{111, 775}, 2}, {{79, 775, 772}, 3},
+  {{111, 775, 772}, 3}, {{89, 772}, 2}, {{121, 772}, 2}, {{768}, 1}, {{769}, 1}, {{787}, 1}, {{776, 769}, 2},
+  {{697}, 1}, {{59}, 1}, {{168, 769}, 2}, {{913, 769}, 2}, {{183}, 1}, {{917, 769}, 2}, {{919, 769}, 2},
+  {{921, 769}, 2}, {{927, 769}, 2}, {{933, 769}, 2}, {{937, 769}, 2}, {{953, 776, 769}, 3}, {{921, 776}, 2},
+  {{933, 776}, 2}, {{945, 769}, 2}, {{949, 769}, 2}, {{951, 769}, 2}, {{953, 769}, 2}, {{965, 776, 769}, 3},
+  {{953, 776}, 2}, {{965, 776}, 2}, {{959, 769}, 2}, {{965, 769}, 2}, {{969, 769}, 2}, {{978, 769}, 2}, {{978, 776}, 2},
+  {{1045, 768}, 2}, {{1045, 776}, 2}, {{1043, 769}, 2}, {{1030, 776}, 2}, {{1050, 769}, 2}, {{1048, 768}, 2},
+  {{1059, 774}, 2}, {{1048, 774}, 2}, {{1080, 774}, 2}, {{1077, 768}, 2}, {{1077, 776}, 2}, {{1075, 769}, 2},
+  {{1110, 776}, 2}, {{1082, 769}, 2}, {{1080, 768}, 2}, {{1091, 774}, 2}, {{1140, 783}, 2}, {{1141, 783}, 2},
+  {{1046, 774}, 2}, {{1078, 774}, 2}, {{1040, 774}, 2}, {{1072, 774}, 2}, {{1040, 776}, 2}, {{1072, 776}, 2},
+  {{1045, 774}, 2}, {{1077, 774}, 2}, {{1240, 776}, 2}, {{1241, 776}, 2}, {{1046, 776}, 2}, {{1078, 776}, 2},
+  {{1047, 776}, 2}, {{1079, 776}, 2}, {{1048, 772}, 2}, {{1080, 772}, 2}, {{1048, 776}, 2}, {{1080, 776}, 2},
+  {{1054, 776}, 2}, {{1086, 776}, 2}, {{1256, 776}, 2}, {{1257, 776}, 2}, {{1069, 776}, 2}, {{1101, 776}, 2},
+  {{1059, 772}, 2}, {{1091, 772}, 2}, {{1059, 776}, 2}, {{1091, 776}, 2}, {{1059, 779}, 2}, {{1091, 779}, 2},
+  {{1063, 776}, 2}, {{1095, 776}, 2}, {{1067, 776}, 2}, {{1099, 776}, 2}, {{1575, 1619}, 2}, {{1575, 1620}, 2},
+  {{1608, 1620}, 2}, {{1575, 1621}, 2}, {{1610, 1620}, 2}, {{1749, 1620}, 2}, {{1729, 1620}, 2}, {{1746, 1620}, 2},
+  {{2344, 2364}, 2}, {{2352, 2364}, 2}, {{2355, 2364}, 2}, {{2325, 2364}, 2}, {{2326, 2364}, 2}, {{2327, 2364}, 2},
+  {{2332, 2364}, 2}, {{2337, 2364}, 2}, {{2338, 2364}, 2}, {{2347, 2364}, 2}, {{2351, 2364}, 2}, {{2503, 2494}, 2},
+  {{2503, 2519}, 2}, {{2465, 2492}, 2}, {{2466, 2492}, 2}, {{2479, 2492}, 2}, {{2610, 2620}, 2}, {{2616, 2620}, 2},
+  {{2582, 2620}, 2}, {{2583, 2620}, 2}, {{2588, 2620}, 2}, {{2603, 2620}, 2}, {{2887, 2902}, 2}, {{2887, 2878}, 2},
+  {{2887, 2903}, 2}, {{2849, 2876}, 2}, {{2850, 2876}, 2}, {{2962, 3031}, 2}, {{3014, 3006}, 2}, {{3015, 3006}, 2},
+  {{3014, 3031}, 2}, {{3142, 3158}, 2}, {{3263, 3285}, 2}, {{3270, 3285}, 2}, {{3270, 3286}, 2}, {{3270, 3266}, 2},
+  {{3270, 3266, 3285}, 3}, {{3398, 3390}, 2}, {{3399, 3390}, 2}, {{3398, 3415}, 2}, {{3545, 3530}, 2},
+  {{3545, 3535}, 2}, {{3545, 3535, 3530}, 3}, {{3545, 3551}, 2}, {{3906, 4023}, 2}, {{3916, 4023}, 2},
+  {{3921, 4023}, 2}, {{3926, 4023}, 2}, {{3931, 4023}, 2}, {{3904, 4021}, 2}, {{3953, 3954}, 2}, {{3953, 3956}, 2},
+  {{4018, 3968}, 2}, {{4019, 3968}, 2}, {{3953, 3968}, 2}, {{3986, 4023}, 2}, {{3996, 4023}, 2}, {{4001, 4023}, 2},
+  {{4006, 4023}, 2}, {{4011, 4023}, 2}, {{3984, 4021}, 2}, {{4133, 4142}, 2}, {{65, 805}, 2}, {{97, 805}, 2},
+  {{66, 775}, 2}, {{98, 775}, 2}, {{66, 803}, 2}, {{98, 803}, 2}, {{66, 817}, 2}, {{98, 817}, 2}, {{67, 807, 769}, 3},
+  {{99, 807, 769}, 3}, {{68, 775}, 2}, {{100, 775}, 2}, {{68, 803}, 2}, {{100, 803}, 2}, {{68, 817}, 2},
+  {{100, 817}, 2}, {{68, 807}, 2}, {{100, 807}, 2}, {{68, 813}, 2}, {{100, 813}, 2}, {{69, 772, 768}, 3},
+  {{101, 772, 768}, 3}, {{69, 772, 769}, 3}, {{101, 772, 769}, 3}, {{69, 813}, 2}, {{101, 813}, 2}, {{69, 816}, 2},
+  {{101, 816}, 2}, {{69, 807, 774}, 3}, {{101, 807, 774}, 3}, {{70, 775}, 2}, {{102, 775}, 2}, {{71, 772}, 2},
+  {{103, 772}, 2}, {{72, 775}, 2}, {{104, 775}, 2}, {{72, 803}, 2}, {{104, 803}, 2}, {{72, 776}, 2}, {{104, 776}, 2},
+  {{72, 807}, 2}, {{104, 807}, 2}, {{72, 814}, 2}, {{104, 814}, 2}, {{73, 816}, 2}, {{105, 816}, 2},
+  {{73, 776, 769}, 3}, {{105, 776, 769}, 3}, {{75, 769}, 2}, {{107, 769}, 2}, {{75, 803}, 2}, {{107, 803}, 2},
+  {{75, 817}, 2}, {{107, 817}, 2}, {{76, 803}, 2}, {{108, 803}, 2}, {{76, 803, 772}, 3}, {{108, 803, 772}, 3},
+  {{76, 817}, 2}, {{108, 817}, 2}, {{76, 813}, 2}, {{108, 813}, 2}, {{77, 769}, 2}, {{109, 769}, 2}, {{77, 775}, 2},
+  {{109, 775}, 2}, {{77, 803}, 2}, {{109, 803}, 2}, {{78, 775}, 2}, {{110, 775}, 2}, {{78, 803}, 2}, {{110, 803}, 2},
+  {{78, 817}, 2}, {{110, 817}, 2}, {{78, 813}, 2}, {{110, 813}, 2}, {{79, 771, 769}, 3}, {{111, 771, 769}, 3},
+  {{79, 771, 776}, 3}, {{111, 771, 776}, 3}, {{79, 772, 768}, 3}, {{111, 772, 768}, 3}, {{79, 772, 769}, 3},
+  {{111, 772, 769}, 3}, {{80, 769}, 2}, {{112, 769}, 2}, {{80, 775}, 2}, {{112, 775}, 2}, {{82, 775}, 2},
+  {{114, 775}, 2}, {{82, 803}, 2}, {{114, 803}, 2}, {{82, 803, 772}, 3}, {{114, 803, 772}, 3}, {{82, 817}, 2},
+  {{114, 817}, 2}, {{83, 775}, 2}, {{115, 775}, 2}, {{83, 803}, 2}, {{115, 803}, 2}, {{83, 769, 775}, 3},
+  {{115, 769, 775}, 3}, {{83, 780, 775}, 3}, {{115, 780, 775}, 3}, {{83, 803, 775}, 3}, {{115, 803, 775}, 3},
+  {{84, 775}, 2}, {{116, 775}, 2}, {{84, 803}, 2}, {{116, 803}, 2}, {{84, 817}, 2}, {{116, 817}, 2}, {{84, 813}, 2},
+  {{116, 813}, 2}, {{85, 804}, 2}, {{117, 804}, 2}, {{85, 816}, 2}, {{117, 816}, 2}, {{85, 813}, 2}, {{117, 813}, 2},
+  {{85, 771, 769}, 3}, {{117, 771, 769}, 3}, {{85, 772, 776}, 3}, {{117, 772, 776}, 3}, {{86, 771}, 2}, {{118, 771}, 2},
+  {{86, 803}, 2}, {{118, 803}, 2}, {{87, 768}, 2}, {{119, 768}, 2}, {{87, 769}, 2}, {{119, 769}, 2}, {{87, 776}, 2},
+  {{119, 776}, 2}, {{87, 775}, 2}, {{119, 775}, 2}, {{87, 803}, 2}, {{119, 803}, 2}, {{88, 775}, 2}, {{120, 775}, 2},
+  {{88, 776}, 2}, {{120, 776}, 2}, {{89, 775}, 2}, {{121, 775}, 2}, {{90, 770}, 2}, {{122, 770}, 2}, {{90, 803}, 2},
+  {{122, 803}, 2}, {{90, 817}, 2}, {{122, 817}, 2}, {{104, 817}, 2}, {{116, 776}, 2}, {{119, 778}, 2}, {{121, 778}, 2},
+  {{383, 775}, 2}, {{65, 803}, 2}, {{97, 803}, 2}, {{65, 777}, 2}, {{97, 777}, 2}, {{65, 770, 769}, 3},
+  {{97, 770, 769}, 3}, {{65, 770, 768}, 3}, {{97, 770, 768}, 3}, {{65, 770, 777}, 3}, {{97, 770, 777}, 3},
+  {{65, 770, 771}, 3}, {{97, 770, 771}, 3}, {{65, 803, 770}, 3}, {{97, 803, 770}, 3}, {{65, 774, 769}, 3},
+  {{97, 774, 769}, 3}, {{65, 774, 768}, 3}, {{97, 774, 768}, 3}, {{65, 774, 777}, 3}, {{97, 774, 777}, 3},
+  {{65, 774, 771}, 3}, {{97, 774, 771}, 3}, {{65, 803, 774}, 3}, {{97, 803, 774}, 3}, {{69, 803}, 2}, {{101, 803}, 2},
+  {{69, 777}, 2}, {{101, 777}, 2}, {{69, 771}, 2}, {{101, 771}, 2}, {{69, 770, 769}, 3}, {{101, 770, 769}, 3},
+  {{69, 770, 768}, 3}, {{101, 770, 768}, 3}, {{69, 770, 777}, 3}, {{101, 770, 777}, 3}, {{69, 770, 771}, 3},
+  {{101, 770, 771}, 3}, {{69, 803, 770}, 3}, {{101, 803, 770}, 3}, {{73, 777}, 2}, {{105, 777}, 2}, {{73, 803}, 2},
+  {{105, 803}, 2}, {{79, 803}, 2}, {{111, 803}, 2}, {{79, 777}, 2}, {{111, 777}, 2}, {{79, 770, 769}, 3},
+  {{111, 770, 769}, 3}, {{79, 770, 768}, 3}, {{111, 770, 768}, 3}, {{79, 770, 777}, 3}, {{111, 770, 777}, 3},
+  {{79, 770, 771}, 3}, {{111, 770, 771}, 3}, {{79, 803, 770}, 3}, {{111, 803, 770}, 3}, {{79, 795, 769}, 3},
+  {{111, 795, 769}, 3}, {{79, 795, 768}, 3}, {{111, 795, 768}, 3}, {{79, 795, 777}, 3}, {{111, 795, 777}, 3},
+  {{79, 795, 771}, 3}, {{111, 795, 771}, 3}, {{79, 795, 803}, 3}, {{111, 795, 803}, 3}, {{85, 803}, 2}, {{117, 803}, 2},
+  {{85, 777}, 2}, {{117, 777}, 2}, {{85, 795, 769}, 3}, {{117, 795, 769}, 3}, {{85, 795, 768}, 3}, {{117, 795, 768}, 3},
+  {{85, 795, 777}, 3}, {{117, 795, 777}, 3}, {{85, 795, 771}, 3}, {{117, 795, 771}, 3}, {{85, 795, 803}, 3},
+  {{117, 795, 803}, 3}, {{89, 768}, 2}, {{121, 768}, 2}, {{89, 803}, 2}, {{121, 803}, 2}, {{89, 777}, 2},
+  {{121, 777}, 2}, {{89, 771}, 2}, {{121, 771}, 2}, {{945, 787}, 2}, {{945, 788}, 2}, {{945, 787, 768}, 3},
+  {{945, 788, 768}, 3}, {{945, 787, 769}, 3}, {{945, 788, 769}, 3}, {{945, 787, 834}, 3}, {{945, 788, 834}, 3},
+  {{913, 787}, 2}, {{913, 788}, 2}, {{913, 787, 768}, 3}, {{913, 788, 768}, 3}, {{913, 787, 769}, 3},
+  {{913, 788, 769}, 3}, {{913, 787, 834}, 3}, {{913, 788, 834}, 3}, {{949, 787}, 2}, {{949, 788}, 2},
+  {{949, 787, 768}, 3}, {{949, 788, 768}, 3}, {{949, 787, 769}, 3}, {{949, 788, 769}, 3}, {{917, 787}, 2},
+  {{917, 788}, 2}, {{917, 787, 768}, 3}, {{917, 788, 768}, 3}, {{917, 787, 769}, 3}, {{917, 788, 769}, 3},
+  {{951, 787}, 2}, {{951, 788}, 2}, {{951, 787, 768}, 3}, {{951, 788, 768}, 3}, {{951, 787, 769}, 3},
+  {{951, 788, 769}, 3}, {{951, 787, 834}, 3}, {{951, 788, 834}, 3}, {{919, 787}, 2}, {{919, 788}, 2},
+  {{919, 787, 768}, 3}, {{919, 788, 768}, 3}, {{919, 787, 769}, 3}, {{919, 788, 769}, 3}, {{919, 787, 834}, 3},
+  {{919, 788, 834}, 3}, {{953, 787}, 2}, {{953, 788}, 2}, {{953, 787, 768}, 3}, {{953, 788, 768}, 3},
+  {{953, 787, 769}, 3}, {{953, 788, 769}, 3}, {{953, 787, 834}, 3}, {{953, 788, 834}, 3}, {{921, 787}, 2},
+  {{921, 788}, 2}, {{921, 787, 768}, 3}, {{921, 788, 768}, 3}, {{921, 787, 769}, 3}, {{921, 788, 769}, 3},
+  {{921, 787, 834}, 3}, {{921, 788, 834}, 3}, {{959, 787}, 2}, {{959, 788}, 2}, {{959, 787, 768}, 3},
+  {{959, 788, 768}, 3}, {{959, 787, 769}, 3}, {{959, 788, 769}, 3}, {{927, 787}, 2}, {{927, 788}, 2},
+  {{927, 787, 768}, 3}, {{927, 788, 768}, 3}, {{927, 787, 769}, 3}, {{927, 788, 769}, 3}, {{965, 787}, 2},
+  {{965, 788}, 2}, {{965, 787, 768}, 3}, {{965, 788, 768}, 3}, {{965, 787, 769}, 3}, {{965, 788, 769}, 3},
+  {{965, 787, 834}, 3}, {{965, 788, 834}, 3}, {{933, 788}, 2}, {{933, 788, 768}, 3}, {{933, 788, 769}, 3},
+  {{933, 788, 834}, 3}, {{969, 787}, 2}, {{969, 788}, 2}, {{969, 787, 768}, 3}, {{969, 788, 768}, 3},
+  {{969, 787, 769}, 3}, {{969, 788, 769}, 3}, {{969, 787, 834}, 3}, {{969, 788, 834}, 3}, {{937, 787}, 2},
+  {{937, 788}, 2}, {{937, 787, 768}, 3}, {{937, 788, 768}, 3}, {{937, 787, 769}, 3}, {{937, 788, 769}, 3},
+  {{937, 787, 834}, 3}, {{937, 788, 834}, 3}, {{945, 768}, 2}, {{945, 769}, 2}, {{949, 768}, 2}, {{949, 769}, 2},
+  {{951, 768}, 2}, {{951, 769}, 2}, {{953, 768}, 2}, {{953, 769}, 2}, {{959, 768}, 2}, {{959, 769}, 2}, {{965, 768}, 2},
+  {{965, 769}, 2}, {{969, 768}, 2}, {{969, 769}, 2}, {{945, 787, 837}, 3}, {{945, 788, 837}, 3},
+  {{945, 787, 768, 837}, 4}, {{945, 788, 768, 837}, 4}, {{945, 787, 769, 837}, 4}, {{945, 788, 769, 837}, 4},
+  {{945, 787, 834, 837}, 4}, {{945, 788, 834, 837}, 4}, {{913, 787, 837}, 3}, {{913, 788, 837}, 3},
+  {{913, 787, 768, 837}, 4}, {{913, 788, 768, 837}, 4}, {{913, 787, 769, 837}, 4}, {{913, 788, 769, 837}, 4},
+  {{913, 787, 834, 837}, 4}, {{913, 788, 834, 837}, 4}, {{951, 787, 837}, 3}, {{951, 788, 837}, 3},
+  {{951, 787, 768, 837}, 4}, {{951, 788, 768, 837}, 4}, {{951, 787, 769, 837}, 4}, {{951, 788, 769, 837}, 4},
+  {{951, 787, 834, 837}, 4}, {{951, 788, 834, 837}, 4}, {{919, 787, 837}, 3}, {{919, 788, 837}, 3},
+  {{919, 787, 768, 837}, 4}, {{919, 788, 768, 837}, 4}, {{919, 787, 769, 837}, 4}, {{919, 788, 769, 837}, 4},
+  {{919, 787, 834, 837}, 4}, {{919, 788, 834, 837}, 4}, {{969, 787, 837}, 3}, {{969, 788, 837}, 3},
+  {{969, 787, 768, 837}, 4}, {{969, 788, 768, 837}, 4}, {{969, 787, 769, 837}, 4}, {{969, 788, 769, 837}, 4},
+  {{969, 787, 834, 837}, 4}, {{969, 788, 834, 837}, 4}, {{937, 787, 837}, 3}, {{937, 788, 837}, 3},
+  {{937, 787, 768, 837}, 4}, {{937, 788, 768, 837}, 4}, {{937, 787, 769, 837}, 4}, {{937, 788, 769, 837}, 4},
+  {{937, 787, 834, 837}, 4}, {{937, 788, 834, 837}, 4}, {{945, 774}, 2}, {{945, 772}, 2}, {{945, 768, 837}, 3},
+  {{945, 837}, 2}, {{945, 769, 837}, 3}, {{945, 834}, 2}, {{945, 834, 837}, 3}, {{913, 774}, 2}, {{913, 772}, 2},
+  {{913, 768}, 2}, {{913, 769}, 2}, {{913, 837}, 2}, {{953}, 1}, {{168, 834}, 2}, {{951, 768, 837}, 3}, {{951, 837}, 2},
+  {{951, 769, 837}, 3}, {{951, 834}, 2}, {{951, 834, 837}, 3}, {{917, 768}, 2}, {{917, 769}, 2}, {{919, 768}, 2},
+  {{919, 769}, 2}, {{919, 837}, 2}, {{8127, 768}, 2}, {{8127, 769}, 2}, {{8127, 834}, 2}, {{953, 774}, 2},
+  {{953, 772}, 2}, {{953, 776, 768}, 3}, {{953, 776, 769}, 3}, {{953, 834}, 2}, {{953, 776, 834}, 3}, {{921, 774}, 2},
+  {{921, 772}, 2}, {{921, 768}, 2}, {{921, 769}, 2}, {{8190, 768}, 2}, {{8190, 769}, 2}, {{8190, 834}, 2},
+  {{965, 774}, 2}, {{965, 772}, 2}, {{965, 776, 768}, 3}, {{965, 776, 769}, 3}, {{961, 787}, 2}, {{961, 788}, 2},
+  {{965, 834}, 2}, {{965, 776, 834}, 3}, {{933, 774}, 2}, {{933, 772}, 2}, {{933, 768}, 2}, {{933, 769}, 2},
+  {{929, 788}, 2}, {{168, 768}, 2}, {{168, 769}, 2}, {{96}, 1}, {{969, 768, 837}, 3}, {{969, 837}, 2},
+  {{969, 769, 837}, 3}, {{969, 834}, 2}, {{969, 834, 837}, 3}, {{927, 768}, 2}, {{927, 769}, 2}, {{937, 768}, 2},
+  {{937, 769}, 2}, {{937, 837}, 2}, {{180}, 1}, {{8194}, 1}, {{8195}, 1}, {{937}, 1}, {{75}, 1}, {{65, 778}, 2},
+  {{8592, 824}, 2}, {{8594, 824}, 2}, {{8596, 824}, 2}, {{8656, 824}, 2}, {{8660, 824}, 2}, {{8658, 824}, 2},
+  {{8707, 824}, 2}, {{8712, 824}, 2}, {{8715, 824}, 2}, {{8739, 824}, 2}, {{8741, 824}, 2}, {{8764, 824}, 2},
+  {{8771, 824}, 2}, {{8773, 824}, 2}, {{8776, 824}, 2}, {{61, 824}, 2}, {{8801, 824}, 2}, {{8781, 824}, 2},
+  {{60, 824}, 2}, {{62, 824}, 2}, {{8804, 824}, 2}, {{8805, 824}, 2}, {{8818, 824}, 2}, {{8819, 824}, 2},
+  {{8822, 824}, 2}, {{8823, 824}, 2}, {{8826, 824}, 2}, {{8827, 824}, 2}, {{8834, 824}, 2}, {{8835, 824}, 2},
+  {{8838, 824}, 2}, {{8839, 824}, 2}, {{8866, 824}, 2}, {{8872, 824}, 2}, {{8873, 824}, 2}, {{8875, 824}, 2},
+  {{8828, 824}, 2}, {{8829, 824}, 2}, {{8849, 824}, 2}, {{8850, 824}, 2}, {{8882, 824}, 2}, {{8883, 824}, 2},
+  {{8884, 824}, 2}, {{8885, 824}, 2}, {{12296}, 1}, {{12297}, 1}, {{10973, 824}, 2}, {{12363, 12441}, 2},
+  {{12365, 12441}, 2}, {{12367, 12441}, 2}, {{12369, 12441}, 2}, {{12371, 12441}, 2}, {{12373, 12441}, 2},
+  {{12375, 12441}, 2}, {{12377, 12441}, 2}, {{12379, 12441}, 2}, {{12381, 12441}, 2}, {{12383, 12441}, 2},
+  {{12385, 12441}, 2}, {{12388, 12441}, 2}, {{12390, 12441}, 2}, {{12392, 12441}, 2}, {{12399, 12441}, 2},
+  {{12399, 12442}, 2}, {{12402, 12441}, 2}, {{12402, 12442}, 2}, {{12405, 12441}, 2}, {{12405, 12442}, 2},
+  {{12408, 12441}, 2}, {{12408, 12442}, 2}, {{12411, 12441}, 2}, {{12411, 12442}, 2}, {{12358, 12441}, 2},
+  {{12445, 12441}, 2}, {{12459, 12441}, 2}, {{12461, 12441}, 2}, {{12463, 12441}, 2}, {{12465, 12441}, 2},
+  {{12467, 12441}, 2}, {{12469, 12441}, 2}, {{12471, 12441}, 2}, {{12473, 12441}, 2}, {{12475, 12441}, 2},
+  {{12477, 12441}, 2}, {{12479, 12441}, 2}, {{12481, 12441}, 2}, {{12484, 12441}, 2}, {{12486, 12441}, 2},
+  {{12488, 12441}, 2}, {{12495, 12441}, 2}, {{12495, 12442}, 2}, {{12498, 12441}, 2}, {{12498, 12442}, 2},
+  {{12501, 12441}, 2}, {{12501, 12442}, 2}, {{12504, 12441}, 2}, {{12504, 12442}, 2}, {{12507, 12441}, 2},
+  {{12507, 12442}, 2}, {{12454, 12441}, 2}, {{12527, 12441}, 2}, {{12528, 12441}, 2}, {{12529, 12441}, 2},
+  {{12530, 12441}, 2}, {{12541, 12441}, 2}, {{35912}, 1}, {{26356}, 1}, {{36554}, 1}, {{36040}, 1}, {{28369}, 1},
+  {{20018}, 1}, {{21477}, 1}, {{40860}, 1}, {{40860}, 1}, {{22865}, 1}, {{37329}, 1}, {{21895}, 1}, {{22856}, 1},
+  {{25078}, 1}, {{30313}, 1}, {{32645}, 1}, {{34367}, 1}, {{34746}, 1}, {{35064}, 1}, {{37007}, 1}, {{27138}, 1},
+  {{27931}, 1}, {{28889}, 1}, {{29662}, 1}, {{33853}, 1}, {{37226}, 1}, {{39409}, 1}, {{20098}, 1}, {{21365}, 1},
+  {{27396}, 1}, {{29211}, 1}, {{34349}, 1}, {{40478}, 1}, {{23888}, 1}, {{28651}, 1}, {{34253}, 1}, {{35172}, 1},
+  {{25289}, 1}, {{33240}, 1}, {{34847}, 1}, {{24266}, 1}, {{26391}, 1}, {{28010}, 1}, {{29436}, 1}, {{37070}, 1},
+  {{20358}, 1}, {{20919}, 1}, {{21214}, 1}, {{25796}, 1}, {{27347}, 1}, {{29200}, 1}, {{30439}, 1}, {{32769}, 1},
+  {{34310}, 1}, {{34396}, 1}, {{36335}, 1}, {{38706}, 1}, {{39791}, 1}, {{40442}, 1}, {{30860}, 1}, {{31103}, 1},
+  {{32160}, 1}, {{33737}, 1}, {{37636}, 1}, {{40575}, 1}, {{35542}, 1}, {{22751}, 1}, {{24324}, 1}, {{31840}, 1},
+  {{32894}, 1}, {{29282}, 1}, {{30922}, 1}, {{36034}, 1}, {{38647}, 1}, {{22744}, 1}, {{23650}, 1}, {{27155}, 1},
+  {{28122}, 1}, {{28431}, 1}, {{32047}, 1}, {{32311}, 1}, {{38475}, 1}, {{21202}, 1}, {{32907}, 1}, {{20956}, 1},
+  {{20940}, 1}, {{31260}, 1}, {{32190}, 1}, {{33777}, 1}, {{38517}, 1}, {{35712}, 1}, {{25295}, 1}, {{27138}, 1},
+  {{35582}, 1}, {{20025}, 1}, {{23527}, 1}, {{24594}, 1}, {{29575}, 1}, {{30064}, 1}, {{21271}, 1}, {{30971}, 1},
+  {{20415}, 1}, {{24489}, 1}, {{19981}, 1}, {{27852}, 1}, {{25976}, 1}, {{32034}, 1}, {{21443}, 1}, {{22622}, 1},
+  {{30465}, 1}, {{33865}, 1}, {{35498}, 1}, {{27578}, 1}, {{36784}, 1}, {{27784}, 1}, {{25342}, 1}, {{33509}, 1},
+  {{25504}, 1}, {{30053}, 1}, {{20142}, 1}, {{20841}, 1}, {{20937}, 1}, {{26753}, 1}, {{31975}, 1}, {{33391}, 1},
+  {{35538}, 1}, {{37327}, 1}, {{21237}, 1}, {{21570}, 1}, {{22899}, 1}, {{24300}, 1}, {{26053}, 1}, {{28670}, 1},
+  {{31018}, 1}, {{38317}, 1}, {{39530}, 1}, {{40599}, 1}, {{40654}, 1}, {{21147}, 1}, {{26310}, 1}, {{27511}, 1},
+  {{36706}, 1}, {{24180}, 1}, {{24976}, 1}, {{25088}, 1}, {{25754}, 1}, {{28451}, 1}, {{29001}, 1}, {{29833}, 1},
+  {{31178}, 1}, {{32244}, 1}, {{32879}, 1}, {{36646}, 1}, {{34030}, 1}, {{36899}, 1}, {{37706}, 1}, {{21015}, 1},
+  {{21155}, 1}, {{21693}, 1}, {{28872}, 1}, {{35010}, 1}, {{35498}, 1}, {{24265}, 1}, {{24565}, 1}, {{25467}, 1},
+  {{27566}, 1}, {{31806}, 1}, {{29557}, 1}, {{20196}, 1}, {{22265}, 1}, {{23527}, 1}, {{23994}, 1}, {{24604}, 1},
+  {{29618}, 1}, {{29801}, 1}, {{32666}, 1}, {{32838}, 1}, {{37428}, 1}, {{38646}, 1}, {{38728}, 1}, {{38936}, 1},
+  {{20363}, 1}, {{31150}, 1}, {{37300}, 1}, {{38584}, 1}, {{24801}, 1}, {{20102}, 1}, {{20698}, 1}, {{23534}, 1},
+  {{23615}, 1}, {{26009}, 1}, {{27138}, 1}, {{29134}, 1}, {{30274}, 1}, {{34044}, 1}, {{36988}, 1}, {{40845}, 1},
+  {{26248}, 1}, {{38446}, 1}, {{21129}, 1}, {{26491}, 1}, {{26611}, 1}, {{27969}, 1}, {{28316}, 1}, {{29705}, 1},
+  {{30041}, 1}, {{30827}, 1}, {{32016}, 1}, {{39006}, 1}, {{20845}, 1}, {{25134}, 1}, {{38520}, 1}, {{20523}, 1},
+  {{23833}, 1}, {{28138}, 1}, {{36650}, 1}, {{24459}, 1}, {{24900}, 1}, {{26647}, 1}, {{29575}, 1}, {{38534}, 1},
+  {{21033}, 1}, {{21519}, 1}, {{23653}, 1}, {{26131}, 1}, {{26446}, 1}, {{26792}, 1}, {{27877}, 1}, {{29702}, 1},
+  {{30178}, 1}, {{32633}, 1}, {{35023}, 1}, {{35041}, 1}, {{37324}, 1}, {{38626}, 1}, {{21311}, 1}, {{28346}, 1},
+  {{21533}, 1}, {{29136}, 1}, {{29848}, 1}, {{34298}, 1}, {{38563}, 1}, {{40023}, 1}, {{40607}, 1}, {{26519}, 1},
+  {{28107}, 1}, {{33256}, 1}, {{31435}, 1}, {{31520}, 1}, {{31890}, 1}, {{29376}, 1}, {{28825}, 1}, {{35672}, 1},
+  {{20160}, 1}, {{33590}, 1}, {{21050}, 1}, {{20999}, 1}, {{24230}, 1}, {{25299}, 1}, {{31958}, 1}, {{23429}, 1},
+  {{27934}, 1}, {{26292}, 1}, {{36667}, 1}, {{34892}, 1}, {{38477}, 1}, {{35211}, 1}, {{24275}, 1}, {{20800}, 1},
+  {{21952}, 1}, {{22618}, 1}, {{26228}, 1}, {{20958}, 1}, {{29482}, 1}, {{30410}, 1}, {{31036}, 1}, {{31070}, 1},
+  {{31077}, 1}, {{31119}, 1}, {{38742}, 1}, {{31934}, 1}, {{32701}, 1}, {{34322}, 1}, {{35576}, 1}, {{36920}, 1},
+  {{37117}, 1}, {{39151}, 1}, {{39164}, 1}, {{39208}, 1}, {{40372}, 1}, {{20398}, 1}, {{20711}, 1}, {{20813}, 1},
+  {{21193}, 1}, {{21220}, 1}, {{21329}, 1}, {{21917}, 1}, {{22022}, 1}, {{22120}, 1}, {{22592}, 1}, {{22696}, 1},
+  {{23652}, 1}, {{23662}, 1}, {{24724}, 1}, {{24936}, 1}, {{24974}, 1}, {{25074}, 1}, {{25935}, 1}, {{26082}, 1},
+  {{26257}, 1}, {{26757}, 1}, {{28023}, 1}, {{28186}, 1}, {{28450}, 1}, {{29038}, 1}, {{29227}, 1}, {{29730}, 1},
+  {{30865}, 1}, {{31038}, 1}, {{31049}, 1}, {{31048}, 1}, {{31056}, 1}, {{31062}, 1}, {{31069}, 1}, {{31117}, 1},
+  {{31118}, 1}, {{31296}, 1}, {{31361}, 1}, {{31680}, 1}, {{32244}, 1}, {{32265}, 1}, {{32321}, 1}, {{32626}, 1},
+  {{32773}, 1}, {{33261}, 1}, {{33401}, 1}, {{33401}, 1}, {{33879}, 1}, {{35088}, 1}, {{35222}, 1}, {{35585}, 1},
+  {{35641}, 1}, {{36051}, 1}, {{36104}, 1}, {{36790}, 1}, {{36920}, 1}, {{38627}, 1}, {{38911}, 1}, {{38971}, 1},
+  {{20006}, 1}, {{20917}, 1}, {{20840}, 1}, {{20352}, 1}, {{20805}, 1}, {{20864}, 1}, {{21191}, 1}, {{21242}, 1},
+  {{21917}, 1}, {{21845}, 1}, {{21913}, 1}, {{21986}, 1}, {{22618}, 1}, {{22707}, 1}, {{22852}, 1}, {{22868}, 1},
+  {{23138}, 1}, {{23336}, 1}, {{24274}, 1}, {{24281}, 1}, {{24425}, 1}, {{24493}, 1}, {{24792}, 1}, {{24910}, 1},
+  {{24840}, 1}, {{24974}, 1}, {{24928}, 1}, {{25074}, 1}, {{25140}, 1}, {{25540}, 1}, {{25628}, 1}, {{25682}, 1},
+  {{25942}, 1}, {{26228}, 1}, {{26391}, 1}, {{26395}, 1}, {{26454}, 1}, {{27513}, 1}, {{27578}, 1}, {{27969}, 1},
+  {{28379}, 1}, {{28363}, 1}, {{28450}, 1}, {{28702}, 1}, {{29038}, 1}, {{30631}, 1}, {{29237}, 1}, {{29359}, 1},
+  {{29482}, 1}, {{29809}, 1}, {{29958}, 1}, {{30011}, 1}, {{30237}, 1}, {{30239}, 1}, {{30410}, 1}, {{30427}, 1},
+  {{30452}, 1}, {{30538}, 1}, {{30528}, 1}, {{30924}, 1}, {{31409}, 1}, {{31680}, 1}, {{31867}, 1}, {{32091}, 1},
+  {{32244}, 1}, {{32574}, 1}, {{32773}, 1}, {{33618}, 1}, {{33775}, 1}, {{34681}, 1}, {{35137}, 1}, {{35206}, 1},
+  {{35222}, 1}, {{35519}, 1}, {{35576}, 1}, {{35531}, 1}, {{35585}, 1}, {{35582}, 1}, {{35565}, 1}, {{35641}, 1},
+  {{35722}, 1}, {{36104}, 1}, {{36664}, 1}, {{36978}, 1}, {{37273}, 1}, {{37494}, 1}, {{38524}, 1}, {{38627}, 1},
+  {{38742}, 1}, {{38875}, 1}, {{38911}, 1}, {{38923}, 1}, {{38971}, 1}, {{39698}, 1}, {{40860}, 1}, {{141386}, 1},
+  {{141380}, 1}, {{144341}, 1}, {{15261}, 1}, {{16408}, 1}, {{16441}, 1}, {{152137}, 1}, {{154832}, 1}, {{163539}, 1},
+  {{40771}, 1}, {{40846}, 1}, {{1497, 1460}, 2}, {{1522, 1463}, 2}, {{1513, 1473}, 2}, {{1513, 1474}, 2},
+  {{1513, 1468, 1473}, 3}, {{1513, 1468, 1474}, 3}, {{1488, 1463}, 2}, {{1488, 1464}, 2}, {{1488, 1468}, 2},
+  {{1489, 1468}, 2}, {{1490, 1468}, 2}, {{1491, 1468}, 2}, {{1492, 1468}, 2}, {{1493, 1468}, 2}, {{1494, 1468}, 2},
+  {{1496, 1468}, 2}, {{1497, 1468}, 2}, {{1498, 1468}, 2}, {{1499, 1468}, 2}, {{1500, 1468}, 2}, {{1502, 1468}, 2},
+  {{1504, 1468}, 2}, {{1505, 1468}, 2}, {{1507, 1468}, 2}, {{1508, 1468}, 2}, {{1510, 1468}, 2}, {{1511, 1468}, 2},
+  {{1512, 1468}, 2}, {{1513, 1468}, 2}, {{1514, 1468}, 2}, {{1493, 1465}, 2}, {{1489, 1471}, 2}, {{1499, 1471}, 2},
+  {{1508, 1471}, 2}, {{119127, 119141}, 2}, {{119128, 119141}, 2}, {{119128, 119141, 119150}, 3},
+  {{119128, 119141, 119151}, 3}, {{119128, 119141, 119152}, 3}, {{119128, 119141, 119153}, 3},
+  {{119128, 119141, 119154}, 3}, {{119225, 119141}, 2}, {{119226, 119141}, 2}, {{119225, 119141, 119150}, 3},
+  {{119226, 119141, 119150}, 3}, {{119225, 119141, 119151}, 3}, {{119226, 119141, 119151}, 3}, {{20029}, 1},
+  {{20024}, 1}, {{20033}, 1}, {{131362}, 1}, {{20320}, 1}, {{20398}, 1}, {{20411}, 1}, {{20482}, 1}, {{20602}, 1},
+  {{20633}, 1}, {{20711}, 1}, {{20687}, 1}, {{13470}, 1}, {{132666}, 1}, {{20813}, 1}, {{20820}, 1}, {{20836}, 1},
+  {{20855}, 1}, {{132380}, 1}, {{13497}, 1}, {{20839}, 1}, {{20877}, 1}, {{132427}, 1}, {{20887}, 1}, {{20900}, 1},
+  {{20172}, 1}, {{20908}, 1}, {{20917}, 1}, {{168415}, 1}, {{20981}, 1}, {{20995}, 1}, {{13535}, 1}, {{21051}, 1},
+  {{21062}, 1}, {{21106}, 1}, {{21111}, 1}, {{13589}, 1}, {{21191}, 1}, {{21193}, 1}, {{21220}, 1}, {{21242}, 1},
+  {{21253}, 1}, {{21254}, 1}, {{21271}, 1}, {{21321}, 1}, {{21329}, 1}, {{21338}, 1}, {{21363}, 1}, {{21373}, 1},
+  {{21375}, 1}, {{21375}, 1}, {{21375}, 1}, {{133676}, 1}, {{28784}, 1}, {{21450}, 1}, {{21471}, 1}, {{133987}, 1},
+  {{21483}, 1}, {{21489}, 1}, {{21510}, 1}, {{21662}, 1}, {{21560}, 1}, {{21576}, 1}, {{21608}, 1}, {{21666}, 1},
+  {{21750}, 1}, {{21776}, 1}, {{21843}, 1}, {{21859}, 1}, {{21892}, 1}, {{21892}, 1}, {{21913}, 1}, {{21931}, 1},
+  {{21939}, 1}, {{21954}, 1}, {{22294}, 1}, {{22022}, 1}, {{22295}, 1}, {{22097}, 1}, {{22132}, 1}, {{20999}, 1},
+  {{22766}, 1}, {{22478}, 1}, {{22516}, 1}, {{22541}, 1}, {{22411}, 1}, {{22578}, 1}, {{22577}, 1}, {{22700}, 1},
+  {{136420}, 1}, {{22770}, 1}, {{22775}, 1}, {{22790}, 1}, {{22810}, 1}, {{22818}, 1}, {{22882}, 1}, {{136872}, 1},
+  {{136938}, 1}, {{23020}, 1}, {{23067}, 1}, {{23079}, 1}, {{23000}, 1}, {{23142}, 1}, {{14062}, 1}, {{14076}, 1},
+  {{23304}, 1}, {{23358}, 1}, {{23358}, 1}, {{137672}, 1}, {{23491}, 1}, {{23512}, 1}, {{23527}, 1}, {{23539}, 1},
+  {{138008}, 1}, {{23551}, 1}, {{23558}, 1}, {{24403}, 1}, {{23586}, 1}, {{14209}, 1}, {{23648}, 1}, {{23662}, 1},
+  {{23744}, 1}, {{23693}, 1}, {{138724}, 1}, {{23875}, 1}, {{138726}, 1}, {{23918}, 1}, {{23915}, 1}, {{23932}, 1},
+  {{24033}, 1}, {{24034}, 1}, {{14383}, 1}, {{24061}, 1}, {{24104}, 1}, {{24125}, 1}, {{24169}, 1}, {{14434}, 1},
+  {{139651}, 1}, {{14460}, 1}, {{24240}, 1}, {{24243}, 1}, {{24246}, 1}, {{24266}, 1}, {{172946}, 1}, {{24318}, 1},
+  {{140081}, 1}, {{140081}, 1}, {{33281}, 1}, {{24354}, 1}, {{24354}, 1}, {{14535}, 1}, {{144056}, 1}, {{156122}, 1},
+  {{24418}, 1}, {{24427}, 1}, {{14563}, 1}, {{24474}, 1}, {{24525}, 1}, {{24535}, 1}, {{24569}, 1}, {{24705}, 1},
+  {{14650}, 1}, {{14620}, 1}, {{24724}, 1}, {{141012}, 1}, {{24775}, 1}, {{24904}, 1}, {{24908}, 1}, {{24910}, 1},
+  {{24908}, 1}, {{24954}, 1}, {{24974}, 1}, {{25010}, 1}, {{24996}, 1}, {{25007}, 1}, {{25054}, 1}, {{25074}, 1},
+  {{25078}, 1}, {{25104}, 1}, {{25115}, 1}, {{25181}, 1}, {{25265}, 1}, {{25300}, 1}, {{25424}, 1}, {{142092}, 1},
+  {{25405}, 1}, {{25340}, 1}, {{25448}, 1}, {{25475}, 1}, {{25572}, 1}, {{142321}, 1}, {{25634}, 1}, {{25541}, 1},
+  {{25513}, 1}, {{14894}, 1}, {{25705}, 1}, {{25726}, 1}, {{25757}, 1}, {{25719}, 1}, {{14956}, 1}, {{25935}, 1},
+  {{25964}, 1}, {{143370}, 1}, {{26083}, 1}, {{26360}, 1}, {{26185}, 1}, {{15129}, 1}, {{26257}, 1}, {{15112}, 1},
+  {{15076}, 1}, {{20882}, 1}, {{20885}, 1}, {{26368}, 1}, {{26268}, 1}, {{32941}, 1}, {{17369}, 1}, {{26391}, 1},
+  {{26395}, 1}, {{26401}, 1}, {{26462}, 1}, {{26451}, 1}, {{144323}, 1}, {{15177}, 1}, {{26618}, 1}, {{26501}, 1},
+  {{26706}, 1}, {{26757}, 1}, {{144493}, 1}, {{26766}, 1}, {{26655}, 1}, {{26900}, 1}, {{15261}, 1}, {{26946}, 1},
+  {{27043}, 1}, {{27114}, 1}, {{27304}, 1}, {{145059}, 1}, {{27355}, 1}, {{15384}, 1}, {{27425}, 1}, {{145575}, 1},
+  {{27476}, 1}, {{15438}, 1}, {{27506}, 1}, {{27551}, 1}, {{27578}, 1}, {{27579}, 1}, {{146061}, 1}, {{138507}, 1},
+  {{146170}, 1}, {{27726}, 1}, {{146620}, 1}, {{27839}, 1}, {{27853}, 1}, {{27751}, 1}, {{27926}, 1}, {{27966}, 1},
+  {{28023}, 1}, {{27969}, 1}, {{28009}, 1}, {{28024}, 1}, {{28037}, 1}, {{146718}, 1}, {{27956}, 1}, {{28207}, 1},
+  {{28270}, 1}, {{15667}, 1}, {{28363}, 1}, {{28359}, 1}, {{147153}, 1}, {{28153}, 1}, {{28526}, 1}, {{147294}, 1},
+  {{147342}, 1}, {{28614}, 1}, {{28729}, 1}, {{28702}, 1}, {{28699}, 1}, {{15766}, 1}, {{28746}, 1}, {{28797}, 1},
+  {{28791}, 1}, {{28845}, 1}, {{132389}, 1}, {{28997}, 1}, {{148067}, 1}, {{29084}, 1}, {{148395}, 1}, {{29224}, 1},
+  {{29237}, 1}, {{29264}, 1}, {{149000}, 1}, {{29312}, 1}, {{29333}, 1}, {{149301}, 1}, {{149524}, 1}, {{29562}, 1},
+  {{29579}, 1}, {{16044}, 1}, {{29605}, 1}, {{16056}, 1}, {{16056}, 1}, {{29767}, 1}, {{29788}, 1}, {{29809}, 1},
+  {{29829}, 1}, {{29898}, 1}, {{16155}, 1}, {{29988}, 1}, {{150582}, 1}, {{30014}, 1}, {{150674}, 1}, {{30064}, 1},
+  {{139679}, 1}, {{30224}, 1}, {{151457}, 1}, {{151480}, 1}, {{151620}, 1}, {{16380}, 1}, {{16392}, 1}, {{30452}, 1},
+  {{151795}, 1}, {{151794}, 1}, {{151833}, 1}, {{151859}, 1}, {{30494}, 1}, {{30495}, 1}, {{30495}, 1}, {{30538}, 1},
+  {{16441}, 1}, {{30603}, 1}, {{16454}, 1}, {{16534}, 1}, {{152605}, 1}, {{30798}, 1}, {{30860}, 1}, {{30924}, 1},
+  {{16611}, 1}, {{153126}, 1}, {{31062}, 1}, {{153242}, 1}, {{153285}, 1}, {{31119}, 1}, {{31211}, 1}, {{16687}, 1},
+  {{31296}, 1}, {{31306}, 1}, {{31311}, 1}, {{153980}, 1}, {{154279}, 1}, {{154279}, 1}, {{31470}, 1}, {{16898}, 1},
+  {{154539}, 1}, {{31686}, 1}, {{31689}, 1}, {{16935}, 1}, {{154752}, 1}, {{31954}, 1}, {{17056}, 1}, {{31976}, 1},
+  {{31971}, 1}, {{32000}, 1}, {{155526}, 1}, {{32099}, 1}, {{17153}, 1}, {{32199}, 1}, {{32258}, 1}, {{32325}, 1},
+  {{17204}, 1}, {{156200}, 1}, {{156231}, 1}, {{17241}, 1}, {{156377}, 1}, {{32634}, 1}, {{156478}, 1}, {{32661}, 1},
+  {{32762}, 1}, {{32773}, 1}, {{156890}, 1}, {{156963}, 1}, {{32864}, 1}, {{157096}, 1}, {{32880}, 1}, {{144223}, 1},
+  {{17365}, 1}, {{32946}, 1}, {{33027}, 1}, {{17419}, 1}, {{33086}, 1}, {{23221}, 1}, {{157607}, 1}, {{157621}, 1},
+  {{144275}, 1}, {{144284}, 1}, {{33281}, 1}, {{33284}, 1}, {{36766}, 1}, {{17515}, 1}, {{33425}, 1}, {{33419}, 1},
+  {{33437}, 1}, {{21171}, 1}, {{33457}, 1}, {{33459}, 1}, {{33469}, 1}, {{33510}, 1}, {{158524}, 1}, {{33509}, 1},
+  {{33565}, 1}, {{33635}, 1}, {{33709}, 1}, {{33571}, 1}, {{33725}, 1}, {{33767}, 1}, {{33879}, 1}, {{33619}, 1},
+  {{33738}, 1}, {{33740}, 1}, {{33756}, 1}, {{158774}, 1}, {{159083}, 1}, {{158933}, 1}, {{17707}, 1}, {{34033}, 1},
+  {{34035}, 1}, {{34070}, 1}, {{160714}, 1}, {{34148}, 1}, {{159532}, 1}, {{17757}, 1}, {{17761}, 1}, {{159665}, 1},
+  {{159954}, 1}, {{17771}, 1}, {{34384}, 1}, {{34396}, 1}, {{34407}, 1}, {{34409}, 1}, {{34473}, 1}, {{34440}, 1},
+  {{34574}, 1}, {{34530}, 1}, {{34681}, 1}, {{34600}, 1}, {{34667}, 1}, {{34694}, 1}, {{17879}, 1}, {{34785}, 1},
+  {{34817}, 1}, {{17913}, 1}, {{34912}, 1}, {{34915}, 1}, {{161383}, 1}, {{35031}, 1}, {{35038}, 1}, {{17973}, 1},
+  {{35066}, 1}, {{13499}, 1}, {{161966}, 1}, {{162150}, 1}, {{18110}, 1}, {{18119}, 1}, {{35488}, 1}, {{35565}, 1},
+  {{35722}, 1}, {{35925}, 1}, {{162984}, 1}, {{36011}, 1}, {{36033}, 1}, {{36123}, 1}, {{36215}, 1}, {{163631}, 1},
+  {{133124}, 1}, {{36299}, 1}, {{36284}, 1}, {{36336}, 1}, {{133342}, 1}, {{36564}, 1}, {{36664}, 1}, {{165330}, 1},
+  {{165357}, 1}, {{37012}, 1}, {{37105}, 1}, {{37137}, 1}, {{165678}, 1}, {{37147}, 1}, {{37432}, 1}, {{37591}, 1},
+  {{37592}, 1}, {{37500}, 1}, {{37881}, 1}, {{37909}, 1}, {{166906}, 1}, {{38283}, 1}, {{18837}, 1}, {{38327}, 1},
+  {{167287}, 1}, {{18918}, 1}, {{38595}, 1}, {{23986}, 1}, {{38691}, 1}, {{168261}, 1}, {{168474}, 1}, {{19054}, 1},
+  {{19062}, 1}, {{38880}, 1}, {{168970}, 1}, {{19122}, 1}, {{169110}, 1}, {{38923}, 1}, {{38923}, 1}, {{38953}, 1},
+  {{169398}, 1}, {{39138}, 1}, {{19251}, 1}, {{39209}, 1}, {{39335}, 1}, {{39362}, 1}, {{39422}, 1}, {{19406}, 1},
+  {{170800}, 1}, {{39698}, 1}, {{40000}, 1}, {{40189}, 1}, {{19662}, 1}, {{19693}, 1}, {{40295}, 1}, {{172238}, 1},
+  {{19704}, 1}, {{172293}, 1}, {{172558}, 1}, {{172689}, 1}, {{40635}, 1}, {{19798}, 1}, {{40697}, 1}, {{40702}, 1},
+  {{40709}, 1}, {{40719}, 1}, {{40726}, 1}, {{40763}, 1}, {{173568}, 1}
+};
+
+/* Primary composites: canonical decompositions of length 2 which are not excluded from composition (see
+ * http://www.unicode.org/Public/4.0-Update/CompositionExclusions-4.0.0.txt), sorted by the decomposition. */
+struct Composition {
+  KInt first;
+  KInt second;
+  KInt composite;
+};
+
+constexpr Composition compositions[] = {
+  {60, 824, 8814}, {61, 824, 8800}, {62, 824, 8815}, {65, 768, 192}, {65, 769, 193}, {65, 770, 194}, {65, 771, 195},
+  {65, 772, 256}, {65, 774, 258}, {65, 775, 550}, {65, 776, 196}, {65, 777, 7842}, {65, 778, 197}, {65, 780, 461},
+  {65, 783, 512}, {65, 785, 514}, {65, 803, 7840}, {65, 805, 7680}, {65, 808, 260}, {66, 775, 7682}, {66, 803, 7684},
+  {66, 817, 7686}, {67, 769, 262}, {67, 770, 264}, {67, 775, 266}, {67, 780, 268}, {67, 807, 199}, {68, 775, 7690},
+  {68, 780, 270}, {68, 803, 7692}, {68, 807, 7696}, {68, 813, 7698}, {68, 817, 7694}, {69, 768, 200}, {69, 769, 201},
+  {69, 770, 202}, {69, 771, 7868}, {69, 772, 274}, {69, 774, 276}, {69, 775, 278}, {69, 776, 203}, {69, 777, 7866},
+  {69, 780, 282}, {69, 783, 516}, {69, 785, 518}, {69, 803, 7864}, {69, 807, 552}, {69, 808, 280}, {69, 813, 7704},
+  {69, 816, 7706}, {70, 775, 7710}, {71, 769, 500}, {71, 770, 284}, {71, 772, 7712}, {71, 774, 286}, {71, 775, 288},
+  {71, 780, 486}, {71, 807, 290}, {72, 770, 292}, {72, 775, 7714}, {72, 776, 7718}, {72, 780, 542}, {72, 803, 7716},
+  {72, 807, 7720}, {72, 814, 7722}, {73, 768, 204}, {73, 769, 205}, {73, 770, 206}, {73, 771, 296}, {73, 772, 298},
+  {73, 774, 300}, {73, 775, 304}, {73, 776, 207}, {73, 777, 7880}, {73, 780, 463}, {73, 783, 520}, {73, 785, 522},
+  {73, 803, 7882}, {73, 808, 302}, {73, 816, 7724}, {74, 770, 308}, {75, 769, 7728}, {75, 780, 488}, {75, 803, 7730},
+  {75, 807, 310}, {75, 817, 7732}, {76, 769, 313}, {76, 780, 317}, {76, 803, 7734}, {76, 807, 315}, {76, 813, 7740},
+  {76, 817, 7738}, {77, 769, 7742}, {77, 775, 7744}, {77, 803, 7746}, {78, 768, 504}, {78, 769, 323}, {78, 771, 209},
+  {78, 775, 7748}, {78, 780, 327}, {78, 803, 7750}, {78, 807, 325}, {78, 813, 7754}, {78, 817, 7752}, {79, 768, 210},
+  {79, 769, 211}, {79, 770, 212}, {79, 771, 213}, {79, 772, 332}, {79, 774, 334}, {79, 775, 558}, {79, 776, 214},
+  {79, 777, 7886}, {79, 779, 336}, {79, 780, 465}, {79, 783, 524}, {79, 785, 526}, {79, 795, 416}, {79, 803, 7884},
+  {79, 808, 490}, {80, 769, 7764}, {80, 775, 7766}, {82, 769, 340}, {82, 775, 7768}, {82, 780, 344}, {82, 783, 528},
+  {82, 785, 530}, {82, 803, 7770}, {82, 807, 342}, {82, 817, 7774}, {83, 769, 346}, {83, 770, 348}, {83, 775, 7776},
+  {83, 780, 352}, {83, 803, 7778}, {83, 806, 536}, {83, 807, 350}, {84, 775, 7786}, {84, 780, 356}, {84, 803, 7788},
+  {84, 806, 538}, {84, 807, 354}, {84, 813, 7792}, {84, 817, 7790}, {85, 768, 217}, {85, 769, 218}, {85, 770, 219},
+  {85, 771, 360}, {85, 772, 362}, {85, 774, 364}, {85, 776, 220}, {85, 777, 7910}, {85, 778, 366}, {85, 779, 368},
+  {85, 780, 467}, {85, 783, 532}, {85, 785, 534}, {85, 795, 431}, {85, 803, 7908}, {85, 804, 7794}, {85, 808, 370},
+  {85, 813, 7798}, {85, 816, 7796}, {86, 771, 7804}, {86, 803, 7806}, {87, 768, 7808}, {87, 769, 7810}, {87, 770, 372},
+  {87, 775, 7814}, {87, 776, 7812}, {87, 803, 7816}, {88, 775, 7818}, {88, 776, 7820}, {89, 768, 7922}, {89, 769, 221},
+  {89, 770, 374}, {89, 771, 7928}, {89, 772, 562}, {89, 775, 7822}, {89, 776, 376}, {89, 777, 7926}, {89, 803, 7924},
+  {90, 769, 377}, {90, 770, 7824}, {90, 775, 379}, {90, 780, 381}, {90, 803, 7826}, {90, 817, 7828}, {97, 768, 224},
+  {97, 769, 225}, {97, 770, 226}, {97, 771, 227}, {97, 772, 257}, {97, 774, 259}, {97, 775, 551}, {97, 776, 228},
+  {97, 777, 7843}, {97, 778, 229}, {97, 780, 462}, {97, 783, 513}, {97, 785, 515}, {97, 803, 7841}, {97, 805, 7681},
+  {97, 808, 261}, {98, 775, 7683}, {98, 803, 7685}, {98, 817, 7687}, {99, 769, 263}, {99, 770, 265}, {99, 775, 267},
+  {99, 780, 269}, {99, 807, 231}, {100, 775, 7691}, {100, 780, 271}, {100, 803, 7693}, {100, 807, 7697},
+  {100, 813, 7699}, {100, 817, 7695}, {101, 768, 232}, {101, 769, 233}, {101, 770, 234}, {101, 771, 7869},
+  {101, 772, 275}, {101, 774, 277}, {101, 775, 279}, {101, 776, 235}, {101, 777, 7867}, {101, 780, 283},
+  {101, 783, 517}, {101, 785, 519}, {101, 803, 7865}, {101, 807, 553}, {101, 808, 281}, {101, 813, 7705},
+  {101, 816, 7707}, {102, 775, 7711}, {103, 769, 501}, {103, 770, 285}, {103, 772, 7713}, {103, 774, 287},
+  {103, 775, 289}, {103, 780, 487}, {103, 807, 291}, {104, 770, 293}, {104, 775, 7715}, {104, 776, 7719},
+  {104, 780, 543}, {104, 803, 7717}, {104, 807, 7721}, {104, 814, 7723}, {104, 817, 7830}, {105, 768, 236},
+  {105, 769, 237}, {105, 770, 238}, {105, 771, 297}, {105, 772, 299}, {105, 774, 301}, {105, 776, 239},
+  {105, 777, 7881}, {105, 780, 464}, {105, 783, 521}, {105, 785, 523}, {105, 803, 7883}, {105, 808, 303},
+  {105, 816, 7725}, {106, 770, 309}, {106, 780, 496}, {107, 769, 7729}, {107, 780, 489}, {107, 803, 7731},
+  {107, 807, 311}, {107, 817, 7733}, {108, 769, 314}, {108, 780, 318}, {108, 803, 7735}, {108, 807, 316},
+  {108, 813, 7741}, {108, 817, 7739}, {109, 769, 7743}, {109, 775, 7745}, {109, 803, 7747}, {110, 768, 505},
+  {110, 769, 324}, {110, 771, 241}, {110, 775, 7749}, {110, 780, 328}, {110, 803, 7751}, {110, 807, 326},
+  {110, 813, 7755}, {110, 817, 7753}, {111, 768, 242}, {111, 769, 243}, {111, 770, 244}, {111, 771, 245},
+  {111, 772, 333}, {111, 774, 335}, {111, 775, 559}, {111, 776, 246}, {111, 777, 7887}, {111, 779, 337},
+  {111, 780, 466}, {111, 783, 525}, {111, 785, 527}, {111, 795, 417}, {111, 803, 7885}, {111, 808, 491},
+  {112, 769, 7765}, {112, 775, 7767}, {114, 769, 341}, {114, 775, 7769}, {114, 780, 345}, {114, 783, 529},
+  {114, 785, 531}, {114, 803, 7771}, {114, 807, 343}, {114, 817, 7775}, {115, 769, 347}, {115, 770, 349},
+  {115, 775, 7777}, {115, 780, 353}, {115, 803, 7779}, {115, 806, 537}, {115, 807, 351}, {116, 775, 7787},
+  {116, 776, 7831}, {116, 780, 357}, {116, 803, 7789}, {116, 806, 539}, {116, 807, 355}, {116, 813, 7793},
+  {116, 817, 7791}, {117, 768, 249}, {117, 769, 250}, {117, 770, 251}, {117, 771, 361}, {117, 772, 363},
+  {117, 774, 365}, {117, 776, 252}, {117, 777, 7911}, {117, 778, 367}, {117, 779, 369}, {117, 780, 468},
+  {117, 783, 533}, {117, 785, 535}, {117, 795, 432}, {117, 803, 7909}, {117, 804, 7795}, {117, 808, 371},
+  {117, 813, 7799}, {117, 816, 7797}, {118, 771, 7805}, {118, 803, 7807}, {119, 768, 7809}, {119, 769, 7811},
+  {119, 770, 373}, {119, 775, 7815}, {119, 776, 7813}, {119, 778, 7832}, {119, 803, 7817}, {120, 775, 7819},
+  {120, 776, 7821}, {121, 768, 7923}, {121, 769, 253}, {121, 770, 375}, {121, 771, 7929}, {121, 772, 563},
+  {121, 775, 7823}, {121, 776, 255}, {121, 777, 7927}, {121, 778, 7833}, {121, 803, 7925}, {122, 769, 378},
+  {122, 770, 7825}, {122, 775, 380}, {122, 780, 382}, {122, 803, 7827}, {122, 817, 7829}, {168, 768, 8173},
+  {168, 769, 901}, {168, 834, 8129}, {194, 768, 7846}, {194, 769, 7844}, {194, 771, 7850}, {194, 777, 7848},
+  {196, 772, 478}, {197, 769, 506}, {198, 769, 508}, {198, 772, 482}, {199, 769, 7688}, {202, 768, 7872},
+  {202, 769, 7870}, {202, 771, 7876}, {202, 777, 7874}, {207, 769, 7726}, {212, 768, 7890}, {212, 769, 7888},
+  {212, 771, 7894}, {212, 777, 7892}, {213, 769, 7756}, {213, 772, 556}, {213, 776, 7758}, {214, 772, 554},
+  {216, 769, 510}, {220, 768, 475}, {220, 769, 471}, {220, 772, 469}, {220, 780, 473}, {226, 768, 7847},
+  {226, 769, 7845}, {226, 771, 7851}, {226, 777, 7849}, {228, 772, 479}, {229, 769, 507}, {230, 769, 509},
+  {230, 772, 483}, {231, 769, 7689}, {234, 768, 7873}, {234, 769, 7871}, {234, 771, 7877}, {234, 777, 7875},
+  {239, 769, 7727}, {244, 768, 7891}, {244, 769, 7889}, {244, 771, 7895}, {244, 777, 7893}, {245, 769, 7757},
+  {245, 772, 557}, {245, 776, 7759}, {246, 772, 555}, {248, 769, 511}, {252, 768, 476}, {252, 769, 472},
+  {252, 772, 470}, {252, 780, 474}, {258, 768, 7856}, {258, 769, 7854}, {258, 771, 7860}, {258, 777, 7858},
+  {259, 768, 7857}, {259, 769, 7855}, {259, 771, 7861}, {259, 777, 7859}, {274, 768, 7700}, {274, 769, 7702},
+  {275, 768, 7701}, {275, 769, 7703}, {332, 768, 7760}, {332, 769, 7762}, {333, 768, 7761}, {333, 769, 7763},
+  {346, 775, 7780}, {347, 775, 7781}, {352, 775, 7782}, {353, 775, 7783}, {360, 769, 7800}, {361, 769, 7801},
+  {362, 776, 7802}, {363, 776, 7803}, {383, 775, 7835}, {416, 768, 7900}, {416, 769, 7898}, {416, 771, 7904},
+  {416, 777, 7902}, {416, 803, 7906}, {417, 768, 7901}, {417, 769, 7899}, {417, 771, 7905}, {417, 777, 7903},
+  {417, 803, 7907}, {431, 768, 7914}, {431, 769, 7912}, {431, 771, 7918}, {431, 777, 7916}, {431, 803, 7920},
+  {432, 768, 7915}, {432, 769, 7913}, {432, 771, 7919}, {432, 777, 7917}, {432, 803, 7921}, {439, 780, 494},
+  {490, 772, 492}, {491, 772, 493}, {550, 772, 480}, {551, 772, 481}, {552, 774, 7708}, {553, 774, 7709},
+  {558, 772, 560}, {559, 772, 561}, {658, 780, 495}, {913, 768, 8122}, {913, 769, 902}, {913, 772, 8121},
+  {913, 774, 8120}, {913, 787, 7944}, {913, 788, 7945}, {913, 837, 8124}, {917, 768, 8136}, {917, 769, 904},
+  {917, 787, 7960}, {917, 788, 7961}, {919, 768, 8138}, {919, 769, 905}, {919, 787, 7976}, {919, 788, 7977},
+  {919, 837, 8140}, {921, 768, 8154}, {921, 769, 906}, {921, 772, 8153}, {921, 774, 8152}, {921, 776, 938},
+  {921, 787, 7992}, {921, 788, 7993}, {927, 768, 8184}, {927, 769, 908}, {927, 787, 8008}, {927, 788, 8009},
+  {929, 788, 8172}, {933, 768, 8170}, {933, 769, 910}, {933, 772, 8169}, {933, 774, 8168}, {933, 776, 939},
+  {933, 788, 8025}, {937, 768, 8186}, {937, 769, 911}, {937, 787, 8040}, {937, 788, 8041}, {937, 837, 8188},
+  {940, 837, 8116}, {942, 837, 8132}, {945, 768, 8048}, {945, 769, 940}, {945, 772, 8113}, {945, 774, 8112},
+  {945, 787, 7936}, {945, 788, 7937}, {945, 834, 8118}, {945, 837, 8115}, {949, 768, 8050}, {949, 769, 941},
+  {949, 787, 7952}, {949, 788, 7953}, {951, 768, 8052}, {951, 769, 942}, {951, 787, 7968}, {951, 788, 7969},
+  {951, 834, 8134}, {951, 837, 8131}, {953, 768, 8054}, {953, 769, 943}, {953, 772, 8145}, {953, 774, 8144},
+  {953, 776, 970}, {953, 787, 7984}, {953, 788, 7985}, {953, 834, 8150}, {959, 768, 8056}, {959, 769, 972},
+  {959, 787, 8000}, {959, 788, 8001}, {961, 787, 8164}, {961, 788, 8165}, {965, 768, 8058}, {965, 769, 973},
+  {965, 772, 8161}, {965, 774, 8160}, {965, 776, 971}, {965, 787, 8016}, {965, 788, 8017}, {965, 834, 8166},
+  {969, 768, 8060}, {969, 769, 974}, {969, 787, 8032}, {969, 788, 8033}, {969, 834, 8182}, {969, 837, 8179},
+  {970, 768, 8146}, {970, 769, 912}, {970, 834, 8151}, {971, 768, 8162}, {971, 769, 944}, {971, 834, 8167},
+  {974, 837, 8180}, {978, 769, 979}, {978, 776, 980}, {1030, 776, 1031}, {1040, 774, 1232}, {1040, 776, 1234},
+  {1043, 769, 1027}, {1045, 768, 1024}, {1045, 774, 1238}, {1045, 776, 1025}, {1046, 774, 1217}, {1046, 776, 1244},
+  {1047, 776, 1246}, {1048, 768, 1037}, {1048, 772, 1250}, {1048, 774, 1049}, {1048, 776, 1252}, {1050, 769, 1036},
+  {1054, 776, 1254}, {1059, 772, 1262}, {1059, 774, 1038}, {1059, 776, 1264}, {1059, 779, 1266}, {1063, 776, 1268},
+  {1067, 776, 1272}, {1069, 776, 1260}, {1072, 774, 1233}, {1072, 776, 1235}, {1075, 769, 1107}, {1077, 768, 1104},
+  {1077, 774, 1239}, {1077, 776, 1105}, {1078, 774, 1218}, {1078, 776, 1245}, {1079, 776, 1247}, {1080, 768, 1117},
+  {1080, 772, 1251}, {1080, 774, 1081}, {1080, 776, 1253}, {1082, 769, 1116}, {1086, 776, 1255}, {1091, 772, 1263},
+  {1091, 774, 1118}, {1091, 776, 1265}, {1091, 779, 1267}, {1095, 776, 1269}, {1099, 776, 1273}, {1101, 776, 1261},
+  {1110, 776, 1111}, {1140, 783, 1142}, {1141, 783, 1143}, {1240, 776, 1242}, {1241, 776, 1243}, {1256, 776, 1258},
+  {1257, 776, 1259}, {1575, 1619, 1570}, {1575, 1620, 1571}, {1575, 1621, 1573}, {1608, 1620, 1572},
+  {1610, 1620, 1574}, {1729, 1620, 1730}, {1746, 1620, 1747}, {1749, 1620, 1728}, {2344, 2364, 2345},
+  {2352, 2364, 2353}, {2355, 2364, 2356}, {2503, 2494, 2507}, {2503, 2519, 2508}, {2887, 2878, 2891},
+  {2887, 2902, 2888}, {2887, 2903, 2892}, {2962, 3031, 2964}, {3014, 3006, 3018}, {3014, 3031, 3020},
+  {3015, 3006, 3019}, {3142, 3158, 3144}, {3263, 3285, 3264}, {3270, 3266, 3274}, {3270, 3285, 3271},
+  {3270, 3286, 3272}, {3274, 3285, 3275}, {3398, 3390, 3402}, {3398, 3415, 3404}, {3399, 3390, 3403},
+  {3545, 3530, 3546}, {3545, 3535, 3548}, {3545, 3551, 3550}, {3548, 3530, 3549}, {4133, 4142, 4134},
+  {7734, 772, 7736}, {7735, 772, 7737}, {7770, 772, 7772}, {7771, 772, 7773}, {7778, 775, 7784}, {7779, 775, 7785},
+  {7840, 770, 7852}, {7840, 774, 7862}, {7841, 770, 7853}, {7841, 774, 7863}, {7864, 770, 7878}, {7865, 770, 7879},
+  {7884, 770, 7896}, {7885, 770, 7897}, {7936, 768, 7938}, {7936, 769, 7940}, {7936, 834, 7942}, {7936, 837, 8064},
+  {7937, 768, 7939}, {7937, 769, 7941}, {7937, 834, 7943}, {7937, 837, 8065}, {7938, 837, 8066}, {7939, 837, 8067},
+  {7940, 837, 8068}, {7941, 837, 8069}, {7942, 837, 8070}, {7943, 837, 8071}, {7944, 768, 7946}, {7944, 769, 7948},
+  {7944, 834, 7950}, {7944, 837, 8072}, {7945, 768, 7947}, {7945, 769, 7949}, {7945, 834, 7951}, {7945, 837, 8073},
+  {7946, 837, 8074}, {7947, 837, 8075}, {7948, 837, 8076}, {7949, 837, 8077}, {7950, 837, 8078}, {7951, 837, 8079},
+  {7952, 768, 7954}, {7952, 769, 7956}, {7953, 768, 7955}, {7953, 769, 7957}, {7960, 768, 7962}, {7960, 769, 7964},
+  {7961, 768, 7963}, {7961, 769, 7965}, {7968, 768, 7970}, {7968, 769, 7972}, {7968, 834, 7974}, {7968, 837, 8080},
+  {7969, 768, 7971}, {7969, 769, 7973}, {7969, 834, 7975}, {7969, 837, 8081}, {7970, 837, 8082}, {7971, 837, 8083},
+  {7972, 837, 8084}, {7973, 837, 8085}, {7974, 837, 8086}, {7975, 837, 8087}, {7976, 768, 7978}, {7976, 769, 7980},
+  {7976, 834, 7982}, {7976, 837, 8088}, {7977, 768, 7979}, {7977, 769, 7981}, {7977, 834, 7983}, {7977, 837, 8089},
+  {7978, 837, 8090}, {7979, 837, 8091}, {7980, 837, 8092}, {7981, 837, 8093}, {7982, 837, 8094}, {7983, 837, 8095},
+  {7984, 768, 7986}, {7984, 769, 7988}, {7984, 834, 7990}, {7985, 768, 7987}, {7985, 769, 7989}, {7985, 834, 7991},
+  {7992, 768, 7994}, {7992, 769, 7996}, {7992, 834, 7998}, {7993, 768, 7995}, {7993, 769, 7997}, {7993, 834, 7999},
+  {8000, 768, 8002}, {8000, 769, 8004}, {8001, 768, 8003}, {8001, 769, 8005}, {8008, 768, 8010}, {8008, 769, 8012},
+  {8009, 768, 8011}, {8009, 769, 8013}, {8016, 768, 8018}, {8016, 769, 8020}, {8016, 834, 8022}, {8017, 768, 8019},
+  {8017, 769, 8021}, {8017, 834, 8023}, {8025, 768, 8027}, {8025, 769, 8029}, {8025, 834, 8031}, {8032, 768, 8034},
+  {8032, 769, 8036}, {8032, 834, 8038}, {8032, 837, 8096}, {8033, 768, 8035}, {8033, 769, 8037}, {8033, 834, 8039},
+  {8033, 837, 8097}, {8034, 837, 8098}, {8035, 837, 8099}, {8036, 837, 8100}, {8037, 837, 8101}, {8038, 837, 8102},
+  {8039, 837, 8103}, {8040, 768, 8042}, {8040, 769, 8044}, {8040, 834, 8046}, {8040, 837, 8104}, {8041, 768, 8043},
+  {8041, 769, 8045}, {8041, 834, 8047}, {8041, 837, 8105}, {8042, 837, 8106}, {8043, 837, 8107}, {8044, 837, 8108},
+  {8045, 837, 8109}, {8046, 837, 8110}, {8047, 837, 8111}, {8048, 837, 8114}, {8052, 837, 8130}, {8060, 837, 8178},
+  {8118, 837, 8119}, {8127, 768, 8141}, {8127, 769, 8142}, {8127, 834, 8143}, {8134, 837, 8135}, {8182, 837, 8183},
+  {8190, 768, 8157}, {8190, 769, 8158}, {8190, 834, 8159}, {8592, 824, 8602}, {8594, 824, 8603}, {8596, 824, 8622},
+  {8656, 824, 8653}, {8658, 824, 8655}, {8660, 824, 8654}, {8707, 824, 8708}, {8712, 824, 8713}, {8715, 824, 8716},
+  {8739, 824, 8740}, {8741, 824, 8742}, {8764, 824, 8769}, {8771, 824, 8772}, {8773, 824, 8775}, {8776, 824, 8777},
+  {8781, 824, 8813}, {8801, 824, 8802}, {8804, 824, 8816}, {8805, 824, 8817}, {8818, 824, 8820}, {8819, 824, 8821},
+  {8822, 824, 8824}, {8823, 824, 8825}, {8826, 824, 8832}, {8827, 824, 8833}, {8828, 824, 8928}, {8829, 824, 8929},
+  {8834, 824, 8836}, {8835, 824, 8837}, {8838, 824, 8840}, {8839, 824, 8841}, {8849, 824, 8930}, {8850, 824, 8931},
+  {8866, 824, 8876}, {8872, 824, 8877}, {8873, 824, 8878}, {8875, 824, 8879}, {8882, 824, 8938}, {8883, 824, 8939},
+  {8884, 824, 8940}, {8885, 824, 8941}, {12358, 12441, 12436}, {12363, 12441, 12364}, {12365, 12441, 12366},
+  {12367, 12441, 12368}, {12369, 12441, 12370}, {12371, 12441, 12372}, {12373, 12441, 12374}, {12375, 12441, 12376},
+  {12377, 12441, 12378}, {12379, 12441, 12380}, {12381, 12441, 12382}, {12383, 12441, 12384}, {12385, 12441, 12386},
+  {12388, 12441, 12389}, {12390, 12441, 12391}, {12392, 12441, 12393}, {12399, 12441, 12400}, {12399, 12442, 12401},
+  {12402, 12441, 12403}, {12402, 12442, 12404}, {12405, 12441, 12406}, {12405, 12442, 12407}, {12408, 12441, 12409},
+  {12408, 12442, 12410}, {12411, 12441, 12412}, {12411, 12442, 12413}, {12445, 12441, 12446}, {12454, 12441, 12532},
+  {12459, 12441, 12460}, {12461, 12441, 12462}, {12463, 12441, 12464}, {12465, 12441, 12466}, {12467, 12441, 12468},
+  {12469, 12441, 12470}, {12471, 12441, 12472}, {12473, 12441, 12474}, {12475, 12441, 12476}, {12477, 12441, 12478},
+  {12479, 12441, 12480}, {12481, 12441, 12482}, {12484, 12441, 12485}, {12486, 12441, 12487}, {12488, 12441, 12489},
+  {12495, 12441, 12496}, {12495, 12442, 12497}, {12498, 12441, 12499}, {12498, 12442, 12500}, {12501, 12441, 12502},
+  {12501, 12442, 12503}, {12504, 12441, 12505}, {12504, 12442, 12506}, {12507, 12441, 12508}, {12507, 12442, 12509},
+  {12527, 12441, 12535}, {12528, 12441, 12536}, {12529, 12441, 12537}, {12530, 12441, 12538}, {12541, 12441, 12542}
+};
+
+// Hangul syllables are decomposed and composed algorithmically, see "3.12 Conjoining Jamo Behavior"
+// in http://www.unicode.org/versions/Unicode4.0.0/ch03.pdf
+constexpr KInt kHangulSBase = 0xAC00;
+constexpr KInt kHangulLBase = 0x1100;
+constexpr KInt kHangulVBase = 0x1161;
+constexpr KInt kHangulTBase = 0x11A7;
+constexpr KInt kHangulLCount = 19;
+constexpr KInt kHangulVCount = 21;
+constexpr KInt kHangulTCount = 28;
+constexpr KInt kHangulNCount = kHangulVCount * kHangulTCount;
+constexpr KInt kHangulSCount = kHangulLCount * kHangulNCount;
+
+// Code points below these are known to pass the quick check without a table lookup.
+constexpr KChar kNFDQuickCheckLimit = 0xC0;
+constexpr KChar kNFCQuickCheckLimit = 0x300;
+
+// Properties of a code point packed into a single trie entry.
+constexpr uint32_t kClassMask = 0xFF;
+constexpr int kDecompositionShift = 8;
+// Index of the decomposition in `decompositionValues` plus one. Zero means no decomposition.
+constexpr uint32_t kDecompositionMask = 0xFFF << kDecompositionShift;
+// The code point is the second one of some composition pair.
+constexpr uint32_t kComposesWithPrevious = 1 << 20;
+// The decomposition of the code point composes back into it.
+constexpr uint32_t kPrimaryComposite = 1 << 21;
+
+static_assert(ARRAY_SIZE(decompositionValues) < (kDecompositionMask >> kDecompositionShift), "Decomposition index must fit the trie entry");
+
+constexpr int kBlockShift = 6;
+constexpr KInt kBlockSize = 1 << kBlockShift;
+
+// Two-stage lookup table of code point properties: the high bits of a code point select a block, the low bits
+// select an entry inside the block. Identical blocks (most of them are all zero) are shared, so a lookup costs
+// two loads instead of binary searches over the sorted tables above. Built on the first use.
+class PropertiesTrie : private Pinned {
+public:
+    static const PropertiesTrie& instance() noexcept {
+        static PropertiesTrie trie [[clang::no_destroy]];
+        return trie;
+    }
+
+    uint32_t get(KInt codePoint) const noexcept {
+        if (codePoint < 0 || codePoint >= limit_) return 0;
+        return blocks_[(static_cast<size_t>(index_[codePoint >> kBlockShift]) << kBlockShift) | (codePoint & (kBlockSize - 1))];
+    }
+
+private:
+    PropertiesTrie() noexcept {
+        KStdVector<std::pair<KInt, uint32_t>> properties;
+        for (size_t i = 0; i < ARRAY_SIZE(canonicalClassesKeys); ++i) {
+            properties.emplace_back(canonicalClassesKeys[i], static_cast<uint32_t>(canonicalClassesValues[i]));
+        }
+        for (size_t i = 0; i < ARRAY_SIZE(decompositionKeys); ++i) {
+            properties.emplace_back(decompositionKeys[i], static_cast<uint32_t>(i + 1) << kDecompositionShift);
+        }
+        for (const Composition& composition : compositions) {
+            properties.emplace_back(composition.second, kComposesWithPrevious);
+            properties.emplace_back(composition.composite, kPrimaryComposite);
+        }
+        // Vowel and trailing jamo compose with the preceding leading jamo and LV syllable respectively.
+        for (KInt i = 0; i < kHangulVCount; ++i) {
+            properties.emplace_back(kHangulVBase + i, kComposesWithPrevious);
+        }
+        for (KInt i = 1; i < kHangulTCount; ++i) {
+            properties.emplace_back(kHangulTBase + i, kComposesWithPrevious);
+        }
+        std::sort(properties.begin(), properties.end(),
+                  [](const std::pair<KInt, uint32_t>& lhs, const std::pair<KInt, uint32_t>& rhs) { return lhs.first < rhs.first; });
+
+        limit_ = properties.back().first + 1;
+        index_.resize(((limit_ - 1) >> kBlockShift) + 1);
+        uint32_t block[kBlockSize];
+        auto property = properties.begin();
+        for (size_t blockIndex = 0; blockIndex < index_.size(); ++blockIndex) {
+            std::fill(block, block + kBlockSize, 0);
+            KInt blockStart = static_cast<KInt>(blockIndex << kBlockShift);
+            for (; property != properties.end() && property->first < blockStart + kBlockSize; ++property) {
+                block[property->first - blockStart] |= property->second;
+            }
+            size_t blockCount = blocks_.size() >> kBlockShift;
+            size_t sharedBlock = 0;
+            while (sharedBlock < blockCount && !std::equal(block, block + kBlockSize, blocks_.begin() + (sharedBlock << kBlockShift))) {
+                ++sharedBlock;
+            }
+            if (sharedBlock == blockCount) {
+                blocks_.insert(blocks_.end(), block, block + kBlockSize);
+            }
+            RuntimeAssert(sharedBlock <= UINT16_MAX, "Too many distinct blocks");
+            index_[blockIndex] = static_cast<uint16_t>(sharedBlock);
+        }
+    }
+
+    KInt limit_ = 0;
+    KStdVector<uint16_t> index_;
+    KStdVector<uint32_t> blocks_;
+};
+
+inline bool isHangulSyllable(KInt codePoint) noexcept {
+    return codePoint >= kHangulSBase && codePoint < kHangulSBase + kHangulSCount;
+}
+
+inline KInt readCodePoint(const KChar*& it, const KChar* end) noexcept {
+    KChar high = *it++;
+    if (high >= 0xD800 && high < 0xDC00 && it != end && *it >= 0xDC00 && *it < 0xE000) {
+        KChar low = *it++;
+        return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return high;
+}
+
+inline void appendCodePoint(KStdVector<KChar>& result, KInt codePoint) {
+    if (codePoint < 0x10000) {
+        result.push_back(static_cast<KChar>(codePoint));
+    } else {
+        codePoint -= 0x10000;
+        result.push_back(static_cast<KChar>(0xD800 + (codePoint >> 10)));
+        result.push_back(static_cast<KChar>(0xDC00 + (codePoint & 0x3FF)));
+    }
+}
+
+// A code point is "stable" if it's a starter that stays intact in the given normalization form regardless
+// of its surroundings. Text between two stable code points can be normalized independently.
+inline bool isStable(const PropertiesTrie& trie, KInt codePoint, NormalizationForm form) noexcept {
+    if (isHangulSyllable(codePoint)) {
+        // LV syllables may compose with a following trailing jamo, but then the jamo itself is not stable.
+        return form == NormalizationForm::kNFC;
+    }
+    uint32_t properties = trie.get(codePoint);
+    if ((properties & kClassMask) != 0) return false;
+    if (form == NormalizationForm::kNFD) return (properties & kDecompositionMask) == 0;
+    return (properties & kComposesWithPrevious) == 0 &&
+            ((properties & kDecompositionMask) == 0 || (properties & kPrimaryComposite) != 0);
+}
+
+size_t quickCheck(const PropertiesTrie& trie, const KChar* begin, const KChar* end, NormalizationForm form) noexcept {
+    KChar quickCheckLimit = form == NormalizationForm::kNFD ? kNFDQuickCheckLimit : kNFCQuickCheckLimit;
+    // The last stable code point may still be affected by what follows, so the prefix ends right before it.
+    const KChar* lastStable = begin;
+    const KChar* it = begin;
+    while (it != end) {
+        if (*it < quickCheckLimit) {
+            lastStable = it++;
+            continue;
+        }
+        const KChar* next = it;
+        if (!isStable(trie, readCodePoint(next, end), form)) return lastStable - begin;
+        lastStable = it;
+        it = next;
+    }
+    return end - begin;
+}
+
+void decompose(KInt codePoint, KStdVector<KInt>& segment) {
+    if (isHangulSyllable(codePoint)) {
+        KInt index = codePoint - kHangulSBase;
+        segment.push_back(kHangulLBase + index / kHangulNCount);
+        segment.push_back(kHangulVBase + (index % kHangulNCount) / kHangulTCount);
+        if (index % kHangulTCount != 0) {
+            segment.push_back(kHangulTBase + index % kHangulTCount);
+        }
+        return;
+    }
+    KInt length;
+    const KInt* decomposition = CanonicalDecomposition(codePoint, &length);
+    if (decomposition == nullptr) {
+        segment.push_back(codePoint);
+    } else {
+        segment.insert(segment.end(), decomposition, decomposition + length);
+    }
+}
+
+// Stable sort of each run of non-starters by their canonical classes.
+void reorder(const PropertiesTrie& trie, KStdVector<KInt>& segment) noexcept {
+    for (size_t i = 1; i < segment.size(); ++i) {
+        KInt codePoint = segment[i];
+        uint32_t canonicalClass = trie.get(codePoint) & kClassMask;
+        if (canonicalClass == 0) continue;
+        size_t j = i;
+        for (; j > 0 && (trie.get(segment[j - 1]) & kClassMask) > canonicalClass; --j) {
+            segment[j] = segment[j - 1];
+        }
+        segment[j] = codePoint;
+    }
+}
+
+// Returns the primary composite of the pair or -1.
+KInt compose(KInt first, KInt second) noexcept {
+    if (first >= kHangulLBase && first < kHangulLBase + kHangulLCount && second >= kHangulVBase && second < kHangulVBase + kHangulVCount) {
+        return kHangulSBase + ((first - kHangulLBase) * kHangulVCount + (second - kHangulVBase)) * kHangulTCount;
+    }
+    if (isHangulSyllable(first) && (first - kHangulSBase) % kHangulTCount == 0 && second > kHangulTBase &&
+        second < kHangulTBase + kHangulTCount) {
+        return first + (second - kHangulTBase);
+    }
+    auto it = std::lower_bound(std::begin(compositions), std::end(compositions), std::make_pair(first, second),
+                               [](const Composition& composition, const std::pair<KInt, KInt>& pair) {
+                                   return composition.first < pair.first || (composition.first == pair.first && composition.second < pair.second);
+                               });
+    if (it == std::end(compositions) || it->first != first || it->second != second) return -1;
+    return it->composite;
+}
+
+// Canonical composition algorithm, see http://www.unicode.org/reports/tr15/#Canonical_Composition
+void compose(const PropertiesTrie& trie, KStdVector<KInt>& segment) noexcept {
+    if (segment.empty()) return;
+    size_t starter = 0;
+    uint32_t lastClass = trie.get(segment[0]) & kClassMask;
+    // A segment starting with a non-starter has nothing to compose with.
+    if (lastClass != 0) lastClass = 256;
+    size_t composedLength = 1;
+    for (size_t i = 1; i < segment.size(); ++i) {
+        KInt codePoint = segment[i];
+        uint32_t canonicalClass = trie.get(codePoint) & kClassMask;
+        KInt composite = lastClass < 256 ? compose(segment[starter], codePoint) : -1;
+        // The pair composes unless the code point is blocked from the starter by a preceding code point.
+        if (composite >= 0 && (lastClass < canonicalClass || lastClass == 0)) {
+            segment[starter] = composite;
+            continue;
+        }
+        if (canonicalClass == 0) {
+            starter = composedLength;
+            lastClass = 0;
+        } else {
+            lastClass = canonicalClass;
+        }
+        segment[composedLength++] = codePoint;
+    }
+    segment.resize(composedLength);
+}
+
+} // namespace
+
+KInt kotlin::CanonicalClass(KInt codePoint) noexcept {
+    return PropertiesTrie::instance().get(codePoint) & kClassMask;
+}
+
+const KInt* kotlin::CanonicalDecomposition(KInt codePoint, KInt* length) noexcept {
+    uint32_t index = (PropertiesTrie::instance().get(codePoint) & kDecompositionMask) >> kDecompositionShift;
+    if (index == 0) return nullptr;
+    const Decomposition& decomposition = decompositionValues[index - 1];
+    *length = decomposition.length;
+    return decomposition.array;
+}
+
+size_t kotlin::NormalizedPrefixLength(const KChar* begin, const KChar* end, NormalizationForm form) noexcept {
+    return quickCheck(PropertiesTrie::instance(), begin, end, form);
+}
+
+void kotlin::Normalize(const KChar* begin, const KChar* end, NormalizationForm form, KStdVector<KChar>& result) {
+    const PropertiesTrie& trie = PropertiesTrie::instance();
+    KStdVector<KInt> segment;
+    const KChar* it = begin;
+    while (it != end) {
+        size_t prefixLength = quickCheck(trie, it, end, form);
+        result.insert(result.end(), it, it + prefixLength);
+        it += prefixLength;
+        if (it == end) break;
+
+        // The segment starts with the last stable code point (if any) before the first unstable one
+        // and lasts until the next stable code point.
+        segment.clear();
+        decompose(readCodePoint(it, end), segment);
+        while (it != end) {
+            const KChar* next = it;
+            KInt codePoint = readCodePoint(next, end);
+            if (isStable(trie, codePoint, form)) break;
+            decompose(codePoint, segment);
+            it = next;
+        }
+        reorder(trie, segment);
+        if (form == NormalizationForm::kNFC) {
+            compose(trie, segment);
+        }
+        for (KInt codePoint : segment) {
+            appendCodePoint(result, codePoint);
+        }
+    }
+}
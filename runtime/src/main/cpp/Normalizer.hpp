@@ -0,0 +1,39 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_NORMALIZER_H
+#define RUNTIME_NORMALIZER_H
+
+#include <cstddef>
+
+#include "Types.h"
+
+namespace kotlin {
+
+// Values must be kept in sync with kotlin.text.regex.Lexer.
+enum class NormalizationForm : KInt {
+    kNFD = 0, // Canonical decomposition.
+    kNFC = 1, // Canonical decomposition followed by canonical composition.
+};
+
+// Returns the canonical combining class of the code point (0 for starters).
+KInt CanonicalClass(KInt codePoint) noexcept;
+
+// Returns the full canonical decomposition of the code point and stores its length into `length`,
+// or returns nullptr if the code point has no decomposition in the table.
+// Hangul syllables are decomposed algorithmically, so they don't have table decompositions.
+const KInt* CanonicalDecomposition(KInt codePoint, KInt* length) noexcept;
+
+// Returns the length of the longest prefix of [begin, end) which is known to be in the given normalization form
+// without any decomposition work ("quick check"). Returns `end - begin` for the already normalized text.
+size_t NormalizedPrefixLength(const KChar* begin, const KChar* end, NormalizationForm form) noexcept;
+
+// Appends the given normalization form of [begin, end) in UTF-16 to `result`.
+// Runs of text that pass the quick check are copied as is.
+void Normalize(const KChar* begin, const KChar* end, NormalizationForm form, KStdVector<KChar>& result);
+
+} // namespace kotlin
+
+#endif // RUNTIME_NORMALIZER_H
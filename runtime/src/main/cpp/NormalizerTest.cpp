@@ -0,0 +1,86 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "Normalizer.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace kotlin;
+
+namespace {
+
+KStdVector<KChar> normalize(std::initializer_list<KChar> input, NormalizationForm form) {
+    KStdVector<KChar> result;
+    Normalize(input.begin(), input.end(), form, result);
+    return result;
+}
+
+size_t prefixLength(std::initializer_list<KChar> input, NormalizationForm form) {
+    return NormalizedPrefixLength(input.begin(), input.end(), form);
+}
+
+} // namespace
+
+TEST(NormalizerTest, CanonicalClass) {
+    EXPECT_EQ(0, CanonicalClass('a'));
+    EXPECT_EQ(230, CanonicalClass(0x0301));
+    EXPECT_EQ(220, CanonicalClass(0x0323));
+    EXPECT_EQ(216, CanonicalClass(0x1D165));
+    EXPECT_EQ(0, CanonicalClass(0x10FFFF));
+    EXPECT_EQ(0, CanonicalClass(-1));
+}
+
+TEST(NormalizerTest, CanonicalDecomposition) {
+    KInt length = 0;
+    EXPECT_EQ(nullptr, CanonicalDecomposition('a', &length));
+    // Hangul syllables are decomposed algorithmically.
+    EXPECT_EQ(nullptr, CanonicalDecomposition(0xAC00, &length));
+
+    const KInt* decomposition = CanonicalDecomposition(0x1E69, &length);
+    ASSERT_NE(nullptr, decomposition);
+    ASSERT_EQ(3, length);
+    EXPECT_EQ('s', decomposition[0]);
+    EXPECT_EQ(0x0323, decomposition[1]);
+    EXPECT_EQ(0x0307, decomposition[2]);
+}
+
+TEST(NormalizerTest, QuickCheck) {
+    EXPECT_EQ(3u, prefixLength({'a', 'b', 'c'}, NormalizationForm::kNFD));
+    EXPECT_EQ(3u, prefixLength({'a', 0x00E9, 'c'}, NormalizationForm::kNFC));
+    // The starter before a combining mark may be affected by it.
+    EXPECT_EQ(1u, prefixLength({'a', 'e', 0x0301}, NormalizationForm::kNFC));
+    EXPECT_EQ(0u, prefixLength({'a', 0x00E9, 'c'}, NormalizationForm::kNFD));
+    EXPECT_EQ(0u, prefixLength({0x0301}, NormalizationForm::kNFD));
+    EXPECT_EQ(0u, prefixLength({0xAC00}, NormalizationForm::kNFD));
+    EXPECT_EQ(1u, prefixLength({0xAC00}, NormalizationForm::kNFC));
+}
+
+TEST(NormalizerTest, NFD) {
+    EXPECT_EQ(KStdVector<KChar>({'a', 'e', 0x0301, 'c'}), normalize({'a', 0x00E9, 'c'}, NormalizationForm::kNFD));
+    // Canonical reordering of the marks.
+    EXPECT_EQ(KStdVector<KChar>({'s', 0x0323, 0x0307}), normalize({'s', 0x0307, 0x0323}, NormalizationForm::kNFD));
+    EXPECT_EQ(KStdVector<KChar>({'s', 0x0323, 0x0307}), normalize({0x1E61, 0x0323}, NormalizationForm::kNFD));
+    // Singleton decomposition.
+    EXPECT_EQ(KStdVector<KChar>({'A', 0x030A}), normalize({0x212B}, NormalizationForm::kNFD));
+    // Hangul.
+    EXPECT_EQ(KStdVector<KChar>({0x1100, 0x1161, 0x11A8}), normalize({0xAC01}, NormalizationForm::kNFD));
+    // Supplementary code points: U+1D15E MUSICAL SYMBOL HALF NOTE.
+    EXPECT_EQ(KStdVector<KChar>({0xD834, 0xDD57, 0xD834, 0xDD65}), normalize({0xD834, 0xDD5E}, NormalizationForm::kNFD));
+    // Unpaired surrogates are kept as is.
+    EXPECT_EQ(KStdVector<KChar>({0xDC00, 'a', 0xD800}), normalize({0xDC00, 'a', 0xD800}, NormalizationForm::kNFD));
+}
+
+TEST(NormalizerTest, NFC) {
+    EXPECT_EQ(KStdVector<KChar>({'a', 0x00E9, 'c'}), normalize({'a', 'e', 0x0301, 'c'}, NormalizationForm::kNFC));
+    EXPECT_EQ(KStdVector<KChar>({0x1E69}), normalize({'s', 0x0307, 0x0323}, NormalizationForm::kNFC));
+    EXPECT_EQ(KStdVector<KChar>({0x00C5}), normalize({0x212B}, NormalizationForm::kNFC));
+    // A mark of the same class blocks the composition.
+    EXPECT_EQ(KStdVector<KChar>({0x00E0, 0x0301}), normalize({'a', 0x0300, 0x0301}, NormalizationForm::kNFC));
+    // Composition exclusions stay decomposed.
+    EXPECT_EQ(KStdVector<KChar>({0x0915, 0x093C}), normalize({0x0958}, NormalizationForm::kNFC));
+    // Hangul.
+    EXPECT_EQ(KStdVector<KChar>({0xAC01}), normalize({0x1100, 0x1161, 0x11A8}, NormalizationForm::kNFC));
+    EXPECT_EQ(KStdVector<KChar>({0xAC01}), normalize({0xAC00, 0x11A8}, NormalizationForm::kNFC));
+}
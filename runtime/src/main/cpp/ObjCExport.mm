@@ -703,6 +703,9 @@ static const TypeInfo* createTypeInfo(
     } else {
       buildITable(result, interfaceVTables);
     }
+    if (result->interfaceTableSize_ < 0) {
+      result->interfaceTableIndex_ = kotlin::BuildInterfaceTableIndex(result->interfaceTable_, -result->interfaceTableSize_);
+    }
   }
 
   MethodTableRecord* openMethods_ = konanAllocArray<MethodTableRecord>(methodTable.size());
@@ -710,6 +713,7 @@ static const TypeInfo* createTypeInfo(
 
   result->openMethods_ = openMethods_;
   result->openMethodsCount_ = methodTable.size();
+  result->openMethodsIndex_ = kotlin::BuildOpenMethodsIndex(openMethods_, methodTable.size());
 
   result->packageName_ = nullptr;
   result->relativeName_ = nullptr; // TODO: add some info.
@@ -17,6 +17,7 @@
 #ifdef KONAN_ANDROID
 #include <android/log.h>
 #endif
+#include <errno.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -26,6 +27,9 @@
 #include <pthread.h>
 #endif
 #include <unistd.h>
+#if !KONAN_WASM && !KONAN_ZEPHYR
+#include <sys/stat.h>
+#endif
 #if KONAN_WINDOWS
 #include <windows.h>
 #endif
@@ -35,6 +39,7 @@
 #include "Common.h"
 #include "Porting.h"
 #include "KAssert.h"
+#include "utf8.h"
 
 #if KONAN_WASM || KONAN_ZEPHYR
 extern "C" RUNTIME_NORETURN void Konan_abort(const char*);
@@ -48,6 +53,172 @@ extern "C" size_t strnlen(const char* buffer, size_t maxSize);
 namespace konan {
 
 // Console operations.
+namespace {
+
+constexpr uint32_t kConsoleBufferSize = 8 * 1024;
+constexpr uint32_t kStdinBufferInitialSize = 64 * 1024;
+// Free space guaranteed to every read from the standard input.
+constexpr uint32_t kStdinMinimalRead = 4 * 1024;
+
+// Standard output goes through a single buffer shared by all the threads rather than per-thread or lock-free ones:
+// - lines printed by different threads come out whole and in the order they were printed, while per-thread buffers
+//   would reorder them on every flush and interleave them with the standard error;
+// - the buffer can be written out at exit, at abort and before reading the standard input without keeping track
+//   of the buffers of all the threads, some of which may be gone already;
+// - the critical section is only a copy or a transcoding into the buffer, and is uncontended unless several
+//   threads print at once, which then contend for the file descriptor anyway.
+// Guards the standard output buffer.
+class ConsoleMutex {
+ public:
+  void lock() {
+#if !KONAN_NO_THREADS
+    pthread_mutex_lock(&mutex_);
+#endif
+  }
+
+  bool tryLock() {
+#if !KONAN_NO_THREADS
+    return pthread_mutex_trylock(&mutex_) == 0;
+#else
+    return true;
+#endif
+  }
+
+  void unlock() {
+#if !KONAN_NO_THREADS
+    pthread_mutex_unlock(&mutex_);
+#endif
+  }
+
+#if !KONAN_NO_THREADS
+  pthread_mutex_t mutex_ = PTHREAD_MUTEX_INITIALIZER;
+#endif
+};
+
+ConsoleMutex consoleMutex;
+// One more byte for the terminating zero on Android.
+char consoleBuffer[kConsoleBufferSize + 1];
+uint32_t consoleBufferSize = 0;
+ConsoleBuffering consoleBuffering = CONSOLE_BUFFERING_AUTO;
+// consoleBuffering with CONSOLE_BUFFERING_AUTO resolved, computed on the first write.
+ConsoleBuffering consoleEffectiveBuffering = CONSOLE_BUFFERING_AUTO;
+
+// Guards the standard input buffer. Pending input is stdinBuffer[stdinStart, stdinEnd).
+ConsoleMutex stdinMutex;
+char* stdinBuffer = nullptr;
+uint32_t stdinBufferSize = 0;
+uint32_t stdinStart = 0;
+uint32_t stdinEnd = 0;
+
+class ConsoleLock {
+ public:
+  explicit ConsoleLock(ConsoleMutex& mutex = consoleMutex) : mutex_(mutex) { mutex_.lock(); }
+  ~ConsoleLock() { mutex_.unlock(); }
+
+ private:
+  ConsoleMutex& mutex_;
+};
+
+ConsoleBuffering resolveBuffering(ConsoleBuffering buffering) {
+  if (buffering != CONSOLE_BUFFERING_AUTO) return buffering;
+#ifdef KONAN_ANDROID
+  // Each write is a logcat entry.
+  return CONSOLE_BUFFERING_NONE;
+#elif KONAN_WASM || KONAN_ZEPHYR
+  return CONSOLE_BUFFERING_LINE;
+#else
+  // Only regular files are fully buffered. A pipe often feeds a log collector or another program that is expected
+  // to see the lines as soon as they are printed, as on a terminal.
+  struct stat info;
+  if (::fstat(STDOUT_FILENO, &info) == 0 && S_ISREG(info.st_mode)) return CONSOLE_BUFFERING_FULL;
+  return CONSOLE_BUFFERING_LINE;
+#endif
+}
+
+void writeFully(int fd, const char* data, uint32_t size) {
+  while (size > 0) {
+    auto written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    data += written;
+    size -= written;
+  }
+}
+
+void writeStdout(const char* data, uint32_t size) {
+#ifdef KONAN_ANDROID
+  __android_log_print(ANDROID_LOG_INFO, "Konan_main", "%.*s", static_cast<int>(size), data);
+#else
+  writeFully(STDOUT_FILENO, data, size);
+#endif
+}
+
+const char* findLineFeed(const char* data, uint32_t size) {
+  if (size == 0) return nullptr;
+#if KONAN_WASM
+  for (uint32_t i = 0; i < size; ++i) {
+    if (data[i] == '\n') return data + i;
+  }
+  return nullptr;
+#else
+  return static_cast<const char*>(::memchr(data, '\n', size));
+#endif
+}
+
+bool containsLineFeed(const char* data, uint32_t size) {
+  return findLineFeed(data, size) != nullptr;
+}
+
+// The functions below must be called under consoleMutex.
+void flushConsoleBuffer() {
+  if (consoleBufferSize == 0) return;
+  writeStdout(consoleBuffer, consoleBufferSize);
+  consoleBufferSize = 0;
+}
+
+void appendToConsoleBuffer(const char* data, uint32_t size) {
+  if (size >= kConsoleBufferSize) {
+    flushConsoleBuffer();
+    writeStdout(data, size);
+    return;
+  }
+  if (consoleBufferSize + size > kConsoleBufferSize) flushConsoleBuffer();
+  memcpy(consoleBuffer + consoleBufferSize, data, size);
+  consoleBufferSize += size;
+}
+
+void completeConsoleWrite(bool lineFeedWritten) {
+  if (consoleEffectiveBuffering == CONSOLE_BUFFERING_AUTO)
+    consoleEffectiveBuffering = resolveBuffering(consoleBuffering);
+  switch (consoleEffectiveBuffering) {
+    case CONSOLE_BUFFERING_LINE:
+      if (!lineFeedWritten) break;
+      // Fall through.
+    case CONSOLE_BUFFERING_AUTO:
+    case CONSOLE_BUFFERING_NONE:
+      flushConsoleBuffer();
+      break;
+    case CONSOLE_BUFFERING_FULL:
+      break;
+  }
+}
+
+void flushConsoleAtExit() {
+  ConsoleLock lock;
+  flushConsoleBuffer();
+}
+
+// Used on abnormal termination, when the thread may be holding the lock already.
+void tryFlushConsole() {
+  if (!consoleMutex.tryLock()) return;
+  flushConsoleBuffer();
+  consoleMutex.unlock();
+}
+
+}  // namespace
+
 void consoleInit() {
 #if KONAN_WINDOWS
   // Note that this code enforces UTF-8 console output, so we may want to rethink
@@ -57,18 +228,51 @@ void consoleInit() {
   // FIXME: should set original CP back during the deinit of the program.
   //  Otherwise, this codepage remains in the console.
 #endif
+#if !KONAN_WASM && !KONAN_ZEPHYR
+  static bool atExitRegistered = false;
+  if (!atExitRegistered) {
+    atExitRegistered = true;
+    ::atexit(flushConsoleAtExit);
+  }
+#endif
 }
 
 void consoleWriteUtf8(const void* utf8, uint32_t sizeBytes) {
-#ifdef KONAN_ANDROID
-  // TODO: use sizeBytes!
-  __android_log_print(ANDROID_LOG_INFO, "Konan_main", "%s", utf8);
-#else
-  ::write(STDOUT_FILENO, utf8, sizeBytes);
-#endif
+  ConsoleLock lock;
+  appendToConsoleBuffer(reinterpret_cast<const char*>(utf8), sizeBytes);
+  completeConsoleWrite(containsLineFeed(reinterpret_cast<const char*>(utf8), sizeBytes));
+}
+
+void consoleWriteUtf16(const uint16_t* utf16, uint32_t length, bool newline) {
+  ConsoleLock lock;
+  const uint16_t* end = utf16 + length;
+  bool lineFeedWritten = newline;
+  while (utf16 != end) {
+    // A code unit takes at most 3 bytes in UTF-8, a surrogate pair takes 4.
+    uint32_t room = (kConsoleBufferSize - consoleBufferSize) / 3;
+    if (room < 2) {
+      flushConsoleBuffer();
+      continue;
+    }
+    const uint16_t* chunkEnd = static_cast<uint32_t>(end - utf16) > room ? utf16 + room : end;
+    // Don't split surrogate pairs.
+    if (chunkEnd != end && utf8::internal::is_lead_surrogate(chunkEnd[-1])) --chunkEnd;
+    char* chunk = consoleBuffer + consoleBufferSize;
+    // Replace incorrect sequences with a default codepoint (see utf8::with_replacement::default_replacement)
+    char* chunkOut = utf8::with_replacement::utf16to8(utf16, chunkEnd, chunk);
+    if (!lineFeedWritten) lineFeedWritten = containsLineFeed(chunk, chunkOut - chunk);
+    consoleBufferSize += chunkOut - chunk;
+    utf16 = chunkEnd;
+  }
+  if (newline) appendToConsoleBuffer("\n", 1);
+  completeConsoleWrite(lineFeedWritten);
 }
 
 void consoleErrorUtf8(const void* utf8, uint32_t sizeBytes) {
+  {
+    ConsoleLock lock;
+    flushConsoleBuffer();
+  }
 #ifdef KONAN_ANDROID
   // TODO: use sizeBytes!
   __android_log_print(ANDROID_LOG_ERROR, "Konan_main", "%s", utf8);
@@ -77,6 +281,18 @@ void consoleErrorUtf8(const void* utf8, uint32_t sizeBytes) {
 #endif
 }
 
+ConsoleBuffering consoleGetBuffering() {
+  ConsoleLock lock;
+  return consoleBuffering;
+}
+
+void consoleSetBuffering(ConsoleBuffering buffering) {
+  ConsoleLock lock;
+  flushConsoleBuffer();
+  consoleBuffering = buffering;
+  consoleEffectiveBuffering = resolveBuffering(buffering);
+}
+
 #if KONAN_WINDOWS
 int getLastErrorMessage(char* message, uint32_t size) {
   auto errCode = ::GetLastError();
@@ -91,54 +307,111 @@ int getLastErrorMessage(char* message, uint32_t size) {
 }
 #endif
 
-int32_t consoleReadUtf8(void* utf8, uint32_t maxSizeBytes) {
-#ifdef KONAN_ZEPHYR
-  return 0;
-#elif KONAN_WINDOWS
-  auto length = 0;
-  void *stdInHandle = ::GetStdHandle(STD_INPUT_HANDLE);
+namespace {
+
+// The functions below must be called under stdinMutex.
+// Returns the number of bytes read, 0 at the end of the input and a negative value on error.
+int32_t readStdin(char* destination, uint32_t size) {
+#if KONAN_WINDOWS
+  void* stdInHandle = ::GetStdHandle(STD_INPUT_HANDLE);
   if (::GetFileType(stdInHandle) == FILE_TYPE_CHAR) {
+    // A UTF-16 code unit takes at most 3 bytes in UTF-8, a surrogate pair takes 4.
+    wchar_t buffer[kStdinMinimalRead / 3];
     unsigned long bufferRead;
-    // In UTF-16 there are surrogate pairs that a 2 * 16-bit long (4 bytes).
-    auto bufferLength = maxSizeBytes / 4 - 1;
-    wchar_t buffer[bufferLength];
-    if (::ReadConsoleW(stdInHandle, buffer, bufferLength, &bufferRead, NULL)) {
-      length = ::WideCharToMultiByte(CP_UTF8, 0, buffer, bufferRead, (char*) utf8,
-                                     maxSizeBytes - 1, NULL, NULL);
-      if (!length && KonanNeedDebugInfo) {
+    if (!::ReadConsoleW(stdInHandle, buffer, sizeof(buffer) / sizeof(buffer[0]), &bufferRead, NULL)) {
+      if (KonanNeedDebugInfo) {
         char msg[512];
         auto errCode = getLastErrorMessage(msg, sizeof(msg));
-        consoleErrorf("UTF-16 to UTF-8 conversion error %d: %s", errCode, msg);
+        consoleErrorf("Console read failure: %d %s", errCode, msg);
       }
-      ((char*) utf8)[length] = 0;
-    } else if (KonanNeedDebugInfo) {
+      return -1;
+    }
+    if (bufferRead == 0) return 0;
+    auto length = ::WideCharToMultiByte(CP_UTF8, 0, buffer, bufferRead, destination, size, NULL, NULL);
+    if (!length && KonanNeedDebugInfo) {
       char msg[512];
       auto errCode = getLastErrorMessage(msg, sizeof(msg));
-      consoleErrorf("Console read failure: %d %s", errCode, msg);
+      consoleErrorf("UTF-16 to UTF-8 conversion error %d: %s", errCode, msg);
     }
+    return length != 0 ? length : -1;
+  }
+#endif
+  if (size > INT32_MAX) size = INT32_MAX;
+  while (true) {
+    auto length = ::read(STDIN_FILENO, destination, size);
+    if (length < 0 && errno == EINTR) continue;
+    return length;
+  }
+}
+
+// Makes room for at least kStdinMinimalRead bytes after the pending input, moving it to the start
+// of the buffer or to a larger one.
+void reserveStdinBuffer() {
+  if (stdinBufferSize - stdinEnd >= kStdinMinimalRead) return;
+  uint32_t pending = stdinEnd - stdinStart;
+  if (stdinBufferSize - pending >= kStdinMinimalRead) {
+    memmove(stdinBuffer, stdinBuffer + stdinStart, pending);
   } else {
-    length = ::read(STDIN_FILENO, utf8, maxSizeBytes - 1);
+    // The line doesn't fit, grow the buffer.
+    RuntimeCheck(stdinBufferSize <= UINT32_MAX / 2, "Standard input line is too long");
+    uint32_t size = stdinBufferSize == 0 ? kStdinBufferInitialSize : stdinBufferSize * 2;
+    char* buffer = reinterpret_cast<char*>(konan::calloc(size, 1));
+    RuntimeCheck(buffer != nullptr, "Out of memory reading the standard input");
+    if (stdinBuffer != nullptr) {
+      memcpy(buffer, stdinBuffer + stdinStart, pending);
+      konan::free(stdinBuffer);
+    }
+    stdinBuffer = buffer;
+    stdinBufferSize = size;
   }
+  stdinStart = 0;
+  stdinEnd = pending;
+}
+
+// Removes the pending input up to `lineEnd` and passes it to the consumer without the trailing '\r'.
+void consumeStdinLine(uint32_t lineEnd, uint32_t next, LineConsumer consumer, void* context) {
+  const char* line = stdinBuffer + stdinStart;
+  uint32_t length = lineEnd - stdinStart;
+  if (length > 0 && line[length - 1] == '\r') --length;
+  stdinStart = next;
+  // The line stays intact until the next read.
+  if (stdinStart == stdinEnd) stdinStart = stdinEnd = 0;
+  consumer(line, length, context);
+}
+
+}  // namespace
+
+bool consoleReadLineUtf8(LineConsumer consumer, void* context) {
+#ifdef KONAN_ZEPHYR
+  return false;
 #else
-  auto length = ::read(STDIN_FILENO, utf8, maxSizeBytes - 1);
-#endif
-  if (length <= 0) return -1;
-  char* start = reinterpret_cast<char*>(utf8);
-  char* current = start + length - 1;
-  bool isTrimming = true;
-  while (current >= start && isTrimming) {
-    switch (*current) {
-      case '\n':
-      case '\r':
-        *current = 0;
-        length--;
-        break;
-      default:
-        isTrimming = false;
+  ConsoleLock lock(stdinMutex);
+  // The pending input before this offset from stdinStart has no line feeds.
+  uint32_t scanned = 0;
+  while (true) {
+    const char* lineFeed = findLineFeed(stdinBuffer + stdinStart + scanned, stdinEnd - stdinStart - scanned);
+    if (lineFeed != nullptr) {
+      uint32_t lineEnd = lineFeed - stdinBuffer;
+      consumeStdinLine(lineEnd, lineEnd + 1, consumer, context);
+      return true;
+    }
+    scanned = stdinEnd - stdinStart;
+    reserveStdinBuffer();
+    {
+      // Show the prompt, if any. Lines already read don't need it, so the output isn't flushed for each line.
+      ConsoleLock consoleLock;
+      flushConsoleBuffer();
     }
-    current--;
+    auto length = readStdin(stdinBuffer + stdinEnd, stdinBufferSize - stdinEnd);
+    if (length <= 0) {
+      if (stdinStart == stdinEnd) return false;
+      // The last line isn't terminated.
+      consumeStdinLine(stdinEnd, stdinEnd, consumer, context);
+      return true;
+    }
+    stdinEnd += length;
   }
-  return length;
+#endif
 }
 
 #if KONAN_INTERNAL_SNPRINTF
@@ -172,6 +445,10 @@ void consoleErrorf(const char* format, ...) {
 }
 
 void consoleFlush() {
+  {
+    ConsoleLock lock;
+    flushConsoleBuffer();
+  }
   ::fflush(stdout);
   ::fflush(stderr);
 }
@@ -240,15 +517,18 @@ void onThreadExit(void (*destructor)(void*), void* destructorParameter) {
 
 // Process execution.
 void abort(void) {
+  tryFlushConsole();
   ::abort();
 }
 
 #if KONAN_WASM || KONAN_ZEPHYR
 void exit(int32_t status) {
+  tryFlushConsole();
   Konan_exit(status);
 }
 #else
 void exit(int32_t status) {
+  tryFlushConsole();
   ::exit(status);
 }
 #endif
@@ -285,18 +565,45 @@ size_t strnlen(const char* buffer, size_t maxSize) {
 // Memory operations.
 #if KONAN_INTERNAL_DLMALLOC
 extern "C" void* dlcalloc(size_t, size_t);
+extern "C" void* dlmalloc(size_t);
+extern "C" size_t dlmalloc_usable_size(void*);
+extern "C" int dlmalloc_trim(size_t);
 extern "C" void dlfree(void*);
 #define calloc_impl dlcalloc
 #define free_impl dlfree
 #define calloc_aligned_impl(count, size, alignment) dlcalloc(count, size)
+#define calloc_object_impl(size) dlcalloc(1, size)
+#define malloc_object_impl dlmalloc
+#define free_object_impl dlfree
+#define object_usable_size_impl dlmalloc_usable_size
+#define trim_heap_impl() dlmalloc_trim(0)
+#define release_object_heap_impl()
+#define object_heap_size_impl() -1
+#define visit_object_heap_impl(visitor, argument) false
 
 #else
 extern "C" void* konan_calloc_impl(size_t, size_t);
 extern "C" void konan_free_impl(void*);
 extern "C" void* konan_calloc_aligned_impl(size_t count, size_t size, size_t alignment);
+extern "C" void* konan_calloc_object_impl(size_t size);
+extern "C" void* konan_malloc_object_impl(size_t size);
+extern "C" void konan_free_object_impl(void*);
+extern "C" size_t konan_object_usable_size_impl(void*);
+extern "C" void konan_trim_heap_impl();
+extern "C" void konan_release_object_heap_impl();
+extern "C" long long konan_object_heap_size_impl();
+extern "C" bool konan_visit_object_heap_impl(void (*visitor)(void*, void*), void* argument);
 #define calloc_impl konan_calloc_impl
 #define free_impl konan_free_impl
 #define calloc_aligned_impl konan_calloc_aligned_impl
+#define calloc_object_impl konan_calloc_object_impl
+#define malloc_object_impl konan_malloc_object_impl
+#define free_object_impl konan_free_object_impl
+#define object_usable_size_impl konan_object_usable_size_impl
+#define trim_heap_impl konan_trim_heap_impl
+#define release_object_heap_impl konan_release_object_heap_impl
+#define object_heap_size_impl konan_object_heap_size_impl
+#define visit_object_heap_impl konan_visit_object_heap_impl
 #endif
 
 void* calloc(size_t count, size_t size) {
@@ -311,6 +618,65 @@ void free(void* pointer) {
   free_impl(pointer);
 }
 
+namespace {
+
+// Bytes used by the objects of all threads. To keep the allocations from contending on it, each thread
+// publishes its changes only when they exceed kObjectBytesBatch.
+constexpr int64_t kObjectBytesBatch = 64 * 1024;
+int64_t objectBytes = 0;
+THREAD_LOCAL_VARIABLE int64_t unpublishedObjectBytes = 0;
+
+void publishObjectBytes() {
+  __atomic_fetch_add(&objectBytes, unpublishedObjectBytes, __ATOMIC_RELAXED);
+  unpublishedObjectBytes = 0;
+}
+
+void* trackObjectAllocation(void* pointer) {
+  if (pointer != nullptr) {
+    unpublishedObjectBytes += object_usable_size_impl(pointer);
+    if (unpublishedObjectBytes > kObjectBytesBatch) publishObjectBytes();
+  }
+  return pointer;
+}
+
+}  // namespace
+
+void* calloc_object(size_t size) {
+  return trackObjectAllocation(calloc_object_impl(size));
+}
+
+void* malloc_object(size_t size) {
+  return trackObjectAllocation(malloc_object_impl(size));
+}
+
+void free_object(void* pointer) {
+  if (pointer == nullptr) return;
+  unpublishedObjectBytes -= object_usable_size_impl(pointer);
+  if (unpublishedObjectBytes < -kObjectBytesBatch) publishObjectBytes();
+  free_object_impl(pointer);
+}
+
+void release_object_heap() {
+  publishObjectBytes();
+  release_object_heap_impl();
+}
+
+int64_t object_bytes() {
+  return __atomic_load_n(&objectBytes, __ATOMIC_RELAXED);
+}
+
+void trim_heap() {
+  trim_heap_impl();
+}
+
+int64_t object_heap_size() {
+  return object_heap_size_impl();
+}
+
+bool visit_object_heap(void (*visitor)(void* block, void* argument), void* argument) {
+  return visit_object_heap_impl(visitor, argument);
+}
+
 #if KONAN_INTERNAL_NOW
 
 #ifdef KONAN_ZEPHYR
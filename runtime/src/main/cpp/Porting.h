@@ -25,14 +25,32 @@
 namespace konan {
 
 // Console operations.
+// Must match ConsoleBuffering in Platform.kt.
+enum ConsoleBuffering {
+  CONSOLE_BUFFERING_AUTO = 0,
+  CONSOLE_BUFFERING_NONE = 1,
+  CONSOLE_BUFFERING_LINE = 2,
+  CONSOLE_BUFFERING_FULL = 3,
+};
+
 void consoleInit();
 void consolePrintf(const char* format, ...);
 void consoleErrorf(const char* format, ...);
+// Standard output goes through a buffer written out according to consoleGetBuffering().
 void consoleWriteUtf8(const void* utf8, uint32_t sizeBytes);
+// Transcodes UTF-16 straight into the standard output buffer, appending a line feed if `newline` is set.
+void consoleWriteUtf16(const uint16_t* utf16, uint32_t length, bool newline);
+// Writes out the standard output buffer first to keep the order of the messages.
 void consoleErrorUtf8(const void* utf8, uint32_t sizeBytes);
-// Negative return value denotes that read wasn't successful.
-int32_t consoleReadUtf8(void* utf8, uint32_t maxSizeBytes);
+// Receives a line of the standard input, valid only during the call.
+typedef void (*LineConsumer)(const char* utf8, uint32_t sizeBytes, void* context);
+// Passes the next line of the standard input without the line terminator to the consumer. The input is read
+// in large blocks, so lines can be of any length. Returns false at the end of the input.
+bool consoleReadLineUtf8(LineConsumer consumer, void* context);
 void consoleFlush();
+ConsoleBuffering consoleGetBuffering();
+// Writes out the buffered output before switching.
+void consoleSetBuffering(ConsoleBuffering buffering);
 
 // Process control.
 RUNTIME_NORETURN void abort(void);
@@ -79,6 +97,23 @@ void *memset(void *b, int c, size_t len);
 void* calloc(size_t count, size_t size);
 void* calloc_aligned(size_t count, size_t size, size_t alignment);
 void free(void* ptr);
+// Kotlin objects are allocated separately from the runtime structures, in a heap of the current thread when
+// the allocator supports that. They may be freed by any thread.
+void* calloc_object(size_t size);
+// Same as calloc_object, but the memory is not zeroed.
+void* malloc_object(size_t size);
+void free_object(void* ptr);
+// Releases the object heap of the current thread. Objects still alive remain valid.
+void release_object_heap();
+// Bytes used by the objects in the heap of the current thread, or -1 if the allocator doesn't track that.
+int64_t object_heap_size();
+// Bytes used by the objects of all threads. Approximate: each thread publishes its allocations in batches.
+int64_t object_bytes();
+// Returns the free memory of the allocator to the OS, as far as the allocator supports that.
+void trim_heap();
+// Calls `visitor` for every allocated block in the object heap of the current thread. Returns false if the allocator
+// can't enumerate its blocks.
+bool visit_object_heap(void (*visitor)(void* block, void* argument), void* argument);
 
 // Time operations.
 uint64_t getTimeMillis();
@@ -14,12 +14,18 @@
  * limitations under the License.
  */
 
+#if !KONAN_NO_THREADS
+#include <pthread.h>
+#endif
+
 #include "Alloc.h"
 #include "Atomic.h"
 #include "Cleaner.h"
+#include "CpuProfiler.hpp"
 #include "Exceptions.h"
 #include "KAssert.h"
 #include "Memory.h"
+#include "Mutex.hpp"
 #include "ObjCExportInit.h"
 #include "Porting.h"
 #include "Runtime.h"
@@ -46,6 +52,7 @@ InitNode* initTailNode = nullptr;
 enum class RuntimeStatus {
     kUninitialized,
     kRunning,
+    kDetached, // Waits in the pool for a thread to attach.
     kDestroying,
 };
 
@@ -53,6 +60,11 @@ struct RuntimeState {
     MemoryState* memoryState;
     Worker* worker;
     RuntimeStatus status = RuntimeStatus::kUninitialized;
+    // Nesting depth of `Kotlin_attachRuntime` calls on the thread.
+    int attachDepth = 0;
+    // Created by `Kotlin_attachRuntime`, so may be detached.
+    bool attached = false;
+    RuntimeState* nextDetached = nullptr;
 };
 
 // Must be synchronized with IrToBitcode.kt
@@ -63,6 +75,64 @@ enum {
   DEINIT_GLOBALS = 3
 };
 
+// Must be synchronized with IrToBitcode.kt
+enum {
+  FILE_NOT_INITIALIZED = 0,
+  FILE_INITIALIZED = 1,
+  FILE_FAILED_TO_INITIALIZE = 2,
+  // Larger values are ids of the threads running the initializer.
+  FILE_FIRST_THREAD_ID = 3,
+};
+
+volatile int32_t lastFileInitThreadId = FILE_FIRST_THREAD_ID - 1;
+THREAD_LOCAL_VARIABLE int32_t fileInitThreadId = FILE_NOT_INITIALIZED;
+volatile int32_t initializedFilesCount = 0;
+
+int32_t currentFileInitThreadId() {
+  if (fileInitThreadId == FILE_NOT_INITIALIZED)
+    fileInitThreadId = atomicAdd(&lastFileInitThreadId, 1);
+  return fileInitThreadId;
+}
+
+#if !KONAN_NO_THREADS
+// Initializers are usually short, so a thread waiting for one spins for a while before going to sleep.
+constexpr int kFileInitSpinCount = 1000;
+
+pthread_mutex_t fileInitMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t fileInitCondition = PTHREAD_COND_INITIALIZER;
+// Number of the threads sleeping on fileInitCondition, so that the initializers only signal it when needed.
+volatile int32_t fileInitWaiters = 0;
+#endif
+
+// Waits until the initializer of the file run by another thread completes or fails.
+void waitForFileInitializer(int32_t volatile* state) {
+#if !KONAN_NO_THREADS
+  for (int i = 0; i < kFileInitSpinCount; ++i) {
+    if (atomicGet(state) < FILE_FIRST_THREAD_ID) return;
+  }
+  pthread_mutex_lock(&fileInitMutex);
+  atomicAdd(&fileInitWaiters, 1);
+  while (atomicGet(state) >= FILE_FIRST_THREAD_ID) {
+    pthread_cond_wait(&fileInitCondition, &fileInitMutex);
+  }
+  atomicAdd(&fileInitWaiters, -1);
+  pthread_mutex_unlock(&fileInitMutex);
+#endif
+}
+
+// Stores the final state of the file, waking up the threads waiting for it.
+void completeFileInitializer(int32_t volatile* state, int32_t value) {
+  atomicSet(state, value);
+#if !KONAN_NO_THREADS
+  // Both the stores and the loads are sequentially consistent: either a waiter sees the new state,
+  // or it has been counted by the time the state is stored.
+  if (atomicGet(&fileInitWaiters) == 0) return;
+  pthread_mutex_lock(&fileInitMutex);
+  pthread_cond_broadcast(&fileInitCondition);
+  pthread_mutex_unlock(&fileInitMutex);
+#endif
+}
+
 void InitOrDeinitGlobalVariables(int initialize, MemoryState* memory) {
   InitNode* currentNode = initHeadNode;
   while (currentNode != nullptr) {
@@ -123,9 +193,11 @@ RuntimeState* initRuntime() {
 
   InitOrDeinitGlobalVariables(ALLOC_THREAD_LOCAL_GLOBALS, result->memoryState);
   CommitTLSStorage(result->memoryState);
+  kotlin::profiler::OnRuntimeThreadAttached();
   // Keep global variables in state as well.
   if (firstRuntime) {
     konan::consoleInit();
+    kotlin::profiler::StartCpuSamplingFromEnvironment();
 #if KONAN_OBJC_INTEROP
     Kotlin_ObjCExport_initialize();
 #endif
@@ -140,6 +212,7 @@ RuntimeState* initRuntime() {
 void deinitRuntime(RuntimeState* state, bool destroyRuntime) {
   RuntimeAssert(state->status == RuntimeStatus::kRunning, "Runtime must be in the running state");
   state->status = RuntimeStatus::kDestroying;
+  konan::consoleFlush();
   // This may be called after TLS is zeroed out, so ::memoryState in Memory cannot be trusted.
   RestoreMemory(state->memoryState);
   bool lastRuntime = atomicAdd(&aliveRuntimesCount, -1) == 0;
@@ -161,6 +234,83 @@ void deinitRuntime(RuntimeState* state, bool destroyRuntime) {
   WorkerDestroyThreadDataIfNeeded(workerId);
 }
 
+// Runtime states detached by `Kotlin_detachRuntime`. Their memory and workers are kept, so attaching one to another
+// thread only takes rebinding them and initializing thread-local globals.
+constexpr int kMaxDetachedRuntimes = 64;
+SimpleMutex detachedRuntimesMutex;
+RuntimeState* detachedRuntimes = nullptr;
+int detachedRuntimesCount = 0;
+
+volatile int64_t runtimeAttachCount = 0;
+volatile int64_t reusedRuntimeAttachCount = 0;
+volatile int64_t runtimeAttachTimeNanos = 0;
+volatile int64_t maxRuntimeAttachTimeNanos = 0;
+
+RuntimeState* takeDetachedRuntime() {
+  LockGuard<SimpleMutex> guard(detachedRuntimesMutex);
+  RuntimeState* state = detachedRuntimes;
+  if (state != nullptr) {
+    detachedRuntimes = state->nextDetached;
+    state->nextDetached = nullptr;
+    --detachedRuntimesCount;
+  }
+  return state;
+}
+
+void bindDetachedRuntime(RuntimeState* state) {
+  RuntimeAssert(state->status == RuntimeStatus::kDetached, "Runtime must be in the detached state");
+  ::runtimeState = state;
+  RestoreMemory(state->memoryState);
+  WorkerAttach(state->worker);
+  kotlin::profiler::OnRuntimeThreadAttached();
+  state->status = RuntimeStatus::kRunning;
+}
+
+bool tryDetachRuntime(RuntimeState* state) {
+  // With the legacy mode the globals are destroyed with the last runtime, which must not wait in the pool.
+  if (Kotlin_getDestroyRuntimeMode() != DESTROY_RUNTIME_ON_SHUTDOWN) return false;
+  LockGuard<SimpleMutex> guard(detachedRuntimesMutex);
+  if (detachedRuntimesCount == kMaxDetachedRuntimes || atomicGet(&globalRuntimeStatus) != kGlobalRuntimeRunning)
+    return false;
+  if (!DetachMemory(state->memoryState))
+    return false;
+  WorkerDetach(state->worker);
+  state->status = RuntimeStatus::kDetached;
+  state->nextDetached = detachedRuntimes;
+  detachedRuntimes = state;
+  ++detachedRuntimesCount;
+  return true;
+}
+
+void recordRuntimeAttach(uint64_t startNanos, bool reused) {
+  int64_t duration = static_cast<int64_t>(konan::getTimeNanos() - startNanos);
+  atomicAdd(&runtimeAttachCount, static_cast<int64_t>(1));
+  if (reused) atomicAdd(&reusedRuntimeAttachCount, static_cast<int64_t>(1));
+  atomicAdd(&runtimeAttachTimeNanos, duration);
+  int64_t max = atomicGet(&maxRuntimeAttachTimeNanos);
+  while (duration > max) {
+    int64_t previous = compareAndSwap(&maxRuntimeAttachTimeNanos, max, duration);
+    if (previous == max) break;
+    max = previous;
+  }
+}
+
+// Destroys the detached runtime states, so that the checkers at shutdown don't see them as alive runtimes.
+void destroyDetachedRuntimes(RuntimeState* current) {
+  RuntimeState* state = takeDetachedRuntime();
+  if (state == nullptr) return;
+  DetachMemory(current->memoryState);
+  WorkerDetach(current->worker);
+  while (state != nullptr) {
+    bindDetachedRuntime(state);
+    deinitRuntime(state, false);
+    state = takeDetachedRuntime();
+  }
+  ::runtimeState = current;
+  RestoreMemory(current->memoryState);
+  WorkerAttach(current->worker);
+}
+
 void Kotlin_deinitRuntimeCallback(void* argument) {
   auto* state = reinterpret_cast<RuntimeState*>(argument);
   deinitRuntime(state, false);
@@ -180,6 +330,35 @@ void AppendToInitializersTail(InitNode *next) {
   initTailNode = next;
 }
 
+void CallInitGlobalPossiblyLock(int32_t volatile* state, void (*init)()) {
+  int32_t threadId = currentFileInitThreadId();
+  while (true) {
+    int32_t value = compareAndSwap(state, static_cast<int32_t>(FILE_NOT_INITIALIZED), threadId);
+    if (value == FILE_INITIALIZED || value == threadId) {
+      // Done, or accessed by the initializer itself.
+      return;
+    }
+    if (value == FILE_FAILED_TO_INITIALIZE) {
+      ThrowIllegalStateException();
+    }
+    if (value == FILE_NOT_INITIALIZED) break;
+    // Another thread is running the initializer.
+    waitForFileInitializer(state);
+  }
+#if KONAN_NO_EXCEPTIONS
+  init();
+#else
+  try {
+    init();
+  } catch (...) {
+    completeFileInitializer(state, FILE_FAILED_TO_INITIALIZE);
+    throw;
+  }
+#endif
+  atomicAdd(&initializedFilesCount, 1);
+  completeFileInitializer(state, FILE_INITIALIZED);
+}
+
 void Kotlin_initRuntimeIfNeeded() {
   if (!isValidRuntime()) {
     initRuntime();
@@ -195,6 +374,37 @@ void Kotlin_deinitRuntimeIfNeeded() {
   }
 }
 
+void Kotlin_attachRuntime() {
+  if (isValidRuntime()) {
+    ++::runtimeState->attachDepth;
+    return;
+  }
+  uint64_t start = konan::getTimeNanos();
+  RuntimeState* state = takeDetachedRuntime();
+  bool reused = state != nullptr;
+  if (reused) {
+    bindDetachedRuntime(state);
+    // Thread-local globals of primitive types live in the native TLS of the thread, so initialize all of them anew.
+    InitOrDeinitGlobalVariables(INIT_THREAD_LOCAL_GLOBALS, state->memoryState);
+  } else {
+    state = initRuntime();
+    state->attached = true;
+  }
+  state->attachDepth = 1;
+  recordRuntimeAttach(start, reused);
+}
+
+void Kotlin_detachRuntime() {
+  RuntimeState* state = ::runtimeState;
+  RuntimeAssert(state != kInvalidRuntime && state->attachDepth > 0, "Runtime must be attached to the current thread");
+  if (--state->attachDepth > 0 || !state->attached) return;
+  konan::consoleFlush();
+  if (!tryDetachRuntime(state)) {
+    deinitRuntime(state, false);
+  }
+  ::runtimeState = kInvalidRuntime;
+}
+
 // TODO: Consider exporting it to interop API.
 void Kotlin_shutdownRuntime() {
     auto* runtime = ::runtimeState;
@@ -233,6 +443,7 @@ void Kotlin_shutdownRuntime() {
     if (Kotlin_forceCheckedShutdown() || Kotlin_memoryLeakCheckerEnabled() || Kotlin_cleanersLeakCheckerEnabled()) {
         // First make sure workers are gone.
         WaitNativeWorkersTermination();
+        destroyDetachedRuntimes(runtime);
 
         // Now check for existence of any other runtimes.
         auto otherRuntimesCount = atomicGet(&aliveRuntimesCount) - 1;
@@ -344,6 +555,18 @@ void Konan_Platform_setCleanersLeakChecker(KBoolean value) {
     g_checkLeakedCleaners = value;
 }
 
+KInt Konan_Platform_getConsoleBuffering() {
+  return konan::consoleGetBuffering();
+}
+
+void Konan_Platform_setConsoleBuffering(KInt value) {
+  konan::consoleSetBuffering(static_cast<konan::ConsoleBuffering>(value));
+}
+
+void Konan_Platform_flushConsole() {
+  konan::consoleFlush();
+}
+
 bool Kotlin_forceCheckedShutdown() {
     return g_forceCheckedShutdown;
 }
@@ -363,4 +586,28 @@ void Kotlin_Debugging_setForceCheckedShutdown(KBoolean value) {
     g_forceCheckedShutdown = value;
 }
 
+KInt Kotlin_Debugging_getInitializedFilesCount() {
+    return atomicGet(&initializedFilesCount);
+}
+
+KLong Kotlin_Debugging_getRuntimeAttachCount() {
+    return atomicGet(&runtimeAttachCount);
+}
+
+KLong Kotlin_Debugging_getReusedRuntimeAttachCount() {
+    return atomicGet(&reusedRuntimeAttachCount);
+}
+
+KLong Kotlin_Debugging_getRuntimeAttachTimeNanos() {
+    return atomicGet(&runtimeAttachTimeNanos);
+}
+
+KLong Kotlin_Debugging_getMaxRuntimeAttachTimeNanos() {
+    return atomicGet(&maxRuntimeAttachTimeNanos);
+}
+
+KLong Kotlin_Debugging_getObjectHeapSize() {
+    return konan::object_heap_size();
+}
+
 }  // extern "C"
@@ -36,6 +36,13 @@ DestroyRuntimeMode Kotlin_getDestroyRuntimeMode();
 void Kotlin_initRuntimeIfNeeded();
 void Kotlin_deinitRuntimeIfNeeded();
 
+// Attaches a runtime to the current thread for a short-lived call into Kotlin from a foreign thread. Reuses a
+// runtime state detached by another thread if there is one, so only thread-local globals are initialized anew.
+// Calls can be nested, and do nothing but counting if the thread already has a runtime.
+void Kotlin_attachRuntime();
+// Undoes `Kotlin_attachRuntime`. The runtime state goes to the pool for other threads to attach.
+void Kotlin_detachRuntime();
+
 // Can only be called once.
 // No new runtimes can be initialized on any thread after this.
 // Must be called on a thread with active runtime.
@@ -45,6 +52,11 @@ void Kotlin_shutdownRuntime();
 // Appends given node to an initializer list.
 void AppendToInitializersTail(struct InitNode*);
 
+// Runs the global initializer of a lazily initialized file unless it's done already. `state` is the file's
+// init state word, compiled code checks it with an acquire load first and only calls here if the file isn't
+// initialized yet. Other threads wait for the initializer to finish, recursive calls from it return at once.
+void CallInitGlobalPossiblyLock(int32_t volatile* state, void (*init)());
+
 bool Kotlin_memoryLeakCheckerEnabled();
 
 bool Kotlin_cleanersLeakCheckerEnabled();
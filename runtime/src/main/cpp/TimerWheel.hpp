@@ -0,0 +1,277 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_TIMER_WHEEL_H
+#define RUNTIME_TIMER_WHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "KAssert.h"
+#include "Types.h"
+#include "Utils.hpp"
+
+namespace kotlin {
+
+// Hierarchical timing wheel, after William Ahern's timeout.c: adding and cancelling a timer take constant time,
+// and timers expire in batches as the wheel is advanced. There are `kLevels` wheels of 64 slots, a slot of
+// level N spans 64^N time units, and a timer sits on the level of the highest 6-bit digit of its remaining time.
+// When the lower levels wrap around, the due slots of the higher levels are cascaded down.
+//
+// Timers are nodes of a pool linked into the slots by index, so that a wheel doesn't allocate once the pool
+// has reached its usual size. Not thread safe.
+template <typename Value>
+class TimerWheel : private Pinned {
+public:
+    // Identifies a timer until it expires or is cancelled. Never 0, and fits into a non-negative `int64_t`.
+    using Handle = uint64_t;
+
+    explicit TimerWheel(uint64_t now) noexcept : now_(now) { heads_.fill(kNone); }
+
+    uint64_t now() const noexcept { return now_; }
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Adds a timer expiring at `when`. A time that is not after `now()` expires on the next `Advance`.
+    Handle Add(uint64_t when, Value value) noexcept {
+        uint32_t index = AllocateNode();
+        Node& node = nodes_[index];
+        node.when = when;
+        node.sequence = sequence_++;
+        node.value = value;
+        Schedule(index);
+        ++size_;
+        return (static_cast<Handle>(node.generation) << 32) | (index + 1);
+    }
+
+    // Removes the timer and stores its value to `value`. Returns false if the timer has already expired or
+    // has been cancelled.
+    bool Cancel(Handle handle, Value* value) noexcept {
+        uint64_t index = (handle & 0xFFFFFFFF) - 1;
+        if (index >= nodes_.size()) return false;
+        Node& node = nodes_[index];
+        if (node.generation != (handle >> 32) || node.list == kFree) return false;
+        Unlink(index);
+        *value = node.value;
+        FreeNode(index);
+        --size_;
+        return true;
+    }
+
+    // Moves the wheel to `now` and calls `expired(value)` for every timer due by then, ordered by time and,
+    // for equal times, by the order of `Add`. `expired` may add and cancel timers.
+    template <typename F>
+    void Advance(uint64_t now, F expired) noexcept {
+        if (now > now_) {
+            Collect(now);
+            now_ = now;
+            // Back to the wheel at their remaining time, or to the expired list.
+            for (uint32_t index : batch_) {
+                Schedule(index);
+            }
+            batch_.clear();
+        }
+
+        if (heads_[kExpired] == kNone) return;
+        for (uint32_t index = heads_[kExpired]; index != kNone; index = nodes_[index].next) {
+            batch_.push_back(index);
+            nodes_[index].list = kNone;
+        }
+        heads_[kExpired] = kNone;
+        std::sort(batch_.begin(), batch_.end(), [this](uint32_t lhs, uint32_t rhs) {
+            const Node& left = nodes_[lhs];
+            const Node& right = nodes_[rhs];
+            return left.when != right.when ? left.when < right.when : left.sequence < right.sequence;
+        });
+        // The batch is copied out, for `expired` may add timers and so reallocate the nodes and reuse the batch.
+        KStdVector<Value> values;
+        values.swap(expiredValues_);
+        for (uint32_t index : batch_) {
+            values.push_back(nodes_[index].value);
+            FreeNode(index);
+        }
+        size_ -= batch_.size();
+        batch_.clear();
+        for (const Value& value : values) {
+            expired(value);
+        }
+        values.clear();
+        values.swap(expiredValues_);
+    }
+
+    // Returns the time after `now()` within which `Advance` has to be called, 0 if there are expired timers,
+    // -1 if there are no timers. The actual expiration may be later: the timers of the higher levels are
+    // cascaded at the start of their slots.
+    int64_t NextTimeout() const noexcept {
+        if (heads_[kExpired] != kNone) return 0;
+        uint64_t timeout = UINT64_MAX;
+        uint64_t elapsedMask = 0;
+        for (int level = 0; level < kLevels; ++level) {
+            if (pending_[level] != 0) {
+                int slot = static_cast<int>(kSlotMask & (now_ >> (level * kSlotBits)));
+                // The timers of the higher levels are at least one turn ahead, or they'd be on a lower level.
+                uint64_t levelTimeout = (__builtin_ctzll(RotateRight(pending_[level], slot)) + (level > 0 ? 1 : 0));
+                levelTimeout <<= level * kSlotBits;
+                // Less what the lower levels have advanced within the current slot.
+                levelTimeout -= elapsedMask & now_;
+                timeout = std::min(timeout, levelTimeout);
+            }
+            elapsedMask = (elapsedMask << kSlotBits) | kSlotMask;
+        }
+        return timeout == UINT64_MAX ? -1 : static_cast<int64_t>(timeout);
+    }
+
+    // Calls `f(value)` for every timer, e.g. to dispose of the values along with the wheel.
+    template <typename F>
+    void ForEach(F f) const noexcept {
+        for (const Node& node : nodes_) {
+            if (node.list != kFree) f(node.value);
+        }
+    }
+
+private:
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr int kLevels = 8;
+    // Timers further than that are parked on the last level and rescheduled when its slot comes.
+    static constexpr uint64_t kMaxTimeout = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+
+    static constexpr uint32_t kNone = UINT32_MAX;
+    // List indices: the slots of all the levels, then the timers due by `now_`.
+    static constexpr uint32_t kExpired = kLevels * kSlots;
+    // Marks the nodes of the pool. A node that is out of both the lists and the pool has `list` set to `kNone`.
+    static constexpr uint32_t kFree = kExpired + 1;
+
+    struct Node {
+        uint64_t when;
+        uint64_t sequence;
+        Value value;
+        uint32_t previous;
+        // Also links the free nodes.
+        uint32_t next;
+        uint32_t generation;
+        uint32_t list;
+    };
+
+    static uint64_t RotateLeft(uint64_t value, int shift) noexcept {
+        return (value << shift) | (value >> ((64 - shift) & 63));
+    }
+
+    static uint64_t RotateRight(uint64_t value, int shift) noexcept {
+        return (value >> shift) | (value << ((64 - shift) & 63));
+    }
+
+    uint32_t AllocateNode() noexcept {
+        if (free_ != kNone) {
+            uint32_t index = free_;
+            free_ = nodes_[index].next;
+            return index;
+        }
+        RuntimeAssert(nodes_.size() < UINT32_MAX - 1, "Too many timers");
+        nodes_.push_back(Node{0, 0, Value(), kNone, kNone, 1, kFree});
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    void FreeNode(uint32_t index) noexcept {
+        Node& node = nodes_[index];
+        // Keep the handles non-negative as `int64_t`.
+        node.generation = node.generation == INT32_MAX ? 1 : node.generation + 1;
+        node.list = kFree;
+        node.next = free_;
+        free_ = index;
+    }
+
+    void Link(uint32_t index, uint32_t list) noexcept {
+        Node& node = nodes_[index];
+        node.list = list;
+        node.previous = kNone;
+        node.next = heads_[list];
+        if (node.next != kNone) nodes_[node.next].previous = index;
+        heads_[list] = index;
+    }
+
+    void Unlink(uint32_t index) noexcept {
+        Node& node = nodes_[index];
+        if (node.previous != kNone) {
+            nodes_[node.previous].next = node.next;
+        } else {
+            heads_[node.list] = node.next;
+        }
+        if (node.next != kNone) nodes_[node.next].previous = node.previous;
+        if (node.list < kExpired && heads_[node.list] == kNone) {
+            pending_[node.list / kSlots] &= ~(uint64_t(1) << (node.list % kSlots));
+        }
+        node.list = kNone;
+    }
+
+    void Schedule(uint32_t index) noexcept {
+        uint64_t when = nodes_[index].when;
+        if (when <= now_) {
+            Link(index, kExpired);
+            return;
+        }
+        uint64_t remaining = std::min(when - now_, kMaxTimeout);
+        int level = (63 - __builtin_clzll(remaining)) / kSlotBits;
+        uint32_t slot = static_cast<uint32_t>(kSlotMask & ((when >> (level * kSlotBits)) - (level > 0 ? 1 : 0)));
+        Link(index, level * kSlots + slot);
+        pending_[level] |= uint64_t(1) << slot;
+    }
+
+    // Moves the timers of the slots passed between `now_` and `now` to `batch_`.
+    void Collect(uint64_t now) noexcept {
+        uint64_t elapsed = now - now_;
+        for (int level = 0; level < kLevels; ++level) {
+            int shift = level * kSlotBits;
+            uint64_t passed;
+            if ((elapsed >> shift) > kSlotMask) {
+                passed = ~uint64_t(0);
+            } else {
+                int levelElapsed = static_cast<int>(kSlotMask & (elapsed >> shift));
+                int oldSlot = static_cast<int>(kSlotMask & (now_ >> shift));
+                int newSlot = static_cast<int>(kSlotMask & (now >> shift));
+                uint64_t span = (uint64_t(1) << levelElapsed) - 1;
+                passed = RotateLeft(span, oldSlot);
+                passed |= RotateRight(RotateLeft(span, newSlot), levelElapsed);
+                passed |= uint64_t(1) << newSlot;
+            }
+            while (uint64_t due = passed & pending_[level]) {
+                int slot = __builtin_ctzll(due);
+                uint32_t list = level * kSlots + slot;
+                for (uint32_t index = heads_[list]; index != kNone; index = nodes_[index].next) {
+                    batch_.push_back(index);
+                    nodes_[index].list = kNone;
+                }
+                heads_[list] = kNone;
+                pending_[level] &= ~(uint64_t(1) << slot);
+            }
+            // The higher levels only move when this one wraps around.
+            if ((passed & 1) == 0) break;
+            elapsed = std::max(elapsed, uint64_t(kSlots) << shift);
+        }
+    }
+
+    uint64_t now_;
+    uint64_t sequence_ = 0;
+    size_t size_ = 0;
+    std::array<uint32_t, kExpired + 1> heads_;
+    std::array<uint64_t, kLevels> pending_ = {};
+    KStdVector<Node> nodes_;
+    uint32_t free_ = kNone;
+    // Reused between `Advance` calls.
+    KStdVector<uint32_t> batch_;
+    KStdVector<Value> expiredValues_;
+};
+
+// Out-of-class definitions of the constants bound to references, not needed since C++17.
+template <typename Value>
+constexpr uint64_t TimerWheel<Value>::kMaxTimeout;
+template <typename Value>
+constexpr uint32_t TimerWheel<Value>::kNone;
+
+} // namespace kotlin
+
+#endif // RUNTIME_TIMER_WHEEL_H
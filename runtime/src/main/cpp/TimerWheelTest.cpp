@@ -0,0 +1,167 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "TimerWheel.hpp"
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace kotlin;
+
+namespace {
+
+using IntWheel = TimerWheel<int>;
+
+std::vector<int> Advance(IntWheel& wheel, uint64_t now) {
+    std::vector<int> expired;
+    wheel.Advance(now, [&expired](int value) { expired.push_back(value); });
+    return expired;
+}
+
+} // namespace
+
+TEST(TimerWheelTest, Empty) {
+    IntWheel wheel(1000);
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_THAT(wheel.NextTimeout(), -1);
+    EXPECT_THAT(Advance(wheel, 1000000), testing::IsEmpty());
+    EXPECT_THAT(wheel.now(), 1000000u);
+}
+
+TEST(TimerWheelTest, ExpiresInOrder) {
+    IntWheel wheel(1000);
+    wheel.Add(1000 + 300, 3);
+    wheel.Add(1000 + 100, 1);
+    wheel.Add(1000 + 200000, 4);
+    wheel.Add(1000 + 100, 2);
+    EXPECT_THAT(wheel.size(), 4u);
+
+    EXPECT_THAT(Advance(wheel, 1000 + 99), testing::IsEmpty());
+    EXPECT_THAT(Advance(wheel, 1000 + 500), testing::ElementsAre(1, 2, 3));
+    EXPECT_THAT(wheel.size(), 1u);
+    EXPECT_THAT(Advance(wheel, 1000 + 1000000), testing::ElementsAre(4));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PastTimeExpiresOnNextAdvance) {
+    IntWheel wheel(1000);
+    wheel.Add(10, 1);
+    wheel.Add(1000, 2);
+    EXPECT_THAT(wheel.NextTimeout(), 0);
+    EXPECT_THAT(Advance(wheel, 1000), testing::ElementsAre(1, 2));
+}
+
+TEST(TimerWheelTest, Cancel) {
+    IntWheel wheel(0);
+    auto first = wheel.Add(100, 1);
+    auto second = wheel.Add(100000, 2);
+    EXPECT_THAT(first, testing::Ne(0u));
+    EXPECT_THAT(second, testing::Ne(first));
+
+    int value = 0;
+    EXPECT_TRUE(wheel.Cancel(second, &value));
+    EXPECT_THAT(value, 2);
+    EXPECT_FALSE(wheel.Cancel(second, &value));
+    EXPECT_THAT(Advance(wheel, 1000000), testing::ElementsAre(1));
+    EXPECT_FALSE(wheel.Cancel(first, &value));
+    EXPECT_FALSE(wheel.Cancel(0, &value));
+    EXPECT_FALSE(wheel.Cancel(12345, &value));
+}
+
+TEST(TimerWheelTest, StaleHandleOfReusedNode) {
+    IntWheel wheel(0);
+    auto first = wheel.Add(100, 1);
+    int value = 0;
+    ASSERT_TRUE(wheel.Cancel(first, &value));
+    auto second = wheel.Add(100, 2);
+    EXPECT_THAT(second, testing::Ne(first));
+    EXPECT_FALSE(wheel.Cancel(first, &value));
+    EXPECT_TRUE(wheel.Cancel(second, &value));
+    EXPECT_THAT(value, 2);
+}
+
+TEST(TimerWheelTest, AddFromExpired) {
+    IntWheel wheel(0);
+    wheel.Add(10, 1);
+    std::vector<int> expired;
+    wheel.Advance(10, [&](int value) {
+        expired.push_back(value);
+        for (int i = 0; i < 100; ++i) {
+            wheel.Add(20, value + 1);
+        }
+    });
+    EXPECT_THAT(expired, testing::ElementsAre(1));
+    EXPECT_THAT(wheel.size(), 100u);
+    EXPECT_THAT(Advance(wheel, 20).size(), 100u);
+}
+
+TEST(TimerWheelTest, ForEach) {
+    IntWheel wheel(0);
+    wheel.Add(10, 1);
+    auto handle = wheel.Add(1 << 20, 2);
+    wheel.Add(1ULL << 50, 3);
+    int value = 0;
+    wheel.Cancel(handle, &value);
+    std::vector<int> values;
+    wheel.ForEach([&values](int value) { values.push_back(value); });
+    EXPECT_THAT(values, testing::UnorderedElementsAre(1, 3));
+}
+
+// Checks the wheel against an ordered map, both for the expired timers and for the time until the next one.
+TEST(TimerWheelTest, Random) {
+    std::mt19937_64 random(42);
+    uint64_t now = 1000000;
+    IntWheel wheel(now);
+    std::map<std::pair<uint64_t, int>, IntWheel::Handle> expected;
+    int next = 0;
+    for (int step = 0; step < 200000; ++step) {
+        switch (random() % 4) {
+            case 0: {
+                // Delays of all the magnitudes.
+                uint64_t delay = random() & ((uint64_t(1) << (random() % 40)) - 1);
+                uint64_t when = now + delay;
+                expected.emplace(std::make_pair(when, next), wheel.Add(when, next));
+                ++next;
+                break;
+            }
+            case 1: {
+                if (expected.empty()) break;
+                auto it = expected.begin();
+                std::advance(it, random() % expected.size());
+                int value = -1;
+                ASSERT_TRUE(wheel.Cancel(it->second, &value));
+                EXPECT_THAT(value, it->first.second);
+                expected.erase(it);
+                break;
+            }
+            default: {
+                int64_t timeout = wheel.NextTimeout();
+                if (expected.empty()) {
+                    ASSERT_THAT(timeout, -1);
+                } else {
+                    uint64_t earliest = expected.begin()->first.first;
+                    ASSERT_THAT(timeout, testing::Ge(0));
+                    // Never wakes up later than the earliest timer.
+                    ASSERT_THAT(now + timeout, testing::Le(std::max(earliest, now)));
+                }
+                uint64_t advance = random() % 3 == 0 && timeout > 0 ? timeout : random() & ((uint64_t(1) << (random() % 24)) - 1);
+                now += advance;
+                std::vector<int> due;
+                while (!expected.empty() && expected.begin()->first.first <= now) {
+                    due.push_back(expected.begin()->first.second);
+                    expected.erase(expected.begin());
+                }
+                ASSERT_THAT(Advance(wheel, now), testing::ElementsAreArray(due));
+                break;
+            }
+        }
+        ASSERT_THAT(wheel.size(), expected.size());
+    }
+}
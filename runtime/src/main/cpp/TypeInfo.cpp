@@ -14,66 +14,112 @@
  * limitations under the License.
  */
 
+#include "Alloc.h"
 #include "KAssert.h"
 #include "TypeInfo.h"
 
-// If one shall use binary search when looking up methods and fields.
-// TODO: maybe select strategy basing on number of elements.
-#define USE_BINARY_SEARCH 1
+namespace {
 
-extern "C" {
-#if USE_BINARY_SEARCH
+// Tables of this size or less are scanned linearly and have no index.
+constexpr int kLinearSearchThreshold = 8;
+constexpr int32_t kEmptySlot = -1;
 
-void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
-  int bottom = 0;
-  int top = info->openMethodsCount_ - 1;
+// Keep in sync with RTTIGenerator.tableIndexSlot.
+inline uint32_t MixKey(uint64_t key) {
+  return static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+template <typename Record, typename KeyOf>
+const int32_t* BuildIndex(const Record* records, int count, KeyOf keyOf) {
+  if (count <= kLinearSearchThreshold) return nullptr;
+  uint32_t size = 1;
+  while (size < 2u * count) size <<= 1;
+  auto* index = static_cast<int32_t*>(konanAllocMemory((size + 1) * sizeof(int32_t)));
+  RuntimeCheck(index != nullptr, "Out of memory building a table index");
+  uint32_t mask = size - 1;
+  index[0] = static_cast<int32_t>(mask);
+  int32_t* slots = index + 1;
+  for (uint32_t i = 0; i < size; ++i) slots[i] = kEmptySlot;
+  for (int i = 0; i < count; ++i) {
+    uint32_t slot = MixKey(keyOf(records[i])) & mask;
+    while (slots[slot] != kEmptySlot) slot = (slot + 1) & mask;
+    slots[slot] = i;
+  }
+  return index;
+}
+
+// Returns the number of the record with the given key, or `count` if there is none.
+// `records` must be sorted by the key, `index` is either null or the hash index of `records`.
+template <typename Record, typename KeyOf, typename Key>
+int Find(const Record* records, int count, const int32_t* index, Key key, KeyOf keyOf) {
+  if (index != nullptr) {
+    uint32_t mask = static_cast<uint32_t>(index[0]);
+    const int32_t* slots = index + 1;
+    for (uint32_t slot = MixKey(key) & mask; slots[slot] != kEmptySlot; slot = (slot + 1) & mask) {
+      if (keyOf(records[slots[slot]]) == key) return slots[slot];
+    }
+    return count;
+  }
+
+  if (count <= kLinearSearchThreshold) {
+    for (int i = 0; i < count; ++i) {
+      if (keyOf(records[i]) == key) return i;
+    }
+    return count;
+  }
 
+  int bottom = 0;
+  int top = count - 1;
   while (bottom <= top) {
     int middle = (bottom + top) / 2;
-    if (info->openMethods_[middle].nameSignature_ < nameSignature)
+    Key middleKey = keyOf(records[middle]);
+    if (middleKey < key)
       bottom = middle + 1;
-    else if (info->openMethods_[middle].nameSignature_ == nameSignature)
-      return info->openMethods_[middle].methodEntryPoint_;
+    else if (middleKey == key)
+      return middle;
     else
       top = middle - 1;
   }
+  return count;
+}
 
-  RuntimeAssert(false, "Unknown open method");
-  return nullptr;
+inline MethodNameHash MethodKey(const MethodTableRecord& record) {
+  return record.nameSignature_;
+}
+
+inline ClassId InterfaceKey(const InterfaceTableRecord& record) {
+  return record.id;
+}
+
+}  // namespace
+
+const int32_t* kotlin::BuildOpenMethodsIndex(const MethodTableRecord* methods, int count) {
+  return BuildIndex(methods, count, MethodKey);
 }
 
-#else
+const int32_t* kotlin::BuildInterfaceTableIndex(const InterfaceTableRecord* interfaceTable, int count) {
+  return BuildIndex(interfaceTable, count, InterfaceKey);
+}
+
+extern "C" {
 
 void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) {
-  for (int i = 0; i < info->openMethodsCount_; ++i) {
-    if (info->openMethods_[i].nameSignature_ == nameSignature) {
-      return info->openMethods_[i].methodEntryPoint_;
-    }
-  }
+  int count = info->openMethodsCount_;
+  int index = Find(info->openMethods_, count, info->openMethodsIndex_, nameSignature, MethodKey);
+  if (index < count) return info->openMethods_[index].methodEntryPoint_;
+
   RuntimeAssert(false, "Unknown open method");
   return nullptr;
 }
 
-#endif
-
 // Seeks for the specified id. In case of failure returns a valid pointer to some record, never returns nullptr.
 // It is the caller's responsibility to check if the search has succeeded or not.
-InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord const* interfaceTable,
-                                                       int interfaceTableSize, ClassId interfaceId) {
-  if (interfaceTableSize <= 8) {
-    // Linear search.
-    int i;
-    for (i = 0; i < interfaceTableSize - 1 && interfaceTable[i].id < interfaceId; ++i);
-    return interfaceTable + i;
-  }
-  int l = 0, r = interfaceTableSize - 1;
-  while (l < r) {
-    int m = (l + r) / 2;
-    if (interfaceTable[m].id < interfaceId)
-      l = m + 1;
-    else r = m;
-  }
-  return interfaceTable + l;
+InterfaceTableRecord const* LookupInterfaceTableRecord(const TypeInfo* info, ClassId interfaceId) {
+  RuntimeAssert(info->interfaceTableSize_ < 0, "Only conservative interface tables are looked up");
+  const InterfaceTableRecord* interfaceTable = info->interfaceTable_;
+  int count = -info->interfaceTableSize_;
+  int index = Find(interfaceTable, count, info->interfaceTableIndex_, interfaceId, InterfaceKey);
+  return interfaceTable + (index < count ? index : 0);
 }
 
 }
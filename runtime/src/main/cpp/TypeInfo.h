@@ -63,6 +63,7 @@ enum Konan_TypeFlags {
   TF_LEAK_DETECTOR_CANDIDATE = 1 << 4,
   TF_SUSPEND_FUNCTION = 1 << 5,
   TF_HAS_FINALIZER = 1 << 6,
+  TF_NO_STACK_TRACE = 1 << 7,
 };
 
 // Flags per object instance.
@@ -147,6 +148,12 @@ struct TypeInfo {
     // Null-terminated array.
     const AssociatedObjectTableRecord* associatedObjects;
 
+    // Hash indices of `openMethods_` and of the conservative `interfaceTable_`, or null if the table is small enough
+    // to be scanned. `index[0]` is the mask of the slots following it. A slot holds the number of a record placed by
+    // the hash of its key with linear probing, or -1. Generated by the compiler, see RTTIGenerator.
+    const int32_t* openMethodsIndex_;
+    const int32_t* interfaceTableIndex_;
+
     // vtable starts just after declared contents of the TypeInfo:
     // void* const vtable_[];
 #ifdef __cplusplus
@@ -171,11 +178,20 @@ extern "C" {
 // (as TypeInfo is compile time constant and type info pointers are stable).
 void* LookupOpenMethod(const TypeInfo* info, MethodNameHash nameSignature) RUNTIME_CONST;
 
-InterfaceTableRecord const* LookupInterfaceTableRecord(InterfaceTableRecord const* interfaceTable,
-                                                       int interfaceTableSize, ClassId interfaceId) RUNTIME_CONST;
+// Looks up the conservative interface table of the type, the one with a negative `interfaceTableSize_`.
+// Const for the same reason as `LookupOpenMethod`.
+InterfaceTableRecord const* LookupInterfaceTableRecord(const TypeInfo* info, ClassId interfaceId) RUNTIME_CONST;
 
 #ifdef __cplusplus
 } // extern "C"
+
+namespace kotlin {
+
+// Build the same indices as the compiler does, for the types created at runtime. Return null for the small tables.
+const int32_t* BuildOpenMethodsIndex(const MethodTableRecord* methods, int count);
+const int32_t* BuildInterfaceTableIndex(const InterfaceTableRecord* interfaceTable, int count);
+
+} // namespace kotlin
 #endif
 
 #endif // RUNTIME_TYPEINFO_H
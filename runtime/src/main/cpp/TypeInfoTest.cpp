@@ -0,0 +1,107 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "TypeInfo.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "Alloc.h"
+
+namespace {
+
+void* EntryPoint(size_t index) {
+    return reinterpret_cast<void*>(index + 1);
+}
+
+// Checks the lookups both in the tables indexed like the compiler does, and in the ones without an index.
+void CheckOpenMethods(std::vector<MethodNameHash> hashes) {
+    std::sort(hashes.begin(), hashes.end());
+    std::vector<MethodTableRecord> methods;
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        methods.push_back({hashes[i], EntryPoint(i)});
+    }
+    for (bool indexed : {false, true}) {
+        TypeInfo info = {};
+        info.openMethods_ = methods.data();
+        info.openMethodsCount_ = methods.size();
+        if (indexed) {
+            info.openMethodsIndex_ = kotlin::BuildOpenMethodsIndex(methods.data(), methods.size());
+            EXPECT_EQ(methods.size() > 8, info.openMethodsIndex_ != nullptr);
+        }
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            EXPECT_EQ(EntryPoint(i), LookupOpenMethod(&info, hashes[i]))
+                    << "size " << hashes.size() << ", index " << i << ", indexed " << indexed;
+        }
+        konanFreeMemory(const_cast<int32_t*>(info.openMethodsIndex_));
+    }
+}
+
+void CheckInterfaceTable(std::vector<ClassId> ids) {
+    std::sort(ids.begin(), ids.end());
+    std::vector<InterfaceTableRecord> table;
+    for (ClassId id : ids) {
+        table.push_back({id, 0, nullptr});
+    }
+    int size = table.size();
+    for (bool indexed : {false, true}) {
+        TypeInfo info = {};
+        info.interfaceTable_ = table.data();
+        info.interfaceTableSize_ = -size;
+        if (indexed) info.interfaceTableIndex_ = kotlin::BuildInterfaceTableIndex(table.data(), size);
+        for (ClassId id : ids) {
+            const InterfaceTableRecord* record = LookupInterfaceTableRecord(&info, id);
+            EXPECT_EQ(id, record->id) << "indexed " << indexed;
+            // Missing ids still give a valid record.
+            for (ClassId missing : {id - 1, id + 1}) {
+                record = LookupInterfaceTableRecord(&info, missing);
+                ASSERT_GE(record, table.data());
+                ASSERT_LT(record, table.data() + size);
+                if (!std::binary_search(ids.begin(), ids.end(), missing)) {
+                    EXPECT_NE(missing, record->id);
+                }
+            }
+        }
+        konanFreeMemory(const_cast<int32_t*>(info.interfaceTableIndex_));
+    }
+}
+
+} // namespace
+
+TEST(TypeInfoTest, LookupOpenMethod) {
+    std::mt19937_64 random(42);
+    for (size_t size : {1, 2, 8, 9, 100, 1000}) {
+        std::vector<MethodNameHash> hashes;
+        while (hashes.size() < size) hashes.push_back(random());
+        CheckOpenMethods(hashes);
+    }
+}
+
+TEST(TypeInfoTest, LookupOpenMethodCollisions) {
+    std::vector<MethodNameHash> hashes;
+    for (MethodNameHash i = 0; i < 100; ++i) hashes.push_back(i);
+    hashes.push_back(~0ull);
+    CheckOpenMethods(hashes);
+
+    hashes.clear();
+    for (MethodNameHash i = 0; i < 64; ++i) hashes.push_back(1ull << i);
+    CheckOpenMethods(hashes);
+}
+
+TEST(TypeInfoTest, LookupInterfaceTableRecord) {
+    std::mt19937 random(42);
+    for (size_t size : {1, 2, 8, 9, 100}) {
+        std::vector<ClassId> ids;
+        while (ids.size() < size) {
+            ClassId id = random() % 100000 - 50000;
+            if (std::find(ids.begin(), ids.end(), id) == ids.end()) ids.push_back(id);
+        }
+        CheckInterfaceTable(ids);
+    }
+    CheckInterfaceTable({-2000000000, -1, 0, 1, 2, 3, 4, 5, 6, 7, 2000000000});
+}
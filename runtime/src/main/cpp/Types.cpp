@@ -14,8 +14,22 @@
  * limitations under the License.
  */
 
+#include <iterator>
+
 #include "Types.h"
 #include "Exceptions.h"
+#include "Natives.h"
+#include "utf8.h"
+
+namespace {
+
+void appendString(KStdString& out, const ObjHeader* string) noexcept {
+  const ArrayHeader* array = string->array();
+  const KChar* chars = CharArrayAddressOfElementAt(array, 0);
+  utf8::unchecked::utf16to8(chars, chars + array->count_, std::back_inserter(out));
+}
+
+}  // namespace
 
 extern "C" {
 
@@ -109,3 +123,17 @@ KVector4f Kotlin_Vector4i32_of(KInt f0, KInt f1, KInt f2, KInt f3) {
 }
 
 }  // extern "C"
+
+KStdString kotlin::TypeName(const TypeInfo* typeInfo) noexcept {
+  KStdString result;
+  if (typeInfo->relativeName_ == nullptr) {
+    result = "<anonymous>";
+    return result;
+  }
+  if (typeInfo->packageName_ != nullptr && typeInfo->packageName_->array()->count_ > 0) {
+    appendString(result, typeInfo->packageName_);
+    result += '.';
+  }
+  appendString(result, typeInfo->relativeName_);
+  return result;
+}
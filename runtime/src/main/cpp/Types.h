@@ -116,6 +116,13 @@ bool IsSubInterface(const TypeInfo* thiz, const TypeInfo* other) RUNTIME_PURE;
 
 #ifdef __cplusplus
 }
+
+namespace kotlin {
+
+// Fully qualified name of the type, or "<anonymous>" for the types without one.
+KStdString TypeName(const TypeInfo* typeInfo) noexcept;
+
+} // namespace kotlin
 #endif
 
 #endif // RUNTIME_TYPES_H
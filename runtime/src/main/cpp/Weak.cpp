@@ -16,6 +16,7 @@
 
 #include "Weak.h"
 
+#include "Atomic.h"
 #include "Memory.h"
 #include "Types.h"
 
@@ -25,7 +26,7 @@ namespace {
 struct WeakReferenceCounter {
   ObjHeader header;
   KRef referred;
-  KInt lock;
+  KInt readers;
   KInt cookie;
 };
 
@@ -33,19 +34,8 @@ inline WeakReferenceCounter* asWeakReferenceCounter(ObjHeader* obj) {
   return reinterpret_cast<WeakReferenceCounter*>(obj);
 }
 
-#if !KONAN_NO_THREADS
-
-inline void lock(int32_t* address) {
-    RuntimeAssert(*address == 0 || *address == 1, "Incorrect lock state");
-    while (__sync_val_compare_and_swap(address, 0, 1) == 1);
-}
-
-inline void unlock(int32_t* address) {
-    int old = __sync_val_compare_and_swap(address, 1, 0);
-    RuntimeAssert(old == 1, "Incorrect lock state");
-}
-
-#endif
+// Number of weak references cleared so far, lets weak-keyed maps skip looking for dead keys.
+KLong clearedWeakReferencesCount = 0;
 
 }  // namespace
 
@@ -85,7 +75,7 @@ OBJ_GETTER(Konan_WeakReferenceCounter_get, ObjHeader* counter) {
   RETURN_OBJ(*referredAddress);
 #else
   auto* weakCounter = asWeakReferenceCounter(counter);
-  RETURN_RESULT_OF(ReadHeapRefLocked, referredAddress,  &weakCounter->lock,  &weakCounter->cookie);
+  RETURN_RESULT_OF(ReadHeapRefLockFree, referredAddress, &weakCounter->readers, &weakCounter->cookie);
 #endif
 }
 
@@ -94,13 +84,18 @@ void WeakReferenceCounterClear(ObjHeader* counter) {
   // Note, that we don't do UpdateRef here, as reference is weak.
 #if KONAN_NO_THREADS
   *referredAddress = nullptr;
+  clearedWeakReferencesCount++;
 #else
-  int32_t* lockAddress = &asWeakReferenceCounter(counter)->lock;
-  // Spinlock.
-  lock(lockAddress);
-  *referredAddress = nullptr;
-  unlock(lockAddress);
+  atomicSet(referredAddress, static_cast<ObjHeader*>(nullptr));
+  // Readers which have seen the old value must retain it before the object can go away.
+  int32_t* readers = &asWeakReferenceCounter(counter)->readers;
+  while (atomicGet(readers) != 0) {}
+  atomicAdd(&clearedWeakReferencesCount, static_cast<KLong>(1));
 #endif
 }
 
+KLong Konan_WeakReference_getClearedCount() {
+  return atomicGet(&clearedWeakReferencesCount);
+}
+
 }  // extern "C"
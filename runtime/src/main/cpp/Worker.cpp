@@ -27,12 +27,22 @@
 #include "PthreadUtils.h"
 #endif
 
+#if WITH_WORKERS && (KONAN_LINUX || KONAN_ANDROID)
+#define WITH_EPOLL 1
+#include <errno.h>
+#include <limits.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 #include "Alloc.h"
 #include "Exceptions.h"
 #include "KAssert.h"
 #include "Memory.h"
 #include "ObjCMMAPI.h"
 #include "Runtime.h"
+#include "TimerWheel.hpp"
 #include "Types.h"
 #include "Worker.h"
 
@@ -41,6 +51,7 @@ extern "C" {
 RUNTIME_NORETURN void ThrowWorkerInvalidState();
 RUNTIME_NORETURN void ThrowWorkerUnsupported();
 OBJ_GETTER(WorkerLaunchpad, KRef);
+void WorkerFdCallbackLaunchpad(KRef callback, KInt events);
 
 }  // extern "C"
 
@@ -70,6 +81,17 @@ enum JobKind {
   // processed for APIs returning request process status.
   JOB_REGULAR = 2,
   JOB_EXECUTE_AFTER = 3,
+  JOB_NATIVE = 4,
+  JOB_FD_READY = 5,
+  JOB_DISPOSE = 6,
+};
+
+// Same as the `FD_*` constants of `Worker`.
+enum {
+  FD_READABLE = 1,
+  FD_WRITABLE = 2,
+  FD_ERROR = 4,
+  FD_HANGUP = 8,
 };
 
 enum class WorkerKind {
@@ -94,19 +116,119 @@ struct Job {
 
     struct {
       KNativePtr operation;
-      uint64_t whenExecute;
     } executeAfter;
+
+    struct {
+      void (*function)(void*);
+      void* argument;
+    } nativeJob;
+
+    struct {
+      int fd;
+      // Of the listener, so that the job of a removed one is skipped.
+      uint32_t generation;
+      KInt events;
+    } fdReady;
+
+    struct {
+      KNativePtr pointer;
+    } dispose;
   };
 };
 
-struct JobCompare {
-  bool operator() (const Job& lhs, const Job& rhs) const {
-    RuntimeAssert(lhs.kind == JOB_EXECUTE_AFTER && rhs.kind == JOB_EXECUTE_AFTER, "Must be delayed jobs");
-    return lhs.executeAfter.whenExecute < rhs.executeAfter.whenExecute;
-  }
+#if WITH_EPOLL
+
+// A descriptor watched by the worker's event loop.
+struct FdListener {
+  KNativePtr callback;
+  uint32_t generation;
+  // The `FD_*` events the listener waits for.
+  KInt events;
+  // The callback is being called. Then `runFdListener` disposes of the callback once it returns.
+  bool running;
 };
 
-typedef KStdOrderedSet<Job, JobCompare> DelayedJobSet;
+// `epoll_event.data` of the wakeup eventfd. Those of the listeners are their generations and descriptors.
+constexpr uint64_t kWakeupEventData = UINT64_MAX;
+
+// The descriptors are polled between that many jobs, so that they are not starved by a queue that never empties.
+constexpr uint32_t kFdPollInterval = 64;
+
+epoll_event fdListenerEvent(int fd, const FdListener& listener) {
+  epoll_event event = {};
+  // One-shot, so that a ready descriptor is queued once, and then watched again after the callback.
+  event.events = EPOLLONESHOT;
+  if (listener.events & FD_READABLE) event.events |= EPOLLIN;
+  if (listener.events & FD_WRITABLE) event.events |= EPOLLOUT;
+  event.data.u64 = (static_cast<uint64_t>(listener.generation) << 32) | static_cast<uint32_t>(fd);
+  return event;
+}
+
+KInt fdEvents(uint32_t epollEvents) {
+  KInt events = 0;
+  if (epollEvents & EPOLLIN) events |= FD_READABLE;
+  if (epollEvents & EPOLLOUT) events |= FD_WRITABLE;
+  if (epollEvents & EPOLLERR) events |= FD_ERROR;
+  if (epollEvents & (EPOLLHUP | EPOLLRDHUP)) events |= FD_HANGUP;
+  return events;
+}
+
+#endif  // WITH_EPOLL
+
+// Operations of the delayed jobs, keyed by the time in microseconds.
+typedef kotlin::TimerWheel<KNativePtr> DelayedJobWheel;
+
+// Ring buffer of jobs. It grows when full and never shrinks, so that a worker doesn't allocate
+// for its jobs once the queue has reached its usual length.
+class JobQueue {
+ public:
+  JobQueue() : jobs_(kInitialCapacity) {}
+
+  size_t size() const { return size_; }
+
+  // Index 0 is the front.
+  const Job& operator[](size_t index) const { return jobs_[(head_ + index) & mask()]; }
+
+  const Job& front() const { return (*this)[0]; }
+
+  void push_back(const Job& job) {
+    if (size_ == jobs_.size()) grow();
+    jobs_[(head_ + size_) & mask()] = job;
+    size_++;
+  }
+
+  void push_front(const Job& job) {
+    if (size_ == jobs_.size()) grow();
+    head_ = (head_ - 1) & mask();
+    jobs_[head_] = job;
+    size_++;
+  }
+
+  void pop_front() {
+    RuntimeAssert(size_ > 0, "Queue must not be empty");
+    head_ = (head_ + 1) & mask();
+    size_--;
+  }
+
+ private:
+  static constexpr size_t kInitialCapacity = 16;
+
+  size_t mask() const { return jobs_.size() - 1; }
+
+  void grow() {
+    KStdVector<Job> jobs(jobs_.size() * 2);
+    for (size_t i = 0; i < size_; ++i) {
+      jobs[i] = (*this)[i];
+    }
+    jobs_.swap(jobs);
+    head_ = 0;
+  }
+
+  // The capacity is a power of 2.
+  KStdVector<Job> jobs_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
 
 }  // namespace
 
@@ -115,6 +237,7 @@ class Worker {
   Worker(KInt id, bool errorReporting, KRef customName, WorkerKind kind)
       : id_(id),
         kind_(kind),
+        delayed_(konan::getTimeMicros()),
         errorReporting_(errorReporting) {
     name_ = customName != nullptr ? CreateStablePointer(customName) : nullptr;
     pthread_mutex_init(&lock_, nullptr);
@@ -126,7 +249,10 @@ class Worker {
   void startEventLoop();
 
   void putJob(Job job, bool toFront);
-  void putDelayedJob(Job job);
+  // Returns the handle for `cancelDelayedJob`.
+  DelayedJobWheel::Handle putDelayedJob(KNativePtr operation, uint64_t whenExecute);
+  // Stores the operation of the cancelled job to `operation`, leaving disposing of it to the caller.
+  bool cancelDelayedJob(DelayedJobWheel::Handle handle, KNativePtr* operation);
 
   bool waitDelayed(bool blocking);
 
@@ -136,6 +262,12 @@ class Worker {
 
   bool waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining);
 
+  // Calls `callback` on the worker whenever `fd` gets ready for `events`. Returns false if the descriptor
+  // cannot be watched or is already watched by this worker.
+  bool addFdListener(int fd, KInt events, KNativePtr callback);
+  // Stores the callback to `callback` if the caller has to dispose of it, or nullptr if it is being called.
+  bool removeFdListener(int fd, KNativePtr* callback);
+
   JobKind processQueueElement(bool blocking);
 
   bool park(KLong timeoutMicroseconds, bool process);
@@ -153,8 +285,8 @@ class Worker {
  private:
   KInt id_;
   WorkerKind kind_;
-  KStdDeque<Job> queue_;
-  DelayedJobSet delayed_;
+  JobQueue queue_;
+  DelayedJobWheel delayed_;
   // Stable pointer with worker's name.
   KNativePtr name_;
   // Lock and condition for waiting on the queue.
@@ -164,6 +296,29 @@ class Worker {
   bool errorReporting_;
   bool terminated_ = false;
   pthread_t thread_ = 0;
+
+  // Wakes the worker waiting for the queue.
+  void signalLocked();
+  // Waits until signalled, or `timeoutMicroseconds` passes if it is not negative.
+  void waitLocked(KLong timeoutMicroseconds, uint64_t* microsecondsPassed);
+  void runFdListener(const Job& job);
+
+#if WITH_EPOLL
+  // Queues the ready descriptors, waiting for them and for the signal to the worker.
+  void pollLocked(KLong timeoutMicroseconds, uint64_t* microsecondsPassed);
+  void rearmLocked(int fd, const FdListener& listener);
+
+  // The event loop waits with `epoll_wait` instead of `cond_` once the first descriptor listener is added.
+  int epollFd_ = -1;
+  // An eventfd watched by `epollFd_`, written to wake the worker.
+  int wakeupFd_ = -1;
+  // If the worker is in `epoll_wait`, and has to be woken up through `wakeupFd_`.
+  bool polling_ = false;
+  // Taken since the descriptors were last polled.
+  uint32_t jobsSincePoll_ = 0;
+  uint32_t nextFdListenerGeneration_ = 1;
+  KStdUnorderedMap<int, FdListener> fdListeners_;
+#endif  // WITH_EPOLL
 };
 
 #endif  // WITH_WORKERS
@@ -197,9 +352,12 @@ class Locker {
   pthread_mutex_t* lock_;
 };
 
-class Future {
+constexpr size_t kCacheLineSize = 64;
+
+// Futures live in the slots of `FuturePool` and are reused once consumed.
+class alignas(kCacheLineSize) Future {
  public:
-  Future(KInt id) : state_(SCHEDULED), id_(id) {
+  explicit Future(uint32_t index) : state_(INVALID), id_(0), result_(nullptr), index_(index) {
     pthread_mutex_init(&lock_, nullptr);
     pthread_cond_init(&cond_, nullptr);
   }
@@ -210,6 +368,34 @@ class Future {
     pthread_cond_destroy(&cond_);
   }
 
+  // The id is the slot index with the generation of the slot, incremented on every reuse,
+  // in the upper bits. So the ids of the consumed futures don't refer to the new ones.
+  static constexpr int kIndexBits = 22;
+  static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+  static constexpr uint32_t kMaxGeneration = (1u << (31 - kIndexBits)) - 1;
+
+  static uint32_t indexOf(KInt id) { return static_cast<uint32_t>(id) & kIndexMask; }
+
+  // Those are called with the State lock taken.
+  void acquire() {
+    Locker locker(&lock_);
+    generation_ = generation_ % kMaxGeneration + 1;
+    id_ = static_cast<KInt>((generation_ << kIndexBits) | index_);
+    state_ = SCHEDULED;
+    result_ = nullptr;
+  }
+
+  void release() {
+    clear();
+    Locker locker(&lock_);
+    id_ = 0;
+    state_ = INVALID;
+  }
+
+  uint32_t index() const { return index_; }
+  uint32_t nextFree() const { return nextFree_; }
+  void setNextFree(uint32_t index) { nextFree_ = index; }
+
   void clear() {
     Locker locker(&lock_);
     if (result_ != nullptr) {
@@ -219,14 +405,14 @@ class Future {
     }
   }
 
-  OBJ_GETTER0(consumeResultUnlocked) {
+  // Sets `thrown` instead of throwing, so that the caller can free the slot first.
+  OBJ_GETTER(consumeResultUnlocked, bool* thrown) {
     Locker locker(&lock_);
     while (state_ == SCHEDULED) {
       pthread_cond_wait(&cond_, &lock_);
     }
-    // TODO: maybe use message from exception?
-    if (state_ == THROWN)
-        ThrowIllegalStateException();
+    *thrown = state_ == THROWN;
+    if (*thrown) RETURN_OBJ(nullptr);
     auto result = AdoptStablePointer(result_, OBJ_RESULT);
     result_ = nullptr;
     return result;
@@ -243,15 +429,87 @@ class Future {
  private:
   // State of future execution.
   KInt state_;
-  // Integer id of the future.
+  // Integer id of the future, 0 when the slot is free.
   KInt id_;
   // Stable pointer with future's result.
   KNativePtr result_;
-  // Lock and condition for waiting on the future.
+  const uint32_t index_;
+  uint32_t generation_ = 0;
+  // Next slot of the free list of the pool.
+  uint32_t nextFree_ = 0;
+  // Lock and condition for waiting on the future, kept for all the uses of the slot.
   pthread_mutex_t lock_;
   pthread_cond_t cond_;
 };
 
+// Slots of the futures, allocated by chunks and never freed. Free slots are reused in LIFO order,
+// so in the steady state scheduling a job doesn't allocate. Called with the State lock taken.
+class FuturePool {
+ public:
+  FuturePool() = default;
+  FuturePool(const FuturePool&) = delete;
+  FuturePool& operator=(const FuturePool&) = delete;
+
+  ~FuturePool() {
+    for (size_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+      for (size_t i = 0; i < kChunkSize; ++i) {
+        chunks_[chunk][i].~Future();
+      }
+      konanFreeMemory(memory_[chunk]);
+    }
+  }
+
+  // Returns nullptr if there are too many futures.
+  Future* allocate() {
+    if (freeList_ == kNoSlot && !grow()) return nullptr;
+    Future* future = slot(freeList_);
+    freeList_ = future->nextFree();
+    future->acquire();
+    return future;
+  }
+
+  void release(Future* future) {
+    future->release();
+    future->setNextFree(freeList_);
+    freeList_ = future->index();
+  }
+
+  Future* find(KInt id) {
+    uint32_t index = Future::indexOf(id);
+    if (index >= chunks_.size() * kChunkSize) return nullptr;
+    Future* future = slot(index);
+    return future->id() == id ? future : nullptr;
+  }
+
+ private:
+  static constexpr size_t kChunkSize = 256;
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+  Future* slot(uint32_t index) { return &chunks_[index / kChunkSize][index % kChunkSize]; }
+
+  bool grow() {
+    if ((chunks_.size() + 1) * kChunkSize > Future::kIndexMask + 1) return false;
+    void* memory = konanAllocMemory(kChunkSize * sizeof(Future) + kCacheLineSize);
+    if (memory == nullptr) return false;
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(memory) + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+    Future* chunk = reinterpret_cast<Future*>(aligned);
+    uint32_t first = static_cast<uint32_t>(chunks_.size() * kChunkSize);
+    // Link the new slots so that the lowest index is taken first.
+    for (size_t i = kChunkSize; i > 0; --i) {
+      new (&chunk[i - 1]) Future(first + static_cast<uint32_t>(i - 1));
+      chunk[i - 1].setNextFree(freeList_);
+      freeList_ = first + static_cast<uint32_t>(i - 1);
+    }
+    chunks_.push_back(chunk);
+    memory_.push_back(memory);
+    return true;
+  }
+
+  KStdVector<Future*> chunks_;
+  KStdVector<void*> memory_;
+  uint32_t freeList_ = kNoSlot;
+};
+
 class State {
  public:
   State() {
@@ -259,7 +517,6 @@ class State {
     pthread_cond_init(&cond_, nullptr);
 
     currentWorkerId_ = 1;
-    currentFutureId_ = 1;
     currentVersion_ = 0;
   }
 
@@ -315,8 +572,8 @@ class State {
     if (it == workers_.end()) return nullptr;
     worker = it->second;
 
-    future = konanConstructInstance<Future>(nextFutureId());
-    futures_[future->id()] = future;
+    future = futures_.allocate();
+    if (future == nullptr) return nullptr;
 
     Job job;
     if (jobFunction == nullptr) {
@@ -336,7 +593,8 @@ class State {
     return future;
   }
 
-  bool executeJobAfterInWorkerUnlocked(KInt id, KRef operation, KLong afterMicroseconds) {
+  // If `handle` is not null, the job is delayed even when `afterMicroseconds` is 0, so that it can be cancelled.
+  bool executeJobAfterInWorkerUnlocked(KInt id, KRef operation, KLong afterMicroseconds, KLong* handle) {
     Worker* worker = nullptr;
     Locker locker(&lock_);
 
@@ -347,18 +605,82 @@ class State {
       return false;
     }
     worker = it->second;
-    Job job;
-    job.kind = JOB_EXECUTE_AFTER;
-    job.executeAfter.operation = CreateStablePointer(operation);
-    if (afterMicroseconds == 0) {
+    KNativePtr operationStablePtr = CreateStablePointer(operation);
+    if (afterMicroseconds == 0 && handle == nullptr) {
+      Job job;
+      job.kind = JOB_EXECUTE_AFTER;
+      job.executeAfter.operation = operationStablePtr;
       worker->putJob(job, false);
     } else {
-      job.executeAfter.whenExecute = konan::getTimeMicros() + afterMicroseconds;
-      worker->putDelayedJob(job);
+      auto delayedHandle = worker->putDelayedJob(operationStablePtr, konan::getTimeMicros() + afterMicroseconds);
+      if (handle != nullptr) *handle = static_cast<KLong>(delayedHandle);
+    }
+    return true;
+  }
+
+  bool cancelDelayedJobInWorkerUnlocked(KInt id, KLong handle) {
+    KNativePtr operation = nullptr;
+    {
+      Locker locker(&lock_);
+
+      auto it = workers_.find(id);
+      if (it == workers_.end()) {
+        return false;
+      }
+      if (!it->second->cancelDelayedJob(static_cast<DelayedJobWheel::Handle>(handle), &operation)) {
+        return false;
+      }
+      operation = disposeOnWorkerLocked(it->second, operation);
+    }
+    if (operation != nullptr) DisposeStablePointer(operation);
+    return true;
+  }
+
+  bool addFdListenerUnlocked(KInt id, KInt fd, KInt events, KRef callback) {
+    KNativePtr callbackStablePtr = CreateStablePointer(callback);
+    {
+      Locker locker(&lock_);
+
+      auto it = workers_.find(id);
+      if (it != workers_.end() && it->second->addFdListener(fd, events, callbackStablePtr)) {
+        return true;
+      }
+    }
+    // Created on this thread, so disposed of right here, but out of `lock_`.
+    DisposeStablePointer(callbackStablePtr);
+    return false;
+  }
+
+  bool removeFdListenerUnlocked(KInt id, KInt fd) {
+    KNativePtr callback = nullptr;
+    {
+      Locker locker(&lock_);
+
+      auto it = workers_.find(id);
+      if (it == workers_.end()) {
+        return false;
+      }
+      if (!it->second->removeFdListener(fd, &callback)) {
+        return false;
+      }
+      if (callback != nullptr) callback = disposeOnWorkerLocked(it->second, callback);
     }
+    if (callback != nullptr) DisposeStablePointer(callback);
     return true;
   }
 
+  // Disposing of a stable pointer may schedule a cleaner, which takes `lock_`, so the caller disposes of it
+  // after releasing the lock. And the object may be not frozen, so a pointer of another worker is disposed of
+  // by a job of that worker instead. Returns the pointer the caller has to dispose of, or nullptr.
+  KNativePtr disposeOnWorkerLocked(Worker* worker, KNativePtr pointer) {
+    if (worker == ::g_worker) return pointer;
+    Job job;
+    job.kind = JOB_DISPOSE;
+    job.dispose.pointer = pointer;
+    worker->putJob(job, false);
+    return nullptr;
+  }
+
   bool scheduleJobInWorkerUnlocked(KInt id, KNativePtr operationStablePtr) {
       Worker* worker = nullptr;
       Locker locker(&lock_);
@@ -376,6 +698,24 @@ class State {
       return true;
   }
 
+  bool scheduleNativeJobInWorkerUnlocked(KInt id, void (*function)(void*), void* argument) {
+      Worker* worker = nullptr;
+      Locker locker(&lock_);
+
+      auto it = workers_.find(id);
+      if (it == workers_.end()) {
+          return false;
+      }
+      worker = it->second;
+
+      Job job;
+      job.kind = JOB_NATIVE;
+      job.nativeJob.function = function;
+      job.nativeJob.argument = argument;
+      worker->putJob(job, false);
+      return true;
+  }
+
   // Returns `true` if something was indeed processed.
   bool processQueueUnlocked(KInt id) {
     // Can only process queue of the current worker.
@@ -392,32 +732,32 @@ class State {
 
   KInt stateOfFutureUnlocked(KInt id) {
     Locker locker(&lock_);
-    auto it = futures_.find(id);
-    if (it == futures_.end()) return INVALID;
-    return it->second->state();
+    Future* future = futures_.find(id);
+    if (future == nullptr) return INVALID;
+    return future->state();
   }
 
   OBJ_GETTER(consumeFutureUnlocked, KInt id) {
     Future* future = nullptr;
     {
       Locker locker(&lock_);
-      auto it = futures_.find(id);
-      if (it == futures_.end()) ThrowWorkerInvalidState();
-      future = it->second;
-
+      future = futures_.find(id);
+      if (future == nullptr) ThrowWorkerInvalidState();
     }
 
-    KRef result = future->consumeResultUnlocked(OBJ_RESULT);
+    bool thrown = false;
+    KRef result = future->consumeResultUnlocked(&thrown, OBJ_RESULT);
 
     {
        Locker locker(&lock_);
-       auto it = futures_.find(id);
-       if (it != futures_.end()) {
-         futures_.erase(it);
-         konanDestructInstance(future);
+       // Unless consumed concurrently.
+       if (futures_.find(id) == future) {
+         futures_.release(future);
        }
     }
 
+    // TODO: maybe use message from exception?
+    if (thrown) ThrowIllegalStateException();
     return result;
   }
 
@@ -463,7 +803,6 @@ class State {
 
   // All those called with lock taken.
   KInt nextWorkerId() { return currentWorkerId_++; }
-  KInt nextFutureId() { return currentFutureId_++; }
 
   void destroyWorkerThreadDataUnlocked(KInt id) {
     Locker locker(&lock_);
@@ -522,11 +861,10 @@ class State {
  private:
   pthread_mutex_t lock_;
   pthread_cond_t cond_;
-  KStdUnorderedMap<KInt, Future*> futures_;
+  FuturePool futures_;
   KStdUnorderedMap<KInt, Worker*> workers_;
   KStdUnorderedMap<KInt, pthread_t> terminating_native_workers_;
   KInt currentWorkerId_;
-  KInt currentFutureId_;
   KInt currentVersion_;
 };
 
@@ -596,8 +934,27 @@ KInt execute(KInt id, KInt transferMode, KRef producer, KNativePtr jobFunction)
 }
 
 void executeAfter(KInt id, KRef job, KLong afterMicroseconds) {
-  if (!theState()->executeJobAfterInWorkerUnlocked(id, job, afterMicroseconds))
+  if (!theState()->executeJobAfterInWorkerUnlocked(id, job, afterMicroseconds, nullptr))
+    ThrowWorkerInvalidState();
+}
+
+KLong executeAfterCancellable(KInt id, KRef job, KLong afterMicroseconds) {
+  KLong handle = 0;
+  if (!theState()->executeJobAfterInWorkerUnlocked(id, job, afterMicroseconds, &handle))
     ThrowWorkerInvalidState();
+  return handle;
+}
+
+KBoolean cancelDelayed(KInt id, KLong handle) {
+  return theState()->cancelDelayedJobInWorkerUnlocked(id, handle);
+}
+
+KBoolean addFdListener(KInt id, KInt fd, KInt events, KRef callback) {
+  return theState()->addFdListenerUnlocked(id, fd, events, callback);
+}
+
+KBoolean removeFdListener(KInt id, KInt fd) {
+  return theState()->removeFdListenerUnlocked(id, fd);
 }
 
 KBoolean processQueue(KInt id) {
@@ -667,6 +1024,22 @@ void executeAfter(KInt id, KRef job, KLong afterMicroseconds) {
   ThrowWorkerUnsupported();
 }
 
+KLong executeAfterCancellable(KInt id, KRef job, KLong afterMicroseconds) {
+  ThrowWorkerUnsupported();
+}
+
+KBoolean cancelDelayed(KInt id, KLong handle) {
+  ThrowWorkerUnsupported();
+}
+
+KBoolean addFdListener(KInt id, KInt fd, KInt events, KRef callback) {
+  ThrowWorkerUnsupported();
+}
+
+KBoolean removeFdListener(KInt id, KInt fd) {
+  ThrowWorkerUnsupported();
+}
+
 KBoolean processQueue(KInt id) {
   ThrowWorkerUnsupported();
 }
@@ -737,6 +1110,20 @@ void WorkerDeinit(Worker* worker) {
 #endif  // WITH_WORKERS
 }
 
+void WorkerAttach(Worker* worker) {
+#if WITH_WORKERS
+  RuntimeAssert(::g_worker == nullptr, "Thread already has a worker");
+  ::g_worker = worker;
+#endif  // WITH_WORKERS
+}
+
+void WorkerDetach(Worker* worker) {
+#if WITH_WORKERS
+  RuntimeAssert(::g_worker == worker, "Must detach the worker of the current thread");
+  ::g_worker = nullptr;
+#endif  // WITH_WORKERS
+}
+
 void WorkerDestroyThreadDataIfNeeded(KInt id) {
 #if WITH_WORKERS
   theState()->destroyWorkerThreadDataUnlocked(id);
@@ -763,11 +1150,20 @@ bool WorkerSchedule(KInt id, KNativePtr jobStablePtr) {
 #endif // WITH_WORKERS
 }
 
+bool WorkerScheduleNative(KInt id, void (*function)(void*), void* argument) {
+#if WITH_WORKERS
+    return theState()->scheduleNativeJobInWorkerUnlocked(id, function, argument);
+#else
+    return false;
+#endif // WITH_WORKERS
+}
+
 #if WITH_WORKERS
 
 Worker::~Worker() {
   // Cleanup jobs in the queue.
-  for (auto job : queue_) {
+  for (size_t i = 0; i < queue_.size(); ++i) {
+    const Job& job = queue_[i];
     switch (job.kind) {
       case JOB_REGULAR:
         DisposeStablePointer(job.regularJob.argument);
@@ -783,6 +1179,18 @@ Worker::~Worker() {
         job.terminationRequest.future->cancelUnlocked();
         break;
       }
+      case JOB_NATIVE: {
+        // The argument is owned by whoever scheduled the job.
+        break;
+      }
+      case JOB_FD_READY: {
+        // The callback is owned by the listener.
+        break;
+      }
+      case JOB_DISPOSE: {
+        DisposeStablePointer(job.dispose.pointer);
+        break;
+      }
       case JOB_NONE: {
         RuntimeCheck(false, "Cannot be in queue");
         break;
@@ -790,10 +1198,17 @@ Worker::~Worker() {
     }
   }
 
-  for (auto job : delayed_) {
-    RuntimeAssert(job.kind == JOB_EXECUTE_AFTER, "Must be delayed");
-    DisposeStablePointer(job.executeAfter.operation);
+  delayed_.ForEach([](KNativePtr operation) { DisposeStablePointer(operation); });
+
+#if WITH_EPOLL
+  for (auto& entry : fdListeners_) {
+    DisposeStablePointer(entry.second.callback);
+  }
+  if (epollFd_ >= 0) {
+    close(epollFd_);
+    close(wakeupFd_);
   }
+#endif
 
   if (name_ != nullptr) DisposeStablePointer(name_);
 
@@ -830,18 +1245,174 @@ void Worker::putJob(Job job, bool toFront) {
     queue_.push_front(job);
   else
     queue_.push_back(job);
-  pthread_cond_signal(&cond_);
+  signalLocked();
 }
 
-void Worker::putDelayedJob(Job job) {
+DelayedJobWheel::Handle Worker::putDelayedJob(KNativePtr operation, uint64_t whenExecute) {
   Locker locker(&lock_);
-  delayed_.insert(job);
+  auto handle = delayed_.Add(whenExecute, operation);
+  signalLocked();
+  return handle;
+}
+
+bool Worker::cancelDelayedJob(DelayedJobWheel::Handle handle, KNativePtr* operation) {
+  Locker locker(&lock_);
+  return delayed_.Cancel(handle, operation);
+}
+
+bool Worker::addFdListener(int fd, KInt events, KNativePtr callback) {
+#if WITH_EPOLL
+  Locker locker(&lock_);
+  if (fdListeners_.count(fd) != 0) return false;
+  if (epollFd_ < 0) {
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeupFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = kWakeupEventData;
+    if (epollFd_ < 0 || wakeupFd_ < 0 || epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeupFd_, &event) != 0) {
+      if (epollFd_ >= 0) close(epollFd_);
+      if (wakeupFd_ >= 0) close(wakeupFd_);
+      epollFd_ = -1;
+      wakeupFd_ = -1;
+      return false;
+    }
+  }
+  FdListener listener = { callback, nextFdListenerGeneration_++, events, false };
+  epoll_event event = fdListenerEvent(fd, listener);
+  if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) return false;
+  fdListeners_.emplace(fd, listener);
+  // The worker may be still waiting on `cond_`.
+  signalLocked();
+  return true;
+#else
+  return false;
+#endif  // WITH_EPOLL
+}
+
+bool Worker::removeFdListener(int fd, KNativePtr* callback) {
+#if WITH_EPOLL
+  Locker locker(&lock_);
+  auto it = fdListeners_.find(fd);
+  if (it == fdListeners_.end()) return false;
+  // Fails if the descriptor is already closed, but then it's not watched anyway.
+  epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+  *callback = it->second.running ? nullptr : it->second.callback;
+  fdListeners_.erase(it);
+  return true;
+#else
+  return false;
+#endif  // WITH_EPOLL
+}
+
+void Worker::runFdListener(const Job& job) {
+#if WITH_EPOLL
+  int fd = job.fdReady.fd;
+  KNativePtr callback = nullptr;
+  {
+    Locker locker(&lock_);
+    auto it = fdListeners_.find(fd);
+    // Removed after the descriptor got ready.
+    if (it == fdListeners_.end() || it->second.generation != job.fdReady.generation) return;
+    it->second.running = true;
+    callback = it->second.callback;
+  }
+  ObjHolder callbackHolder;
+  KRef obj = DerefStablePointer(callback, callbackHolder.slot());
+  try {
+    WorkerFdCallbackLaunchpad(obj, job.fdReady.events);
+  } catch (ExceptionObjHolder& e) {
+    if (errorReporting())
+      ReportUnhandledException(e.obj());
+  }
+  {
+    Locker locker(&lock_);
+    auto it = fdListeners_.find(fd);
+    if (it != fdListeners_.end() && it->second.generation == job.fdReady.generation) {
+      it->second.running = false;
+      rearmLocked(fd, it->second);
+      return;
+    }
+  }
+  // Removed while the callback was running.
+  DisposeStablePointer(callback);
+#endif  // WITH_EPOLL
+}
+
+void Worker::signalLocked() {
   pthread_cond_signal(&cond_);
+#if WITH_EPOLL
+  if (polling_) {
+    uint64_t value = 1;
+    // Can only fail when the counter is about to overflow, and then the worker is woken up anyway.
+    auto written = write(wakeupFd_, &value, sizeof(value));
+    (void)written;
+  }
+#endif
+}
+
+void Worker::waitLocked(KLong timeoutMicroseconds, uint64_t* microsecondsPassed) {
+#if WITH_EPOLL
+  if (epollFd_ >= 0) {
+    pollLocked(timeoutMicroseconds, microsecondsPassed);
+    return;
+  }
+#endif
+  if (timeoutMicroseconds < 0) {
+    pthread_cond_wait(&cond_, &lock_);
+  } else if (timeoutMicroseconds > 0) {
+    WaitOnCondVar(&cond_, &lock_, timeoutMicroseconds * 1000LL, microsecondsPassed);
+  }
+}
+
+#if WITH_EPOLL
+
+void Worker::pollLocked(KLong timeoutMicroseconds, uint64_t* microsecondsPassed) {
+  constexpr int kMaxEvents = 64;
+  epoll_event events[kMaxEvents];
+  // Rounded up, so as not to spin through the last millisecond of the timeout.
+  int timeoutMilliseconds = -1;
+  if (timeoutMicroseconds >= 0) {
+    KLong milliseconds = (timeoutMicroseconds + 999) / 1000;
+    timeoutMilliseconds = milliseconds > INT_MAX ? INT_MAX : static_cast<int>(milliseconds);
+  }
+  uint64_t before = microsecondsPassed ? konan::getTimeMicros() : 0;
+  jobsSincePoll_ = 0;
+  polling_ = true;
+  pthread_mutex_unlock(&lock_);
+  int count = epoll_wait(epollFd_, events, kMaxEvents, timeoutMilliseconds);
+  pthread_mutex_lock(&lock_);
+  polling_ = false;
+  if (microsecondsPassed) *microsecondsPassed = konan::getTimeMicros() - before;
+  // The count is negative if interrupted by a signal, and then the caller just waits again.
+  for (int i = 0; i < count; ++i) {
+    uint64_t data = events[i].data.u64;
+    if (data == kWakeupEventData) {
+      uint64_t value;
+      auto consumed = read(wakeupFd_, &value, sizeof(value));
+      (void)consumed;
+      continue;
+    }
+    Job job;
+    job.kind = JOB_FD_READY;
+    job.fdReady.fd = static_cast<int>(data & 0xFFFFFFFF);
+    job.fdReady.generation = static_cast<uint32_t>(data >> 32);
+    job.fdReady.events = fdEvents(events[i].events);
+    queue_.push_back(job);
+  }
+}
+
+void Worker::rearmLocked(int fd, const FdListener& listener) {
+  epoll_event event = fdListenerEvent(fd, listener);
+  // Fails if the descriptor was closed without removing the listener first, which then never fires again.
+  epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event);
 }
 
+#endif  // WITH_EPOLL
+
 bool Worker::waitDelayed(bool blocking) {
   Locker locker(&lock_);
-  if (delayed_.size() == 0) return false;
+  if (delayed_.empty()) return false;
   if (blocking) waitForQueueLocked(-1, nullptr);
   return true;
 }
@@ -850,6 +1421,12 @@ Job Worker::getJob(bool blocking) {
   Locker locker(&lock_);
   RuntimeAssert(!terminated_, "Must not be terminated");
   if (queue_.size() == 0 && !blocking) return Job { .kind = JOB_NONE };
+#if WITH_EPOLL
+  // Otherwise the descriptors are only polled once the queue is empty.
+  if (epollFd_ >= 0 && queue_.size() != 0 && ++jobsSincePoll_ >= kFdPollInterval) {
+    pollLocked(0, nullptr);
+  }
+#endif
   waitForQueueLocked(-1, nullptr);
   auto result = queue_.front();
   queue_.pop_front();
@@ -857,20 +1434,18 @@ Job Worker::getJob(bool blocking) {
 }
 
 KLong Worker::checkDelayedLocked() {
-  if (delayed_.size() == 0) {
+  if (delayed_.empty()) {
     return -1;
   }
-  auto it = delayed_.begin();
-  auto job = *it;
-  RuntimeAssert(job.kind == JOB_EXECUTE_AFTER, "Must be delayed job");
-  auto now = konan::getTimeMicros();
-  if (job.executeAfter.whenExecute <= now) {
-    delayed_.erase(it);
+  size_t queued = queue_.size();
+  delayed_.Advance(konan::getTimeMicros(), [this](KNativePtr operation) {
+    Job job;
+    job.kind = JOB_EXECUTE_AFTER;
+    job.executeAfter.operation = operation;
     queue_.push_back(job);
-    return 0;
-  } else {
-    return job.executeAfter.whenExecute - now;
-  }
+  });
+  if (queue_.size() != queued) return 0;
+  return delayed_.NextTimeout();
 }
 
 bool Worker::waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining) {
@@ -884,20 +1459,18 @@ bool Worker::waitForQueueLocked(KLong timeoutMicroseconds, KLong* remaining) {
           ? timeoutMicroseconds
           : closestToRunMicroseconds;
     }
-    if (closestToRunMicroseconds == 0) {
-      // Just no wait at all here.
-    } else if (closestToRunMicroseconds > 0) {
+    if (closestToRunMicroseconds >= 0) {
       // Protect from potential overflow, cutting at 10_000_000 seconds, aka 115 days.
       if (closestToRunMicroseconds > 10LL * 1000 * 1000 * 1000 * 1000)
         closestToRunMicroseconds = 10LL * 1000 * 1000 * 1000 * 1000;
-      uint64_t nsDelta = closestToRunMicroseconds * 1000LL;
       uint64_t microsecondsPassed = 0;
-      WaitOnCondVar(&cond_, &lock_, nsDelta, remaining ? &microsecondsPassed : nullptr);
+      // With no time to wait, only picks up the descriptors that are already ready.
+      waitLocked(closestToRunMicroseconds, remaining ? &microsecondsPassed : nullptr);
       if (remaining) {
         *remaining = timeoutMicroseconds - microsecondsPassed;
       }
     } else {
-      pthread_cond_wait(&cond_, &lock_);
+      waitLocked(-1, nullptr);
       if (remaining) *remaining = 0;
     }
     if (timeoutMicroseconds >= 0) return queue_.size() != 0;
@@ -985,6 +1558,18 @@ JobKind Worker::processQueueElement(bool blocking) {
        job.regularJob.future->storeResultUnlocked(result, ok);
        break;
     }
+    case JOB_NATIVE: {
+      job.nativeJob.function(job.nativeJob.argument);
+      break;
+    }
+    case JOB_FD_READY: {
+      runFdListener(job);
+      break;
+    }
+    case JOB_DISPOSE: {
+      DisposeStablePointer(job.dispose.pointer);
+      break;
+    }
     default: {
       RuntimeCheck(false, "Must be exhaustive");
     }
@@ -1016,6 +1601,22 @@ void Kotlin_Worker_executeAfterInternal(KInt id, KRef job, KLong afterMicrosecon
   executeAfter(id, job, afterMicroseconds);
 }
 
+KLong Kotlin_Worker_executeAfterCancellableInternal(KInt id, KRef job, KLong afterMicroseconds) {
+  return executeAfterCancellable(id, job, afterMicroseconds);
+}
+
+KBoolean Kotlin_Worker_cancelDelayedInternal(KInt id, KLong handle) {
+  return cancelDelayed(id, handle);
+}
+
+KBoolean Kotlin_Worker_addFdListenerInternal(KInt id, KInt fd, KInt events, KRef callback) {
+  return addFdListener(id, fd, events, callback);
+}
+
+KBoolean Kotlin_Worker_removeFdListenerInternal(KInt id, KInt fd) {
+  return removeFdListener(id, fd);
+}
+
 KBoolean Kotlin_Worker_processQueueInternal(KInt id) {
   return processQueue(id);
 }
@@ -10,6 +10,10 @@ KInt GetWorkerId(Worker* worker);
 
 Worker* WorkerInit(KBoolean errorReporting);
 void WorkerDeinit(Worker* worker);
+// Make `worker` the worker of the current thread. Used for runtime states moved between threads.
+void WorkerAttach(Worker* worker);
+// Unbind `worker` from the current thread without destroying it.
+void WorkerDetach(Worker* worker);
 // Clean up all associated thread state, if this was a native worker.
 void WorkerDestroyThreadDataIfNeeded(KInt id);
 // Wait until all terminating native workers finish termination. Expected to be called at most once.
@@ -18,5 +22,7 @@ void WaitNativeWorkersTermination();
 void WaitNativeWorkerTermination(KInt id);
 // Schedule the job without the result.
 bool WorkerSchedule(KInt id, KNativePtr jobStablePtr);
+// Schedule `function(argument)` to be called on the worker's thread. The function must not throw.
+bool WorkerScheduleNative(KInt id, void (*function)(void*), void* argument);
 
 #endif // RUNTIME_WORKER_H
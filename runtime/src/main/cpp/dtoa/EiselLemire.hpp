@@ -0,0 +1,31 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_DTOA_EISEL_LEMIRE_H
+#define RUNTIME_DTOA_EISEL_LEMIRE_H
+
+#include <cstdint>
+
+namespace kotlin {
+namespace dtoa {
+
+// Any decimal number with at most that many significant digits fits into the 64-bit mantissa of the fast path.
+constexpr int kEiselLemireMaxDigits = 19;
+
+// Computes the double closest to `mantissa * 10^exponent10`. Small values are computed with plain floating
+// point arithmetic, the rest with a single (rarely two) 64x128-bit multiplication against a table of
+// truncated powers of ten (D. Lemire, "Number Parsing at a Gigabyte per Second", Software: Practice and
+// Experience 51(8), 2021).
+// Returns false when the result cannot be decided this way (ambiguous rounding, subnormal or infinite
+// result, exponent out of the table range). The caller must then fall back to the exact bigint algorithm.
+bool EiselLemireToDouble(uint64_t mantissa, int32_t exponent10, double* result) noexcept;
+
+// The same for floats.
+bool EiselLemireToFloat(uint64_t mantissa, int32_t exponent10, float* result) noexcept;
+
+} // namespace dtoa
+} // namespace kotlin
+
+#endif // RUNTIME_DTOA_EISEL_LEMIRE_H
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "FloatingPointParser.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "EiselLemire.hpp"
+#include "../DoubleConversions.h"
+#include "../Exceptions.h"
+#include "../Natives.h"
+#include "../Types.h"
+
+using namespace kotlin;
+
+// Exact bigint algorithms from dblparse.cpp and fltparse.cpp. Take a null-terminated string of decimal
+// digits without leading and trailing zeros and a decimal exponent.
+KDouble createDouble(const char* s, KInt e);
+KFloat createFloat(const char* s, KInt e);
+
+namespace {
+
+// Exponents beyond that are saturated: they produce zero or infinity anyway.
+constexpr int64_t kMaxExplicitExponent = 1000000;
+
+// Mirrors the trimming of very small numbers in FloatingPointParser.initialParse, since the bigint
+// algorithm can only handle exponents down to E-309.
+constexpr int64_t kApproxMinMagnitude = -359;
+constexpr size_t kMaxDigits = 52;
+
+struct DecimalLiteral {
+    bool negative = false;
+    const char* digitsBegin = nullptr;
+    // Integer and fraction digits, possibly with a single '.' between them.
+    const char* digitsEnd = nullptr;
+    int64_t fractionLength = 0;
+    int64_t exponent = 0;
+};
+
+inline bool isDigit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+bool scanDecimalLiteral(const char* begin, const char* end, DecimalLiteral* literal) noexcept {
+    const char* p = begin;
+    if (p != end && (*p == '+' || *p == '-')) {
+        literal->negative = *p == '-';
+        ++p;
+    }
+    literal->digitsBegin = p;
+    while (p != end && isDigit(*p)) ++p;
+    bool hasDigits = p != literal->digitsBegin;
+    if (p != end && *p == '.') {
+        const char* fractionBegin = ++p;
+        while (p != end && isDigit(*p)) ++p;
+        literal->fractionLength = p - fractionBegin;
+        hasDigits = hasDigits || literal->fractionLength > 0;
+    }
+    literal->digitsEnd = p;
+    if (!hasDigits) return false;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p != end && (*p == '+' || *p == '-')) {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if (p == end || !isDigit(*p)) return false;
+        int64_t exponent = 0;
+        for (; p != end && isDigit(*p); ++p) {
+            if (exponent < kMaxExplicitExponent) exponent = exponent * 10 + (*p - '0');
+        }
+        literal->exponent = negativeExponent ? -exponent : exponent;
+    }
+    return p == end;
+}
+
+struct DoubleTraits {
+    using Type = double;
+    // See FloatingPointParser.DOUBLE_MIN_EXP and DOUBLE_MAX_EXP.
+    static constexpr int64_t kMinExponent = -324;
+    static constexpr int64_t kMaxExponent = 308;
+
+    static bool fastPath(uint64_t mantissa, int32_t exponent10, double* result) noexcept {
+        return dtoa::EiselLemireToDouble(mantissa, exponent10, result);
+    }
+
+    static dtoa::ParseStatus slowPath(const char* digits, KInt exponent10, double* result) {
+        double value = createDouble(digits, exponent10);
+        uint64_t bits = static_cast<uint64_t>(doubleToBits(value));
+        if (static_cast<int32_t>(bits >> 32) >= 0) {
+            *result = value;
+            return dtoa::ParseStatus::kOk;
+        }
+        return static_cast<int32_t>(bits) == -1 ? dtoa::ParseStatus::kInvalidFormat : dtoa::ParseStatus::kOutOfMemory;
+    }
+
+    static double infinity() noexcept { return bitsToDouble(0x7FF0000000000000LL); }
+};
+
+struct FloatTraits {
+    using Type = float;
+    // See FloatingPointParser.FLOAT_MIN_EXP and FLOAT_MAX_EXP.
+    static constexpr int64_t kMinExponent = -46;
+    static constexpr int64_t kMaxExponent = 38;
+
+    static bool fastPath(uint64_t mantissa, int32_t exponent10, float* result) noexcept {
+        return dtoa::EiselLemireToFloat(mantissa, exponent10, result);
+    }
+
+    static dtoa::ParseStatus slowPath(const char* digits, KInt exponent10, float* result) {
+        float value = createFloat(digits, exponent10);
+        int32_t bits = floatToBits(value);
+        if (bits >= 0) {
+            *result = value;
+            return dtoa::ParseStatus::kOk;
+        }
+        return bits == -1 ? dtoa::ParseStatus::kInvalidFormat : dtoa::ParseStatus::kOutOfMemory;
+    }
+
+    static float infinity() noexcept { return bitsToFloat(0x7F800000); }
+};
+
+template <typename Traits>
+dtoa::ParseStatus parseSlow(const DecimalLiteral& literal, typename Traits::Type* result) {
+    KStdString digits;
+    for (const char* p = literal.digitsBegin; p != literal.digitsEnd; ++p) {
+        if (*p == '.' || (digits.empty() && *p == '0')) continue;
+        digits.push_back(*p);
+    }
+    int64_t exponent10 = literal.exponent - literal.fractionLength;
+    while (digits.size() > 1 && digits.back() == '0') {
+        digits.pop_back();
+        ++exponent10;
+    }
+
+    int64_t length = static_cast<int64_t>(digits.size());
+    if (exponent10 + length - 1 < Traits::kMinExponent) {
+        *result = 0;
+        return dtoa::ParseStatus::kOk;
+    }
+    if (exponent10 > Traits::kMaxExponent || exponent10 + length - 1 > Traits::kMaxExponent) {
+        *result = Traits::infinity();
+        return dtoa::ParseStatus::kOk;
+    }
+    if (digits.size() > kMaxDigits && exponent10 < kApproxMinMagnitude) {
+        int64_t trimmed = std::min(kApproxMinMagnitude - exponent10, length - 1);
+        digits.resize(static_cast<size_t>(length - trimmed));
+        exponent10 += trimmed;
+    }
+    return Traits::slowPath(digits.c_str(), static_cast<KInt>(exponent10), result);
+}
+
+template <typename Traits>
+dtoa::ParseStatus parse(const char* begin, const char* end, typename Traits::Type* result) {
+    using T = typename Traits::Type;
+
+    DecimalLiteral literal;
+    if (!scanDecimalLiteral(begin, end, &literal)) return dtoa::ParseStatus::kInvalidFormat;
+
+    uint64_t mantissa = 0;
+    int digitCount = 0;
+    int64_t droppedDigitCount = 0;
+    bool droppedNonZero = false;
+    for (const char* p = literal.digitsBegin; p != literal.digitsEnd; ++p) {
+        if (*p == '.') continue;
+        int digit = *p - '0';
+        if (digitCount == 0 && digit == 0) continue;
+        if (digitCount < dtoa::kEiselLemireMaxDigits) {
+            mantissa = mantissa * 10 + digit;
+            ++digitCount;
+        } else {
+            ++droppedDigitCount;
+            droppedNonZero = droppedNonZero || digit != 0;
+        }
+    }
+
+    T value = 0;
+    dtoa::ParseStatus status = dtoa::ParseStatus::kOk;
+    int64_t exponent10 = literal.exponent - literal.fractionLength + droppedDigitCount;
+    if (mantissa == 0) {
+        value = 0;
+    } else if (exponent10 < -kMaxExplicitExponent || exponent10 > kMaxExplicitExponent) {
+        status = parseSlow<Traits>(literal, &value);
+    } else if (!droppedNonZero) {
+        if (!Traits::fastPath(mantissa, static_cast<int32_t>(exponent10), &value)) status = parseSlow<Traits>(literal, &value);
+    } else {
+        // The exact value lies between mantissa and mantissa + 1 (scaled). If both bounds round to the same
+        // number, so does the value itself.
+        T upper;
+        if (!Traits::fastPath(mantissa, static_cast<int32_t>(exponent10), &value) ||
+            !Traits::fastPath(mantissa + 1, static_cast<int32_t>(exponent10), &upper) || value != upper) {
+            status = parseSlow<Traits>(literal, &value);
+        }
+    }
+    if (status == dtoa::ParseStatus::kOk) *result = literal.negative ? -value : value;
+    return status;
+}
+
+template <typename Traits>
+typename Traits::Type parseUtf8OrThrow(KConstRef bytes, KInt startIndex, KInt endIndex) {
+    const ArrayHeader* array = bytes->array();
+    const char* begin = reinterpret_cast<const char*>(ByteArrayAddressOfElementAt(array, 0));
+    typename Traits::Type result = 0;
+    switch (parse<Traits>(begin + startIndex, begin + endIndex, &result)) {
+        case dtoa::ParseStatus::kOk:
+            return result;
+        case dtoa::ParseStatus::kInvalidFormat:
+            ThrowNumberFormatException();
+        case dtoa::ParseStatus::kOutOfMemory:
+            ThrowOutOfMemoryError();
+    }
+    return result;
+}
+
+} // namespace
+
+dtoa::ParseStatus dtoa::ParseDoubleUtf8(const char* begin, const char* end, double* result) {
+    return parse<DoubleTraits>(begin, end, result);
+}
+
+dtoa::ParseStatus dtoa::ParseFloatUtf8(const char* begin, const char* end, float* result) {
+    return parse<FloatTraits>(begin, end, result);
+}
+
+extern "C" {
+
+KDouble Kotlin_native_FloatingPointParser_parseDoubleUtf8Impl(KConstRef bytes, KInt startIndex, KInt endIndex) {
+    return parseUtf8OrThrow<DoubleTraits>(bytes, startIndex, endIndex);
+}
+
+KFloat Kotlin_native_FloatingPointParser_parseFloatUtf8Impl(KConstRef bytes, KInt startIndex, KInt endIndex) {
+    return parseUtf8OrThrow<FloatTraits>(bytes, startIndex, endIndex);
+}
+
+} // extern "C"
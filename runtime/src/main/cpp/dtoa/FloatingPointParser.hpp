@@ -0,0 +1,35 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_DTOA_FLOATING_POINT_PARSER_H
+#define RUNTIME_DTOA_FLOATING_POINT_PARSER_H
+
+#include <cstddef>
+
+namespace kotlin {
+namespace dtoa {
+
+enum class ParseStatus {
+    kOk,
+    kInvalidFormat,
+    kOutOfMemory,
+};
+
+// Parse a decimal floating point literal `[+-]digits[.digits][(e|E)[+-]digits]` (either the integer
+// or the fraction part may be empty, but not both) directly from the UTF-8 range [begin, end),
+// without creating an intermediate Kotlin string.
+// The range must contain the literal only: no whitespace, no type suffix, no named (NaN, Infinity)
+// or hexadecimal forms. Rounds to the nearest representable value just like `String.toDouble()`.
+// Numbers with at most 19 significant digits and a moderate exponent take the Eisel-Lemire fast path,
+// the rest fall back to the exact bigint algorithm.
+ParseStatus ParseDoubleUtf8(const char* begin, const char* end, double* result);
+
+// The same for floats.
+ParseStatus ParseFloatUtf8(const char* begin, const char* end, float* result);
+
+} // namespace dtoa
+} // namespace kotlin
+
+#endif // RUNTIME_DTOA_FLOATING_POINT_PARSER_H
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "FloatingPointParser.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+#include "EiselLemire.hpp"
+
+using namespace kotlin;
+
+namespace {
+
+double parseDouble(const char* literal) {
+    double result = -1;
+    EXPECT_EQ(dtoa::ParseStatus::kOk, dtoa::ParseDoubleUtf8(literal, literal + strlen(literal), &result)) << literal;
+    return result;
+}
+
+float parseFloat(const char* literal) {
+    float result = -1;
+    EXPECT_EQ(dtoa::ParseStatus::kOk, dtoa::ParseFloatUtf8(literal, literal + strlen(literal), &result)) << literal;
+    return result;
+}
+
+} // namespace
+
+TEST(EiselLemireTest, ExactValues) {
+    double d;
+    ASSERT_TRUE(dtoa::EiselLemireToDouble(1, 0, &d));
+    EXPECT_EQ(1.0, d);
+    ASSERT_TRUE(dtoa::EiselLemireToDouble(239, -2, &d));
+    EXPECT_EQ(2.39, d);
+    ASSERT_TRUE(dtoa::EiselLemireToDouble(1, 22, &d));
+    EXPECT_EQ(1e22, d);
+    ASSERT_TRUE(dtoa::EiselLemireToDouble(17976931348623157ULL, 292, &d));
+    EXPECT_EQ(std::numeric_limits<double>::max(), d);
+
+    float f;
+    ASSERT_TRUE(dtoa::EiselLemireToFloat(5, -1, &f));
+    EXPECT_EQ(0.5f, f);
+    ASSERT_TRUE(dtoa::EiselLemireToFloat(34028235, 31, &f));
+    EXPECT_EQ(std::numeric_limits<float>::max(), f);
+}
+
+TEST(EiselLemireTest, Fallback) {
+    double d;
+    // Out of the table range.
+    EXPECT_FALSE(dtoa::EiselLemireToDouble(1, 400, &d));
+    EXPECT_FALSE(dtoa::EiselLemireToDouble(1, -400, &d));
+    // Subnormal and infinite results.
+    EXPECT_FALSE(dtoa::EiselLemireToDouble(5, -324, &d));
+    EXPECT_FALSE(dtoa::EiselLemireToDouble(2, 308, &d));
+    // Exactly halfway between 2^53 and 2^53 + 2.
+    EXPECT_FALSE(dtoa::EiselLemireToDouble(9007199254740993ULL, 0, &d));
+
+    float f;
+    EXPECT_FALSE(dtoa::EiselLemireToFloat(14, -46, &f));
+    EXPECT_FALSE(dtoa::EiselLemireToFloat(4, 38, &f));
+}
+
+TEST(EiselLemireTest, MatchesStrtod) {
+    // A deterministic sweep over mantissas of different lengths and the whole exponent range.
+    uint64_t mantissa = 1;
+    for (int i = 0; i < 20000; ++i) {
+        mantissa = mantissa * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t value = mantissa % 10000000000000000000ULL;
+        int32_t exponent10 = i % 651 - 342;
+        char literal[64];
+        snprintf(literal, sizeof(literal), "%llue%d", static_cast<unsigned long long>(value), exponent10);
+        double d;
+        if (dtoa::EiselLemireToDouble(value, exponent10, &d)) {
+            EXPECT_EQ(strtod(literal, nullptr), d) << literal;
+        }
+        float f;
+        if (dtoa::EiselLemireToFloat(value, exponent10, &f)) {
+            EXPECT_EQ(strtof(literal, nullptr), f) << literal;
+        }
+    }
+}
+
+TEST(FloatingPointParserTest, ParseDoubleUtf8) {
+    EXPECT_EQ(0.0, parseDouble("0"));
+    EXPECT_TRUE(std::signbit(parseDouble("-0.0")));
+    EXPECT_EQ(0.5, parseDouble(".5"));
+    EXPECT_EQ(5.0, parseDouble("5."));
+    EXPECT_EQ(-12500.0, parseDouble("-12.5E+3"));
+    EXPECT_EQ(1.2345, parseDouble("00000123.4500000e-2"));
+    EXPECT_EQ(9007199254740992.0, parseDouble("9007199254740993"));
+    // Halfway between 1 and the next double rounds to even, anything above it rounds up.
+    EXPECT_EQ(1.0, parseDouble("1.00000000000000011102230246251565404236316680908203125"));
+    EXPECT_EQ(1.0000000000000002, parseDouble("1.00000000000000011102230246251565404236316680908203126"));
+    EXPECT_EQ(123456789012345678901234567890.0, parseDouble("123456789012345678901234567890"));
+    EXPECT_EQ(4.9e-324, parseDouble("4.9e-324"));
+    EXPECT_EQ(0.0, parseDouble("1e-400"));
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), parseDouble("1e400"));
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), parseDouble("1e99999999999999999999"));
+    EXPECT_EQ(0.0, parseDouble("1e-99999999999999999999"));
+}
+
+TEST(FloatingPointParserTest, ParseFloatUtf8) {
+    EXPECT_EQ(0.5f, parseFloat("0.5"));
+    EXPECT_EQ(-2.39f, parseFloat("-2.39"));
+    EXPECT_EQ(1.4e-45f, parseFloat("1.4e-45"));
+    EXPECT_EQ(std::numeric_limits<float>::max(), parseFloat("3.4028235e38"));
+    EXPECT_EQ(std::numeric_limits<float>::infinity(), parseFloat("3.5e38"));
+    EXPECT_EQ(16777216.0f, parseFloat("16777217"));
+}
+
+TEST(FloatingPointParserTest, InvalidFormat) {
+    const char* literals[] = {"", "-", ".", "e5", "1e", "1e+", "1.2.3", "1x", " 1", "1 ", "NaN", "Infinity", "--1", "1e5.5", "0x10", "1d"};
+    for (const char* literal : literals) {
+        double d;
+        EXPECT_EQ(dtoa::ParseStatus::kInvalidFormat, dtoa::ParseDoubleUtf8(literal, literal + strlen(literal), &d)) << literal;
+        float f;
+        EXPECT_EQ(dtoa::ParseStatus::kInvalidFormat, dtoa::ParseFloatUtf8(literal, literal + strlen(literal), &f)) << literal;
+    }
+}
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "cbigint.h"
+#include "EiselLemire.hpp"
 #include "../Exceptions.h"
 #include "../KString.h"
 #include "../Natives.h"
@@ -640,6 +641,19 @@ OutOfMemory:
 
 KDouble Kotlin_native_FloatingPointParser_parseDoubleImpl (KString s, KInt e)
 {
+  /* Fast path: the string holds at most 19 significant digits, accumulate them right away. */
+  if (s->count_ <= kotlin::dtoa::kEiselLemireMaxDigits)
+    {
+      const KChar* digits = CharArrayAddressOfElementAt(s, 0);
+      U_64 mantissa = 0;
+      uint32_t i = 0;
+      for (; i < s->count_ && digits[i] >= '0' && digits[i] <= '9'; ++i)
+        mantissa = mantissa * 10 + (digits[i] - '0');
+      KDouble dbl;
+      if (i == s->count_ && kotlin::dtoa::EiselLemireToDouble (mantissa, e, &dbl))
+        return dbl;
+    }
+
   const KChar* utf16 = CharArrayAddressOfElementAt(s, 0);
   KStdString utf8;
   utf8.reserve(s->count_);
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "cbigint.h"
+#include "EiselLemire.hpp"
 #include "../Exceptions.h"
 #include "../KString.h"
 #include "../Natives.h"
@@ -540,6 +541,19 @@ OutOfMemory:
 extern "C" KFloat
 Kotlin_native_FloatingPointParser_parseFloatImpl(KString s, KInt e)
 {
+  /* Fast path: the string holds at most 19 significant digits, accumulate them right away. */
+  if (s->count_ <= kotlin::dtoa::kEiselLemireMaxDigits)
+    {
+      const KChar* digits = CharArrayAddressOfElementAt(s, 0);
+      U_64 mantissa = 0;
+      uint32_t i = 0;
+      for (; i < s->count_ && digits[i] >= '0' && digits[i] <= '9'; ++i)
+        mantissa = mantissa * 10 + (digits[i] - '0');
+      KFloat flt;
+      if (i == s->count_ && kotlin::dtoa::EiselLemireToFloat (mantissa, e, &flt))
+        return flt;
+    }
+
   const KChar* utf16 = CharArrayAddressOfElementAt(s, 0);
   KStdString utf8;
   utf8.reserve(s->count_);
@@ -0,0 +1,796 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "LazyDfa.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "../Alloc.h"
+#include "../KAssert.h"
+#include "../Porting.h"
+
+using namespace kotlin;
+
+namespace {
+
+constexpr KInt kMaxCodePoint = 0x10FFFF;
+
+// Limits on the pattern complexity. Patterns beyond them are left to the backtracking engine.
+constexpr size_t kMaxPatternLength = 4096;
+constexpr int kMaxNesting = 64;
+constexpr int32_t kMaxRepeat = 1000;
+constexpr size_t kMaxInstructions = 1 << 14;
+constexpr size_t kMaxAlphabetSize = 1024;
+
+// Memory budget of a single DFA cache. An estimate of the per-state overhead of the containers is included.
+constexpr size_t kCacheBudget = 256 * 1024;
+constexpr size_t kStateOverhead = 64;
+// If the cache has to be flushed again before the input advanced by that many code points per cached state,
+// the DFA is not worth it.
+constexpr size_t kMinCodePointsPerState = 10;
+
+constexpr int32_t kUnknownState = -1;
+constexpr uint8_t kAcceptingState = 1 << 0;
+constexpr uint8_t kDeadState = 1 << 1;
+
+constexpr KInt kMaxLazyDfas = 256;
+// Unsupported patterns are remembered as well, up to a limit.
+constexpr size_t kMaxRegistryEntries = 4 * kMaxLazyDfas;
+
+using Ranges = KStdVector<std::pair<KInt, KInt>>;
+
+void normalizeRanges(Ranges& ranges) noexcept {
+    std::sort(ranges.begin(), ranges.end());
+    size_t merged = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        if (merged > 0 && ranges[i].first <= ranges[merged - 1].second + 1) {
+            ranges[merged - 1].second = std::max(ranges[merged - 1].second, ranges[i].second);
+        } else {
+            ranges[merged++] = ranges[i];
+        }
+    }
+    ranges.resize(merged);
+}
+
+// `ranges` must be normalized.
+Ranges negateRanges(const Ranges& ranges) {
+    Ranges result;
+    KInt next = 0;
+    for (const auto& range : ranges) {
+        if (range.first > next) result.emplace_back(next, range.first - 1);
+        next = range.second + 1;
+    }
+    if (next <= kMaxCodePoint) result.emplace_back(next, kMaxCodePoint);
+    return result;
+}
+
+inline bool isSurrogate(KInt codePoint) noexcept {
+    return codePoint >= 0xD800 && codePoint < 0xE000;
+}
+
+inline bool isLineTerminator(KInt codePoint, bool unixLines) noexcept {
+    if (unixLines) return codePoint == '\n';
+    return codePoint == '\n' || codePoint == '\r' || codePoint == 0x0085 || (codePoint | 1) == 0x2029;
+}
+
+inline KInt readCodePoint(const KChar*& it, const KChar* end) noexcept {
+    KChar high = *it++;
+    if (high >= 0xD800 && high < 0xDC00 && it != end && *it >= 0xDC00 && *it < 0xE000) {
+        KChar low = *it++;
+        return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return high;
+}
+
+inline int hexDigit(KInt c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Returns the first occurrence of `literal` in [begin, end) or nullptr.
+const KChar* findLiteral(const KChar* begin, const KChar* end, const KStdVector<KChar>& literal) noexcept {
+    while (begin < end) {
+        void* found = konan::memmem(begin, (end - begin) * sizeof(KChar), literal.data(), literal.size() * sizeof(KChar));
+        if (found == nullptr) return nullptr;
+        size_t offset = reinterpret_cast<uintptr_t>(found) - reinterpret_cast<uintptr_t>(begin);
+        // Byte search may find the literal across the code unit boundaries.
+        if (offset % sizeof(KChar) == 0) return begin + offset / sizeof(KChar);
+        begin += offset / sizeof(KChar) + 1;
+    }
+    return nullptr;
+}
+
+struct Node {
+    enum class Kind {
+        kEmpty,
+        kSet, // A single code point from `set`.
+        kConcat,
+        kAlternation,
+        kRepeat, // `children[0]` repeated from `min` to `max` (-1 for unbounded) times.
+    };
+
+    Kind kind;
+    int32_t set = -1;
+    KStdVector<int32_t> children;
+    int32_t min = 0;
+    int32_t max = 0;
+};
+
+// Recursive descent parser of the supported pattern subset. Any construct it doesn't know exactly
+// makes the whole pattern unsupported.
+class Parser : private Pinned {
+public:
+    Parser(const KChar* pattern, size_t length, KInt flags) : flags_(flags) {
+        const KChar* end = pattern + length;
+        while (pattern != end) {
+            pattern_.push_back(readCodePoint(pattern, end));
+        }
+    }
+
+    // Returns the root node or -1 if the pattern is not supported.
+    int32_t parse() {
+        if (flags_ & regex::kLiteral) {
+            KStdVector<int32_t> literals;
+            for (KInt codePoint : pattern_) {
+                if (isSurrogate(codePoint)) return -1;
+                literals.push_back(addSet({{codePoint, codePoint}}));
+            }
+            return addSequence(Node::Kind::kConcat, std::move(literals));
+        }
+
+        size_t begin = 0;
+        size_t end = pattern_.size();
+        if (begin < end && pattern_[begin] == '^') {
+            anchoredAtStart = true;
+            ++begin;
+        }
+        if (begin < end && pattern_[end - 1] == '$') {
+            size_t backslashes = 0;
+            while (end - 1 - backslashes > begin && pattern_[end - 2 - backslashes] == '\\') ++backslashes;
+            if (backslashes % 2 == 0) {
+                anchoredAtEnd = true;
+                --end;
+            }
+        }
+        if ((anchoredAtStart || anchoredAtEnd) && (flags_ & regex::kMultiline)) return -1;
+
+        position_ = begin;
+        end_ = end;
+        int32_t root = parseAlternation();
+        if (root < 0 || position_ != end_) return -1;
+        // `^a|b` anchors only the first alternative.
+        if ((anchoredAtStart || anchoredAtEnd) && topLevelAlternation_) return -1;
+        return root;
+    }
+
+    int32_t addSet(Ranges ranges) {
+        normalizeRanges(ranges);
+        sets.push_back(std::move(ranges));
+        Node node;
+        node.kind = Node::Kind::kSet;
+        node.set = static_cast<int32_t>(sets.size() - 1);
+        return addNode(std::move(node));
+    }
+
+    KStdVector<Node> nodes;
+    KStdVector<Ranges> sets;
+    bool anchoredAtStart = false;
+    bool anchoredAtEnd = false;
+
+private:
+    int32_t addNode(Node node) {
+        nodes.push_back(std::move(node));
+        return static_cast<int32_t>(nodes.size() - 1);
+    }
+
+    int32_t addSequence(Node::Kind kind, KStdVector<int32_t> children) {
+        if (children.size() == 1) return children[0];
+        Node node;
+        node.kind = children.empty() ? Node::Kind::kEmpty : kind;
+        node.children = std::move(children);
+        return addNode(std::move(node));
+    }
+
+    bool atEnd() const noexcept { return position_ == end_; }
+    KInt peek() const noexcept { return atEnd() ? -1 : pattern_[position_]; }
+
+    int32_t parseAlternation() {
+        if (++depth_ > kMaxNesting) return -1;
+        KStdVector<int32_t> alternatives;
+        while (true) {
+            int32_t alternative = parseConcat();
+            if (alternative < 0) return -1;
+            alternatives.push_back(alternative);
+            if (peek() != '|') break;
+            ++position_;
+        }
+        if (depth_ == 1) topLevelAlternation_ = alternatives.size() > 1;
+        --depth_;
+        return addSequence(Node::Kind::kAlternation, std::move(alternatives));
+    }
+
+    int32_t parseConcat() {
+        KStdVector<int32_t> items;
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            int32_t item = parseRepeat();
+            if (item < 0) return -1;
+            items.push_back(item);
+        }
+        return addSequence(Node::Kind::kConcat, std::move(items));
+    }
+
+    int32_t parseRepeat() {
+        int32_t atom = parseAtom();
+        if (atom < 0) return -1;
+        int32_t min;
+        int32_t max;
+        switch (peek()) {
+            case '*': min = 0; max = -1; ++position_; break;
+            case '+': min = 1; max = -1; ++position_; break;
+            case '?': min = 0; max = 1; ++position_; break;
+            case '{':
+                if (!parseBounds(&min, &max)) return -1;
+                break;
+            default:
+                return atom;
+        }
+        // Reluctant quantifiers accept the same strings as the greedy ones, possessive ones don't.
+        if (peek() == '?') {
+            ++position_;
+        } else if (peek() == '+') {
+            return -1;
+        }
+        if (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{') return -1;
+
+        Node node;
+        node.kind = Node::Kind::kRepeat;
+        node.children.push_back(atom);
+        node.min = min;
+        node.max = max;
+        return addNode(std::move(node));
+    }
+
+    bool parseNumber(int32_t* result) {
+        if (peek() < '0' || peek() > '9') return false;
+        int32_t number = 0;
+        while (peek() >= '0' && peek() <= '9') {
+            number = number * 10 + (pattern_[position_++] - '0');
+            if (number > kMaxRepeat) return false;
+        }
+        *result = number;
+        return true;
+    }
+
+    bool parseBounds(int32_t* min, int32_t* max) {
+        ++position_;
+        if (!parseNumber(min)) return false;
+        *max = *min;
+        if (peek() == ',') {
+            ++position_;
+            *max = -1;
+            if (peek() != '}' && !parseNumber(max)) return false;
+        }
+        if (peek() != '}') return false;
+        ++position_;
+        return *max < 0 || *min <= *max;
+    }
+
+    int32_t parseAtom() {
+        KInt c = pattern_[position_++];
+        switch (c) {
+            case '(': {
+                if (peek() == '?') {
+                    // Only non-capturing groups, no lookarounds, atomic groups or inline flags.
+                    if (position_ + 1 >= end_ || pattern_[position_ + 1] != ':') return -1;
+                    position_ += 2;
+                }
+                int32_t group = parseAlternation();
+                if (group < 0 || peek() != ')') return -1;
+                ++position_;
+                return group;
+            }
+            case '[': {
+                Ranges ranges;
+                if (!parseClass(ranges)) return -1;
+                return addSet(std::move(ranges));
+            }
+            case '.':
+                if (flags_ & regex::kDotAll) return addSet({{0, kMaxCodePoint}});
+                return addSet(negateRanges(lineTerminators()));
+            case '\\': {
+                Ranges ranges;
+                if (!parseEscape(ranges)) return -1;
+                return addSet(std::move(ranges));
+            }
+            case ')': case '^': case '$': case '*': case '+': case '?': case '{': case '}': case ']': case '|':
+                return -1;
+            default:
+                if (isSurrogate(c)) return -1;
+                return addSet({{c, c}});
+        }
+    }
+
+    Ranges lineTerminators() const {
+        Ranges result = {{'\n', '\n'}};
+        if ((flags_ & regex::kUnixLines) == 0) {
+            result.insert(result.end(), {{'\r', '\r'}, {0x0085, 0x0085}, {0x2028, 0x2029}});
+        }
+        normalizeRanges(result);
+        return result;
+    }
+
+    // Parses an escape sequence after the backslash. Appends the code points it stands for to `ranges`.
+    bool parseEscape(Ranges& ranges) {
+        if (atEnd()) return false;
+        KInt c = pattern_[position_++];
+        Ranges predefined;
+        switch (c) {
+            case 'd': case 'D':
+                predefined = {{'0', '9'}};
+                break;
+            case 'w': case 'W':
+                predefined = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+                break;
+            case 's': case 'S':
+                predefined = {{'\t', '\r'}, {' ', ' '}};
+                break;
+            case 't': ranges.emplace_back('\t', '\t'); return true;
+            case 'n': ranges.emplace_back('\n', '\n'); return true;
+            case 'r': ranges.emplace_back('\r', '\r'); return true;
+            case 'f': ranges.emplace_back(0x000C, 0x000C); return true;
+            case 'a': ranges.emplace_back(0x0007, 0x0007); return true;
+            case 'e': ranges.emplace_back(0x001B, 0x001B); return true;
+            case 'x': case 'u': {
+                int digits = c == 'x' ? 2 : 4;
+                KInt codePoint = 0;
+                for (int i = 0; i < digits; ++i) {
+                    int digit = hexDigit(peek());
+                    if (digit < 0) return false;
+                    codePoint = codePoint * 16 + digit;
+                    ++position_;
+                }
+                if (isSurrogate(codePoint)) return false;
+                ranges.emplace_back(codePoint, codePoint);
+                return true;
+            }
+            default:
+                // Escaped punctuation stands for itself. Escaped letters and digits have special meanings.
+                if (c < 0x80 && !(c >= '0' && c <= '9') && !(c >= 'a' && c <= 'z') && !(c >= 'A' && c <= 'Z')) {
+                    ranges.emplace_back(c, c);
+                    return true;
+                }
+                return false;
+        }
+        if (c >= 'A' && c <= 'Z') predefined = negateRanges(predefined);
+        ranges.insert(ranges.end(), predefined.begin(), predefined.end());
+        return true;
+    }
+
+    // Parses a code point or an escape sequence inside a character class.
+    bool parseClassItem(Ranges& ranges) {
+        KInt c = pattern_[position_++];
+        if (c == '[' || c == ']' || (c == '&' && peek() == '&') || isSurrogate(c)) return false;
+        if (c == '\\') return parseEscape(ranges);
+        ranges.emplace_back(c, c);
+        return true;
+    }
+
+    bool parseClass(Ranges& ranges) {
+        bool negated = peek() == '^';
+        if (negated) ++position_;
+        // Leading ']' and empty classes are treated differently by different engines.
+        if (peek() == ']') return false;
+        while (true) {
+            if (atEnd()) return false;
+            if (peek() == ']') {
+                ++position_;
+                break;
+            }
+            Ranges item;
+            if (!parseClassItem(item)) return false;
+            if (peek() == '-' && position_ + 1 < end_ && pattern_[position_ + 1] != ']') {
+                ++position_;
+                Ranges high;
+                if (atEnd() || !parseClassItem(high)) return false;
+                // A predefined class can't be a bound of a range.
+                if (item.size() != 1 || item[0].first != item[0].second || high.size() != 1 || high[0].first != high[0].second) return false;
+                if (high[0].first < item[0].first) return false;
+                item[0].second = high[0].first;
+            }
+            ranges.insert(ranges.end(), item.begin(), item.end());
+        }
+        normalizeRanges(ranges);
+        if (negated) ranges = negateRanges(ranges);
+        return true;
+    }
+
+    KInt flags_;
+    KStdVector<KInt> pattern_;
+    size_t position_ = 0;
+    size_t end_ = 0;
+    int depth_ = 0;
+    bool topLevelAlternation_ = false;
+};
+
+class Registry : private Pinned {
+public:
+    static Registry& instance() noexcept {
+        static Registry registry [[clang::no_destroy]];
+        return registry;
+    }
+
+    KInt add(const KChar* pattern, size_t length, KInt flags) noexcept {
+        Key key{KStdVector<KChar>(pattern, pattern + length), flags};
+        {
+            LockGuard<SimpleMutex> guard(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end()) return it->second;
+            // Not remembered, as the pattern may well be supported: the registry is just full.
+            if (size_ >= kMaxLazyDfas) return -1;
+        }
+
+        // Building the DFA takes a while, so it's done outside of the spinlock. The threads racing to register
+        // the same pattern build a DFA each, and all but the first one drop theirs.
+        auto* dfa = konanConstructInstance<regex::LazyDfa>(pattern, length, flags);
+        bool supported = dfa->supported();
+        KInt id = -1;
+        {
+            LockGuard<SimpleMutex> guard(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                id = it->second;
+            } else if (supported && size_ < kMaxLazyDfas) {
+                id = size_++;
+                dfas_[id].store(dfa, std::memory_order_release);
+                dfa = nullptr;
+                entries_.emplace(std::move(key), id);
+            } else if (!supported && entries_.size() < kMaxRegistryEntries) {
+                // Remember unsupported patterns too, so that they are not parsed again.
+                entries_.emplace(std::move(key), id);
+            }
+        }
+        if (dfa != nullptr) konanDestructInstance(dfa);
+        return id;
+    }
+
+    regex::LazyDfa& get(KInt id) noexcept {
+        RuntimeAssert(id >= 0 && id < kMaxLazyDfas, "Invalid LazyDfa id");
+        regex::LazyDfa* dfa = dfas_[id].load(std::memory_order_acquire);
+        RuntimeAssert(dfa != nullptr, "Invalid LazyDfa id");
+        return *dfa;
+    }
+
+private:
+    struct Key {
+        KStdVector<KChar> pattern;
+        KInt flags;
+
+        bool operator==(const Key& other) const noexcept { return flags == other.flags && pattern == other.pattern; }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            // FNV-1a.
+            size_t result = 2166136261u ^ static_cast<uint32_t>(key.flags);
+            for (KChar c : key.pattern) {
+                result = (result ^ c) * 16777619u;
+            }
+            return result;
+        }
+    };
+
+    // Patterns to the ids of their DFAs, or to -1 for the unsupported ones.
+    using Entries = std::unordered_map<Key, KInt, KeyHash, std::equal_to<Key>, KonanAllocator<std::pair<const Key, KInt>>>;
+
+    Registry() noexcept = default;
+
+    SimpleMutex mutex_;
+    Entries entries_;
+    KInt size_ = 0;
+    std::atomic<regex::LazyDfa*> dfas_[kMaxLazyDfas] = {};
+};
+
+} // namespace
+
+regex::LazyDfa::LazyDfa(const KChar* pattern, size_t length, KInt flags) noexcept {
+    if (length > kMaxPatternLength || (flags & (kCaseInsensitive | kComments | kCanonEq)) != 0) return;
+    unixLines_ = (flags & kUnixLines) != 0;
+
+    Parser parser(pattern, length, flags);
+    int32_t root = parser.parse();
+    if (root < 0) return;
+    anchoredAtStart_ = parser.anchoredAtStart;
+    anchoredAtEnd_ = parser.anchoredAtEnd;
+    int32_t anySet = parser.nodes[parser.addSet({{0, kMaxCodePoint}})].set;
+
+    // The alphabet classes are the intervals between the bounds of all the ranges.
+    alphabet_.push_back(0);
+    for (const Ranges& ranges : parser.sets) {
+        for (const auto& range : ranges) {
+            alphabet_.push_back(range.first);
+            if (range.second < kMaxCodePoint) alphabet_.push_back(range.second + 1);
+        }
+    }
+    std::sort(alphabet_.begin(), alphabet_.end());
+    alphabet_.erase(std::unique(alphabet_.begin(), alphabet_.end()), alphabet_.end());
+    if (alphabet_.size() > kMaxAlphabetSize) return;
+    alphabetSize_ = static_cast<int32_t>(alphabet_.size());
+    for (KInt c = 0; c < 256; ++c) {
+        latin1Classes_[c] = static_cast<uint16_t>(std::upper_bound(alphabet_.begin(), alphabet_.end(), c) - alphabet_.begin() - 1);
+    }
+    setWords_ = (alphabet_.size() + 63) / 64;
+    sets_.resize(parser.sets.size() * setWords_);
+    for (size_t set = 0; set < parser.sets.size(); ++set) {
+        for (const auto& range : parser.sets[set]) {
+            for (int32_t c = alphabetClass(range.first); c <= alphabetClass(range.second); ++c) {
+                sets_[set * setWords_ + c / 64] |= uint64_t(1) << (c % 64);
+            }
+        }
+    }
+
+    // Thompson construction, back to front: each node is compiled knowing where to continue after it.
+    instructions_.push_back(Instruction{Instruction::Op::kMatch, -1, -1, -1});
+    auto emit = [this](int32_t set, int32_t next, Instruction::Op op, int32_t alternative) {
+        instructions_.push_back(Instruction{op, set, next, alternative});
+        return static_cast<int32_t>(instructions_.size() - 1);
+    };
+    std::function<int32_t(int32_t, int32_t)> compile = [&](int32_t nodeIndex, int32_t next) -> int32_t {
+        if (instructions_.size() > kMaxInstructions) return next;
+        const Node& node = parser.nodes[nodeIndex];
+        switch (node.kind) {
+            case Node::Kind::kEmpty:
+                return next;
+            case Node::Kind::kSet:
+                return emit(node.set, next, Instruction::Op::kConsume, -1);
+            case Node::Kind::kConcat:
+                for (auto child = node.children.rbegin(); child != node.children.rend(); ++child) {
+                    next = compile(*child, next);
+                }
+                return next;
+            case Node::Kind::kAlternation: {
+                int32_t start = compile(node.children.back(), next);
+                for (size_t i = node.children.size() - 1; i > 0; --i) {
+                    start = emit(-1, compile(node.children[i - 1], next), Instruction::Op::kSplit, start);
+                }
+                return start;
+            }
+            case Node::Kind::kRepeat: {
+                int32_t child = node.children[0];
+                int32_t tail = next;
+                if (node.max < 0) {
+                    int32_t loop = emit(-1, -1, Instruction::Op::kSplit, next);
+                    int32_t body = compile(child, loop);
+                    instructions_[loop].next = body;
+                    tail = loop;
+                } else {
+                    for (int32_t i = node.min; i < node.max; ++i) {
+                        tail = emit(-1, compile(child, tail), Instruction::Op::kSplit, next);
+                    }
+                }
+                for (int32_t i = 0; i < node.min; ++i) {
+                    tail = compile(child, tail);
+                }
+                return tail;
+            }
+        }
+        return next;
+    };
+    anchoredStart_ = compile(root, 0);
+    // An implicit `(?s:.)*?` in front of the pattern for searching.
+    unanchoredStart_ = emit(-1, anchoredStart_, Instruction::Op::kSplit, -1);
+    int32_t any = emit(anySet, unanchoredStart_, Instruction::Op::kConsume, -1);
+    instructions_[unanchoredStart_].alternative = any;
+    if (instructions_.size() > kMaxInstructions) return;
+
+    // The literal every match starts with.
+    const Node& rootNode = parser.nodes[root];
+    KStdVector<int32_t> leading;
+    if (rootNode.kind == Node::Kind::kSet) {
+        leading.push_back(root);
+    } else if (rootNode.kind == Node::Kind::kConcat) {
+        leading = rootNode.children;
+    }
+    for (int32_t nodeIndex : leading) {
+        const Node& node = parser.nodes[nodeIndex];
+        if (node.kind != Node::Kind::kSet) break;
+        const Ranges& ranges = parser.sets[node.set];
+        if (ranges.size() != 1 || ranges[0].first != ranges[0].second) break;
+        KInt codePoint = ranges[0].first;
+        if (codePoint < 0x10000) {
+            prefix_.push_back(static_cast<KChar>(codePoint));
+        } else {
+            prefix_.push_back(static_cast<KChar>(0xD800 + ((codePoint - 0x10000) >> 10)));
+            prefix_.push_back(static_cast<KChar>(0xDC00 + ((codePoint - 0x10000) & 0x3FF)));
+        }
+    }
+
+    supported_ = true;
+}
+
+regex::MatchStatus regex::LazyDfa::Matches(const KChar* begin, const KChar* end) noexcept {
+    RuntimeAssert(supported_, "Unsupported pattern");
+    if (cacheMutex_.try_lock()) {
+        MatchStatus result = match(cache_, begin, end, Mode::kEntire);
+        cacheMutex_.unlock();
+        return result;
+    }
+    // Another thread is using the shared cache. Don't wait for it.
+    Cache cache;
+    return match(cache, begin, end, Mode::kEntire);
+}
+
+regex::MatchStatus regex::LazyDfa::ContainsMatchIn(const KChar* begin, const KChar* end) noexcept {
+    RuntimeAssert(supported_, "Unsupported pattern");
+    if (cacheMutex_.try_lock()) {
+        MatchStatus result = match(cache_, begin, end, Mode::kContains);
+        cacheMutex_.unlock();
+        return result;
+    }
+    Cache cache;
+    return match(cache, begin, end, Mode::kContains);
+}
+
+size_t regex::LazyDfa::StateSetHash::operator()(const KStdVector<int32_t>& set) const noexcept {
+    size_t hash = set.size();
+    for (int32_t state : set) {
+        hash = hash * 31 + static_cast<size_t>(state);
+    }
+    return hash;
+}
+
+void regex::LazyDfa::Cache::clear() noexcept {
+    transitions.clear();
+    stateFlags.clear();
+    states.clear();
+    ids.clear();
+    anchoredStart = -1;
+    unanchoredStart = -1;
+    memoryUsage = 0;
+}
+
+int32_t regex::LazyDfa::alphabetClass(KInt codePoint) const noexcept {
+    if (codePoint < 256) return latin1Classes_[codePoint];
+    return static_cast<int32_t>(std::upper_bound(alphabet_.begin(), alphabet_.end(), codePoint) - alphabet_.begin() - 1);
+}
+
+bool regex::LazyDfa::contains(int32_t set, int32_t alphabetClass) const noexcept {
+    return (sets_[set * setWords_ + alphabetClass / 64] >> (alphabetClass % 64)) & 1;
+}
+
+void regex::LazyDfa::addClosure(Cache& cache, int32_t instruction) const noexcept {
+    cache.stack.push_back(instruction);
+    while (!cache.stack.empty()) {
+        int32_t current = cache.stack.back();
+        cache.stack.pop_back();
+        if (cache.visited[current] == cache.visitedGeneration) continue;
+        cache.visited[current] = cache.visitedGeneration;
+        const Instruction& code = instructions_[current];
+        if (code.op == Instruction::Op::kSplit) {
+            cache.stack.push_back(code.alternative);
+            cache.stack.push_back(code.next);
+        } else {
+            cache.nextStates.push_back(current);
+        }
+    }
+}
+
+// Returns the id of the DFA state for `cache.nextStates`, or kUnknownState if the cache is out of budget.
+int32_t regex::LazyDfa::internState(Cache& cache) const noexcept {
+    std::sort(cache.nextStates.begin(), cache.nextStates.end());
+    auto it = cache.ids.find(cache.nextStates);
+    if (it != cache.ids.end()) return it->second;
+
+    size_t memoryUsage = kStateOverhead + (alphabetSize_ + cache.nextStates.size()) * sizeof(int32_t);
+    if (cache.memoryUsage + memoryUsage > kCacheBudget) return kUnknownState;
+    cache.memoryUsage += memoryUsage;
+
+    int32_t id = static_cast<int32_t>(cache.states.size());
+    it = cache.ids.emplace(cache.nextStates, id).first;
+    cache.states.push_back(&it->first);
+    uint8_t flags = cache.nextStates.empty() ? kDeadState : 0;
+    for (int32_t state : cache.nextStates) {
+        if (instructions_[state].op == Instruction::Op::kMatch) flags |= kAcceptingState;
+    }
+    cache.stateFlags.push_back(flags);
+    cache.transitions.resize(cache.transitions.size() + alphabetSize_, kUnknownState);
+    return id;
+}
+
+int32_t regex::LazyDfa::startState(Cache& cache, bool anchored) const noexcept {
+    int32_t& start = anchored ? cache.anchoredStart : cache.unanchoredStart;
+    if (start != kUnknownState) return start;
+    if (cache.visited.size() < instructions_.size()) cache.visited.resize(instructions_.size());
+    cache.nextStates.clear();
+    ++cache.visitedGeneration;
+    addClosure(cache, anchored ? anchoredStart_ : unanchoredStart_);
+    start = internState(cache);
+    return start;
+}
+
+int32_t regex::LazyDfa::computeTransition(Cache& cache, int32_t state, int32_t alphabetClass) const noexcept {
+    cache.nextStates.clear();
+    if (++cache.visitedGeneration == 0) {
+        std::fill(cache.visited.begin(), cache.visited.end(), 0);
+        cache.visitedGeneration = 1;
+    }
+    for (int32_t current : *cache.states[state]) {
+        const Instruction& code = instructions_[current];
+        if (code.op == Instruction::Op::kConsume && contains(code.set, alphabetClass)) {
+            addClosure(cache, code.next);
+        }
+    }
+    int32_t next = internState(cache);
+    if (next != kUnknownState) {
+        cache.transitions[static_cast<size_t>(state) * alphabetSize_ + alphabetClass] = next;
+    }
+    return next;
+}
+
+regex::MatchStatus regex::LazyDfa::match(Cache& cache, const KChar* begin, const KChar* end, Mode mode) noexcept {
+    bool anchored = mode == Mode::kEntire || anchoredAtStart_;
+    bool acceptAnywhere = mode == Mode::kContains && !anchoredAtEnd_;
+    // `$` matches at the end of the input and right before the final line terminator.
+    const KChar* endOfLine[3] = {end, end, end};
+    if (mode == Mode::kContains && anchoredAtEnd_) {
+        if (end - begin >= 1 && isLineTerminator(end[-1], unixLines_)) endOfLine[1] = end - 1;
+        if (end - begin >= 2 && !unixLines_ && end[-2] == '\r' && end[-1] == '\n') endOfLine[2] = end - 2;
+    }
+    bool usePrefix = !anchored && !prefix_.empty();
+
+    int32_t start = startState(cache, anchored);
+    if (start == kUnknownState) {
+        cache.clear();
+        start = startState(cache, anchored);
+    }
+    int32_t state = start;
+    const KChar* lastReset = nullptr;
+    const KChar* it = begin;
+    while (true) {
+        uint8_t flags = cache.stateFlags[state];
+        if (flags & kAcceptingState) {
+            if (acceptAnywhere) return MatchStatus::kMatch;
+            if (mode == Mode::kContains && (it == endOfLine[0] || it == endOfLine[1] || it == endOfLine[2])) return MatchStatus::kMatch;
+        }
+        if (it == end || (flags & kDeadState)) break;
+        if (usePrefix && state == start) {
+            // Nothing is matched at the moment, so skip right to the next possible start of a match.
+            it = findLiteral(it, end, prefix_);
+            if (it == nullptr) return MatchStatus::kNoMatch;
+        }
+
+        int32_t alphabetClass = this->alphabetClass(readCodePoint(it, end));
+        int32_t next = cache.transitions[static_cast<size_t>(state) * alphabetSize_ + alphabetClass];
+        if (next == kUnknownState) {
+            next = computeTransition(cache, state, alphabetClass);
+            if (next == kUnknownState) {
+                // The cache is full: flush it and continue with the state just computed.
+                if (lastReset != nullptr && static_cast<size_t>(it - lastReset) < kMinCodePointsPerState * cache.states.size()) {
+                    return MatchStatus::kGaveUp;
+                }
+                lastReset = it;
+                cache.clear();
+                next = internState(cache);
+                start = startState(cache, anchored);
+            }
+        }
+        state = next;
+    }
+    if (mode == Mode::kEntire && it == end && (cache.stateFlags[state] & kAcceptingState)) return MatchStatus::kMatch;
+    return MatchStatus::kNoMatch;
+}
+
+KInt regex::RegisterLazyDfa(const KChar* pattern, size_t length, KInt flags) noexcept {
+    return Registry::instance().add(pattern, length, flags);
+}
+
+regex::LazyDfa& regex::GetLazyDfa(KInt id) noexcept {
+    return Registry::instance().get(id);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#ifndef RUNTIME_REGEX_LAZY_DFA_H
+#define RUNTIME_REGEX_LAZY_DFA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "../Mutex.hpp"
+#include "../Types.h"
+#include "../Utils.hpp"
+
+namespace kotlin {
+namespace regex {
+
+// Values must be kept in sync with kotlin.text.regex.Pattern.
+constexpr KInt kUnixLines = 1 << 0;
+constexpr KInt kCaseInsensitive = 1 << 1;
+constexpr KInt kComments = 1 << 2;
+constexpr KInt kMultiline = 1 << 3;
+constexpr KInt kLiteral = 1 << 4;
+constexpr KInt kDotAll = 1 << 5;
+constexpr KInt kCanonEq = 1 << 6;
+
+enum class MatchStatus {
+    kNoMatch,
+    kMatch,
+    // The state cache thrashes on this input. The caller should use the backtracking engine instead.
+    kGaveUp,
+};
+
+// Matcher for the regular subset of the pattern syntax: literals, `.`, character classes with ranges and
+// negation, `\d \w \s` and their negations, groups, alternation, greedy and reluctant quantifiers, `^` at
+// the very beginning and `$` at the very end of the pattern. Backreferences, lookarounds, possessive
+// quantifiers, inline flags and other features make the pattern unsupported, as do the CASE_INSENSITIVE,
+// COMMENTS and CANON_EQ flags.
+//
+// The pattern is compiled into a Thompson NFA over code points. A DFA is built from it lazily while matching:
+// each DFA state is a set of NFA states, and a transition is computed the first time it is taken. Code points
+// are mapped to a small alphabet of classes which no character set of the pattern can tell apart, so the
+// transition table stays small. The states are cached between calls up to a memory budget. When the budget
+// is exhausted the cache is flushed, and if that happens too often the match gives up.
+//
+// Only answers whether the pattern matches the entire input or some part of it. Match boundaries and groups
+// are left to the backtracking engine, since the leftmost-first semantics of the latter can't be reproduced
+// by a DFA directly.
+class LazyDfa : private Pinned {
+public:
+    LazyDfa(const KChar* pattern, size_t length, KInt flags) noexcept;
+
+    // Whether the pattern and the flags can be handled by this engine. Nothing else can be called otherwise.
+    bool supported() const noexcept { return supported_; }
+
+    MatchStatus Matches(const KChar* begin, const KChar* end) noexcept;
+    MatchStatus ContainsMatchIn(const KChar* begin, const KChar* end) noexcept;
+
+private:
+    struct Instruction {
+        enum class Op : uint8_t {
+            kConsume, // Consume a code point from `set` and go to `next`.
+            kSplit, // Go to both `next` and `alternative`.
+            kMatch,
+        };
+
+        Op op;
+        int32_t set;
+        int32_t next;
+        int32_t alternative;
+    };
+
+    struct StateSetHash {
+        size_t operator()(const KStdVector<int32_t>& set) const noexcept;
+    };
+
+    using StateIds = std::unordered_map<
+            KStdVector<int32_t>,
+            int32_t,
+            StateSetHash,
+            std::equal_to<KStdVector<int32_t>>,
+            KonanAllocator<std::pair<const KStdVector<int32_t>, int32_t>>>;
+
+    struct Cache : private Pinned {
+        // `alphabetSize_` entries per state, kUnknownState for the transitions not computed yet.
+        KStdVector<int32_t> transitions;
+        // kAcceptingState and kDeadState bits per state.
+        KStdVector<uint8_t> stateFlags;
+        // NFA states of each DFA state, point to the keys of `ids`.
+        KStdVector<const KStdVector<int32_t>*> states;
+        StateIds ids;
+        int32_t anchoredStart = -1;
+        int32_t unanchoredStart = -1;
+        size_t memoryUsage = 0;
+
+        // Scratch space for computing the epsilon closures.
+        KStdVector<uint32_t> visited;
+        uint32_t visitedGeneration = 0;
+        KStdVector<int32_t> stack;
+        KStdVector<int32_t> nextStates;
+
+        void clear() noexcept;
+    };
+
+    enum class Mode {
+        kEntire,
+        kContains,
+    };
+
+    MatchStatus match(Cache& cache, const KChar* begin, const KChar* end, Mode mode) noexcept;
+    int32_t alphabetClass(KInt codePoint) const noexcept;
+    bool contains(int32_t set, int32_t alphabetClass) const noexcept;
+    void addClosure(Cache& cache, int32_t instruction) const noexcept;
+    int32_t internState(Cache& cache) const noexcept;
+    int32_t startState(Cache& cache, bool anchored) const noexcept;
+    int32_t computeTransition(Cache& cache, int32_t state, int32_t alphabetClass) const noexcept;
+
+    bool supported_ = false;
+    bool anchoredAtStart_ = false;
+    bool anchoredAtEnd_ = false;
+    bool unixLines_ = false;
+    KStdVector<Instruction> instructions_;
+    int32_t anchoredStart_ = -1;
+    int32_t unanchoredStart_ = -1;
+    // Lower bounds of the alphabet classes, sorted.
+    KStdVector<KInt> alphabet_;
+    int32_t alphabetSize_ = 0;
+    uint16_t latin1Classes_[256];
+    // A bitmap over the alphabet classes for each character set of the pattern.
+    KStdVector<uint64_t> sets_;
+    size_t setWords_ = 0;
+    // Every match starts with this literal. Used to skip the input quickly.
+    KStdVector<KChar> prefix_;
+
+    SimpleMutex cacheMutex_;
+    Cache cache_;
+};
+
+// Compiles the pattern into a LazyDfa shared by all the Regex instances with the same pattern and flags.
+// Compiled DFAs are never freed, so their number is limited to 256. Returns -1 if the pattern is not supported or
+// the limit is reached: then the pattern is left to the backtracking engine.
+KInt RegisterLazyDfa(const KChar* pattern, size_t length, KInt flags) noexcept;
+
+// Returns the LazyDfa registered with the given id.
+LazyDfa& GetLazyDfa(KInt id) noexcept;
+
+} // namespace regex
+} // namespace kotlin
+
+#endif // RUNTIME_REGEX_LAZY_DFA_H
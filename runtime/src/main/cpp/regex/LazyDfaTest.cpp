@@ -0,0 +1,192 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+#include "LazyDfa.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace kotlin;
+
+namespace {
+
+std::u16string utf16(const char* ascii) {
+    return std::u16string(ascii, ascii + std::char_traits<char>::length(ascii));
+}
+
+class Dfa {
+public:
+    explicit Dfa(const std::u16string& pattern, KInt flags = 0) :
+        dfa_(reinterpret_cast<const KChar*>(pattern.data()), pattern.size(), flags) {}
+    explicit Dfa(const char* pattern, KInt flags = 0) : Dfa(utf16(pattern), flags) {}
+
+    bool supported() const { return dfa_.supported(); }
+
+    regex::MatchStatus matches(const std::u16string& input) {
+        auto* begin = reinterpret_cast<const KChar*>(input.data());
+        return dfa_.Matches(begin, begin + input.size());
+    }
+
+    regex::MatchStatus contains(const std::u16string& input) {
+        auto* begin = reinterpret_cast<const KChar*>(input.data());
+        return dfa_.ContainsMatchIn(begin, begin + input.size());
+    }
+
+    bool matches(const char* input) { return matches(utf16(input)) == regex::MatchStatus::kMatch; }
+    bool contains(const char* input) { return contains(utf16(input)) == regex::MatchStatus::kMatch; }
+
+private:
+    regex::LazyDfa dfa_;
+};
+
+} // namespace
+
+TEST(LazyDfaTest, Unsupported) {
+    const char* patterns[] = {"(a)\\1", "a(?=b)", "a(?!b)", "(?<=a)b", "(?>a)", "a++", "a*+", "(?i)a", "\\ba", "\\p{L}",
+                              "\\Qa\\E", "a|^b", "a|b$", "[a&&b]", "[[a]b]", "\\0101", "\\cA", "\\k", "a{1001}", "]", "}"};
+    for (const char* pattern : patterns) {
+        EXPECT_FALSE(Dfa(pattern).supported()) << pattern;
+    }
+    EXPECT_FALSE(Dfa("a", regex::kCaseInsensitive).supported());
+    EXPECT_FALSE(Dfa("a", regex::kComments).supported());
+    EXPECT_FALSE(Dfa("a", regex::kCanonEq).supported());
+    EXPECT_FALSE(Dfa("^a", regex::kMultiline).supported());
+    EXPECT_TRUE(Dfa("a", regex::kMultiline).supported());
+}
+
+TEST(LazyDfaTest, Matches) {
+    Dfa dfa("(?:GET|POST) /api/v[0-9]+/\\w+(/.*)?");
+    ASSERT_TRUE(dfa.supported());
+    EXPECT_TRUE(dfa.matches("GET /api/v1/users"));
+    EXPECT_TRUE(dfa.matches("POST /api/v12/users/42?x=1"));
+    EXPECT_FALSE(dfa.matches("PUT /api/v1/users"));
+    EXPECT_FALSE(dfa.matches("GET /api/v/users"));
+    EXPECT_FALSE(dfa.matches("GET /api/v1/users\n"));
+    EXPECT_FALSE(dfa.matches(""));
+
+    Dfa bounded("a{2,3}b?");
+    EXPECT_FALSE(bounded.matches("a"));
+    EXPECT_TRUE(bounded.matches("aa"));
+    EXPECT_TRUE(bounded.matches("aaab"));
+    EXPECT_FALSE(bounded.matches("aaaa"));
+
+    Dfa empty("");
+    EXPECT_TRUE(empty.matches(""));
+    EXPECT_FALSE(empty.matches("a"));
+    EXPECT_TRUE(empty.contains("a"));
+}
+
+TEST(LazyDfaTest, ContainsMatchIn) {
+    Dfa dfa("error [0-9]{3}");
+    EXPECT_TRUE(dfa.contains("2020-01-01 error 503 upstream"));
+    EXPECT_FALSE(dfa.contains("2020-01-01 error 50 upstream"));
+    EXPECT_FALSE(dfa.contains(""));
+
+    // Long input with many partial occurrences of the prefix.
+    std::u16string input;
+    for (int i = 0; i < 10000; ++i) input += u"error x ";
+    EXPECT_EQ(regex::MatchStatus::kNoMatch, dfa.contains(input));
+    input += u"error 404";
+    EXPECT_EQ(regex::MatchStatus::kMatch, dfa.contains(input));
+}
+
+TEST(LazyDfaTest, Anchors) {
+    Dfa dfa("^ab$");
+    EXPECT_TRUE(dfa.contains("ab"));
+    EXPECT_TRUE(dfa.contains("ab\n"));
+    EXPECT_TRUE(dfa.contains("ab\r\n"));
+    EXPECT_EQ(regex::MatchStatus::kMatch, dfa.contains(utf16("ab") + u"\u2028"));
+    EXPECT_FALSE(dfa.contains("ab\n\n"));
+    EXPECT_FALSE(dfa.contains("xab"));
+    EXPECT_TRUE(dfa.matches("ab"));
+    EXPECT_FALSE(dfa.matches("ab\n"));
+
+    Dfa unixLines("ab$", regex::kUnixLines);
+    EXPECT_TRUE(unixLines.contains("xab\n"));
+    EXPECT_FALSE(unixLines.contains("xab\r\n"));
+
+    Dfa escaped("a\\$");
+    EXPECT_TRUE(escaped.contains("xa$x"));
+}
+
+TEST(LazyDfaTest, CharacterClasses) {
+    Dfa dfa("[^\\d\\s]+-[a-c-]\\.");
+    EXPECT_TRUE(dfa.matches("xy-b."));
+    EXPECT_TRUE(dfa.matches("xy--."));
+    EXPECT_FALSE(dfa.matches("x1-b."));
+    EXPECT_FALSE(dfa.matches("xy-d."));
+    EXPECT_FALSE(dfa.matches("xy-bx"));
+
+    Dfa dot("a.b");
+    EXPECT_FALSE(dot.matches("a\nb"));
+    EXPECT_FALSE(dot.matches("a\rb"));
+    EXPECT_TRUE(Dfa("a.b", regex::kUnixLines).matches("a\rb"));
+    EXPECT_TRUE(Dfa("a.b", regex::kDotAll).matches("a\nb"));
+
+    EXPECT_TRUE(Dfa("a.b", regex::kLiteral).matches("a.b"));
+    EXPECT_FALSE(Dfa("a.b", regex::kLiteral).matches("axb"));
+}
+
+TEST(LazyDfaTest, SupplementaryCodePoints) {
+    std::u16string emoji = u"\U0001F600";
+    EXPECT_EQ(regex::MatchStatus::kMatch, Dfa(".").matches(emoji));
+    EXPECT_EQ(regex::MatchStatus::kMatch, Dfa("[^a]").matches(emoji));
+    EXPECT_EQ(regex::MatchStatus::kNoMatch, Dfa("..").matches(emoji));
+    EXPECT_EQ(regex::MatchStatus::kMatch, Dfa(u"x\U0001F600+").contains(u"yx" + emoji + emoji));
+    // Unpaired surrogates are matched as single characters.
+    EXPECT_EQ(regex::MatchStatus::kMatch, Dfa("a.").matches(u"a\xD800"));
+}
+
+TEST(LazyDfaTest, CacheFlush) {
+    // The n-th symbol from the end: the minimal DFA has 2^n states.
+    Dfa dfa("(?:a|b)*a(?:a|b){14}");
+    std::u16string input;
+    uint32_t random = 1;
+    for (int i = 0; i < 200000; ++i) {
+        random = random * 1103515245 + 12345;
+        input += (random >> 16) & 1 ? u'a' : u'b';
+    }
+    input[input.size() - 15] = u'a';
+    EXPECT_NE(regex::MatchStatus::kNoMatch, dfa.matches(input));
+    input[input.size() - 15] = u'b';
+    EXPECT_NE(regex::MatchStatus::kMatch, dfa.matches(input));
+}
+
+TEST(LazyDfaTest, Registry) {
+    std::u16string pattern = u"a+b";
+    auto* data = reinterpret_cast<const KChar*>(pattern.data());
+    KInt id = regex::RegisterLazyDfa(data, pattern.size(), 0);
+    ASSERT_GE(id, 0);
+    EXPECT_EQ(id, regex::RegisterLazyDfa(data, pattern.size(), 0));
+    EXPECT_NE(id, regex::RegisterLazyDfa(data, pattern.size(), regex::kDotAll));
+
+    std::u16string unsupported = u"(a)\\1";
+    EXPECT_EQ(-1, regex::RegisterLazyDfa(reinterpret_cast<const KChar*>(unsupported.data()), unsupported.size(), 0));
+
+    std::u16string input = u"xaab";
+    auto* begin = reinterpret_cast<const KChar*>(input.data());
+    EXPECT_EQ(regex::MatchStatus::kMatch, regex::GetLazyDfa(id).ContainsMatchIn(begin, begin + input.size()));
+}
+
+TEST(LazyDfaTest, RegistryRace) {
+    std::u16string pattern = u"(ab|cd)*e";
+    auto* data = reinterpret_cast<const KChar*>(pattern.data());
+    std::vector<KInt> ids(8, -1);
+    std::vector<std::thread> threads;
+    for (auto& id : ids) {
+        threads.emplace_back([&id, data, &pattern] { id = regex::RegisterLazyDfa(data, pattern.size(), 0); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_GE(ids[0], 0);
+    for (KInt id : ids) {
+        EXPECT_EQ(ids[0], id);
+    }
+    EXPECT_EQ(ids[0], regex::RegisterLazyDfa(data, pattern.size(), 0));
+}
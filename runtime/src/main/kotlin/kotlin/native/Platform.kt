@@ -41,6 +41,33 @@ public enum class MemoryModel {
     RELAXED
 }
 
+/**
+ * Buffering of the standard output stream.
+ */
+@ExperimentalStdlibApi
+public enum class ConsoleBuffering {
+    /**
+     * [FULL] if the standard output is redirected to a file, [LINE] otherwise, e.g. for a terminal or a pipe.
+     */
+    AUTO,
+
+    /**
+     * Each write goes to the standard output immediately.
+     */
+    NONE,
+
+    /**
+     * Output is written when a line feed is printed or the buffer is full.
+     */
+    LINE,
+
+    /**
+     * Output is written when the buffer is full, on [Platform.flushConsole], before reading from the standard input
+     * or printing to the standard error, and at the program exit.
+     */
+    FULL
+}
+
 /**
  * Object describing the current platform program executes upon.
  */
@@ -96,6 +123,21 @@ public object Platform {
     public var isCleanersLeakCheckerActive: Boolean
         get() = Platform_getCleanersLeakChecker()
         set(value) = Platform_setCleanersLeakChecker(value)
+
+    /**
+     * Buffering of the standard output stream, [ConsoleBuffering.AUTO] by default.
+     * Changing it writes out the buffered output.
+     */
+    @ExperimentalStdlibApi
+    public var consoleBuffering: ConsoleBuffering
+        get() = ConsoleBuffering.values()[Platform_getConsoleBuffering()]
+        set(value) = Platform_setConsoleBuffering(value.ordinal)
+
+    /**
+     * Writes out the buffered standard output.
+     */
+    @ExperimentalStdlibApi
+    public fun flushConsole(): Unit = Platform_flushConsole()
 }
 
 @SymbolName("Konan_Platform_canAccessUnaligned")
@@ -127,3 +169,12 @@ private external fun Platform_getCleanersLeakChecker(): Boolean
 
 @SymbolName("Konan_Platform_setCleanersLeakChecker")
 private external fun Platform_setCleanersLeakChecker(value: Boolean): Unit
+
+@SymbolName("Konan_Platform_getConsoleBuffering")
+private external fun Platform_getConsoleBuffering(): Int
+
+@SymbolName("Konan_Platform_setConsoleBuffering")
+private external fun Platform_setConsoleBuffering(value: Int): Unit
+
+@SymbolName("Konan_Platform_flushConsole")
+private external fun Platform_flushConsole(): Unit
@@ -49,6 +49,18 @@ external internal fun executeInternal(
 @SymbolName("Kotlin_Worker_executeAfterInternal")
 external internal fun executeAfterInternal(id: Int, operation: () -> Unit, afterMicroseconds: Long): Unit
 
+@SymbolName("Kotlin_Worker_executeAfterCancellableInternal")
+external internal fun executeAfterCancellableInternal(id: Int, operation: () -> Unit, afterMicroseconds: Long): Long
+
+@SymbolName("Kotlin_Worker_cancelDelayedInternal")
+external internal fun cancelDelayedInternal(id: Int, handle: Long): Boolean
+
+@SymbolName("Kotlin_Worker_addFdListenerInternal")
+external internal fun addFdListenerInternal(id: Int, fd: Int, events: Int, callback: (Int) -> Unit): Boolean
+
+@SymbolName("Kotlin_Worker_removeFdListenerInternal")
+external internal fun removeFdListenerInternal(id: Int, fd: Int): Boolean
+
 @SymbolName("Kotlin_Worker_processQueueInternal")
 external internal fun processQueueInternal(id: Int): Boolean
 
@@ -69,6 +81,9 @@ internal fun ThrowWorkerInvalidState(): Unit =
 @ExportForCppRuntime
 internal fun WorkerLaunchpad(function: () -> Any?) = function()
 
+@ExportForCppRuntime
+internal fun WorkerFdCallbackLaunchpad(callback: (Int) -> Unit, events: Int) = callback(events)
+
 @PublishedApi
 @SymbolName("Kotlin_Worker_detachObjectGraphInternal")
 external internal fun detachObjectGraphInternal(mode: Int, producer: () -> Any?): NativePtr
@@ -5,6 +5,8 @@
 
 package kotlin.native.concurrent
 
+import kotlin.native.OsFamily
+import kotlin.native.Platform
 import kotlin.native.internal.ExportForCppRuntime
 import kotlin.native.internal.Frozen
 import kotlin.native.internal.VolatileLambda
@@ -59,6 +61,15 @@ public inline class Worker @PublishedApi internal constructor(val id: Int) {
         @Deprecated("Use kotlinx.cinterop.StableRef instead", level = DeprecationLevel.WARNING)
         public fun fromCPointer(pointer: COpaquePointer?): Worker =
                 if (pointer != null) Worker(pointer.toLong().toInt()) else throw IllegalArgumentException()
+
+        /** Events of [addFdListener]: the descriptor can be read without blocking. */
+        public const val FD_READABLE: Int = 1
+        /** Events of [addFdListener]: the descriptor can be written without blocking. */
+        public const val FD_WRITABLE: Int = 2
+        /** Events of [addFdListener]: an error happened on the descriptor. Reported even if not asked for. */
+        public const val FD_ERROR: Int = 4
+        /** Events of [addFdListener]: the peer closed the connection. Reported even if not asked for. */
+        public const val FD_HANGUP: Int = 8
     }
 
     /**
@@ -111,6 +122,57 @@ public inline class Worker @PublishedApi internal constructor(val id: Int) {
         executeAfterInternal(id, operation, afterMicroseconds)
     }
 
+    /**
+     * Same as [executeAfter], but the job can be cancelled with [cancelDelayed] until it is due.
+     *
+     * @return the handle of the job for [cancelDelayed] of this worker.
+     * @throws [IllegalArgumentException] on negative values of [afterMicroseconds].
+     * @throws [IllegalStateException] if [operation] parameter is not frozen and worker is not current.
+     */
+    public fun executeAfterCancellable(afterMicroseconds: Long = 0, operation: () -> Unit): Long {
+        val current = currentInternal()
+        if (current != id && !operation.isFrozen) throw IllegalStateException("Job for another worker must be frozen")
+        if (afterMicroseconds < 0) throw IllegalArgumentException("Timeout parameter must be non-negative")
+        return executeAfterCancellableInternal(id, operation, afterMicroseconds)
+    }
+
+    /**
+     * Cancels the job planned with [executeAfterCancellable] on this worker, if it is not due yet.
+     *
+     * @param handle the value returned by [executeAfterCancellable] of this worker.
+     * @return `true` if the job was cancelled, `false` if it has already been queued for execution, executed or
+     * cancelled, or if the worker is terminated.
+     */
+    public fun cancelDelayed(handle: Long): Boolean = cancelDelayedInternal(id, handle)
+
+    /**
+     * Calls [callback] as a job of this worker whenever the file descriptor [fd] gets ready for [events],
+     * a combination of [FD_READABLE] and [FD_WRITABLE]. [callback] receives the events that are ready.
+     * The worker waits for its descriptors and its jobs together, so one worker can serve both I/O and computations.
+     * The descriptor is watched again once [callback] returns, so [callback] shall consume what is ready,
+     * or it is called again right away. [callback] must be either frozen, or registered on the current worker.
+     * Only supported on Linux and Android.
+     *
+     * @throws [IllegalStateException] if [fd] is already watched by this worker or cannot be watched,
+     * or if [callback] is not frozen and worker is not current.
+     * @throws [UnsupportedOperationException] on other platforms.
+     */
+    public fun addFdListener(fd: Int, events: Int, callback: (events: Int) -> Unit): Unit {
+        if (Platform.osFamily != OsFamily.LINUX && Platform.osFamily != OsFamily.ANDROID)
+            throw UnsupportedOperationException("File descriptor listeners are only supported on Linux and Android")
+        val current = currentInternal()
+        if (current != id && !callback.isFrozen) throw IllegalStateException("Job for another worker must be frozen")
+        if (!addFdListenerInternal(id, fd, events, callback))
+            throw IllegalStateException("Cannot watch file descriptor $fd")
+    }
+
+    /**
+     * Stops watching [fd] added with [addFdListener]. Must be called before the descriptor is closed.
+     *
+     * @return `true` if [fd] was watched by this worker.
+     */
+    public fun removeFdListener(fd: Int): Boolean = removeFdListenerInternal(id, fd)
+
     /**
      * Process pending job(s) on the queue of this worker.
      * Note that jobs scheduled with [executeAfter] using non-zero timeout are
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.internal
+
+/**
+ * Sampling profiler of the heap allocations of all workers.
+ *
+ * On average one sample is taken per [start]'s `samplingIntervalBytes` allocated bytes, with the larger
+ * allocations being proportionally more likely to be sampled. A sample records the stack of the allocation and
+ * the type of the allocated object. The profiles report the estimated number of objects and bytes allocated
+ * at each stack, computed from the samples.
+ *
+ * The profiler can be started and stopped at any moment. While it is stopped, allocations are not slowed down.
+ */
+public object AllocationProfiler {
+    public const val DEFAULT_SAMPLING_INTERVAL_BYTES: Long = 512 * 1024
+
+    /**
+     * Starts sampling the allocations. The samples collected before are kept, use [reset] to discard them.
+     */
+    public fun start(samplingIntervalBytes: Long = DEFAULT_SAMPLING_INTERVAL_BYTES) {
+        require(samplingIntervalBytes > 0) { "Sampling interval must be positive: $samplingIntervalBytes" }
+        AllocationProfiler_start(samplingIntervalBytes)
+    }
+
+    public fun stop() = AllocationProfiler_stop()
+
+    public val isActive: Boolean
+        get() = AllocationProfiler_isActive()
+
+    /**
+     * Discards the samples collected so far.
+     */
+    public fun reset() = AllocationProfiler_reset()
+
+    /**
+     * The samples in the pprof format (`profile.proto` of https://github.com/google/pprof), ready to be written
+     * to a file and opened with `pprof`. The type of the allocated object is the `object type` label of a sample.
+     */
+    public fun pprofProfile(): ByteArray = AllocationProfiler_dumpPprof()
+
+    /**
+     * The samples as collapsed stacks, understood by `flamegraph.pl` and most of the flame graph viewers:
+     * a line per stack with the frames from the outermost one and the type of the allocated object separated
+     * by `;`, followed by the estimated number of allocated bytes.
+     */
+    public fun collapsedStacks(): String = AllocationProfiler_dumpCollapsed()
+}
+
+@SymbolName("Kotlin_AllocationProfiler_start")
+private external fun AllocationProfiler_start(samplingIntervalBytes: Long)
+
+@SymbolName("Kotlin_AllocationProfiler_stop")
+private external fun AllocationProfiler_stop()
+
+@SymbolName("Kotlin_AllocationProfiler_isActive")
+private external fun AllocationProfiler_isActive(): Boolean
+
+@SymbolName("Kotlin_AllocationProfiler_reset")
+private external fun AllocationProfiler_reset()
+
+@SymbolName("Kotlin_AllocationProfiler_dumpPprof")
+private external fun AllocationProfiler_dumpPprof(): ByteArray
+
+@SymbolName("Kotlin_AllocationProfiler_dumpCollapsed")
+private external fun AllocationProfiler_dumpCollapsed(): String
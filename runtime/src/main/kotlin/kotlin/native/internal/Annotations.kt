@@ -145,3 +145,11 @@ internal annotation class HasFinalizer
 @RequiresOptIn(level = RequiresOptIn.Level.ERROR)
 @Retention(value = AnnotationRetention.BINARY)
 internal annotation class InternalForKotlinNative
+
+/**
+ * Marks a [Throwable] subclass used for control flow rather than for reporting errors.
+ * Instances of the class and of its subclasses don't capture the stack trace when created,
+ * so [Throwable.getStackTrace] returns an empty array for them.
+ */
+@Target(AnnotationTarget.CLASS)
+public annotation class NoStackTrace
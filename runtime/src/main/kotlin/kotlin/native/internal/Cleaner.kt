@@ -87,6 +87,25 @@ fun <T> createCleaner(argument: T, block: (T) -> Unit): Cleaner {
     return CleanerImpl(cleanPtr).freeze()
 }
 
+/**
+ * Number of workers executing Cleaner blocks, 1 by default. Blocks of different cleaners
+ * may run in parallel if there is more than one worker.
+ *
+ * Can only be changed before the first cleaner is created.
+ *
+ * @throws IllegalStateException if the workers have already been started.
+ */
+@ExperimentalStdlibApi
+var cleanerWorkersCount: Int
+    get() = getCleanerWorkersCount()
+    set(value) {
+        require(value in 1..MAX_CLEANER_WORKERS) { "Number of cleaner workers must be in 1..$MAX_CLEANER_WORKERS" }
+        check(setCleanerWorkersCount(value)) { "Cleaner workers have already been started" }
+    }
+
+// Keep in sync with kMaxCleanerWorkers in Cleaner.cpp.
+private const val MAX_CLEANER_WORKERS = 16
+
 /**
  * Perform GC on a worker that executes Cleaner blocks.
  */
@@ -98,6 +117,7 @@ fun performGCOnCleanerWorker() =
 
 /**
  * Wait for a worker that executes Cleaner blocks to complete its scheduled tasks.
+ * If there are several such workers, only the first one is waited for.
  */
 @InternalForKotlinNative
 fun waitCleanerWorker() =
@@ -108,6 +128,12 @@ fun waitCleanerWorker() =
 @SymbolName("Kotlin_CleanerImpl_getCleanerWorker")
 external private fun getCleanerWorker(): Worker
 
+@SymbolName("Kotlin_CleanerImpl_getCleanerWorkersCount")
+external private fun getCleanerWorkersCount(): Int
+
+@SymbolName("Kotlin_CleanerImpl_setCleanerWorkersCount")
+external private fun setCleanerWorkersCount(count: Int): Boolean
+
 @ExportForCppRuntime("Kotlin_CleanerImpl_shutdownCleanerWorker")
 private fun shutdownCleanerWorker(worker: Worker, executeScheduledCleaners: Boolean) {
     worker.requestTermination(executeScheduledCleaners).result
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.internal
+
+/**
+ * Sampling CPU profiler of the threads running Kotlin code.
+ *
+ * Every [start]'s `intervalMicros` microseconds of the CPU time of the process, the stack of the thread running at
+ * that moment is recorded. The frames are symbolized with the source files and lines when the binary has
+ * the debug information.
+ *
+ * The profiler can also be started for the whole run of a program by setting the `KONAN_CPU_PROFILE` environment
+ * variable to the path of the file the [collapsedStacks] are written to when the program exits, and optionally
+ * `KONAN_CPU_PROFILE_INTERVAL_US` to the sampling interval.
+ *
+ * Not supported on Windows.
+ */
+public object CpuProfiler {
+    public const val DEFAULT_INTERVAL_MICROS: Long = 10_000
+
+    /**
+     * Starts sampling. The samples collected before are kept, use [reset] to discard them.
+     *
+     * Returns `false` if the profiler is already active or is not supported on this platform.
+     */
+    public fun start(intervalMicros: Long = DEFAULT_INTERVAL_MICROS): Boolean {
+        require(intervalMicros > 0) { "Sampling interval must be positive: $intervalMicros" }
+        return CpuProfiler_start(intervalMicros)
+    }
+
+    public fun stop() = CpuProfiler_stop()
+
+    public val isActive: Boolean
+        get() = CpuProfiler_isActive()
+
+    /**
+     * Discards the samples collected so far.
+     */
+    public fun reset() = CpuProfiler_reset()
+
+    /**
+     * Number of the samples lost because the profiler couldn't keep up with them.
+     */
+    public val droppedSamples: Long
+        get() = CpuProfiler_droppedSamples()
+
+    /**
+     * The samples as collapsed stacks, understood by `flamegraph.pl` and most of the flame graph viewers:
+     * a line per stack with the frames from the outermost one separated by `;`, followed by the number of samples.
+     */
+    public fun collapsedStacks(): String = CpuProfiler_dumpCollapsed()
+}
+
+@SymbolName("Kotlin_CpuProfiler_start")
+private external fun CpuProfiler_start(intervalMicros: Long): Boolean
+
+@SymbolName("Kotlin_CpuProfiler_stop")
+private external fun CpuProfiler_stop()
+
+@SymbolName("Kotlin_CpuProfiler_isActive")
+private external fun CpuProfiler_isActive(): Boolean
+
+@SymbolName("Kotlin_CpuProfiler_reset")
+private external fun CpuProfiler_reset()
+
+@SymbolName("Kotlin_CpuProfiler_droppedSamples")
+private external fun CpuProfiler_droppedSamples(): Long
+
+@SymbolName("Kotlin_CpuProfiler_dumpCollapsed")
+private external fun CpuProfiler_dumpCollapsed(): String
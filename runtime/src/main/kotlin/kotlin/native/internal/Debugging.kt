@@ -11,6 +11,54 @@ public object Debugging {
     public var forceCheckedShutdown: Boolean
         get() = Debugging_getForceCheckedShutdown()
         set(value) = Debugging_setForceCheckedShutdown(value)
+
+    /**
+     * Number of files whose global properties were initialized on the first access so far.
+     * Only such files are counted, so it stays zero unless the program is compiled with `-Xlazy-global-initialization`.
+     */
+    public val initializedFilesCount: Int
+        get() = Debugging_getInitializedFilesCount()
+
+    /**
+     * Number of runtime attaches by foreign threads through `AttachRuntime` of the exported C API so far,
+     * and how many of them reused a runtime state detached by another thread.
+     */
+    public val runtimeAttachCount: Long
+        get() = Debugging_getRuntimeAttachCount()
+
+    public val reusedRuntimeAttachCount: Long
+        get() = Debugging_getReusedRuntimeAttachCount()
+
+    /**
+     * Total and maximal time the runtime attaches took, in nanoseconds.
+     */
+    public val runtimeAttachTimeNanos: Long
+        get() = Debugging_getRuntimeAttachTimeNanos()
+
+    public val maxRuntimeAttachTimeNanos: Long
+        get() = Debugging_getMaxRuntimeAttachTimeNanos()
+
+    /**
+     * Number of disposed cleaners whose blocks haven't been run yet, and of the ones already run.
+     */
+    public val pendingCleanersCount: Long
+        get() = Debugging_getPendingCleanersCount()
+
+    public val executedCleanersCount: Long
+        get() = Debugging_getExecutedCleanersCount()
+
+    /**
+     * Maximal time between a cleaner disposal and the start of its block, in nanoseconds.
+     */
+    public val maxCleanerLagNanos: Long
+        get() = Debugging_getMaxCleanerLagNanos()
+
+    /**
+     * Bytes used by the objects in the heap of the current worker, or -1 if the allocator doesn't keep
+     * separate heaps for the workers.
+     */
+    public val objectHeapSize: Long
+        get() = Debugging_getObjectHeapSize()
 }
 
 @SymbolName("Kotlin_Debugging_getForceCheckedShutdown")
@@ -18,3 +66,30 @@ private external fun Debugging_getForceCheckedShutdown(): Boolean
 
 @SymbolName("Kotlin_Debugging_setForceCheckedShutdown")
 private external fun Debugging_setForceCheckedShutdown(value: Boolean): Unit
+
+@SymbolName("Kotlin_Debugging_getInitializedFilesCount")
+private external fun Debugging_getInitializedFilesCount(): Int
+
+@SymbolName("Kotlin_Debugging_getRuntimeAttachCount")
+private external fun Debugging_getRuntimeAttachCount(): Long
+
+@SymbolName("Kotlin_Debugging_getReusedRuntimeAttachCount")
+private external fun Debugging_getReusedRuntimeAttachCount(): Long
+
+@SymbolName("Kotlin_Debugging_getRuntimeAttachTimeNanos")
+private external fun Debugging_getRuntimeAttachTimeNanos(): Long
+
+@SymbolName("Kotlin_Debugging_getMaxRuntimeAttachTimeNanos")
+private external fun Debugging_getMaxRuntimeAttachTimeNanos(): Long
+
+@SymbolName("Kotlin_Debugging_getPendingCleanersCount")
+private external fun Debugging_getPendingCleanersCount(): Long
+
+@SymbolName("Kotlin_Debugging_getExecutedCleanersCount")
+private external fun Debugging_getExecutedCleanersCount(): Long
+
+@SymbolName("Kotlin_Debugging_getMaxCleanerLagNanos")
+private external fun Debugging_getMaxCleanerLagNanos(): Long
+
+@SymbolName("Kotlin_Debugging_getObjectHeapSize")
+private external fun Debugging_getObjectHeapSize(): Long
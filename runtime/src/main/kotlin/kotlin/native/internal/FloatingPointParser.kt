@@ -18,6 +18,7 @@
 package kotlin.native.internal
 
 import kotlin.comparisons.*
+import kotlin.native.checkBoundsIndexes
 
 /**
  * Takes a String and an integer exponent. The String should hold a positive
@@ -49,6 +50,26 @@ private external fun parseDoubleImpl(s: String, e: Int): Double
 @SymbolName("Kotlin_native_FloatingPointParser_parseFloatImpl")
 private external fun parseFloatImpl(s: String, e: Int): Float
 
+/**
+ * Parses a decimal floating point literal directly from the UTF-8 bytes of [bytes] in range
+ * [[startIndex], [endIndex]), without creating an intermediate string.
+ * Returns the closest double value to the real number.
+ *
+ * @exception NumberFormatException if the bytes don't represent a decimal floating point literal
+ */
+@SymbolName("Kotlin_native_FloatingPointParser_parseDoubleUtf8Impl")
+private external fun parseDoubleUtf8Impl(bytes: ByteArray, startIndex: Int, endIndex: Int): Double
+
+/**
+ * Parses a decimal floating point literal directly from the UTF-8 bytes of [bytes] in range
+ * [[startIndex], [endIndex]), without creating an intermediate string.
+ * Returns the closest float value to the real number.
+ *
+ * @exception NumberFormatException if the bytes don't represent a decimal floating point literal
+ */
+@SymbolName("Kotlin_native_FloatingPointParser_parseFloatUtf8Impl")
+private external fun parseFloatUtf8Impl(bytes: ByteArray, startIndex: Int, endIndex: Int): Float
+
 /**
  * Used to parse a string and return either a single or double precision
  * floating point number.
@@ -378,4 +399,32 @@ object FloatingPointParser {
 
         return result
     }
+
+    /**
+     * Returns the closest double value to the decimal floating point literal
+     * `[+-]digits[.digits][(e|E)[+-]digits]` held in UTF-8 encoding by [bytes] in range [[startIndex], [endIndex]).
+     * Unlike [parseDouble], doesn't accept surrounding whitespace, type suffixes, named and hexadecimal forms.
+     *
+     * Intended for parsers of textual formats (CSV, JSON, etc.), which can avoid creating a string per number.
+     *
+     * @exception NumberFormatException if the bytes don't represent a decimal floating point literal
+     */
+    fun parseDouble(bytes: ByteArray, startIndex: Int = 0, endIndex: Int = bytes.size): Double {
+        checkBoundsIndexes(startIndex, endIndex, bytes.size)
+        return parseDoubleUtf8Impl(bytes, startIndex, endIndex)
+    }
+
+    /**
+     * Returns the closest float value to the decimal floating point literal
+     * `[+-]digits[.digits][(e|E)[+-]digits]` held in UTF-8 encoding by [bytes] in range [[startIndex], [endIndex]).
+     * Unlike [parseFloat], doesn't accept surrounding whitespace, type suffixes, named and hexadecimal forms.
+     *
+     * Intended for parsers of textual formats (CSV, JSON, etc.), which can avoid creating a string per number.
+     *
+     * @exception NumberFormatException if the bytes don't represent a decimal floating point literal
+     */
+    fun parseFloat(bytes: ByteArray, startIndex: Int = 0, endIndex: Int = bytes.size): Float {
+        checkBoundsIndexes(startIndex, endIndex, bytes.size)
+        return parseFloatUtf8Impl(bytes, startIndex, endIndex)
+    }
 }
\ No newline at end of file
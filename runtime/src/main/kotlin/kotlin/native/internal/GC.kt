@@ -92,6 +92,23 @@ object GC {
         get() = getTuneThreshold()
         set(value) = setTuneThreshold(value)
 
+    /**
+     * Soft limit for the memory taken by objects of all workers, in bytes, or 0 if there is no limit.
+     * Allocations above 90% of the limit trigger full collections including cycles, and the freed memory
+     * is returned to the OS. Such collections are spaced by the growth of the heap, and more so while they
+     * free little. Allocations never fail because of the limit.
+     */
+    var softHeapLimit: Long
+        get() = getSoftHeapLimit()
+        set(value) = setSoftHeapLimit(value)
+
+    /**
+     * Memory taken by objects of all workers, in bytes. Each worker reports its allocations in batches,
+     * so the value is approximate.
+     */
+    val heapUsage: Long
+        get() = getHeapUsage()
+
 
     /**
      * If cyclic collector for atomic references to be deployed.
@@ -114,6 +131,13 @@ object GC {
     @SymbolName("Kotlin_native_internal_GC_findCycle")
     external fun findCycle(root: Any): Array<Any>?
 
+    /**
+     * Write a snapshot of the objects of the current worker to the file at [path], for the offline analysis
+     * with `tools/scripts/heap_snapshot.py`. Returns `false` if the file cannot be written.
+     */
+    @SymbolName("Kotlin_native_internal_GC_dumpHeapSnapshot")
+    external fun dumpHeapSnapshot(path: String): Boolean
+
     @SymbolName("Kotlin_native_internal_GC_getThreshold")
     private external fun getThreshold(): Int
 
@@ -138,6 +162,15 @@ object GC {
     @SymbolName("Kotlin_native_internal_GC_setTuneThreshold")
     private external fun setTuneThreshold(value: Boolean)
 
+    @SymbolName("Kotlin_native_internal_GC_getSoftHeapLimit")
+    private external fun getSoftHeapLimit(): Long
+
+    @SymbolName("Kotlin_native_internal_GC_setSoftHeapLimit")
+    private external fun setSoftHeapLimit(value: Long)
+
+    @SymbolName("Kotlin_native_internal_GC_getHeapUsage")
+    private external fun getHeapUsage(): Long
+
     @SymbolName("Kotlin_native_internal_GC_getCyclicCollector")
     private external fun getCyclicCollectorEnabled(): Boolean
 
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+ * that can be found in the LICENSE file.
+ */
+
+package kotlin.native.ref
+
+import kotlin.native.identityHashCode
+
+/**
+ * A map holding its keys weakly: once a key is collected by the memory manager, its entry disappears
+ * from the map. Keys are compared by identity.
+ *
+ * Values are held strongly, so a value referring to its own key keeps the entry alive.
+ * Reading the keys doesn't take locks, but the map itself is not thread-safe.
+ */
+@ExperimentalStdlibApi
+public class WeakKeyedMap<K : Any, V : Any> {
+    private class Entry<V : Any>(val hash: Int, val key: WeakReferenceImpl, var value: V, var next: Entry<V>?)
+
+    private var table = arrayOfNulls<Entry<V>>(INITIAL_CAPACITY)
+    private var count = 0
+    // Dead keys are looked for only if some weak references, not necessarily of this map, were cleared since
+    // the last time. Updates scan the table no more often than once per as many updates as there are entries,
+    // or when it is full, so that the scans take amortized constant time per update.
+    private var clearedCount = weakReferencesClearedCount()
+    private var updatesSinceExpunge = 0
+
+    /**
+     * Returns the number of entries with live keys.
+     * Takes time proportional to the size of the map if weak references were cleared since the last call.
+     */
+    public val size: Int
+        get() {
+            expungeStaleEntries()
+            return count
+        }
+
+    /**
+     * Returns the value for the given key, or `null` if there is no such key in the map.
+     */
+    public operator fun get(key: K): V? = findEntry(key, key.identityHashCode())?.value
+
+    /**
+     * Returns `true` if the map contains the given key.
+     */
+    public fun containsKey(key: K): Boolean = findEntry(key, key.identityHashCode()) != null
+
+    /**
+     * Associates the value with the key. Returns the previous value, or `null` if there was none.
+     */
+    public fun put(key: K, value: V): V? {
+        val hash = key.identityHashCode()
+        findEntry(key, hash)?.let { entry ->
+            val oldValue = entry.value
+            entry.value = value
+            return oldValue
+        }
+        if (++updatesSinceExpunge >= count) expungeStaleEntries()
+        if (count >= table.size / 4 * 3) {
+            expungeStaleEntries()
+            // Unless many entries were dead, grow anyway, so that the next full scan is as many updates away.
+            if (count >= table.size / 8 * 3) resize(table.size * 2)
+        }
+        val index = indexFor(hash, table.size)
+        table[index] = Entry(hash, getWeakReferenceImpl(key), value, table[index])
+        count++
+        return null
+    }
+
+    public operator fun set(key: K, value: V) {
+        put(key, value)
+    }
+
+    /**
+     * Returns the value for the given key. If there is no such key, puts the result of [defaultValue] and returns it.
+     */
+    public inline fun getOrPut(key: K, defaultValue: () -> V): V =
+            get(key) ?: defaultValue().also { put(key, it) }
+
+    /**
+     * Removes the key from the map. Returns its value, or `null` if there was no such key.
+     */
+    public fun remove(key: K): V? {
+        if (++updatesSinceExpunge >= count) expungeStaleEntries()
+        val hash = key.identityHashCode()
+        val index = indexFor(hash, table.size)
+        var previous: Entry<V>? = null
+        var entry = table[index]
+        while (entry != null) {
+            if (entry.hash == hash && entry.key.get() === key) {
+                unlink(index, previous, entry)
+                return entry.value
+            }
+            previous = entry
+            entry = entry.next
+        }
+        return null
+    }
+
+    /**
+     * Removes all the entries from the map.
+     */
+    public fun clear() {
+        table = arrayOfNulls(INITIAL_CAPACITY)
+        count = 0
+    }
+
+    private fun findEntry(key: K, hash: Int): Entry<V>? {
+        var entry = table[indexFor(hash, table.size)]
+        while (entry != null) {
+            if (entry.hash == hash && entry.key.get() === key) return entry
+            entry = entry.next
+        }
+        return null
+    }
+
+    private fun unlink(index: Int, previous: Entry<V>?, entry: Entry<V>) {
+        if (previous == null) table[index] = entry.next else previous.next = entry.next
+        count--
+    }
+
+    private fun expungeStaleEntries() {
+        val currentClearedCount = weakReferencesClearedCount()
+        if (currentClearedCount == clearedCount) return
+        clearedCount = currentClearedCount
+        updatesSinceExpunge = 0
+        for (index in table.indices) {
+            var previous: Entry<V>? = null
+            var entry = table[index]
+            while (entry != null) {
+                if (entry.key.get() == null) {
+                    unlink(index, previous, entry)
+                } else {
+                    previous = entry
+                }
+                entry = entry.next
+            }
+        }
+    }
+
+    private fun resize(capacity: Int) {
+        val newTable = arrayOfNulls<Entry<V>>(capacity)
+        for (head in table) {
+            var entry = head
+            while (entry != null) {
+                val next = entry.next
+                val index = indexFor(entry.hash, capacity)
+                entry.next = newTable[index]
+                newTable[index] = entry
+                entry = next
+            }
+        }
+        table = newTable
+    }
+
+    private companion object {
+        const val INITIAL_CAPACITY = 16
+
+        // Capacity is a power of two. Mixes the high bits in, as identity hash codes are aligned addresses.
+        fun indexFor(hash: Int, capacity: Int) = (hash xor (hash ushr 16)) and (capacity - 1)
+    }
+}
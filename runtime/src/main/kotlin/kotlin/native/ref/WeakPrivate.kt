@@ -37,8 +37,8 @@ import kotlin.native.internal.Escapes
 @NoReorderFields
 @Frozen
 internal class WeakReferenceCounter(var referred: COpaquePointer?) : WeakReferenceImpl() {
-    // Spinlock, potentially taken when materializing or removing 'referred' object.
-    var lock: Int = 0
+    // Number of threads materializing 'referred' object, which must not be removed until they are done.
+    var readers: Int = 0
 
     // Optimization for concurrent access.
     var cookie: Int = 0
@@ -52,6 +52,10 @@ internal abstract class WeakReferenceImpl {
     abstract fun get(): Any?
 }
 
+// Number of weak references cleared so far.
+@SymbolName("Konan_WeakReference_getClearedCount")
+external internal fun weakReferencesClearedCount(): Long
+
 // Get a counter from non-null object.
 @SymbolName("Konan_getWeakReferenceImpl")
 @Escapes(0b01) // referent escapes.
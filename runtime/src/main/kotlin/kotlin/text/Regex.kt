@@ -13,6 +13,20 @@ internal interface FlagEnum {
     val mask: Int
 }
 
+/**
+ * Compiles the [pattern] for the native DFA matcher.
+ * Returns an id of the compiled DFA or -1 if the pattern uses features not supported by the DFA matcher.
+ */
+@SymbolName("Kotlin_text_regex_registerLazyDfa")
+external private fun registerLazyDfa(pattern: String, flags: Int): Int
+
+/**
+ * Returns 1 if the DFA with the given [id] matches the entire [input] (or some part of it if [entire] is false),
+ * 0 if it doesn't and -1 if the DFA gave up on this input.
+ */
+@SymbolName("Kotlin_text_regex_lazyDfaMatch")
+external private fun lazyDfaMatch(id: Int, input: String, entire: Boolean): Int
+
 private fun Iterable<FlagEnum>.toInt(): Int = this.fold(0, { value, option -> value or option.value })
 
 private fun fromInt(value: Int): Set<RegexOption> =
@@ -95,6 +109,10 @@ public actual class Regex internal constructor(internal val nativePattern: Patte
     /** The set of options that were used to create this regular expression.  */
     actual val options: Set<RegexOption> = fromInt(nativePattern.flags)
 
+    // Simple patterns are also compiled into a native DFA which answers yes/no questions without backtracking.
+    // Registered on the first such question only, for most regular expressions are only used to find matches.
+    private val lazyDfa by lazy { registerLazyDfa(nativePattern.pattern, nativePattern.flags) }
+
     actual companion object {
         /**
          * Returns a regular expression that matches the specified [literal] string literally.
@@ -144,11 +162,21 @@ public actual class Regex internal constructor(internal val nativePattern: Patte
         return matchResult
     }
 
+    /** Returns 1 or 0 if the DFA matcher (dis)proved the match, -1 if the backtracking matcher must be used. */
+    private fun matchWithDfa(input: CharSequence, entire: Boolean): Int =
+            if (input is String && lazyDfa >= 0) lazyDfaMatch(lazyDfa, input, entire) else -1
+
     /** Indicates whether the regular expression matches the entire [input]. */
-    actual infix fun matches(input: CharSequence): Boolean = doMatch(input, Mode.MATCH) != null
+    actual infix fun matches(input: CharSequence): Boolean {
+        val result = matchWithDfa(input, entire = true)
+        return if (result >= 0) result == 1 else doMatch(input, Mode.MATCH) != null
+    }
 
     /** Indicates whether the regular expression can find at least one match in the specified [input]. */
-    actual fun containsMatchIn(input: CharSequence): Boolean = find(input) != null
+    actual fun containsMatchIn(input: CharSequence): Boolean {
+        val result = matchWithDfa(input, entire = false)
+        return if (result >= 0) result == 1 else find(input) != null
+    }
 
     /**
      * Returns the first match of a regular expression in the [input], beginning at the specified [startIndex].
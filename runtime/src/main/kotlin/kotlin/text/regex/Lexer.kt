@@ -32,16 +32,12 @@ external private fun getCanonicalClassInternal(ch: Int): Int
 @SymbolName("Kotlin_text_regex_hasSingleCodepointDecompositionInternal")
 external private fun hasSingleCodepointDecompositionInternal(ch: Int): Boolean
 
-/** Returns a decomposition for a given codepoint. */
-@SymbolName("Kotlin_text_regex_getDecompositionInternal")
-external private fun getDecompositionInternal(ch: Int): IntArray?
-
 /**
- * Decomposes the given string represented as an array of codepoints. Saves the decomposition into [outputCodepoints] array.
- * Returns the length of the decomposition.
+ * Returns the given normalization form ([NORMALIZATION_FORM_NFD] or [NORMALIZATION_FORM_NFC]) of the string.
+ * Returns the string itself if it is already normalized.
  */
-@SymbolName("Kotlin_text_regex_decomposeString")
-external private fun decomposeString(inputCodePoints: IntArray, inputLength: Int, outputCodePoints: IntArray): Int
+@SymbolName("Kotlin_text_regex_normalize")
+external private fun normalizeInternal(input: String, form: Int): String
 // =============================================================================================================
 
 /**
@@ -797,80 +793,17 @@ internal class Lexer(val patternString: String, flags: Int) {
         fun hasDecompositionNonNullCanClass(ch: Int): Boolean =
             (ch == 0x0340) or (ch == 0x0341) or (ch == 0x0343) or (ch == 0x0344)
 
-        /** Gets decomposition for given codepoint from decomposition mappings table. */
-        fun getDecomposition(ch: Int): IntArray? = getDecompositionInternal(ch)
-
         // =============================================================================================================
 
+        // Values must be kept in sync with kotlin::NormalizationForm in Normalizer.hpp.
+        val NORMALIZATION_FORM_NFD = 0
+        val NORMALIZATION_FORM_NFC = 1
+
         /**
-         * Normalize given string.
+         * Normalize given string: canonical decomposition followed by canonical ordering.
+         * See http://www.unicode.org/reports/tr15/#Decomposition for details.
          */
-        fun normalize(input: String): String {
-            val inputChars = input.toCharArray()
-            val inputLength = inputChars.size
-            var inputCodePointsIndex = 0
-            var decompHangulIndex = 0
-
-            //codePoints of input
-            val inputCodePoints = IntArray(inputLength)
-
-            //result of canonical decomposition of input
-            var resCodePoints = IntArray(inputLength * MAX_DECOMPOSITION_LENGTH)
-
-            //current symbol's codepoint
-            var ch: Int
-
-            //current symbol's decomposition
-            var decomp: IntArray?
-
-            //result of canonical and Hangul decomposition of input
-            val decompHangul: IntArray
-
-            //result of canonical decomposition of input in UTF-16 encoding
-            val result = StringBuilder()
-
-            var i = 0
-            while (i < inputLength) {
-                ch = input.codePointAt(i)
-                inputCodePoints[inputCodePointsIndex++] = ch
-                i += if (Char.isSupplementaryCodePoint(ch)) 2 else 1
-            }
-
-            // Canonical decomposition based on mappings in decomposition table.
-            var resCodePointsIndex = decomposeString(inputCodePoints, inputCodePointsIndex, resCodePoints)
-
-            // Canonical ordering.
-            // See http://www.unicode.org/reports/tr15/#Decomposition for details
-            resCodePoints = Lexer.getCanonicalOrder(resCodePoints, resCodePointsIndex)
-
-            // Decomposition for Hangul syllables.
-            // See http://www.unicode.org/reports/tr15/#Hangul for details
-            decompHangul = IntArray(resCodePoints.size)
-            @Suppress("NAME_SHADOWING")
-            for (i in 0..resCodePointsIndex - 1) {
-                val curSymb = resCodePoints[i]
-
-                decomp = getHangulDecomposition(curSymb)
-                if (decomp == null) {
-                    decompHangul[decompHangulIndex++] = curSymb
-                } else {
-                    // Note that Hangul decompositions have length that is equal 2 or 3.
-                    decompHangul[decompHangulIndex++] = decomp[0]
-                    decompHangul[decompHangulIndex++] = decomp[1]
-                    if (decomp.size == 3) {
-                        decompHangul[decompHangulIndex++] = decomp[2]
-                    }
-                }
-            }
-
-            // Translating into UTF-16 encoding
-            @Suppress("NAME_SHADOWING")
-            for (i in 0..decompHangulIndex - 1) {
-                result.append(Char.toChars(decompHangul[i]))
-            }
-
-            return result.toString()
-        }
+        fun normalize(input: String): String = normalizeInternal(input, NORMALIZATION_FORM_NFD)
 
         /**
          * Rearrange codepoints in [inputInts] according to canonical order. Return an array with rearranged codepoints.
@@ -912,31 +845,5 @@ internal class Lexer(val patternString: String, flags: Int) {
 
             return inputInts
         }
-
-        /**
-         * Gets decomposition for given Hangul syllable.
-         * This is an implementation of Hangul decomposition algorithm
-         * according to http://www.unicode.org/versions/Unicode4.0.0/ch03.pdf "3.12 Conjoining Jamo Behavior".
-         */
-        fun getHangulDecomposition(ch: Int): IntArray? {
-            val SIndex = ch - SBase
-
-            if (SIndex < 0 || SIndex >= SCount) {
-                return null
-            } else {
-                val L = LBase + SIndex / NCount
-                val V = VBase + SIndex % NCount / TCount
-                var T = SIndex % TCount
-                val decomp: IntArray
-
-                if (T == 0) {
-                    decomp = intArrayOf(L, V)
-                } else {
-                    T = TBase + T
-                    decomp = intArrayOf(L, V, T)
-                }
-                return decomp
-            }
-        }
     }
 }
@@ -29,6 +29,14 @@ package kotlin.text.regex
 @SymbolName("Kotlin_text_regex_decomposeCodePoint")
 external private fun decomposeCodePoint(codePoint: Int, outputCodePoints: IntArray, fromIndex: Int): Int
 
+/**
+ * Decomposes the codepoint at [index] of [string] together with the following combining marks, up to the next
+ * decomposed char boundary, and saves the decomposition in canonical order into [outputCodePoints].
+ * Returns the number of the chars read shifted left by 8, or-ed with the length of the decomposition.
+ */
+@SymbolName("Kotlin_text_regex_decomposeSegment")
+external private fun decomposeSegment(string: String, index: Int, outputCodePoints: IntArray): Int
+
 /** Represents canonical decomposition of Unicode character. Is used when CANON_EQ flag of Pattern class is specified. */
 open internal class DecomposedCharSet(
         /** Decomposition of the Unicode codepoint */
@@ -39,6 +47,12 @@ open internal class DecomposedCharSet(
     /** Contains information about number of chars that were read for a codepoint last time */
     private var readCharsForCodePoint = 1
 
+    /**
+     * Decomposition of the part of testString being matched.
+     * All decompositions have length that is less or equal Lexer.MAX_DECOMPOSITION_LENGTH
+     */
+    private val decomposedCodePoint = IntArray(Lexer.MAX_DECOMPOSITION_LENGTH)
+
     /** UTF-16 encoding of decomposedChar */
     private val decomposedCharUTF16: String by lazy {
         val strBuff = StringBuilder()
@@ -50,21 +64,40 @@ open internal class DecomposedCharSet(
     }
 
     override fun matches(startIndex: Int, testString: CharSequence, matchResult: MatchResultImpl): Int {
-        var strIndex = startIndex
-        val rightBound = testString.length
+        if (startIndex >= testString.length) {
+            return -1
+        }
 
-        if (strIndex >= rightBound) {
+        // A string is decomposed in a single native call, other char sequences code point by code point.
+        val segment = if (testString is String)
+            decomposeSegment(testString, startIndex, decomposedCodePoint)
+        else
+            decomposeCharSequenceSegment(startIndex, testString)
+        val strIndex = startIndex + (segment ushr 8)
+        val readCodePoints = segment and 0xFF
+
+        // Compare decomposedChar with decomposed char that was just read from testString
+        if (readCodePoints != decomposedCharLength) {
             return -1
         }
 
+        for (i in 0 until readCodePoints) {
+            if (decomposedCodePoint[i] != decomposedChar[i]) {
+                return -1
+            }
+        }
+        return next.matches(strIndex, testString, matchResult)
+    }
+
+    /** Same as the native [decomposeSegment] for an arbitrary [testString]. */
+    private fun decomposeCharSequenceSegment(startIndex: Int, testString: CharSequence): Int {
+        var strIndex = startIndex
+        val rightBound = testString.length
+
         // We read testString and decompose it gradually to compare with this decomposedChar at position strIndex
         var curChar = codePointAt(strIndex, testString, rightBound)
         strIndex += readCharsForCodePoint
-        var readCodePoints = 0
-        var i = 0
-        // All decompositions have length that is less or equal Lexer.MAX_DECOMPOSITION_LENGTH
-        var decomposedCodePoint: IntArray = IntArray(Lexer.MAX_DECOMPOSITION_LENGTH)
-        readCodePoints += decomposeCodePoint(curChar, decomposedCodePoint, readCodePoints)
+        var readCodePoints = decomposeCodePoint(curChar, decomposedCodePoint, 0)
 
         if (strIndex < rightBound) {
             curChar = codePointAt(strIndex, testString, rightBound)
@@ -92,33 +125,10 @@ open internal class DecomposedCharSet(
             }
         }
 
-        // Some optimization since length of decomposed char is <= 3 usually
-        when (readCodePoints) {
-            0, 1, 2 -> {}
-
-            3 -> {
-                var i1 = Lexer.getCanonicalClass(decomposedCodePoint[1])
-                val i2 = Lexer.getCanonicalClass(decomposedCodePoint[2])
-
-                if (i2 != 0 && i1 > i2) {
-                    i1 = decomposedCodePoint[1]
-                    decomposedCodePoint[1] = decomposedCodePoint[2]
-                    decomposedCodePoint[2] = i1
-                }
-            }
-
-            else -> decomposedCodePoint = Lexer.getCanonicalOrder(decomposedCodePoint, readCodePoints)
+        if (readCodePoints > 2) {
+            Lexer.getCanonicalOrder(decomposedCodePoint, readCodePoints)
         }
-
-        // Compare decomposedChar with decomposed char that was just read from testString
-        if (readCodePoints != decomposedCharLength) {
-            return -1
-        }
-
-        if ((0 until readCodePoints).firstOrNull { decomposedCodePoint[i] != decomposedChar[i] } != null) {
-            return -1
-        }
-        return next.matches(strIndex, testString, matchResult)
+        return ((strIndex - startIndex) shl 8) or readCodePoints
     }
 
     override val name: String
@@ -51,43 +51,30 @@ internal class HangulDecomposedCharSet(
 
     override fun matches(startIndex: Int, testString: CharSequence, matchResult: MatchResultImpl): Int {
         var index = startIndex
-
-        /*
-         * All decompositions for Hangul syllables have length that
-         * is less or equal Lexer.MAX_DECOMPOSITION_LENGTH
-         */
         val rightBound = testString.length
-        var SyllIndex = 0
-        val decompSyllable = IntArray(Lexer
-                .MAX_HANGUL_DECOMPOSITION_LENGTH)
-        val decompCurSymb: IntArray?
-        var curSymb: Char
 
         /*
          * For details about Hangul composition and decomposition see
          * http://www.unicode.org/versions/Unicode4.0.0/ch03.pdf
          * "3.12 Conjoining Jamo Behavior"
          */
-        var LIndex: Int
-        var VIndex = -1
-        var TIndex = -1
-
         if (index >= rightBound) {
             return -1
         }
-        curSymb = testString[index++]
-        decompCurSymb = Lexer.getHangulDecomposition(curSymb.toInt())
+        val L: Int
+        val V: Int
+        var T = -1
+        val curSymb = testString[index++].toInt()
+        val SIndex = curSymb - Lexer.SBase
 
-        if (decompCurSymb == null) {
+        if (SIndex < 0 || SIndex >= Lexer.SCount) {
 
             /*
              * We deal with ordinary letter or sequence of jamos
              * at index at testString.
              */
-            decompSyllable[SyllIndex++] = curSymb.toInt()
-            LIndex = curSymb.toInt() - Lexer.LBase
-
-            if (LIndex < 0 || LIndex >= Lexer.LCount) {
+            L = curSymb
+            if (L - Lexer.LBase < 0 || L - Lexer.LBase >= Lexer.LCount) {
 
                 /*
                  * Ordinary letter, that doesn't match this
@@ -95,12 +82,8 @@ internal class HangulDecomposedCharSet(
                 return -1
             }
 
-            if (index < rightBound) {
-                curSymb = testString[index]
-                VIndex = curSymb.toInt() - Lexer.VBase
-            }
-
-            if (VIndex < 0 || VIndex >= Lexer.VCount) {
+            V = if (index < rightBound) testString[index].toInt() else -1
+            if (V - Lexer.VBase < 0 || V - Lexer.VBase >= Lexer.VCount) {
 
                 /*
                  * Single L jamo doesn't compose Hangul syllable,
@@ -109,60 +92,39 @@ internal class HangulDecomposedCharSet(
                 return -1
             }
             index++
-            decompSyllable[SyllIndex++] = curSymb.toInt()
 
             if (index < rightBound) {
-                curSymb = testString[index]
-                TIndex = curSymb.toInt() - Lexer.TBase
-            }
-
-            if (TIndex < 0 || TIndex >= Lexer.TCount) {
-
-                /*
-                 * We deal with LV syllable at testString, so
-                 * compare it to this
-                 */
-                return if (decomposedCharLength == 2
-                        && decompSyllable[0] == decomposedChar[0].toInt()
-                        && decompSyllable[1] == decomposedChar[1].toInt())
-                    next.matches(index, testString, matchResult)
-                else
-                    -1
+                val curT = testString[index].toInt()
+                if (curT - Lexer.TBase >= 0 && curT - Lexer.TBase < Lexer.TCount) {
+                    // LVT syllable at testString.
+                    T = curT
+                    index++
+                }
             }
-            index++
-            decompSyllable[@Suppress("UNUSED_CHANGED_VALUE")SyllIndex++] = curSymb.toInt()
-
-            /*
-             * We deal with LVT syllable at testString, so
-             * compare it to this
-             */
-            return if (decomposedCharLength == 3
-                    && decompSyllable[0] == decomposedChar[0].toInt()
-                    && decompSyllable[1] == decomposedChar[1].toInt()
-                    && decompSyllable[2] == decomposedChar[2].toInt())
-                next.matches(index, testString, matchResult)
-            else
-                -1
         } else {
 
             /*
              * We deal with Hangul syllable at index at testString.
-             * So we decomposed it to compare with this.
+             * So we decompose it, without allocating, to compare with this.
              */
-            var i = 0
-
-            if (decompCurSymb.size != decomposedCharLength) {
-                return -1
-            }
-
-            while (i < decomposedCharLength) {
-                if (decompCurSymb[i] != decomposedChar[i].toInt()) {
-                    return -1
-                }
-                i++
+            L = Lexer.LBase + SIndex / Lexer.NCount
+            V = Lexer.VBase + SIndex % Lexer.NCount / Lexer.TCount
+            val TIndex = SIndex % Lexer.TCount
+            if (TIndex != 0) {
+                T = Lexer.TBase + TIndex
             }
-            return next.matches(index, testString, matchResult)
         }
+
+        val matches = if (T == -1)
+            decomposedCharLength == 2
+                    && L == decomposedChar[0].toInt()
+                    && V == decomposedChar[1].toInt()
+        else
+            decomposedCharLength == 3
+                    && L == decomposedChar[0].toInt()
+                    && V == decomposedChar[1].toInt()
+                    && T == decomposedChar[2].toInt()
+        return if (matches) next.matches(index, testString, matchResult) else -1
     }
 
     override fun first(set: AbstractSet): Boolean {
@@ -141,6 +141,12 @@ mi_decl_export void mi_register_output(mi_output_fun* out, void* arg) mi_attr_no
 typedef void (mi_cdecl mi_error_fun)(int err, void* arg);
 mi_decl_export void mi_register_error(mi_error_fun* fun, void* arg);
 
+#if KONAN_MI_MALLOC
+// Called on a thread that is done, before its heaps are deleted.
+typedef void (mi_cdecl mi_thread_done_fun)(void);
+mi_decl_export void mi_register_thread_done(mi_thread_done_fun* fun) mi_attr_noexcept;
+#endif // KONAN_MI_MALLOC
+
 mi_decl_export void mi_collect(bool force)    mi_attr_noexcept;
 mi_decl_export int  mi_version(void)          mi_attr_noexcept;
 mi_decl_export void mi_stats_reset(void)      mi_attr_noexcept;
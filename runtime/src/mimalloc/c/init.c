@@ -206,10 +206,24 @@ static bool _mi_heap_init(void) {
   return false;
 }
 
+#if KONAN_MI_MALLOC
+static mi_thread_done_fun* volatile thread_done = NULL;
+
+void mi_register_thread_done(mi_thread_done_fun* fun) mi_attr_noexcept {
+  thread_done = fun;
+}
+#endif // KONAN_MI_MALLOC
+
 // Free the thread local default heap (called from `mi_thread_done`)
 static bool _mi_heap_done(mi_heap_t* heap) {
   if (!mi_heap_is_initialized(heap)) return true;
 
+#if KONAN_MI_MALLOC
+  // Lets the owners of the other heaps of the thread release them before they are deleted below.
+  mi_thread_done_fun* fun = thread_done;
+  if (fun != NULL) fun();
+#endif // KONAN_MI_MALLOC
+
   // reset default heap
   _mi_heap_set_default_direct(_mi_is_main_thread() ? &_mi_heap_main : (mi_heap_t*)&_mi_heap_empty);
 
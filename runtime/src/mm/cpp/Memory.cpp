@@ -6,6 +6,9 @@
 #include "Memory.h"
 
 #include "GlobalsRegistry.hpp"
+#include "HeapSnapshot.hpp"
+#include "KString.h"
+#include "Porting.h"
 #include "ThreadData.hpp"
 #include "ThreadRegistry.hpp"
 #include "Utils.hpp"
@@ -75,3 +78,27 @@ extern "C" RUNTIME_NOTHROW void ClearTLS(MemoryState* memory) {
 extern "C" RUNTIME_NOTHROW ObjHeader** LookupTLS(void** key, int index) {
     return mm::ThreadRegistry::Instance().CurrentThreadData()->tls().Lookup(key, index);
 }
+
+// TODO: Roots on the stacks and in the thread-local storage of the other threads are missing, and other threads may
+// mutate the heap while it is traversed: this needs the threads to be suspended.
+extern "C" KBoolean Kotlin_native_internal_GC_dumpHeapSnapshot(KRef, KRef path) {
+    char* cPath = CreateCStringFromString(path);
+    HeapSnapshotWriter writer(cPath);
+    konan::free(cPath);
+    if (!writer.ok()) return false;
+    KStdVector<ObjHeader*> roots;
+    for (ObjHeader** location : mm::GlobalsRegistry::Instance().Iter()) {
+        if (*location == nullptr) continue;
+        writer.WriteRoot(HeapSnapshotWriter::kRootGlobal, *location);
+        roots.push_back(*location);
+    }
+    // Only the thread-local roots of the current thread: the other threads are not suspended, so their storage may
+    // be written, or cleared as they exit, while it is walked.
+    for (ObjHeader** location : mm::ThreadRegistry::Instance().CurrentThreadData()->tls()) {
+        if (*location == nullptr) continue;
+        writer.WriteRoot(HeapSnapshotWriter::kRootThreadLocal, *location);
+        roots.push_back(*location);
+    }
+    writer.WriteReachableObjects(roots);
+    return writer.Finish();
+}
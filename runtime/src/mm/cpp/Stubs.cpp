@@ -51,6 +51,11 @@ void RestoreMemory(MemoryState*) {
     // TODO: Remove this function when legacy MM is gone.
 }
 
+bool DetachMemory(MemoryState*) {
+    // Thread data is bound to the thread it was registered on.
+    return false;
+}
+
 RUNTIME_NOTHROW OBJ_GETTER(AllocInstance, const TypeInfo* type_info) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -59,6 +64,10 @@ OBJ_GETTER(AllocArrayInstance, const TypeInfo* type_info, int32_t elements) {
     RuntimeCheck(false, "Unimplemented");
 }
 
+OBJ_GETTER(AllocUninitializedArrayInstance, const TypeInfo* type_info, int32_t elements) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 OBJ_GETTER(InitThreadLocalSingleton, ObjHeader** location, const TypeInfo* typeInfo, void (*ctor)(ObjHeader*)) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -97,6 +106,14 @@ RUNTIME_NOTHROW void UpdateHeapRefIfNull(ObjHeader** location, const ObjHeader*
     RuntimeCheck(false, "Unimplemented");
 }
 
+RUNTIME_NOTHROW void UpdateHeapRefsRange(ObjHeader** destination, ObjHeader* const* source, uint32_t count) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
+RUNTIME_NOTHROW void FillHeapRefsRange(ObjHeader** destination, const ObjHeader* object, uint32_t count) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 RUNTIME_NOTHROW void UpdateReturnRef(ObjHeader** returnSlot, const ObjHeader* object) {
     RuntimeCheck(false, "Unimplemented");
 }
@@ -114,6 +131,10 @@ RUNTIME_NOTHROW OBJ_GETTER(ReadHeapRefLocked, ObjHeader** location, int32_t* spi
     RuntimeCheck(false, "Unimplemented");
 }
 
+RUNTIME_NOTHROW OBJ_GETTER(ReadHeapRefLockFree, ObjHeader** location, int32_t* readers, int32_t* cookie) {
+    RuntimeCheck(false, "Unimplemented");
+}
+
 RUNTIME_NOTHROW void EnterFrame(ObjHeader** start, int parameters, int count) {
     RuntimeCheck(false, "Unimplemented");
 }
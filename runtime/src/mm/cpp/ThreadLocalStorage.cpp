@@ -15,6 +15,10 @@ void mm::ThreadLocalStorage::AddRecord(Key key, int size) noexcept {
         RuntimeAssert(it->second.size == size, "Attempt to add TLS record with the same key, but different size");
         return;
     }
+    // All threads store the same offset here.
+    void* offset = reinterpret_cast<void*>(static_cast<intptr_t>(size_));
+    void* previous = __atomic_exchange_n(key, offset, __ATOMIC_RELAXED);
+    RuntimeAssert(previous == nullptr || previous == offset, "TLS records must be added in the same order on all threads");
     map_.emplace(key, Entry{size_, size});
     size_ += size;
 }
@@ -31,19 +35,3 @@ void mm::ThreadLocalStorage::Clear() noexcept {
     storage_.clear();
     state_ = State::kCleared;
 }
-
-ObjHeader** mm::ThreadLocalStorage::Lookup(Key key, int index) noexcept {
-    RuntimeAssert(state_ == State::kCommitted, "Storage must be in the committed state");
-    if (lastKeyAndEntry_.first == key) {
-        return Lookup(lastKeyAndEntry_.second, index);
-    }
-    auto it = map_.find(key);
-    RuntimeAssert(it != map_.end(), "Unknown TLS key");
-    lastKeyAndEntry_ = *it;
-    return Lookup(it->second, index);
-}
-
-ObjHeader** mm::ThreadLocalStorage::Lookup(Entry entry, int index) noexcept {
-    RuntimeAssert(index < entry.size, "Out of bounds TLS access");
-    return &storage_[entry.offset + index];
-}
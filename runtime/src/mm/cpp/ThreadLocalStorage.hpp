@@ -6,19 +6,24 @@
 #ifndef RUNTIME_MM_THREAD_LOCAL_STORAGE_H
 #define RUNTIME_MM_THREAD_LOCAL_STORAGE_H
 
+#include <cstdint>
 #include <unordered_map>
-#include <utility>
 #include <vector>
 
+#include "KAssert.h"
 #include "Memory.h"
 #include "Utils.hpp"
 
 namespace kotlin {
 namespace mm {
 
+// Storage of the object references in `@ThreadLocal` globals. Each module adds a record of its own size under
+// its key, and the records are laid out one after another. Every thread adds the same records in the same order,
+// so a record has the same offset on all threads. The offset is stored right in the key, and the lookup is just
+// an addition to the storage base.
 class ThreadLocalStorage : Pinned {
 public:
-    using Key = void*;
+    using Key = void**;
 
     class Iterator {
     public:
@@ -45,7 +50,13 @@ public:
     // Clear storage. Can only be called after `Commit`.
     void Clear() noexcept;
     // Lookup value in storage. Can only be called after `Commit`.
-    ObjHeader** Lookup(Key key, int index) noexcept;
+    ObjHeader** Lookup(Key key, int index) noexcept {
+        RuntimeAssert(state_ == State::kCommitted, "Storage must be in the committed state");
+        int offset = RecordOffset(key);
+        // Only the bounds of the whole storage are checked: the bounds of the record would take a search in `map_`.
+        RuntimeAssert(index >= 0 && static_cast<size_t>(offset + index) < storage_.size(), "Out of bounds TLS access");
+        return &storage_[offset + index];
+    }
 
     Iterator begin() noexcept { return Iterator(storage_.begin()); }
     Iterator end() noexcept { return Iterator(storage_.end()); }
@@ -62,14 +73,15 @@ private:
         int size;
     };
 
-    ObjHeader** Lookup(Entry entry, int index) noexcept;
+    static int RecordOffset(Key key) noexcept {
+        return static_cast<int>(reinterpret_cast<intptr_t>(__atomic_load_n(key, __ATOMIC_RELAXED)));
+    }
 
     std::vector<ObjHeader*> storage_;
-    // TODO: `std::unordered_map` is probably the wrong container here.
+    // Only used to find duplicate records, lookups don't need it.
     std::unordered_map<Key, Entry> map_;
     State state_ = State::kBuilding;
     int size_ = 0; // Only used in `State::kBuilding`
-    std::pair<Key, Entry> lastKeyAndEntry_;
 };
 
 } // namespace mm
@@ -10,15 +10,9 @@
 
 using namespace kotlin;
 
-namespace {
-
-struct Key {};
-
-} // namespace
-
 TEST(ThreadLocalStorageTest, Lookup) {
-    Key key1;
-    Key key2;
+    void* key1 = nullptr;
+    void* key2 = nullptr;
     mm::ThreadLocalStorage tls;
 
     tls.AddRecord(&key1, 1);
@@ -46,8 +40,8 @@ TEST(ThreadLocalStorageTest, Lookup) {
 }
 
 TEST(ThreadLocalStorageTest, Iterate) {
-    Key key1;
-    Key key2;
+    void* key1 = nullptr;
+    void* key2 = nullptr;
     mm::ThreadLocalStorage tls;
 
     tls.AddRecord(&key1, 1);
@@ -68,9 +62,9 @@ TEST(ThreadLocalStorageTest, Iterate) {
 }
 
 TEST(ThreadLocalStorageTest, AddRecordEmpty) {
-    Key key1;
-    Key key2;
-    Key key3;
+    void* key1 = nullptr;
+    void* key2 = nullptr;
+    void* key3 = nullptr;
     mm::ThreadLocalStorage tls;
 
     tls.AddRecord(&key1, 1);
@@ -92,7 +86,7 @@ TEST(ThreadLocalStorageTest, AddRecordEmpty) {
 }
 
 TEST(ThreadLocalStorageTest, AddRecordSameSize) {
-    Key key1;
+    void* key1 = nullptr;
     mm::ThreadLocalStorage tls;
 
     tls.AddRecord(&key1, 1);
@@ -139,7 +133,7 @@ TEST(ThreadLocalStorageTest, ClearEmpty) {
 }
 
 TEST(ThreadLocalStorageTest, ClearNonEmpty) {
-    Key key1;
+    void* key1 = nullptr;
     mm::ThreadLocalStorage tls;
 
     tls.AddRecord(&key1, 1);
@@ -155,9 +149,9 @@ TEST(ThreadLocalStorageTest, ClearNonEmpty) {
     EXPECT_THAT(actual, testing::IsEmpty());
 }
 
-TEST(ThreadLocalStorageTest, LookupCaching) {
-    Key key1;
-    Key key2;
+TEST(ThreadLocalStorageTest, LookupRepeatedly) {
+    void* key1 = nullptr;
+    void* key2 = nullptr;
     mm::ThreadLocalStorage tls;
 
     tls.AddRecord(&key1, 1);
@@ -173,3 +167,21 @@ TEST(ThreadLocalStorageTest, LookupCaching) {
     EXPECT_EQ(location2, tls.Lookup(&key2, 0));
     EXPECT_EQ(location1, tls.Lookup(&key1, 0));
 }
+
+TEST(ThreadLocalStorageTest, SameLayoutForAllStorages) {
+    void* key1 = nullptr;
+    void* key2 = nullptr;
+    mm::ThreadLocalStorage tls1;
+    mm::ThreadLocalStorage tls2;
+
+    tls1.AddRecord(&key1, 2);
+    tls1.AddRecord(&key2, 1);
+    tls1.Commit();
+    tls2.AddRecord(&key1, 2);
+    tls2.AddRecord(&key2, 1);
+    tls2.Commit();
+
+    EXPECT_EQ(tls1.Lookup(&key2, 0) - tls1.Lookup(&key1, 0), 2);
+    EXPECT_EQ(tls2.Lookup(&key2, 0) - tls2.Lookup(&key1, 0), 2);
+    EXPECT_NE(tls1.Lookup(&key1, 1), tls2.Lookup(&key1, 1));
+}
@@ -5,11 +5,59 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-extern "C" {
-void* mi_calloc(size_t, size_t);
-void mi_free(void*);
-void* mi_calloc_aligned(size_t count, size_t size, size_t alignment);
+#include "Common.h"
+#include "mimalloc.h"
+
+namespace {
+
+// Kotlin objects allocated by this thread. Runtime structures stay in the default heap of the thread,
+// so they don't share pages with the objects.
+// Objects may be freed by any thread: mimalloc puts such blocks to the delayed free list of their page,
+// and the owning heap collects them on its next allocations.
+// The heap is released by `deinitMemory` of the thread. But the thread-exit destructor of mimalloc may run
+// before the one of Kotlin, e.g. on a foreign thread that attached the runtime, and it deletes all the heaps
+// of the thread. So mimalloc calls `onThreadDone` first, and the heap is released there instead.
+THREAD_LOCAL_VARIABLE mi_heap_t* objectHeap = nullptr;
+
+void onThreadDone() {
+  mi_heap_t* heap = objectHeap;
+  if (heap == nullptr) return;
+  objectHeap = nullptr;
+  mi_heap_delete(heap);
+}
+
+mi_heap_t* getObjectHeap() {
+  mi_heap_t* heap = objectHeap;
+  if (heap == nullptr) {
+    mi_register_thread_done(onThreadDone);
+    heap = mi_heap_new();
+    objectHeap = heap;
+  }
+  return heap;
+}
+
+bool addAreaSize(const mi_heap_t*, const mi_heap_area_t* area, void*, size_t, void* arg) {
+  // `used` is the number of used blocks in the area.
+  *reinterpret_cast<size_t*>(arg) += area->used * area->block_size;
+  return true;
+}
+
+struct BlockVisitor {
+  void (*visitor)(void*, void*);
+  void* argument;
+};
+
+bool visitBlock(const mi_heap_t*, const mi_heap_area_t*, void* block, size_t, void* arg) {
+  // Called for each area with a null block as well.
+  if (block == nullptr) return true;
+  auto* blockVisitor = reinterpret_cast<BlockVisitor*>(arg);
+  blockVisitor->visitor(block, blockVisitor->argument);
+  return true;
+}
 
+}  // namespace
+
+extern "C" {
 void* konan_calloc_impl(size_t n_elements, size_t elem_size) {
  return mi_calloc(n_elements, elem_size);
 }
@@ -21,4 +69,53 @@ void* konan_calloc_aligned_impl(size_t count, size_t size, size_t alignment) {
 void konan_free_impl (void* mem) {
   mi_free(mem);
 }
+
+void* konan_calloc_object_impl(size_t size) {
+  mi_heap_t* heap = getObjectHeap();
+  if (heap == nullptr) return nullptr;
+  return mi_heap_calloc(heap, 1, size);
+}
+
+void* konan_malloc_object_impl(size_t size) {
+  mi_heap_t* heap = getObjectHeap();
+  if (heap == nullptr) return nullptr;
+  return mi_heap_malloc(heap, size);
+}
+
+void konan_free_object_impl(void* mem) {
+  mi_free(mem);
+}
+
+void konan_release_object_heap_impl() {
+  // Objects still alive (e.g. transferred to other workers) are moved to the default heap of the thread,
+  // the empty pages are returned.
+  onThreadDone();
+}
+
+size_t konan_object_usable_size_impl(void* mem) {
+  return mi_usable_size(mem);
+}
+
+void konan_trim_heap_impl() {
+  if (objectHeap != nullptr) mi_heap_collect(objectHeap, true);
+  mi_collect(true);
+}
+
+long long konan_object_heap_size_impl() {
+  mi_heap_t* heap = objectHeap;
+  if (heap == nullptr) return 0;
+  size_t size = 0;
+  mi_heap_visit_blocks(heap, false, addAreaSize, &size);
+  return static_cast<long long>(size);
+}
+
+bool konan_visit_object_heap_impl(void (*visitor)(void*, void*), void* argument) {
+  mi_heap_t* heap = objectHeap;
+  if (heap == nullptr) return true;
+  // Collects the blocks freed by other threads, so that they are not visited.
+  mi_heap_collect(heap, false);
+  BlockVisitor blockVisitor = { visitor, argument };
+  mi_heap_visit_blocks(heap, true, visitBlock, &blockVisitor);
+  return true;
+}
 }  // extern "C"
@@ -4,6 +4,11 @@
  */
 #include <stdlib.h>
 #include <stdio.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
 
 extern "C" {
 // Memory operations.
@@ -19,5 +24,43 @@ void* konan_calloc_aligned_impl(size_t count, size_t size, size_t alignment) {
 void konan_free_impl (void* mem) {
   free(mem);
 }
+
+// Kotlin objects share the heap with everything else here.
+void* konan_calloc_object_impl(size_t size) {
+  return calloc(1, size);
+}
+
+void* konan_malloc_object_impl(size_t size) {
+  return malloc(size);
+}
+
+void konan_free_object_impl(void* mem) {
+  free(mem);
 }
 
+void konan_release_object_heap_impl() {}
+
+size_t konan_object_usable_size_impl(void* mem) {
+#if defined(__APPLE__)
+  return malloc_size(mem);
+#elif defined(_WIN32)
+  return _msize(mem);
+#else
+  return malloc_usable_size(mem);
+#endif
+}
+
+void konan_trim_heap_impl() {
+#if defined(__GLIBC__)
+  malloc_trim(0);
+#endif
+}
+
+long long konan_object_heap_size_impl() {
+  return -1;
+}
+
+bool konan_visit_object_heap_impl(void (*visitor)(void*, void*), void* argument) {
+  return false;
+}
+}
@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+#
+# Copyright 2010-2020 JetBrains s.r.o. Use of this source code is governed by the Apache 2.0 license
+# that can be found in the LICENSE file.
+#
+"""Analyzes heap snapshots written by kotlin.native.internal.GC.dumpHeapSnapshot.
+
+Computes the dominator tree of the objects and reports the shallow and retained sizes per type and the objects
+retaining the most memory. The retained size of an object is the memory freed if the object became unreachable;
+the retained size of a type is the memory of the union of the retained sets of its objects.
+
+Besides the explicit roots of the snapshot, an object is a root if its reference count exceeds the number of
+references to it from the snapshot (it is referenced from a global, a stable pointer or another thread), or if
+its reference count is unknown and nothing in the snapshot refers to it.
+
+See runtime/src/main/cpp/HeapSnapshot.hpp for the format.
+"""
+
+import argparse
+import sys
+
+MAGIC = b"KNHEAP"
+VERSION = 1
+
+TAG_END = 0
+TAG_TYPE = 1
+TAG_OBJECT = 2
+TAG_ROOT = 3
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.position = 0
+
+    def byte(self):
+        value = self.data[self.position]
+        self.position += 1
+        return value
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            value = self.data[self.position]
+            self.position += 1
+            result |= (value & 0x7f) << shift
+            if value < 0x80:
+                return result
+            shift += 7
+
+    def string(self):
+        length = self.varint()
+        result = self.data[self.position:self.position + length].decode("utf-8", errors="replace")
+        self.position += length
+        return result
+
+
+class Snapshot:
+    def __init__(self):
+        # Type id -> (name, reference field names).
+        self.types = {}
+        self.addresses = []
+        self.object_types = []
+        self.sizes = []
+        # Reference count + 1, 0 if unknown.
+        self.ref_counts = []
+        # Addresses of the referred objects, some of them may be outside the snapshot.
+        self.references = []
+        self.roots = []
+
+
+def read_snapshot(path):
+    with open(path, "rb") as file:
+        data = file.read()
+    if not data.startswith(MAGIC):
+        raise ValueError("%s is not a heap snapshot" % path)
+    reader = Reader(data)
+    reader.position = len(MAGIC)
+    version = reader.byte()
+    if version != VERSION:
+        raise ValueError("Unsupported snapshot version %d" % version)
+    snapshot = Snapshot()
+    while True:
+        tag = reader.byte()
+        if tag == TAG_END:
+            return snapshot
+        if tag == TAG_TYPE:
+            type_id = reader.varint()
+            name = reader.string()
+            reader.varint()  # Zigzag-encoded instance size.
+            fields = [reader.string() for _ in range(reader.varint())]
+            snapshot.types[type_id] = (name, fields)
+        elif tag == TAG_OBJECT:
+            snapshot.addresses.append(reader.varint())
+            snapshot.object_types.append(reader.varint())
+            snapshot.sizes.append(reader.varint())
+            snapshot.ref_counts.append(reader.varint())
+            snapshot.references.append([reader.varint() for _ in range(reader.varint())])
+        elif tag == TAG_ROOT:
+            reader.byte()  # Root kind.
+            snapshot.roots.append(reader.varint())
+        else:
+            raise ValueError("Unknown record %d at offset %d, the snapshot is truncated or corrupt"
+                             % (tag, reader.position - 1))
+
+
+def build_graph(snapshot):
+    """Returns the successors of every node, node 0 being the virtual root and node i + 1 the i-th object."""
+    index = {address: i + 1 for i, address in enumerate(snapshot.addresses)}
+    count = len(snapshot.addresses) + 1
+    successors = [[] for _ in range(count)]
+    incoming = [0] * count
+    for i, references in enumerate(snapshot.references):
+        node = successors[i + 1]
+        for address in references:
+            target = index.get(address)
+            if target is not None:
+                node.append(target)
+                incoming[target] += 1
+    roots = successors[0]
+    for address in snapshot.roots:
+        target = index.get(address)
+        if target is not None:
+            roots.append(target)
+    for i, ref_count in enumerate(snapshot.ref_counts):
+        node = i + 1
+        if (ref_count == 0 and incoming[node] == 0) or ref_count - 1 > incoming[node]:
+            roots.append(node)
+    return successors
+
+
+def reverse_postorder(successors):
+    visited = [False] * len(successors)
+    order = []
+    visited[0] = True
+    stack = [(0, iter(successors[0]))]
+    while stack:
+        node, children = stack[-1]
+        for child in children:
+            if not visited[child]:
+                visited[child] = True
+                stack.append((child, iter(successors[child])))
+                break
+        else:
+            stack.pop()
+            order.append(node)
+    order.reverse()
+    return order
+
+
+def dominators(successors, order):
+    """Cooper, Harvey, Kennedy. "A Simple, Fast Dominance Algorithm". Unreachable nodes get -1."""
+    position = [-1] * len(successors)
+    for i, node in enumerate(order):
+        position[node] = i
+    predecessors = [[] for _ in range(len(successors))]
+    for node in order:
+        for child in successors[node]:
+            predecessors[child].append(node)
+    idom = [-1] * len(successors)
+    idom[0] = 0
+
+    def intersect(a, b):
+        while a != b:
+            while position[a] > position[b]:
+                a = idom[a]
+            while position[b] > position[a]:
+                b = idom[b]
+        return a
+
+    changed = True
+    while changed:
+        changed = False
+        for node in order[1:]:
+            new_idom = -1
+            for predecessor in predecessors[node]:
+                if idom[predecessor] == -1:
+                    continue
+                new_idom = predecessor if new_idom == -1 else intersect(predecessor, new_idom)
+            if idom[node] != new_idom:
+                idom[node] = new_idom
+                changed = True
+    return idom
+
+
+def analyze(snapshot):
+    successors = build_graph(snapshot)
+    order = reverse_postorder(successors)
+    idom = dominators(successors, order)
+    sizes = [0] + snapshot.sizes
+    types = [None] + snapshot.object_types
+
+    retained = sizes[:]
+    for node in reversed(order[1:]):
+        retained[idom[node]] += retained[node]
+
+    # An object contributes to the retained size of its type unless it is dominated by another object of the type.
+    children = [[] for _ in range(len(successors))]
+    for node in order[1:]:
+        children[idom[node]].append(node)
+    type_stats = {}
+    for type_id in snapshot.types:
+        type_stats[type_id] = [0, 0, 0]  # Count, shallow size, retained size.
+    for i, type_id in enumerate(snapshot.object_types):
+        stats = type_stats.setdefault(type_id, [0, 0, 0])
+        stats[0] += 1
+        stats[1] += snapshot.sizes[i]
+    on_path = {}
+    stack = [(0, False)]
+    while stack:
+        node, leaving = stack.pop()
+        type_id = types[node]
+        if leaving:
+            on_path[type_id] -= 1
+            continue
+        if node != 0:
+            if on_path.get(type_id, 0) == 0:
+                type_stats[type_id][2] += retained[node]
+            on_path[type_id] = on_path.get(type_id, 0) + 1
+            stack.append((node, True))
+        for child in children[node]:
+            stack.append((child, False))
+
+    reachable = len(order) - 1
+    return retained, type_stats, reachable
+
+
+def format_size(size):
+    for unit in ("B", "KB", "MB"):
+        if size < 1024:
+            return "%d %s" % (size, unit)
+        size //= 1024
+    return "%d GB" % size
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("snapshot", help="snapshot written by GC.dumpHeapSnapshot")
+    parser.add_argument("--types", type=int, default=30, help="number of types to report (default: %(default)s)")
+    parser.add_argument("--objects", type=int, default=20,
+                        help="number of the largest retainers to report (default: %(default)s)")
+    parser.add_argument("--bytes", action="store_true", help="report sizes in bytes")
+    args = parser.parse_args()
+
+    snapshot = read_snapshot(args.snapshot)
+    retained, type_stats, reachable = analyze(snapshot)
+    size = str if args.bytes else format_size
+    type_name = lambda type_id: snapshot.types.get(type_id, ("<unknown type>",))[0]
+
+    total = sum(snapshot.sizes)
+    print("%d objects, %s; %d reachable, %s" % (len(snapshot.sizes), size(total), reachable, size(retained[0])))
+    print()
+    print("%10s %14s %14s  %s" % ("Count", "Shallow", "Retained", "Type"))
+    by_retained = sorted(type_stats.items(), key=lambda item: (item[1][2], item[1][1]), reverse=True)
+    for type_id, (count, shallow, type_retained) in by_retained[:args.types]:
+        if count == 0:
+            continue
+        print("%10d %14s %14s  %s" % (count, size(shallow), size(type_retained), type_name(type_id)))
+    print()
+    print("%18s %14s %14s  %s" % ("Address", "Shallow", "Retained", "Type"))
+    largest = sorted(range(len(snapshot.sizes)), key=lambda i: retained[i + 1], reverse=True)
+    for i in largest[:args.objects]:
+        print("%18s %14s %14s  %s" % (hex(snapshot.addresses[i]), size(snapshot.sizes[i]), size(retained[i + 1]),
+                                      type_name(snapshot.object_types[i])))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())